@@ -0,0 +1,338 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "SAPI.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/object.h"
+#include "kernel/exception.h"
+#include "kernel/fcall.h"
+#include "kernel/array.h"
+#include "kernel/operators.h"
+#include "kernel/concat.h"
+#include "kernel/file.h"
+
+#ifndef PHP_WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Phalcon\CLI\Task\Volt
+ *
+ * Compiles every Volt template in a views directory ahead of time, so the application
+ * servers can run Volt with "compileAlways" and "stat" disabled and never compile a
+ * template at runtime. A manifest with the compiled path of every template is written
+ * after compiling them
+ *
+ *<code>
+ *
+ *class VoltTask extends \Phalcon\CLI\Task\Volt
+ *{
+ *
+ *  //The same options passed to Phalcon\Mvc\View\Engine\Volt
+ *  protected $_options = array(
+ *    "compiledPath" => "../app/compiled-templates/",
+ *    "compiledSeparator" => "_"
+ *  );
+ *
+ *}
+ *
+ * //Compiles app/views/ using 4 processes
+ * //php cli.php volt compile app/views/ 4
+ *
+ *</code>
+ */
+
+
+/**
+ * Phalcon\CLI\Task\Volt initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_CLI_Task_Volt){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\CLI\\Task, Volt, cli_task_volt, "phalcon\\cli\\task", phalcon_cli_task_volt_method_entry, 0);
+
+	zend_declare_property_null(phalcon_cli_task_volt_ce, SL("_options"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_string(phalcon_cli_task_volt_ce, SL("_extension"), ".volt", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_cli_task_volt_ce, SL("_manifestPath"), ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	return SUCCESS;
+}
+
+/**
+ * Checks if the templates can be compiled in child processes
+ */
+static int phalcon_cli_task_volt_can_fork(TSRMLS_D){
+
+#ifndef PHP_WIN32
+	return sapi_module.name && !strcmp(sapi_module.name, "cli");
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Compiles every chunk of templates in a child process returning the number of processes
+ * that failed. Children leave with _exit so the resources shared with the parent aren't
+ * released twice
+ */
+static int phalcon_cli_task_volt_fork(zval *compiler, zval *chunks TSRMLS_DC){
+
+	int failed = 0;
+
+#ifndef PHP_WIN32
+	zval **chunk, *result = NULL;
+	HashPosition pos;
+	pid_t pid, *pids;
+	int number_pids = 0, status, i;
+
+	pids = ecalloc(zend_hash_num_elements(Z_ARRVAL_P(chunks)), sizeof(pid_t));
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(chunks), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(chunks), (void **) &chunk, &pos) == SUCCESS) {
+
+		pid = fork();
+		if (!pid) {
+			zend_call_method_with_1_params(&compiler, Z_OBJCE_P(compiler), NULL, "compilefiles", &result, *chunk);
+			_exit((EG(exception) || !result) ? 1 : 0);
+		}
+
+		/**
+		 * The chunk is compiled by the parent if the process can't be created
+		 */
+		if (pid < 0) {
+			zend_call_method_with_1_params(&compiler, Z_OBJCE_P(compiler), NULL, "compilefiles", &result, *chunk);
+			if (result) {
+				zval_ptr_dtor(&result);
+				result = NULL;
+			}
+			if (EG(exception)) {
+				break;
+			}
+		} else {
+			pids[number_pids++] = pid;
+		}
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(chunks), &pos);
+	}
+
+	for (i = 0; i < number_pids; i++) {
+		if (waitpid(pids[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+			failed++;
+		}
+	}
+
+	efree(pids);
+#endif
+
+	return failed;
+}
+
+/**
+ * Compiles the templates in a views directory. When no directory is passed the views
+ * directory of the "view" service is used
+ *
+ * @param string $viewsDir
+ * @param int $processes
+ * @return array
+ */
+PHP_METHOD(Phalcon_CLI_Task_Volt, compileAction){
+
+	zval *views_dir = NULL, *processes = NULL, *dependency_injector;
+	zval *service, *view, *compiler, *options, *extension;
+	zval *templates, *chunk_size, *chunks, *manifest = NULL;
+	zval *template_path = NULL, *compiled_path = NULL, *manifest_path = NULL;
+	zval *compiled_dir = NULL, *export_return, *export, *contents;
+	zval *failed_processes, *exception_message = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	long number_processes, number_templates;
+	int failed, eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|zz", &views_dir, &processes) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(dependency_injector);
+	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	if (!views_dir || !zend_is_true(views_dir)) {
+		if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "A dependency injection object is required to access the 'view' service");
+			return;
+		}
+	
+		PHALCON_INIT_VAR(service);
+		ZVAL_STRING(service, "view", 1);
+	
+		PHALCON_INIT_VAR(view);
+		PHALCON_CALL_METHOD_PARAMS_1(view, dependency_injector, "getshared", service, PH_NO_CHECK);
+	
+		PHALCON_INIT_NVAR(views_dir);
+		PHALCON_CALL_METHOD(views_dir, view, "getviewsdir", PH_NO_CHECK);
+	}
+	
+	if (!processes) {
+		number_processes = 1;
+	} else {
+		number_processes = phalcon_get_intval(processes);
+	}
+	
+	PHALCON_INIT_VAR(compiler);
+	object_init_ex(compiler, phalcon_mvc_view_engine_volt_compiler_ce);
+	if (Z_TYPE_P(dependency_injector) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setdi", dependency_injector, PH_NO_CHECK);
+	}
+	
+	PHALCON_INIT_VAR(options);
+	phalcon_read_property(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	if (Z_TYPE_P(options) == IS_ARRAY) { 
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", options, PH_NO_CHECK);
+	}
+	
+	PHALCON_INIT_VAR(extension);
+	phalcon_read_property(&extension, this_ptr, SL("_extension"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(templates);
+	PHALCON_CALL_METHOD_PARAMS_2(templates, compiler, "findtemplates", views_dir, extension, PH_NO_CHECK);
+	
+	number_templates = zend_hash_num_elements(Z_ARRVAL_P(templates));
+	if (number_processes > 1 && number_templates > 1 && phalcon_cli_task_volt_can_fork(TSRMLS_C)) {
+	
+		/** 
+		 * Split the templates between the processes
+		 */
+		PHALCON_INIT_VAR(chunk_size);
+		ZVAL_LONG(chunk_size, (number_templates + number_processes - 1) / number_processes);
+	
+		PHALCON_INIT_VAR(chunks);
+		PHALCON_CALL_FUNC_PARAMS_2(chunks, "array_chunk", templates, chunk_size);
+	
+		failed = phalcon_cli_task_volt_fork(compiler, chunks TSRMLS_CC);
+		if (EG(exception)) {
+			PHALCON_MM_RESTORE();
+			return;
+		}
+	
+		if (failed) {
+			PHALCON_INIT_VAR(failed_processes);
+			ZVAL_LONG(failed_processes, failed);
+	
+			PHALCON_INIT_VAR(exception_message);
+			PHALCON_CONCAT_SV(exception_message, "Templates could not be compiled, failed processes: ", failed_processes);
+			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+			return;
+		}
+	
+		PHALCON_INIT_VAR(manifest);
+		array_init(manifest);
+	
+		if (!phalcon_valid_foreach(templates TSRMLS_CC)) {
+			return;
+		}
+	
+		ah0 = Z_ARRVAL_P(templates);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	
+		ph_cycle_start_0:
+	
+			if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
+				goto ph_cycle_end_0;
+			}
+	
+			PHALCON_GET_FOREACH_VALUE(template_path);
+	
+			PHALCON_INIT_NVAR(compiled_path);
+			PHALCON_CALL_METHOD_PARAMS_1(compiled_path, compiler, "getcompiledpath", template_path, PH_NO_CHECK);
+			phalcon_array_update_zval(&manifest, template_path, &compiled_path, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+			goto ph_cycle_start_0;
+	
+		ph_cycle_end_0:
+		if(0){}
+	
+	} else {
+		PHALCON_INIT_NVAR(manifest);
+		PHALCON_CALL_METHOD_PARAMS_1(manifest, compiler, "compilefiles", templates, PH_NO_CHECK);
+	}
+	
+	/** 
+	 * The manifest is placed in the compilation directory, if there isn't one it's placed
+	 * in the views directory
+	 */
+	PHALCON_INIT_VAR(manifest_path);
+	phalcon_read_property(&manifest_path, this_ptr, SL("_manifestPath"), PH_NOISY_CC);
+	if (Z_TYPE_P(manifest_path) == IS_NULL) {
+		PHALCON_INIT_VAR(compiled_dir);
+		if (Z_TYPE_P(options) == IS_ARRAY) { 
+			eval_int = phalcon_array_isset_string(options, SS("compiledPath"));
+			if (eval_int) {
+				PHALCON_INIT_NVAR(compiled_dir);
+				phalcon_array_fetch_string(&compiled_dir, options, SL("compiledPath"), PH_NOISY_CC);
+			}
+		}
+		if (!zend_is_true(compiled_dir)) {
+			PHALCON_CPY_WRT(compiled_dir, views_dir);
+		}
+	
+		PHALCON_INIT_NVAR(manifest_path);
+		if (Z_TYPE_P(compiled_dir) == IS_STRING && Z_STRLEN_P(compiled_dir) && Z_STRVAL_P(compiled_dir)[Z_STRLEN_P(compiled_dir) - 1] != '/' && Z_STRVAL_P(compiled_dir)[Z_STRLEN_P(compiled_dir) - 1] != '\\') {
+			PHALCON_CONCAT_VS(manifest_path, compiled_dir, "/volt-manifest.php");
+		} else {
+			PHALCON_CONCAT_VS(manifest_path, compiled_dir, "volt-manifest.php");
+		}
+	}
+	
+	PHALCON_INIT_VAR(export_return);
+	ZVAL_BOOL(export_return, 1);
+	
+	PHALCON_INIT_VAR(export);
+	PHALCON_CALL_FUNC_PARAMS_2(export, "var_export", manifest, export_return);
+	
+	PHALCON_INIT_VAR(contents);
+	PHALCON_CONCAT_SVS(contents, "<?php\n\nreturn ", export, ";\n");
+	if (phalcon_file_put_contents_atomic(manifest_path, contents TSRMLS_CC) == FAILURE) {
+		PHALCON_INIT_NVAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Manifest file ", manifest_path, " could not be written");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+		return;
+	}
+	
+	RETURN_CCTOR(manifest);
+}
+
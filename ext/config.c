@@ -28,6 +28,8 @@
 #include "Zend/zend_operators.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
+#include "Zend/zend_object_handlers.h"
+#include "Zend/zend_gc.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -59,8 +61,195 @@
  *  )
  * ));</code>
  *
+ * Nested arrays are kept as they are and converted to Phalcon\Config objects the first time
+ * they're accessed, sections that are never read don't create objects
  */
 
+static zend_object_handlers phalcon_config_object_handlers;
+
+/**
+ * Arrays without a 0 index are exposed as nested Phalcon\Config objects
+ */
+static void phalcon_config_materialize(zval **slot TSRMLS_DC){
+
+	zval *config;
+
+	if (Z_TYPE_PP(slot) != IS_ARRAY || Z_ISREF_PP(slot) || zend_hash_index_exists(Z_ARRVAL_PP(slot), 0)) {
+		return;
+	}
+
+	MAKE_STD_ZVAL(config);
+	object_init_ex(config, phalcon_config_ce);
+	phalcon_config_import(config, *slot TSRMLS_CC);
+
+	zval_ptr_dtor(slot);
+	*slot = config;
+}
+
+/**
+ * Converts the nested array stored in a property before it's used
+ */
+static void phalcon_config_materialize_property(zval *object, zval *member TSRMLS_DC){
+
+	HashTable *properties;
+	zval **slot;
+
+	if (Z_TYPE_P(member) != IS_STRING) {
+		return;
+	}
+
+	properties = zend_std_get_properties(object TSRMLS_CC);
+	if (properties && zend_hash_find(properties, Z_STRVAL_P(member), Z_STRLEN_P(member) + 1, (void **) &slot) == SUCCESS) {
+		phalcon_config_materialize(slot TSRMLS_CC);
+	}
+}
+
+/**
+ * Converts all the nested arrays, used when the object is iterated, dumped or compared
+ */
+static HashTable *phalcon_config_get_properties(zval *object TSRMLS_DC){
+
+	HashTable *properties;
+	HashPosition pos;
+	zval **slot;
+
+	properties = zend_std_get_properties(object TSRMLS_CC);
+
+	/** 
+	 * The garbage collector walks the properties too, nothing can be allocated while it runs
+	 */
+	if (properties && !GC_G(gc_active)) {
+		zend_hash_internal_pointer_reset_ex(properties, &pos);
+		while (zend_hash_get_current_data_ex(properties, (void **) &slot, &pos) == SUCCESS) {
+			phalcon_config_materialize(slot TSRMLS_CC);
+			zend_hash_move_forward_ex(properties, &pos);
+		}
+	}
+
+	return properties;
+}
+
+#if PHP_VERSION_ID >= 50400
+static zval *phalcon_config_read_property(zval *object, zval *member, int type, const zend_literal *key TSRMLS_DC){
+	phalcon_config_materialize_property(object, member TSRMLS_CC);
+	return zend_std_read_property(object, member, type, key TSRMLS_CC);
+}
+#else
+static zval *phalcon_config_read_property(zval *object, zval *member, int type TSRMLS_DC){
+	phalcon_config_materialize_property(object, member TSRMLS_CC);
+	return zend_std_read_property(object, member, type TSRMLS_CC);
+}
+#endif
+
+#if PHP_VERSION_ID >= 50500
+static zval **phalcon_config_get_property_ptr_ptr(zval *object, zval *member, int type, const zend_literal *key TSRMLS_DC){
+	phalcon_config_materialize_property(object, member TSRMLS_CC);
+	return zend_std_get_property_ptr_ptr(object, member, type, key TSRMLS_CC);
+}
+#elif PHP_VERSION_ID >= 50400
+static zval **phalcon_config_get_property_ptr_ptr(zval *object, zval *member, const zend_literal *key TSRMLS_DC){
+	phalcon_config_materialize_property(object, member TSRMLS_CC);
+	return zend_std_get_property_ptr_ptr(object, member, key TSRMLS_CC);
+}
+#else
+static zval **phalcon_config_get_property_ptr_ptr(zval *object, zval *member TSRMLS_DC){
+	phalcon_config_materialize_property(object, member TSRMLS_CC);
+	return zend_std_get_property_ptr_ptr(object, member TSRMLS_CC);
+}
+#endif
+
+static int phalcon_config_compare_objects(zval *object1, zval *object2 TSRMLS_DC){
+
+	phalcon_config_get_properties(object1 TSRMLS_CC);
+	phalcon_config_get_properties(object2 TSRMLS_CC);
+
+	return zend_std_compare_objects(object1, object2 TSRMLS_CC);
+}
+
+static zend_object_value phalcon_config_object_new(zend_class_entry *class_type TSRMLS_DC){
+
+	zend_object *object;
+	zend_object_value retval;
+#if PHP_VERSION_ID < 50400
+	zval *tmp;
+#endif
+
+	retval = zend_objects_new(&object, class_type TSRMLS_CC);
+#if PHP_VERSION_ID >= 50400
+	object_properties_init(object, class_type);
+#else
+	zend_hash_copy(object->properties, &class_type->default_properties, (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+#endif
+	retval.handlers = &phalcon_config_object_handlers;
+
+	return retval;
+}
+
+/**
+ * Copies the values of an array to the properties of a Phalcon\Config
+ */
+void phalcon_config_import(zval *object, zval *array_config TSRMLS_DC){
+
+	HashPosition pos;
+	zval **value;
+	char *key, numeric_key[MAX_LENGTH_OF_LONG + 1];
+	uint key_length;
+	ulong index;
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(array_config), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(array_config), (void **) &value, &pos) == SUCCESS) {
+
+		if (zend_hash_get_current_key_ex(Z_ARRVAL_P(array_config), &key, &key_length, &index, 0, &pos) != HASH_KEY_IS_STRING) {
+			key_length = snprintf(numeric_key, sizeof(numeric_key), "%lu", index) + 1;
+			key = numeric_key;
+		}
+
+		add_property_zval_ex(object, key, key_length, *value TSRMLS_CC);
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(array_config), &pos);
+	}
+}
+
+/**
+ * Builds an array with the values of a Phalcon\Config, nested arrays that were not accessed are
+ * shared as they are
+ */
+static void phalcon_config_to_array(zval *return_value, zval *object TSRMLS_DC){
+
+	HashTable *properties;
+	HashPosition pos;
+	zval **value, *item;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	properties = zend_std_get_properties(object TSRMLS_CC);
+
+	array_init_size(return_value, properties ? zend_hash_num_elements(properties) : 0);
+	if (!properties) {
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(properties, &pos);
+	while (zend_hash_get_current_data_ex(properties, (void **) &value, &pos) == SUCCESS) {
+
+		if (Z_TYPE_PP(value) == IS_OBJECT && instanceof_function(Z_OBJCE_PP(value), phalcon_config_ce TSRMLS_CC)) {
+			MAKE_STD_ZVAL(item);
+			phalcon_config_to_array(item, *value TSRMLS_CC);
+		} else {
+			item = *value;
+			Z_ADDREF_P(item);
+		}
+
+		if (zend_hash_get_current_key_ex(properties, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+			zend_symtable_update(Z_ARRVAL_P(return_value), key, key_length, &item, sizeof(zval *), NULL);
+		} else {
+			zend_hash_index_update(Z_ARRVAL_P(return_value), index, &item, sizeof(zval *), NULL);
+		}
+
+		zend_hash_move_forward_ex(properties, &pos);
+	}
+}
 
 /**
  * Phalcon\Config initializer
@@ -69,6 +258,14 @@ PHALCON_INIT_CLASS(Phalcon_Config){
 
 	PHALCON_REGISTER_CLASS(Phalcon, Config, config, phalcon_config_method_entry, 0);
 
+	phalcon_config_ce->create_object = phalcon_config_object_new;
+
+	memcpy(&phalcon_config_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	phalcon_config_object_handlers.read_property = phalcon_config_read_property;
+	phalcon_config_object_handlers.get_property_ptr_ptr = phalcon_config_get_property_ptr_ptr;
+	phalcon_config_object_handlers.get_properties = phalcon_config_get_properties;
+	phalcon_config_object_handlers.compare_objects = phalcon_config_compare_objects;
+
 	return SUCCESS;
 }
 
@@ -79,15 +276,7 @@ PHALCON_INIT_CLASS(Phalcon_Config){
  */
 PHP_METHOD(Phalcon_Config, __construct){
 
-	zval *array_config = NULL, *value = NULL, *key = NULL, *config_value = NULL;
-	HashTable *ah0;
-	HashPosition hp0;
-	zval **hd;
-	char *hash_index;
-	uint hash_index_len;
-	ulong hash_num;
-	int hash_type;
-	int eval_int;
+	zval *array_config = NULL;
 
 	PHALCON_MM_GROW();
 
@@ -101,43 +290,7 @@ PHP_METHOD(Phalcon_Config, __construct){
 	}
 	
 	if (Z_TYPE_P(array_config) == IS_ARRAY) { 
-	
-		if (!phalcon_valid_foreach(array_config TSRMLS_CC)) {
-			return;
-		}
-	
-		ah0 = Z_ARRVAL_P(array_config);
-		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	
-		ph_cycle_start_0:
-	
-			if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
-				goto ph_cycle_end_0;
-			}
-	
-			PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
-			PHALCON_GET_FOREACH_VALUE(value);
-	
-			if (Z_TYPE_P(value) == IS_ARRAY) { 
-				eval_int = phalcon_array_isset_long(value, 0);
-				if (!eval_int) {
-					PHALCON_INIT_NVAR(config_value);
-					object_init_ex(config_value, phalcon_config_ce);
-					PHALCON_CALL_METHOD_PARAMS_1_NORETURN(config_value, "__construct", value, PH_CHECK);
-					phalcon_update_property_zval_zval(this_ptr, key, config_value TSRMLS_CC);
-				} else {
-					phalcon_update_property_zval_zval(this_ptr, key, value TSRMLS_CC);
-				}
-			} else {
-				phalcon_update_property_zval_zval(this_ptr, key, value TSRMLS_CC);
-			}
-	
-			zend_hash_move_forward_ex(ah0, &hp0);
-			goto ph_cycle_start_0;
-	
-		ph_cycle_end_0:
-		if(0){}
-	
+		phalcon_config_import(this_ptr, array_config TSRMLS_CC);
 	} else {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_config_exception_ce, "The configuration must be an Array");
 		return;
@@ -169,3 +322,18 @@ PHP_METHOD(Phalcon_Config, __set_state){
 	RETURN_CTOR(config);
 }
 
+/**
+ * Converts the object recursively to an array
+ *
+ *<code>
+ *	print_r($config->toArray());
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Config, toArray){
+
+
+	phalcon_config_to_array(return_value, this_ptr TSRMLS_CC);
+}
+
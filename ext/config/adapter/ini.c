@@ -39,6 +39,8 @@
 #include "kernel/string.h"
 #include "kernel/array.h"
 
+#include "main/php_streams.h"
+
 /**
  * Phalcon\Config\Adapter\Ini
  *
@@ -68,7 +70,136 @@
  *	echo $config->database->username;
  *</code>
  *
+ * Parsed files are kept in memory by the process, they're only parsed again when their
+ * modification time or size change
+ */
+
+typedef struct _phalcon_config_ini_entry {
+	time_t mtime;
+	off_t size;
+	zval *config;
+} phalcon_config_ini_entry;
+
+/**
+ * Copies a parsed configuration to persistent memory
+ */
+static zval *phalcon_config_ini_persist(zval *value){
+
+	zval *copy, **item, *item_copy;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	copy = pemalloc(sizeof(zval), 1);
+	*copy = *value;
+	INIT_PZVAL(copy);
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			Z_STRVAL_P(copy) = pestrndup(Z_STRVAL_P(value), Z_STRLEN_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+			Z_ARRVAL_P(copy) = pemalloc(sizeof(HashTable), 1);
+			zend_hash_init(Z_ARRVAL_P(copy), zend_hash_num_elements(Z_ARRVAL_P(value)), NULL, NULL, 1);
+
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void **) &item, &pos) == SUCCESS) {
+				item_copy = phalcon_config_ini_persist(*item);
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(value), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+					zend_hash_update(Z_ARRVAL_P(copy), key, key_length, &item_copy, sizeof(zval *), NULL);
+				} else {
+					zend_hash_index_update(Z_ARRVAL_P(copy), index, &item_copy, sizeof(zval *), NULL);
+				}
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos);
+			}
+			break;
+
+		case IS_NULL:
+		case IS_BOOL:
+		case IS_LONG:
+		case IS_DOUBLE:
+			break;
+
+		default:
+			ZVAL_NULL(copy);
+			break;
+	}
+
+	return copy;
+}
+
+/**
+ * Releases a configuration copied by phalcon_config_ini_persist
  */
+static void phalcon_config_ini_persist_free(zval *value){
+
+	zval **item;
+	HashPosition pos;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_STRING:
+			pefree(Z_STRVAL_P(value), 1);
+			break;
+
+		case IS_ARRAY:
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void **) &item, &pos) == SUCCESS) {
+				phalcon_config_ini_persist_free(*item);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos);
+			}
+			zend_hash_destroy(Z_ARRVAL_P(value));
+			pefree(Z_ARRVAL_P(value), 1);
+			break;
+	}
+
+	pefree(value, 1);
+}
+
+/**
+ * Copies a cached configuration back to the request memory
+ */
+static zval *phalcon_config_ini_restore(zval *value){
+
+	zval *copy, **item, *item_copy;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	ALLOC_INIT_ZVAL(copy);
+	*copy = *value;
+	INIT_PZVAL(copy);
+
+	if (Z_TYPE_P(value) == IS_STRING) {
+		Z_STRVAL_P(copy) = estrndup(Z_STRVAL_P(value), Z_STRLEN_P(value));
+	} else if (Z_TYPE_P(value) == IS_ARRAY) {
+		array_init_size(copy, zend_hash_num_elements(Z_ARRVAL_P(value)));
+
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(value), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(value), (void **) &item, &pos) == SUCCESS) {
+			item_copy = phalcon_config_ini_restore(*item);
+			if (zend_hash_get_current_key_ex(Z_ARRVAL_P(value), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+				zend_hash_update(Z_ARRVAL_P(copy), key, key_length, &item_copy, sizeof(zval *), NULL);
+			} else {
+				zend_hash_index_update(Z_ARRVAL_P(copy), index, &item_copy, sizeof(zval *), NULL);
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(value), &pos);
+		}
+	}
+
+	return copy;
+}
+
+static void phalcon_config_ini_entry_dtor(void *data){
+
+	phalcon_config_ini_entry *entry = (phalcon_config_ini_entry *) data;
+
+	phalcon_config_ini_persist_free(entry->config);
+}
 
 
 /**
@@ -100,6 +231,13 @@ PHP_METHOD(Phalcon_Config_Adapter_Ini, __construct){
 	ulong hash_num;
 	int hash_type;
 
+	phalcon_config_ini_entry *cached, entry;
+	php_stream_statbuf ssb;
+	char real_path[MAXPATHLEN];
+	int cacheable = 0;
+	uint real_path_length = 0;
+	HashTable *cache;
+
 	PHALCON_MM_GROW();
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &file_path) == FAILURE) {
@@ -107,6 +245,29 @@ PHP_METHOD(Phalcon_Config_Adapter_Ini, __construct){
 		RETURN_NULL();
 	}
 
+	/** 
+	 * Files are identified by their absolute path, modification time and size
+	 */
+	if (Z_TYPE_P(file_path) == IS_STRING && Z_STRLEN_P(file_path) > 0) {
+		if (expand_filepath(Z_STRVAL_P(file_path), real_path TSRMLS_CC)) {
+			if (php_stream_stat_path(real_path, &ssb) == 0) {
+				cacheable = 1;
+				real_path_length = strlen(real_path) + 1;
+
+				cache = PHALCON_GLOBAL(config_cache);
+				if (cache && zend_hash_find(cache, real_path, real_path_length, (void **) &cached) == SUCCESS) {
+					if (cached->mtime == ssb.sb.st_mtime && cached->size == ssb.sb.st_size) {
+						config = phalcon_config_ini_restore(cached->config);
+						phalcon_memory_observe(&config TSRMLS_CC);
+						PHALCON_CALL_PARENT_PARAMS_1_NORETURN(this_ptr, "Phalcon\\Config\\Adapter\\Ini", "__construct", config);
+						PHALCON_MM_RESTORE();
+						return;
+					}
+				}
+			}
+		}
+	}
+
 	PHALCON_INIT_VAR(config);
 	array_init(config);
 	
@@ -186,6 +347,22 @@ PHP_METHOD(Phalcon_Config_Adapter_Ini, __construct){
 	
 	ph_cycle_end_0:
 	
+	if (cacheable) {
+		cache = PHALCON_GLOBAL(config_cache);
+		if (!cache) {
+			cache = pemalloc(sizeof(HashTable), 1);
+			zend_hash_init(cache, 8, NULL, phalcon_config_ini_entry_dtor, 1);
+			PHALCON_GLOBAL(config_cache) = cache;
+		} else if (zend_hash_num_elements(cache) >= PHALCON_CONFIG_CACHE_SIZE) {
+			zend_hash_clean(cache);
+		}
+
+		entry.mtime = ssb.sb.st_mtime;
+		entry.size = ssb.sb.st_size;
+		entry.config = phalcon_config_ini_persist(config);
+		zend_hash_update(cache, real_path, real_path_length, &entry, sizeof(phalcon_config_ini_entry), NULL);
+	}
+	
 	PHALCON_CALL_PARENT_PARAMS_1_NORETURN(this_ptr, "Phalcon\\Config\\Adapter\\Ini", "__construct", config);
 	
 	PHALCON_MM_RESTORE();
@@ -41,6 +41,7 @@
 #include "kernel/string.h"
 #include "kernel/operators.h"
 #include "kernel/file.h"
+#include "kernel/persistent.h"
 
 /**
  * Phalcon\Db\Adapter\Pdo
@@ -68,10 +69,83 @@ PHALCON_INIT_CLASS(Phalcon_Db_Adapter_Pdo){
 
 	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_pdo"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_affectedRows"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_poolKey"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_poolSlot"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
 
+/**
+ * Gives back the pool slot leased by the adapter. The handle is returned without an open
+ * transaction, while statements still use it the slot stays leased until the end of the request
+ */
+static void phalcon_db_adapter_pdo_release_slot(zval *this_ptr TSRMLS_DC){
+
+	zval *pool_key, *pool_slot, *pdo, *in_transaction;
+	phalcon_persistent_pool *pool = NULL;
+	long slot;
+
+	pool_slot = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_poolSlot"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(pool_slot) != IS_LONG) {
+		return;
+	}
+
+	slot = Z_LVAL_P(pool_slot);
+
+	pool_key = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_poolKey"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(pool_key) == IS_STRING) {
+		pool = phalcon_persistent_pool_find(Z_STRVAL_P(pool_key), Z_STRLEN_P(pool_key) TSRMLS_CC);
+	}
+
+	PHALCON_MM_GROW();
+
+	pdo = zend_read_property(phalcon_db_adapter_pdo_ce, this_ptr, SL("_pdo"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(pdo) == IS_OBJECT) {
+		PHALCON_INIT_VAR(in_transaction);
+		PHALCON_CALL_METHOD(in_transaction, pdo, "intransaction", PH_NO_CHECK);
+		if (zend_is_true(in_transaction)) {
+			if (pool) {
+				pool->rollbacks++;
+			}
+			PHALCON_CALL_METHOD_NORETURN(pdo, "rollback", PH_NO_CHECK);
+		}
+
+		/** 
+		 * PDOStatements hold a reference to the PDO object they were prepared on
+		 */
+		if (EG(objects_store).object_buckets[Z_OBJ_HANDLE_P(pdo)].bucket.obj.refcount > 1) {
+			pool = NULL;
+		}
+	}
+
+	if (pool) {
+		phalcon_persistent_release(pool, slot);
+	}
+
+	zend_update_property_null(phalcon_db_adapter_pdo_ce, this_ptr, SL("_poolSlot") TSRMLS_CC);
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Removes the PDO persistent handler of a pool slot, PDO closes it when nobody else uses it.
+ * The key is built the same way PDO builds the keys of the persistent ids
+ */
+static void phalcon_db_adapter_pdo_forget_handler(zval *dsn, zval *username, zval *password, zval *persistent_id TSRMLS_DC){
+
+	char *hash_key;
+	int hash_key_length;
+
+	hash_key_length = spprintf(&hash_key, 0, "PDO:DBH:DSN=%s:%s:%s:%s",
+		Z_STRVAL_P(dsn),
+		Z_TYPE_P(username) == IS_STRING ? Z_STRVAL_P(username) : "",
+		Z_TYPE_P(password) == IS_STRING ? Z_STRVAL_P(password) : "",
+		Z_STRVAL_P(persistent_id));
+
+	zend_hash_del(&EG(persistent_list), hash_key, hash_key_length + 1);
+	efree(hash_key);
+}
+
 /**
  * Constructor for Phalcon\Db\Adapter\Pdo
  *
@@ -102,6 +176,22 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, __construct){
  * This method is automatically called in Phalcon\Db\Adapter\Pdo constructor.
  * Call it when you need to restore a database connection
  *
+ * Descriptors with a 'pool' entry take their connection from a per-worker pool of persistent
+ * connections. Warm connections are reused after the driver checks that they are alive,
+ * connections idle for more than 'idleTimeout' seconds are replaced, transactions left open are
+ * rolled back and the optional 'reset' statement is executed before a connection is reused.
+ * A request can't lease more than 'size' connections of the same descriptor
+ *
+ *<code>
+ * $connection = new Phalcon\Db\Adapter\Pdo\Mysql(array(
+ *  'host' => 'localhost',
+ *  'username' => 'sigma',
+ *  'password' => 'secret',
+ *  'dbname' => 'blog',
+ *  'pool' => array('size' => 4, 'idleTimeout' => 300, 'reset' => 'SET NAMES utf8')
+ * ));
+ *</code>
+ *
  * @param 	array $descriptor
  * @return 	boolean
  */
@@ -110,6 +200,11 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 	zval *descriptor = NULL, *username, *password, *dsn_parts;
 	zval *value = NULL, *key = NULL, *dsn_attribute = NULL, *dot_comma, *dsn_attributes;
 	zval *pdo_type, *dsn, *options, *persistent, *pdo;
+	zval *pool_options = NULL, *pool_option = NULL, *reset_sql = NULL;
+	zval *pool_key = NULL, *persistent_id = NULL, *in_transaction;
+	phalcon_persistent_pool *pool = NULL;
+	long pool_size = PHALCON_PERSISTENT_POOL_SIZE, idle_timeout = PHALCON_PERSISTENT_IDLE_TIMEOUT;
+	int use_pool = 0, pool_slot = -1, pool_state = PHALCON_PERSISTENT_NEW;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -159,6 +254,39 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 		ZVAL_NULL(password);
 	}
 
+	/** 
+	 * The pool options are not part of the dsn
+	 */
+	eval_int = phalcon_array_isset_string(descriptor, SS("pool"));
+	if (eval_int) {
+		PHALCON_INIT_VAR(pool_options);
+		phalcon_array_fetch_string(&pool_options, descriptor, SL("pool"), PH_NOISY_CC);
+		PHALCON_SEPARATE_PARAM(descriptor);
+		phalcon_array_unset_string(descriptor, SS("pool"));
+		if (zend_is_true(pool_options)) {
+			use_pool = 1;
+			if (Z_TYPE_P(pool_options) == IS_ARRAY) { 
+				eval_int = phalcon_array_isset_string(pool_options, SS("size"));
+				if (eval_int) {
+					PHALCON_INIT_NVAR(pool_option);
+					phalcon_array_fetch_string(&pool_option, pool_options, SL("size"), PH_NOISY_CC);
+					pool_size = phalcon_get_intval(pool_option);
+				}
+				eval_int = phalcon_array_isset_string(pool_options, SS("idleTimeout"));
+				if (eval_int) {
+					PHALCON_INIT_NVAR(pool_option);
+					phalcon_array_fetch_string(&pool_option, pool_options, SL("idleTimeout"), PH_NOISY_CC);
+					idle_timeout = phalcon_get_intval(pool_option);
+				}
+				eval_int = phalcon_array_isset_string(pool_options, SS("reset"));
+				if (eval_int) {
+					PHALCON_INIT_VAR(reset_sql);
+					phalcon_array_fetch_string(&reset_sql, pool_options, SL("reset"), PH_NOISY_CC);
+				}
+			}
+		}
+	}
+
 	eval_int = phalcon_array_isset_string(descriptor, SS("dsn"));
 	if (!eval_int) {
 		PHALCON_INIT_VAR(dsn_parts);
@@ -221,13 +349,77 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect){
 		}
 	}
 
+	if (use_pool) {
+		if (pool_size < 1) {
+			pool_size = 1;
+		}
+
+		/** 
+		 * Reconnections give back the slot they were using
+		 */
+		phalcon_db_adapter_pdo_release_slot(this_ptr TSRMLS_CC);
+
+		PHALCON_INIT_VAR(pool_key);
+		PHALCON_CONCAT_VSV(pool_key, dsn, ":", username);
+
+		pool = phalcon_persistent_pool_get(Z_STRVAL_P(pool_key), Z_STRLEN_P(pool_key), pool_size TSRMLS_CC);
+		if (!pool) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The connection pool couldn't be created");
+			return;
+		}
+
+		pool_slot = phalcon_persistent_acquire(pool, idle_timeout, &pool_state);
+		if (pool_slot < 0) {
+			zend_throw_exception_ex(phalcon_db_exception_ce, 0 TSRMLS_CC, "The connection pool is exhausted, the request is already using its %u connections", pool->size);
+			PHALCON_MM_RESTORE();
+			return;
+		}
+
+		/** 
+		 * Every slot is a different PDO persistent id
+		 */
+		PHALCON_INIT_VAR(persistent_id);
+		Z_STRLEN_P(persistent_id) = spprintf(&Z_STRVAL_P(persistent_id), 0, "phalcon-pool-%d", pool_slot);
+		Z_TYPE_P(persistent_id) = IS_STRING;
+		phalcon_array_update_long(&options, PDO_ATTR_PERSISTENT, &persistent_id, PH_COPY | PH_SEPARATE TSRMLS_CC);
+
+		if (pool_state == PHALCON_PERSISTENT_EXPIRED) {
+			phalcon_db_adapter_pdo_forget_handler(dsn, username, password, persistent_id TSRMLS_CC);
+		}
+	}
+
 	ce0 = zend_fetch_class(SL("PDO"), ZEND_FETCH_CLASS_AUTO TSRMLS_CC);
 
 	PHALCON_INIT_VAR(pdo);
 	object_init_ex(pdo, ce0);
-	PHALCON_CALL_METHOD_PARAMS_4_NORETURN(pdo, "__construct", dsn, username, password, options, PH_CHECK);
+	if (phalcon_call_method_four_params(NULL, pdo, SL("__construct"), dsn, username, password, options, PH_CHECK, 0 TSRMLS_CC) == FAILURE) {
+		if (pool) {
+			phalcon_persistent_release(pool, pool_slot);
+		}
+		return;
+	}
 	phalcon_update_property_zval(this_ptr, SL("_pdo"), pdo TSRMLS_CC);
 
+	if (pool) {
+		phalcon_update_property_zval(this_ptr, SL("_poolKey"), pool_key TSRMLS_CC);
+		phalcon_update_property_long(this_ptr, SL("_poolSlot"), pool_slot TSRMLS_CC);
+
+		/** 
+		 * Reused connections don't carry the state of the previous request
+		 */
+		if (pool_state == PHALCON_PERSISTENT_REUSED) {
+			PHALCON_INIT_VAR(in_transaction);
+			PHALCON_CALL_METHOD(in_transaction, pdo, "intransaction", PH_NO_CHECK);
+			if (zend_is_true(in_transaction)) {
+				pool->rollbacks++;
+				PHALCON_CALL_METHOD_NORETURN(pdo, "rollback", PH_NO_CHECK);
+			}
+			if (reset_sql && zend_is_true(reset_sql)) {
+				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(pdo, "exec", reset_sql, PH_NO_CHECK);
+			}
+		}
+	}
+
 	PHALCON_MM_RESTORE();}
 
 /**
@@ -553,6 +745,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, close){
 	PHALCON_INIT_VAR(pdo);
 	phalcon_read_property(&pdo, this_ptr, SL("_pdo"), PH_NOISY_CC);
 	if (Z_TYPE_P(pdo) == IS_OBJECT) {
+		phalcon_db_adapter_pdo_release_slot(this_ptr TSRMLS_CC);
 		phalcon_update_property_null(this_ptr, SL("_pdo") TSRMLS_CC);
 		PHALCON_MM_RESTORE();
 		RETURN_TRUE;
@@ -969,18 +1162,44 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, getInternalHandler){
 }
 
 /**
- * Lists table indexes
- *
- * @param string $table
- * @param string $schema
- * @return Phalcon\Db\Index[]
+ * Groups the rows of a schema-wide description by the table they belong to
  */
-PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeIndexes){
+static void phalcon_db_adapter_pdo_group_by_table(zval *tables, zval *describe, char *column, unsigned int column_length TSRMLS_DC){
 
-	zval *table, *schema = NULL, *dialect, *fetch_assoc, *sql;
-	zval *describe, *indexes, *index = NULL, *key_name = NULL, *empty_arr = NULL;
-	zval *column_name = NULL, *index_objects, *index_columns = NULL;
-	zval *name = NULL;
+	zval *row = NULL, *table = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	if (!phalcon_valid_foreach(describe TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(describe);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(row);
+	
+		PHALCON_INIT_NVAR(table);
+		phalcon_array_fetch_string(&table, row, column, column_length, PH_NOISY_CC);
+		phalcon_array_update_append_multi_2(&tables, table, row, 0 TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Builds the Phalcon\Db\Index objects of a table from the rows describing its indexes
+ */
+static void phalcon_db_adapter_pdo_build_indexes(zval *index_objects, zval *describe TSRMLS_DC){
+
+	zval *indexes, *index = NULL, *key_name = NULL, *empty_arr = NULL;
+	zval *column_name = NULL, *index_columns = NULL, *name = NULL;
 	HashTable *ah0, *ah1;
 	HashPosition hp0, hp1;
 	zval **hd;
@@ -992,30 +1211,6 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeIndexes){
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &table, &schema) == FAILURE) {
-		PHALCON_MM_RESTORE();
-		RETURN_NULL();
-	}
-
-	if (!schema) {
-		PHALCON_INIT_NVAR(schema);
-	}
-	
-	PHALCON_INIT_VAR(dialect);
-	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
-	
-	PHALCON_INIT_VAR(fetch_assoc);
-	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
-	
-	/** 
-	 * Get the SQL required to describe indexes from the Dialect
-	 */
-	PHALCON_INIT_VAR(sql);
-	PHALCON_CALL_METHOD_PARAMS_2(sql, dialect, "describeindexes", table, schema, PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(describe);
-	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
-	
 	PHALCON_INIT_VAR(indexes);
 	array_init(indexes);
 	
@@ -1052,9 +1247,6 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeIndexes){
 	
 	ph_cycle_end_0:
 	
-	PHALCON_INIT_VAR(index_objects);
-	array_init(index_objects);
-	
 	if (!phalcon_valid_foreach(indexes TSRMLS_CC)) {
 		return;
 	}
@@ -1080,34 +1272,21 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeIndexes){
 		goto ph_cycle_start_1;
 	
 	ph_cycle_end_1:
-	
-	
-	RETURN_CTOR(index_objects);
+
+	PHALCON_MM_RESTORE();
 }
 
 /**
- * Lists table references
+ * Lists table indexes
  *
  * @param string $table
  * @param string $schema
- * @return Phalcon\Db\Reference[]
+ * @return Phalcon\Db\Index[]
  */
-PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeReferences){
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeIndexes){
 
-	zval *table, *schema = NULL, *dialect, *sql, *empty_arr, *references;
-	zval *fetch_assoc, *describe, *reference = NULL, *constraint_name = NULL;
-	zval *referenced_schema = NULL, *referenced_table = NULL;
-	zval *reference_array = NULL, *column_name = NULL, *referenced_columns = NULL;
-	zval *reference_objects, *array_reference = NULL;
-	zval *name = NULL, *columns = NULL, *definition = NULL;
-	HashTable *ah0, *ah1;
-	HashPosition hp0, hp1;
-	zval **hd;
-	char *hash_index;
-	uint hash_index_len;
-	ulong hash_num;
-	int hash_type;
-	int eval_int;
+	zval *table, *schema = NULL, *dialect, *fetch_assoc, *sql;
+	zval *describe, *index_objects;
 
 	PHALCON_MM_GROW();
 
@@ -1123,21 +1302,51 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeReferences){
 	PHALCON_INIT_VAR(dialect);
 	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
 	
+	PHALCON_INIT_VAR(fetch_assoc);
+	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
+	
+	/** 
+	 * Get the SQL required to describe indexes from the Dialect
+	 */
 	PHALCON_INIT_VAR(sql);
-	PHALCON_CALL_METHOD_PARAMS_2(sql, dialect, "describereferences", table, schema, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_2(sql, dialect, "describeindexes", table, schema, PH_NO_CHECK);
 	
+	PHALCON_INIT_VAR(describe);
+	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(index_objects);
+	array_init(index_objects);
+	phalcon_db_adapter_pdo_build_indexes(index_objects, describe TSRMLS_CC);
+	
+	RETURN_CTOR(index_objects);
+}
+
+/**
+ * Builds the Phalcon\Db\Reference objects of a table from the rows describing its foreign keys
+ */
+static void phalcon_db_adapter_pdo_build_references(zval *reference_objects, zval *describe TSRMLS_DC){
+
+	zval *empty_arr, *references, *reference = NULL, *constraint_name = NULL;
+	zval *referenced_schema = NULL, *referenced_table = NULL;
+	zval *reference_array = NULL, *column_name = NULL, *referenced_columns = NULL;
+	zval *array_reference = NULL, *name = NULL, *columns = NULL, *definition = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
 	PHALCON_INIT_VAR(empty_arr);
 	array_init(empty_arr);
 	
 	PHALCON_INIT_VAR(references);
 	array_init(references);
 	
-	PHALCON_INIT_VAR(fetch_assoc);
-	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
-	
-	PHALCON_INIT_VAR(describe);
-	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
-	
 	if (!phalcon_valid_foreach(describe TSRMLS_CC)) {
 		return;
 	}
@@ -1185,9 +1394,6 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeReferences){
 	
 	ph_cycle_end_0:
 	
-	PHALCON_INIT_VAR(reference_objects);
-	array_init(reference_objects);
-	
 	if (!phalcon_valid_foreach(references TSRMLS_CC)) {
 		return;
 	}
@@ -1232,11 +1438,376 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeReferences){
 		goto ph_cycle_start_1;
 	
 	ph_cycle_end_1:
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Lists table references
+ *
+ * @param string $table
+ * @param string $schema
+ * @return Phalcon\Db\Reference[]
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeReferences){
+
+	zval *table, *schema = NULL, *dialect, *sql;
+	zval *fetch_assoc, *describe, *reference_objects;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &table, &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
 	
+	PHALCON_INIT_VAR(dialect);
+	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CALL_METHOD_PARAMS_2(sql, dialect, "describereferences", table, schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(fetch_assoc);
+	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(describe);
+	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(reference_objects);
+	array_init(reference_objects);
+	phalcon_db_adapter_pdo_build_references(reference_objects, describe TSRMLS_CC);
 	
 	RETURN_CTOR(reference_objects);
 }
 
+/**
+ * Returns the Phalcon\Db\Column objects of every table in a schema indexed by table. This
+ * implementation describes the tables one by one, adapters able to describe a whole schema
+ * in a single query override it
+ *
+ * @param string $schema
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchemaColumns){
+
+	zval *schema = NULL, *tables, *schema_columns, *table = NULL, *columns = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
+	
+	PHALCON_INIT_VAR(schema_columns);
+	array_init(schema_columns);
+	
+	PHALCON_INIT_VAR(tables);
+	PHALCON_CALL_METHOD_PARAMS_1(tables, this_ptr, "listtables", schema, PH_NO_CHECK);
+	
+	if (!phalcon_valid_foreach(tables TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(tables);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(table);
+	
+		PHALCON_INIT_NVAR(columns);
+		PHALCON_CALL_METHOD_PARAMS_2(columns, this_ptr, "describecolumns", table, schema, PH_NO_CHECK);
+		phalcon_array_update_zval(&schema_columns, table, &columns, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(schema_columns);
+}
+
+/**
+ * Returns the Phalcon\Db\Index objects of every table in a schema indexed by table. Dialects able to describe a whole
+ * schema answer with a single query, otherwise the tables are described one by one
+ *
+ * @param string $schema
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchemaIndexes){
+
+	zval *schema = NULL, *dialect, *sql, *fetch_assoc, *describe;
+	zval *tables = NULL, *schema_objects, *objects = NULL, *table = NULL, *rows = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
+	
+	PHALCON_INIT_VAR(schema_objects);
+	array_init(schema_objects);
+	
+	PHALCON_INIT_VAR(dialect);
+	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
+	if (phalcon_method_exists_ex(dialect, SS("describeschemaindexes") TSRMLS_CC) == FAILURE) {
+	
+		PHALCON_INIT_VAR(tables);
+		PHALCON_CALL_METHOD_PARAMS_1(tables, this_ptr, "listtables", schema, PH_NO_CHECK);
+	
+		if (!phalcon_valid_foreach(tables TSRMLS_CC)) {
+			return;
+		}
+	
+		ah0 = Z_ARRVAL_P(tables);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(table);
+	
+			PHALCON_INIT_NVAR(objects);
+			PHALCON_CALL_METHOD_PARAMS_2(objects, this_ptr, "describeindexes", table, schema, PH_NO_CHECK);
+			phalcon_array_update_zval(&schema_objects, table, &objects, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	
+		RETURN_CTOR(schema_objects);
+	}
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CALL_METHOD_PARAMS_1(sql, dialect, "describeschemaindexes", schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(fetch_assoc);
+	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(describe);
+	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
+	
+	PHALCON_INIT_NVAR(tables);
+	array_init(tables);
+	phalcon_db_adapter_pdo_group_by_table(tables, describe, SL("table_name") TSRMLS_CC);
+	
+	ah0 = Z_ARRVAL_P(tables);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(table, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(rows);
+	
+		PHALCON_INIT_NVAR(objects);
+		array_init(objects);
+		phalcon_db_adapter_pdo_build_indexes(objects, rows TSRMLS_CC);
+		phalcon_array_update_zval(&schema_objects, table, &objects, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(schema_objects);
+}
+
+/**
+ * Returns the Phalcon\Db\Reference objects of every table in a schema indexed by table. Dialects able to describe a whole
+ * schema answer with a single query, otherwise the tables are described one by one
+ *
+ * @param string $schema
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchemaReferences){
+
+	zval *schema = NULL, *dialect, *sql, *fetch_assoc, *describe;
+	zval *tables = NULL, *schema_objects, *objects = NULL, *table = NULL, *rows = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
+	
+	PHALCON_INIT_VAR(schema_objects);
+	array_init(schema_objects);
+	
+	PHALCON_INIT_VAR(dialect);
+	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
+	if (phalcon_method_exists_ex(dialect, SS("describeschemareferences") TSRMLS_CC) == FAILURE) {
+	
+		PHALCON_INIT_VAR(tables);
+		PHALCON_CALL_METHOD_PARAMS_1(tables, this_ptr, "listtables", schema, PH_NO_CHECK);
+	
+		if (!phalcon_valid_foreach(tables TSRMLS_CC)) {
+			return;
+		}
+	
+		ah0 = Z_ARRVAL_P(tables);
+		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+		while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+			PHALCON_GET_FOREACH_VALUE(table);
+	
+			PHALCON_INIT_NVAR(objects);
+			PHALCON_CALL_METHOD_PARAMS_2(objects, this_ptr, "describereferences", table, schema, PH_NO_CHECK);
+			phalcon_array_update_zval(&schema_objects, table, &objects, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+			zend_hash_move_forward_ex(ah0, &hp0);
+		}
+	
+		RETURN_CTOR(schema_objects);
+	}
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CALL_METHOD_PARAMS_1(sql, dialect, "describeschemareferences", schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(fetch_assoc);
+	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(describe);
+	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
+	
+	PHALCON_INIT_NVAR(tables);
+	array_init(tables);
+	phalcon_db_adapter_pdo_group_by_table(tables, describe, SL("table_name") TSRMLS_CC);
+	
+	ah0 = Z_ARRVAL_P(tables);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(table, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(rows);
+	
+		PHALCON_INIT_NVAR(objects);
+		array_init(objects);
+		phalcon_db_adapter_pdo_build_references(objects, rows TSRMLS_CC);
+		phalcon_array_update_zval(&schema_objects, table, &objects, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(schema_objects);
+}
+
+/**
+ * Describes every table in a schema at once. Cold starts can load the columns, indexes and
+ * foreign keys of the whole schema with one query per kind instead of one per table
+ *
+ *<code>
+ * $description = $connection->describeSchema("blog");
+ * print_r($description["robots"]["columns"]);
+ *</code>
+ *
+ * @param string $schema
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchema){
+
+	zval *schema = NULL, *schema_columns, *schema_indexes, *schema_references;
+	zval *description, *empty_arr, *table = NULL, *columns = NULL;
+	zval *indexes = NULL, *references = NULL, *table_description = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
+	
+	PHALCON_INIT_VAR(schema_columns);
+	PHALCON_CALL_METHOD_PARAMS_1(schema_columns, this_ptr, "describeschemacolumns", schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(schema_indexes);
+	PHALCON_CALL_METHOD_PARAMS_1(schema_indexes, this_ptr, "describeschemaindexes", schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(schema_references);
+	PHALCON_CALL_METHOD_PARAMS_1(schema_references, this_ptr, "describeschemareferences", schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(empty_arr);
+	array_init(empty_arr);
+	
+	PHALCON_INIT_VAR(description);
+	array_init(description);
+	
+	if (!phalcon_valid_foreach(schema_columns TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(schema_columns);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(table, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(columns);
+	
+		PHALCON_INIT_NVAR(table_description);
+		array_init(table_description);
+		phalcon_array_update_string(&table_description, SL("columns"), &columns, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		if (phalcon_array_isset(schema_indexes, table)) {
+			PHALCON_INIT_NVAR(indexes);
+			phalcon_array_fetch(&indexes, schema_indexes, table, PH_NOISY_CC);
+			phalcon_array_update_string(&table_description, SL("indexes"), &indexes, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		} else {
+			phalcon_array_update_string(&table_description, SL("indexes"), &empty_arr, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		if (phalcon_array_isset(schema_references, table)) {
+			PHALCON_INIT_NVAR(references);
+			phalcon_array_fetch(&references, schema_references, table, PH_NOISY_CC);
+			phalcon_array_update_string(&table_description, SL("references"), &references, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		} else {
+			phalcon_array_update_string(&table_description, SL("references"), &empty_arr, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		phalcon_array_update_zval(&description, table, &table_description, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(description);
+}
+
 /**
  * Gets creation options from a table
  *
@@ -1316,3 +1887,16 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, supportSequences){
 	RETURN_FALSE;
 }
 
+/**
+ * Returns the statistics of the connection pools of the worker indexed by descriptor. Each
+ * pool reports its size, the connections opened, the ones leased by the current request, the
+ * reused connections (hits), the new ones (misses), the idle ones replaced (expired), the
+ * transactions rolled back on reuse and the connections refused because the pool was full
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, getPoolStats){
+
+
+	phalcon_persistent_stats(return_value TSRMLS_CC);
+}
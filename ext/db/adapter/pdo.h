@@ -40,9 +40,14 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, isUnderTransaction);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, getInternalHandler);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeIndexes);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeReferences);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchemaColumns);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchemaIndexes);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchemaReferences);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, describeSchema);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, tableOptions);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, getDefaultIdValue);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, supportSequences);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, getPoolStats);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, descriptor)
@@ -102,6 +107,22 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_describereferences, 0, 0,
 	ZEND_ARG_INFO(0, schema)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_describeschemacolumns, 0, 0, 0)
+	ZEND_ARG_INFO(0, schema)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_describeschemaindexes, 0, 0, 0)
+	ZEND_ARG_INFO(0, schema)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_describeschemareferences, 0, 0, 0)
+	ZEND_ARG_INFO(0, schema)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_describeschema, 0, 0, 0)
+	ZEND_ARG_INFO(0, schema)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_tableoptions, 0, 0, 1)
 	ZEND_ARG_INFO(0, tableName)
 	ZEND_ARG_INFO(0, schemaName)
@@ -127,9 +148,14 @@ PHALCON_INIT_FUNCS(phalcon_db_adapter_pdo_method_entry){
 	PHP_ME(Phalcon_Db_Adapter_Pdo, getInternalHandler, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Adapter_Pdo, describeIndexes, arginfo_phalcon_db_adapter_pdo_describeindexes, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Adapter_Pdo, describeReferences, arginfo_phalcon_db_adapter_pdo_describereferences, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Adapter_Pdo, describeSchemaColumns, arginfo_phalcon_db_adapter_pdo_describeschemacolumns, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Adapter_Pdo, describeSchemaIndexes, arginfo_phalcon_db_adapter_pdo_describeschemaindexes, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Adapter_Pdo, describeSchemaReferences, arginfo_phalcon_db_adapter_pdo_describeschemareferences, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Adapter_Pdo, describeSchema, arginfo_phalcon_db_adapter_pdo_describeschema, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Adapter_Pdo, tableOptions, arginfo_phalcon_db_adapter_pdo_tableoptions, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Adapter_Pdo, getDefaultIdValue, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Adapter_Pdo, supportSequences, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Adapter_Pdo, getPoolStats, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
 	PHP_FE_END
 };
 
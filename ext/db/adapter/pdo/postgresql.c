@@ -125,51 +125,19 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, connect){
 }
 
 /**
- * Returns an array of Phalcon\Db\Column objects describing a table
- *
- * <code>print_r($connection->describeColumns("posts")); ?></code>
- *
- * @param string $table
- * @param string $schema
- * @return Phalcon\Db\Column[]
+ * Builds the Phalcon\Db\Column objects of a table from the rows of its description
  */
-PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, describeColumns){
+static void phalcon_db_adapter_pdo_postgresql_build_columns(zval *columns, zval *describe TSRMLS_DC){
 
-	zval *table, *schema = NULL, *columns, *sql, *fetch_assoc;
-	zval *describe, *old_column = NULL, *field = NULL, *definition = NULL;
+	zval *old_column = NULL, *field = NULL, *definition = NULL;
 	zval *char_size = NULL, *numeric_size = NULL, *column_type = NULL;
 	zval *attribute = NULL, *column_name = NULL, *column = NULL;
-	zval *t0 = NULL;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &table, &schema) == FAILURE) {
-		PHALCON_MM_RESTORE();
-		RETURN_NULL();
-	}
-
-	if (!schema) {
-		PHALCON_INIT_NVAR(schema);
-	}
-	
-	PHALCON_INIT_VAR(columns);
-	array_init(columns);
-	
-	PHALCON_INIT_VAR(t0);
-	phalcon_read_property(&t0, this_ptr, SL("_dialect"), PH_NOISY_CC);
-	
-	PHALCON_INIT_VAR(sql);
-	PHALCON_CALL_METHOD_PARAMS_2(sql, t0, "describecolumns", table, schema, PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(fetch_assoc);
-	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
-	
-	PHALCON_INIT_VAR(describe);
-	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
-	
 	PHALCON_INIT_VAR(old_column);
 	
 	if (!phalcon_valid_foreach(describe TSRMLS_CC)) {
@@ -294,11 +262,147 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, describeColumns){
 		goto ph_cycle_start_0;
 	
 	ph_cycle_end_0:
+
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns an array of Phalcon\Db\Column objects describing a table
+ *
+ * <code>print_r($connection->describeColumns("posts")); ?></code>
+ *
+ * @param string $table
+ * @param string $schema
+ * @return Phalcon\Db\Column[]
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, describeColumns){
+
+	zval *table, *schema = NULL, *columns, *sql, *fetch_assoc;
+	zval *describe;
+	zval *t0 = NULL;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &table, &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
+	
+	PHALCON_INIT_VAR(columns);
+	array_init(columns);
+	
+	PHALCON_INIT_VAR(t0);
+	phalcon_read_property(&t0, this_ptr, SL("_dialect"), PH_NOISY_CC);
 	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CALL_METHOD_PARAMS_2(sql, t0, "describecolumns", table, schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(fetch_assoc);
+	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(describe);
+	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
+	
+	phalcon_db_adapter_pdo_postgresql_build_columns(columns, describe TSRMLS_CC);
 	
 	RETURN_CTOR(columns);
 }
 
+/**
+ * Returns the Phalcon\Db\Column objects of every table in a schema indexed by table, the
+ * columns of all the tables are read with a single query to the information schema
+ *
+ * <code>
+ * print_r($connection->describeSchemaColumns("blog")); ?>
+ * </code>
+ *
+ * @param string $schema
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, describeSchemaColumns){
+
+	zval *schema = NULL, *dialect, *sql, *fetch_assoc, *describe;
+	zval *tables, *schema_columns, *columns = NULL, *field = NULL, *table = NULL;
+	zval *rows = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	char *hash_index;
+	uint hash_index_len;
+	ulong hash_num;
+	int hash_type;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &schema) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!schema) {
+		PHALCON_INIT_NVAR(schema);
+	}
+	
+	PHALCON_INIT_VAR(dialect);
+	phalcon_read_property(&dialect, this_ptr, SL("_dialect"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(sql);
+	PHALCON_CALL_METHOD_PARAMS_1(sql, dialect, "describeschemacolumns", schema, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(fetch_assoc);
+	phalcon_get_class_constant(fetch_assoc, phalcon_db_ce, SS("FETCH_ASSOC") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(describe);
+	PHALCON_CALL_METHOD_PARAMS_2(describe, this_ptr, "fetchall", sql, fetch_assoc, PH_NO_CHECK);
+	
+	/** 
+	 * The rows come ordered by table and position, they are grouped by table
+	 */
+	PHALCON_INIT_VAR(tables);
+	array_init(tables);
+	
+	if (!phalcon_valid_foreach(describe TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(describe);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(field);
+	
+		PHALCON_INIT_NVAR(table);
+		phalcon_array_fetch_string(&table, field, SL("table"), PH_NOISY_CC);
+		phalcon_array_update_append_multi_2(&tables, table, field, 0 TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	PHALCON_INIT_VAR(schema_columns);
+	array_init(schema_columns);
+	
+	ah0 = Z_ARRVAL_P(tables);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_KEY(table, ah0, hp0);
+		PHALCON_GET_FOREACH_VALUE(rows);
+	
+		PHALCON_INIT_NVAR(columns);
+		array_init(columns);
+		phalcon_db_adapter_pdo_postgresql_build_columns(columns, rows TSRMLS_CC);
+		phalcon_array_update_zval(&schema_columns, table, &columns, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	RETURN_CTOR(schema_columns);
+}
+
 /**
  * Return the default identity value to insert in an identity column
  *
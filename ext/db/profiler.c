@@ -37,6 +37,17 @@
 #include "kernel/operators.h"
 #include "kernel/array.h"
 
+#include "ext/standard/php_smart_str.h"
+
+#include <time.h>
+#include <ctype.h>
+
+#ifdef PHP_WIN32
+#include "win32/php_stdint.h"
+#else
+#include <stdint.h>
+#endif
+
 /**
  * Phalcon\Db\Profiler
  *
@@ -69,7 +80,433 @@
  *
  *</code>
  *
+ * The aggregated mode doesn't keep the profiles. Statements are reduced to their shape (literals
+ * are replaced by placeholders) and every shape gets a latency histogram, the memory used doesn't
+ * depend on the number of statements executed
+ *
+ *<code>
+ *
+ *	$profiler = new Phalcon\Db\Profiler();
+ *	$profiler->setAggregated(true);
+ *
+ *	//Append the histograms to a file when the request ends
+ *	$profiler->setDumpFile('/var/log/app/sql-latency.log');
+ *
+ *	print_r($profiler->getHistograms());
+ *
+ *</code>
+ */
+
+/** Distinct statement shapes kept by a profiler, the following ones are counted together */
+#define PHALCON_PROFILER_MAX_SHAPES 256
+
+/** Shapes are truncated to this length */
+#define PHALCON_PROFILER_MAX_SHAPE_LENGTH 512
+
+/** Buckets per power of two of the histograms */
+#define PHALCON_PROFILER_SUB_BUCKETS 4
+
+/** Bucket 0 counts the statements under 1 microsecond, the last one those over 2^40 microseconds */
+#define PHALCON_PROFILER_BUCKETS (1 + 40 * PHALCON_PROFILER_SUB_BUCKETS)
+
+#define PHALCON_PROFILER_OTHER_SHAPE "(other)"
+
+typedef struct _phalcon_db_profiler_shape {
+	unsigned long count;
+	double sum;
+	double min;
+	double max;
+	unsigned int buckets[PHALCON_PROFILER_BUCKETS];
+} phalcon_db_profiler_shape;
+
+typedef struct _phalcon_db_profiler_object {
+	zend_object std;
+	int aggregated;
+	double start;
+	smart_str active_shape;
+	HashTable *shapes;
+	unsigned long total_count;
+	double total_sum;
+} phalcon_db_profiler_object;
+
+static zend_object_handlers phalcon_db_profiler_handlers;
+
+/**
+ * Returns a monotonic time in microseconds, the wall clock is used where there is no monotonic clock
+ */
+static double phalcon_db_profiler_now(void){
+
+	struct timeval tv;
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+	}
+#endif
+
+	gettimeofday(&tv, NULL);
+	return (double) tv.tv_sec * 1000000.0 + (double) tv.tv_usec;
+}
+
+/**
+ * Reduces a statement to its shape: quoted strings and numbers become '?', runs of whitespace
+ * become a single space and lists of placeholders like IN (1, 2, 3) become a single '?'
+ */
+static void phalcon_db_profiler_normalize(smart_str *shape, const char *sql, unsigned int length){
+
+	unsigned int i = 0;
+	char ch, quote, previous = '\0';
+
+	shape->len = 0;
+
+	while (i < length && shape->len < PHALCON_PROFILER_MAX_SHAPE_LENGTH) {
+
+		ch = sql[i];
+
+		if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+			while (i < length && (sql[i] == ' ' || sql[i] == '\t' || sql[i] == '\n' || sql[i] == '\r')) {
+				i++;
+			}
+			if (shape->len && i < length) {
+				smart_str_appendc(shape, ' ');
+			}
+			previous = ' ';
+			continue;
+		}
+
+		/**
+		 * String literals, backslashes and doubled quotes don't close them
+		 */
+		if (ch == '\'') {
+			quote = ch;
+			i++;
+			while (i < length) {
+				if (sql[i] == '\\' && i + 1 < length) {
+					i += 2;
+					continue;
+				}
+				if (sql[i] == quote) {
+					if (i + 1 < length && sql[i + 1] == quote) {
+						i += 2;
+						continue;
+					}
+					break;
+				}
+				i++;
+			}
+			i++;
+		} else {
+			/**
+			 * Numbers that are not part of an identifier or a numbered placeholder
+			 */
+			if (ch >= '0' && ch <= '9' && !(isalnum((unsigned char) previous) || previous == '_' || previous == '$' || previous == ':' || previous == '?')) {
+				while (i < length && (isalnum((unsigned char) sql[i]) || sql[i] == '.')) {
+					i++;
+				}
+			} else {
+				smart_str_appendc(shape, ch);
+				previous = ch;
+				i++;
+				continue;
+			}
+		}
+
+		/**
+		 * The literal is replaced, a list of literals keeps one placeholder
+		 */
+		if (shape->len >= 3 && shape->c[shape->len - 1] == ' ' && shape->c[shape->len - 2] == ',' && shape->c[shape->len - 3] == '?') {
+			shape->len -= 2;
+		} else {
+			if (shape->len >= 2 && shape->c[shape->len - 1] == ',' && shape->c[shape->len - 2] == '?') {
+				shape->len -= 1;
+			} else {
+				smart_str_appendc(shape, '?');
+			}
+		}
+		previous = '?';
+	}
+
+	smart_str_0(shape);
+}
+
+/**
+ * Returns the bucket of a latency in microseconds
+ */
+static unsigned int phalcon_db_profiler_bucket(double elapsed){
+
+	uint64_t value;
+	unsigned int msb = 0, index;
+
+	if (elapsed < 1.0) {
+		return 0;
+	}
+
+	if (elapsed >= 1099511627776.0) {
+		return PHALCON_PROFILER_BUCKETS - 1;
+	}
+
+	value = (uint64_t) elapsed;
+	while ((value >> msb) > 1) {
+		msb++;
+	}
+
+	index = 1 + msb * PHALCON_PROFILER_SUB_BUCKETS + (unsigned int) (((value << 2) >> msb) & 3);
+	if (index >= PHALCON_PROFILER_BUCKETS) {
+		index = PHALCON_PROFILER_BUCKETS - 1;
+	}
+
+	return index;
+}
+
+/**
+ * Estimates a percentile as the middle of the bucket where it falls, clamped to the extremes seen
+ */
+static double phalcon_db_profiler_percentile(phalcon_db_profiler_shape *shape, double percentile){
+
+	unsigned long rank, seen = 0;
+	unsigned int i, msb, sub;
+	double lower, upper, value;
+
+	rank = (unsigned long) (percentile * shape->count + 0.999999);
+	if (rank < 1) {
+		rank = 1;
+	}
+
+	for (i = 0; i < PHALCON_PROFILER_BUCKETS; i++) {
+		seen += shape->buckets[i];
+		if (seen >= rank) {
+			break;
+		}
+	}
+
+	if (i == 0) {
+		value = 0.5;
+	} else {
+		msb = (i - 1) / PHALCON_PROFILER_SUB_BUCKETS;
+		sub = (i - 1) % PHALCON_PROFILER_SUB_BUCKETS;
+		lower = (1.0 + (double) sub / PHALCON_PROFILER_SUB_BUCKETS) * (double) ((uint64_t) 1 << msb);
+		upper = (1.0 + (double) (sub + 1) / PHALCON_PROFILER_SUB_BUCKETS) * (double) ((uint64_t) 1 << msb);
+		value = (lower + upper) / 2;
+	}
+
+	if (value < shape->min) {
+		value = shape->min;
+	}
+	if (value > shape->max) {
+		value = shape->max;
+	}
+
+	return value;
+}
+
+/**
+ * Adds a statement to the histogram of its shape
+ */
+static void phalcon_db_profiler_record(phalcon_db_profiler_object *intern, double elapsed){
+
+	phalcon_db_profiler_shape *shape, empty;
+	char *key;
+	unsigned int key_length;
+
+	if (!intern->shapes) {
+		ALLOC_HASHTABLE(intern->shapes);
+		zend_hash_init(intern->shapes, 32, NULL, NULL, 0);
+	}
+
+	if (intern->active_shape.len) {
+		key = intern->active_shape.c;
+		key_length = intern->active_shape.len;
+	} else {
+		key = "";
+		key_length = 0;
+	}
+
+	if (zend_hash_find(intern->shapes, key, key_length + 1, (void **) &shape) == FAILURE) {
+		if (zend_hash_num_elements(intern->shapes) >= PHALCON_PROFILER_MAX_SHAPES) {
+			key = PHALCON_PROFILER_OTHER_SHAPE;
+			key_length = sizeof(PHALCON_PROFILER_OTHER_SHAPE) - 1;
+		}
+		if (zend_hash_find(intern->shapes, key, key_length + 1, (void **) &shape) == FAILURE) {
+			memset(&empty, 0, sizeof(phalcon_db_profiler_shape));
+			empty.min = elapsed;
+			empty.max = elapsed;
+			zend_hash_add(intern->shapes, key, key_length + 1, &empty, sizeof(phalcon_db_profiler_shape), (void **) &shape);
+		}
+	}
+
+	shape->count++;
+	shape->sum += elapsed;
+	if (elapsed < shape->min) {
+		shape->min = elapsed;
+	}
+	if (elapsed > shape->max) {
+		shape->max = elapsed;
+	}
+	shape->buckets[phalcon_db_profiler_bucket(elapsed)]++;
+
+	intern->total_count++;
+	intern->total_sum += elapsed;
+}
+
+static void phalcon_db_profiler_clear(phalcon_db_profiler_object *intern){
+
+	if (intern->shapes) {
+		zend_hash_destroy(intern->shapes);
+		FREE_HASHTABLE(intern->shapes);
+		intern->shapes = NULL;
+	}
+
+	intern->total_count = 0;
+	intern->total_sum = 0;
+	intern->active_shape.len = 0;
+}
+
+/**
+ * Appends a double to a JSON document, the locale must not change the decimal point
+ */
+static void phalcon_db_profiler_json_double(smart_str *buffer, double value){
+
+	char number[64];
+	int length;
+
+	length = snprintf(number, sizeof(number), "%.6F", value);
+	smart_str_appendl(buffer, number, length);
+}
+
+static void phalcon_db_profiler_json_string(smart_str *buffer, const char *str, unsigned int length){
+
+	unsigned int i;
+	unsigned char ch;
+	char escaped[8];
+
+	smart_str_appendc(buffer, '"');
+	for (i = 0; i < length; i++) {
+		ch = (unsigned char) str[i];
+		switch (ch) {
+			case '"':
+				smart_str_appendl(buffer, "\\\"", 2);
+				break;
+			case '\\':
+				smart_str_appendl(buffer, "\\\\", 2);
+				break;
+			default:
+				if (ch < 0x20) {
+					snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+					smart_str_appendl(buffer, escaped, 6);
+				} else {
+					smart_str_appendc(buffer, ch);
+				}
+				break;
+		}
+	}
+	smart_str_appendc(buffer, '"');
+}
+
+/**
+ * Writes the histograms as a single line JSON document
+ */
+static void phalcon_db_profiler_dump(smart_str *buffer, phalcon_db_profiler_object *intern TSRMLS_DC){
+
+	phalcon_db_profiler_shape *shape;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+	int first = 1;
+
+	smart_str_appends(buffer, "{\"statements\":");
+	smart_str_append_unsigned(buffer, intern->total_count);
+	smart_str_appends(buffer, ",\"seconds\":");
+	phalcon_db_profiler_json_double(buffer, intern->total_sum / 1000000.0);
+	smart_str_appends(buffer, ",\"shapes\":[");
+
+	if (intern->shapes) {
+		zend_hash_internal_pointer_reset_ex(intern->shapes, &pos);
+		while (zend_hash_get_current_data_ex(intern->shapes, (void **) &shape, &pos) == SUCCESS) {
+			zend_hash_get_current_key_ex(intern->shapes, &key, &key_length, &index, 0, &pos);
+
+			if (!first) {
+				smart_str_appendc(buffer, ',');
+			}
+			first = 0;
+
+			smart_str_appends(buffer, "{\"sql\":");
+			phalcon_db_profiler_json_string(buffer, key, key_length - 1);
+			smart_str_appends(buffer, ",\"count\":");
+			smart_str_append_unsigned(buffer, shape->count);
+			smart_str_appends(buffer, ",\"sum\":");
+			phalcon_db_profiler_json_double(buffer, shape->sum / 1000000.0);
+			smart_str_appends(buffer, ",\"min\":");
+			phalcon_db_profiler_json_double(buffer, shape->min / 1000000.0);
+			smart_str_appends(buffer, ",\"max\":");
+			phalcon_db_profiler_json_double(buffer, shape->max / 1000000.0);
+			smart_str_appends(buffer, ",\"p50\":");
+			phalcon_db_profiler_json_double(buffer, phalcon_db_profiler_percentile(shape, 0.50) / 1000000.0);
+			smart_str_appends(buffer, ",\"p95\":");
+			phalcon_db_profiler_json_double(buffer, phalcon_db_profiler_percentile(shape, 0.95) / 1000000.0);
+			smart_str_appends(buffer, ",\"p99\":");
+			phalcon_db_profiler_json_double(buffer, phalcon_db_profiler_percentile(shape, 0.99) / 1000000.0);
+			smart_str_appendc(buffer, '}');
+
+			zend_hash_move_forward_ex(intern->shapes, &pos);
+		}
+	}
+
+	smart_str_appends(buffer, "]}");
+	smart_str_0(buffer);
+}
+
+static void phalcon_db_profiler_object_free(void *object TSRMLS_DC){
+
+	phalcon_db_profiler_object *intern = (phalcon_db_profiler_object *) object;
+
+	phalcon_db_profiler_clear(intern);
+	smart_str_free(&intern->active_shape);
+
+	zend_object_std_dtor(&intern->std TSRMLS_CC);
+	efree(intern);
+}
+
+static zend_object_value phalcon_db_profiler_object_new(zend_class_entry *class_type TSRMLS_DC){
+
+	phalcon_db_profiler_object *intern;
+	zend_object_value retval;
+#if PHP_VERSION_ID < 50400
+	zval *tmp;
+#endif
+
+	intern = ecalloc(1, sizeof(phalcon_db_profiler_object));
+	zend_object_std_init(&intern->std, class_type TSRMLS_CC);
+#if PHP_VERSION_ID >= 50400
+	object_properties_init(&intern->std, class_type);
+#else
+	zend_hash_copy(intern->std.properties, &class_type->default_properties, (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+#endif
+
+	retval.handle = zend_objects_store_put(intern, (zend_objects_store_dtor_t) zend_objects_destroy_object, phalcon_db_profiler_object_free, NULL TSRMLS_CC);
+	retval.handlers = &phalcon_db_profiler_handlers;
+
+	return retval;
+}
+
+/**
+ * Clones copy the mode and the properties, the histograms start empty
  */
+static zend_object_value phalcon_db_profiler_object_clone(zval *object TSRMLS_DC){
+
+	zend_object_value retval;
+	phalcon_db_profiler_object *old_object, *new_object;
+
+	old_object = (phalcon_db_profiler_object *) zend_object_store_get_object(object TSRMLS_CC);
+	retval = phalcon_db_profiler_object_new(old_object->std.ce TSRMLS_CC);
+	new_object = (phalcon_db_profiler_object *) zend_object_store_get_object_by_handle(retval.handle TSRMLS_CC);
+	new_object->aggregated = old_object->aggregated;
+
+	zend_objects_clone_members(&new_object->std, retval, &old_object->std, Z_OBJ_HANDLE_P(object) TSRMLS_CC);
+
+	return retval;
+}
 
 
 /**
@@ -82,6 +519,12 @@ PHALCON_INIT_CLASS(Phalcon_Db_Profiler){
 	zend_declare_property_null(phalcon_db_profiler_ce, SL("_allProfiles"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_db_profiler_ce, SL("_activeProfile"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_long(phalcon_db_profiler_ce, SL("_totalSeconds"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_db_profiler_ce, SL("_dumpFile"), ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	phalcon_db_profiler_ce->create_object = phalcon_db_profiler_object_new;
+
+	memcpy(&phalcon_db_profiler_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	phalcon_db_profiler_handlers.clone_obj = phalcon_db_profiler_object_clone;
 
 	return SUCCESS;
 }
@@ -106,6 +549,7 @@ PHP_METHOD(Phalcon_Db_Profiler, startProfile){
 
 	zval *sql_statement, *active_profile, *micro;
 	zval *time;
+	phalcon_db_profiler_object *intern;
 
 	PHALCON_MM_GROW();
 
@@ -114,6 +558,21 @@ PHP_METHOD(Phalcon_Db_Profiler, startProfile){
 		RETURN_NULL();
 	}
 
+	/** 
+	 * Aggregated profiles only keep the shape of the statement and the starting time
+	 */
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (intern->aggregated) {
+		if (Z_TYPE_P(sql_statement) == IS_STRING) {
+			phalcon_db_profiler_normalize(&intern->active_shape, Z_STRVAL_P(sql_statement), Z_STRLEN_P(sql_statement));
+		} else {
+			intern->active_shape.len = 0;
+		}
+		intern->start = phalcon_db_profiler_now();
+		RETURN_CTOR(this_ptr);
+	}
+	
+
 	PHALCON_INIT_VAR(active_profile);
 	object_init_ex(active_profile, phalcon_db_profiler_item_ce);
 	PHALCON_CALL_METHOD_PARAMS_1_NORETURN(active_profile, "setsqlstatement", sql_statement, PH_NO_CHECK);
@@ -143,9 +602,16 @@ PHP_METHOD(Phalcon_Db_Profiler, stopProfile){
 	zval *micro, *final_time, *active_profile, *initial_time;
 	zval *diference, *total_seconds, *new_total_seconds;
 	zval *t0 = NULL;
+	phalcon_db_profiler_object *intern;
 
 	PHALCON_MM_GROW();
 
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (intern->aggregated) {
+		phalcon_db_profiler_record(intern, phalcon_db_profiler_now() - intern->start);
+		RETURN_CTOR(this_ptr);
+	}
+
 	PHALCON_INIT_VAR(micro);
 	ZVAL_BOOL(micro, 1);
 	
@@ -189,6 +655,12 @@ PHP_METHOD(Phalcon_Db_Profiler, stopProfile){
 PHP_METHOD(Phalcon_Db_Profiler, getNumberTotalStatements){
 
 	zval *all_profiles, *number_profiles;
+	phalcon_db_profiler_object *intern;
+
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (intern->aggregated) {
+		RETURN_LONG(intern->total_count);
+	}
 
 	PHALCON_MM_GROW();
 
@@ -208,6 +680,12 @@ PHP_METHOD(Phalcon_Db_Profiler, getNumberTotalStatements){
  */
 PHP_METHOD(Phalcon_Db_Profiler, getTotalElapsedSeconds){
 
+	phalcon_db_profiler_object *intern;
+
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (intern->aggregated) {
+		RETURN_DOUBLE(intern->total_sum / 1000000.0);
+	}
 
 	RETURN_MEMBER(this_ptr, "_totalSeconds");
 }
@@ -231,9 +709,13 @@ PHP_METHOD(Phalcon_Db_Profiler, getProfiles){
 PHP_METHOD(Phalcon_Db_Profiler, reset){
 
 	zval *empty_arr;
+	phalcon_db_profiler_object *intern;
 
 	PHALCON_MM_GROW();
 
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	phalcon_db_profiler_clear(intern);
+
 	PHALCON_INIT_VAR(empty_arr);
 	array_init(empty_arr);
 	phalcon_update_property_zval(this_ptr, SL("_allProfiles"), empty_arr TSRMLS_CC);
@@ -252,3 +734,163 @@ PHP_METHOD(Phalcon_Db_Profiler, getLastProfile){
 	RETURN_MEMBER(this_ptr, "_activeProfile");
 }
 
+/**
+ * Enables or disables the aggregated mode. Aggregated profilers don't create Phalcon\Db\Profiler\Item
+ * objects nor call beforeStartProfile/afterEndProfile, the statements are added to the latency
+ * histogram of their shape
+ *
+ * @param boolean $aggregated
+ * @return Phalcon\Db\Profiler
+ */
+PHP_METHOD(Phalcon_Db_Profiler, setAggregated){
+
+	zval *aggregated;
+	phalcon_db_profiler_object *intern;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &aggregated) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	intern->aggregated = zend_is_true(aggregated);
+
+	RETURN_CTORW(this_ptr);
+}
+
+/**
+ * Checks whether the profiler is in aggregated mode
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Profiler, isAggregated){
+
+	phalcon_db_profiler_object *intern;
+
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	RETURN_BOOL(intern->aggregated);
+}
+
+/**
+ * Returns the histograms of the aggregated mode indexed by statement shape. Every shape reports
+ * the number of statements and the total, minimum, maximum, p50, p95 and p99 latencies in seconds.
+ * Percentiles are estimated from the histogram, their error is below 13%
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Db_Profiler, getHistograms){
+
+	phalcon_db_profiler_object *intern;
+	phalcon_db_profiler_shape *shape;
+	HashPosition pos;
+	zval *histogram;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+
+	array_init(return_value);
+	if (!intern->shapes) {
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(intern->shapes, &pos);
+	while (zend_hash_get_current_data_ex(intern->shapes, (void **) &shape, &pos) == SUCCESS) {
+		zend_hash_get_current_key_ex(intern->shapes, &key, &key_length, &index, 0, &pos);
+
+		MAKE_STD_ZVAL(histogram);
+		array_init_size(histogram, 8);
+		add_assoc_long_ex(histogram, SS("count"), shape->count);
+		add_assoc_double_ex(histogram, SS("sum"), shape->sum / 1000000.0);
+		add_assoc_double_ex(histogram, SS("min"), shape->min / 1000000.0);
+		add_assoc_double_ex(histogram, SS("max"), shape->max / 1000000.0);
+		add_assoc_double_ex(histogram, SS("p50"), phalcon_db_profiler_percentile(shape, 0.50) / 1000000.0);
+		add_assoc_double_ex(histogram, SS("p95"), phalcon_db_profiler_percentile(shape, 0.95) / 1000000.0);
+		add_assoc_double_ex(histogram, SS("p99"), phalcon_db_profiler_percentile(shape, 0.99) / 1000000.0);
+
+		add_assoc_zval_ex(return_value, key, key_length, histogram);
+
+		zend_hash_move_forward_ex(intern->shapes, &pos);
+	}
+}
+
+/**
+ * Returns the histograms of the aggregated mode as a single line JSON document
+ *
+ *<code>
+ * {"statements":2,"seconds":0.000412,"shapes":[{"sql":"SELECT * FROM robots WHERE id = ?","count":2,...}]}
+ *</code>
+ *
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Profiler, dump){
+
+	phalcon_db_profiler_object *intern;
+	smart_str buffer = {0};
+
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+
+	phalcon_db_profiler_dump(&buffer, intern TSRMLS_CC);
+	RETURN_STRINGL(buffer.c, buffer.len, 0);
+}
+
+/**
+ * Sets a file where the JSON dump of the histograms is appended when the profiler is destroyed,
+ * usually at the end of the request
+ *
+ * @param string $path
+ * @return Phalcon\Db\Profiler
+ */
+PHP_METHOD(Phalcon_Db_Profiler, setDumpFile){
+
+	zval *path;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &path) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	phalcon_update_property_zval(this_ptr, SL("_dumpFile"), path TSRMLS_CC);
+	
+	RETURN_CTORW(this_ptr);
+}
+
+/**
+ * Appends the dump of the histograms to the dump file if any
+ */
+PHP_METHOD(Phalcon_Db_Profiler, __destruct){
+
+	zval *dump_file, *line, *flags;
+	phalcon_db_profiler_object *intern;
+	smart_str buffer = {0};
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(dump_file);
+	phalcon_read_property(&dump_file, this_ptr, SL("_dumpFile"), PH_NOISY_CC);
+	if (Z_TYPE_P(dump_file) != IS_STRING) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	intern = (phalcon_db_profiler_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (!intern->total_count) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	phalcon_db_profiler_dump(&buffer, intern TSRMLS_CC);
+	smart_str_appendc(&buffer, '\n');
+	smart_str_0(&buffer);
+	
+	PHALCON_INIT_VAR(line);
+	ZVAL_STRINGL(line, buffer.c, buffer.len, 0);
+	
+	/** 
+	 * FILE_APPEND | LOCK_EX, workers can share the file
+	 */
+	PHALCON_INIT_VAR(flags);
+	ZVAL_LONG(flags, 10);
+	PHALCON_CALL_FUNC_PARAMS_3_NORETURN("file_put_contents", dump_file, line, flags);
+	
+	PHALCON_MM_RESTORE();
+}
@@ -29,11 +29,25 @@ PHP_METHOD(Phalcon_Db_Profiler, getTotalElapsedSeconds);
 PHP_METHOD(Phalcon_Db_Profiler, getProfiles);
 PHP_METHOD(Phalcon_Db_Profiler, reset);
 PHP_METHOD(Phalcon_Db_Profiler, getLastProfile);
+PHP_METHOD(Phalcon_Db_Profiler, setAggregated);
+PHP_METHOD(Phalcon_Db_Profiler, isAggregated);
+PHP_METHOD(Phalcon_Db_Profiler, getHistograms);
+PHP_METHOD(Phalcon_Db_Profiler, dump);
+PHP_METHOD(Phalcon_Db_Profiler, setDumpFile);
+PHP_METHOD(Phalcon_Db_Profiler, __destruct);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_profiler_startprofile, 0, 0, 1)
 	ZEND_ARG_INFO(0, sqlStatement)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_profiler_setaggregated, 0, 0, 1)
+	ZEND_ARG_INFO(0, aggregated)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_profiler_setdumpfile, 0, 0, 1)
+	ZEND_ARG_INFO(0, path)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_db_profiler_method_entry){
 	PHP_ME(Phalcon_Db_Profiler, __construct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Db_Profiler, startProfile, arginfo_phalcon_db_profiler_startprofile, ZEND_ACC_PUBLIC) 
@@ -43,6 +57,12 @@ PHALCON_INIT_FUNCS(phalcon_db_profiler_method_entry){
 	PHP_ME(Phalcon_Db_Profiler, getProfiles, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Profiler, reset, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Db_Profiler, getLastProfile, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Profiler, setAggregated, arginfo_phalcon_db_profiler_setaggregated, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Profiler, isAggregated, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Profiler, getHistograms, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Profiler, dump, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Profiler, setDumpFile, arginfo_phalcon_db_profiler_setdumpfile, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Db_Profiler, __destruct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_DTOR) 
 	PHP_FE_END
 };
 
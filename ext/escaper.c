@@ -45,7 +45,7 @@
  * Escapes different kinds of text securing them. By using this component you may
  * prevent XSS attacks.
  *
- * This component only works with UTF-8. The PREG extension needs to be compiled with UTF-8 support.
+ * This component only works with UTF-8.
  *
  *<code>
  * $escaper = new Phalcon\Escaper();
@@ -125,7 +125,8 @@ PHP_METHOD(Phalcon_Escaper, setHtmlQuoteType){
 }
 
 /**
- * Escapes a HTML string. Internally uses htmlspeciarchars
+ * Escapes a HTML string. UTF-8 text is escaped natively producing the same output as
+ * htmlspecialchars, other encodings and quote types are delegated to htmlspecialchars
  *
  * @param string $text
  * @return string
@@ -152,6 +153,18 @@ PHP_METHOD(Phalcon_Escaper, escapeHtml){
 	PHALCON_INIT_VAR(encoding);
 	phalcon_read_property(&encoding, this_ptr, SL("_encoding"), PH_NOISY_CC);
 	
+	/**
+	 * UTF-8 with the standard quote styles is escaped natively, anything else goes to htmlspecialchars
+	 */
+	if (Z_TYPE_P(html_quote_type) == IS_LONG && Z_LVAL_P(html_quote_type) >= 0 && Z_LVAL_P(html_quote_type) <= 3) {
+		if (Z_TYPE_P(encoding) == IS_STRING && Z_STRLEN_P(encoding) == 5 && !strncasecmp(Z_STRVAL_P(encoding), "utf-8", 5)) {
+			if (phalcon_escape_html(return_value, text, Z_LVAL_P(html_quote_type)) == SUCCESS) {
+				PHALCON_MM_RESTORE();
+				return;
+			}
+		}
+	}
+	
 	PHALCON_INIT_VAR(escaped);
 	PHALCON_CALL_FUNC_PARAMS_3(escaped, "htmlspecialchars", text, html_quote_type, encoding);
 	
@@ -159,14 +172,19 @@ PHP_METHOD(Phalcon_Escaper, escapeHtml){
 }
 
 /**
- * Escapes a HTML attribute string
+ * Escapes a HTML attribute string. Characters other than alphanumerics and ",.-_" are replaced
+ * by their named or hexadecimal entity
+ *
+ *<code>
+ * echo $escaper->escapeHtmlAttr('a"b'); // a&quot;b
+ *</code>
  *
  * @param string $text
  * @return string
  */
 PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr){
 
-	zval *text, *html_map = NULL;
+	zval *text;
 
 	PHALCON_MM_GROW();
 
@@ -175,17 +193,12 @@ PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr){
 		RETURN_NULL();
 	}
 
-	PHALCON_INIT_VAR(html_map);
-	phalcon_read_property(&html_map, this_ptr, SL("_htmlEscapeMap"), PH_NOISY_CC);
-	if (Z_TYPE_P(html_map) == IS_NULL) {
-		PHALCON_INIT_NVAR(html_map);
-		array_init(html_map);
-		add_index_stringl(html_map, 34, SL("quot"), 1);
-		add_index_stringl(html_map, 38, SL("amp"), 1);
-		add_index_stringl(html_map, 60, SL("lt"), 1);
-		add_index_stringl(html_map, 62, SL("gt"), 1);
-		phalcon_update_property_zval(this_ptr, SL("_htmlEscapeMap"), html_map TSRMLS_CC);
+	if (Z_TYPE_P(text) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_escaper_exception_ce, "The text must be string");
+		return;
 	}
+
+	phalcon_escape_htmlattr(return_value, text);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -241,10 +254,11 @@ PHP_METHOD(Phalcon_Escaper, cssSanitize){
  * Escape CSS strings by replacing non-alphanumeric chars by their hexadecimal representation
  *
  * @param string $css
+ * @return string
  */
 PHP_METHOD(Phalcon_Escaper, escapeCss){
 
-	zval *css, *pattern, *callback, *sanitized;
+	zval *css;
 
 	PHALCON_MM_GROW();
 
@@ -257,23 +271,41 @@ PHP_METHOD(Phalcon_Escaper, escapeCss){
 		PHALCON_THROW_EXCEPTION_STR(phalcon_escaper_exception_ce, "The CSS must be string");
 		return;
 	}
-	if (zend_is_true(css)) {
-		PHALCON_INIT_VAR(pattern);
-		ZVAL_STRING(pattern, "/[^a-z0-9]/iSu", 1);
-	
-		PHALCON_INIT_VAR(callback);
-		array_init(callback);
-		phalcon_array_append(&callback, this_ptr, PH_SEPARATE TSRMLS_CC);
-		add_next_index_stringl(callback, SL("cssSanitize"), 1);
-	
-		PHALCON_INIT_VAR(sanitized);
-		PHALCON_CALL_FUNC_PARAMS_3(sanitized, "preg_replace_callback", pattern, callback, css);
+
+	phalcon_escape_css(return_value, css);
 	
-		RETURN_CCTOR(sanitized);
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Escape javascript strings by replacing non-alphanumeric chars by their hexadecimal escaped representation
+ *
+ *<code>
+ * echo $escaper->escapeJs("alert('hello');"); // alert\x28\x27hello\x27\x29\x3B
+ *</code>
+ *
+ * @param string $js
+ * @return string
+ */
+PHP_METHOD(Phalcon_Escaper, escapeJs){
+
+	zval *js;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &js) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
 	}
+
+	if (Z_TYPE_P(js) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_escaper_exception_ce, "The javascript must be string");
+		return;
+	}
+
+	phalcon_escape_js(return_value, js);
 	
 	PHALCON_MM_RESTORE();
-	RETURN_NULL();
 }
 
 /**
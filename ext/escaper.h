@@ -28,6 +28,7 @@ PHP_METHOD(Phalcon_Escaper, escapeHtml);
 PHP_METHOD(Phalcon_Escaper, escapeHtmlAttr);
 PHP_METHOD(Phalcon_Escaper, cssSanitize);
 PHP_METHOD(Phalcon_Escaper, escapeCss);
+PHP_METHOD(Phalcon_Escaper, escapeJs);
 PHP_METHOD(Phalcon_Escaper, escapeUrl);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_escaper_setenconding, 0, 0, 1)
@@ -54,6 +55,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_escaper_escapecss, 0, 0, 1)
 	ZEND_ARG_INFO(0, css)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_escaper_escapejs, 0, 0, 1)
+	ZEND_ARG_INFO(0, js)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_escaper_escapeurl, 0, 0, 1)
 	ZEND_ARG_INFO(0, url)
 ZEND_END_ARG_INFO()
@@ -66,6 +71,7 @@ PHALCON_INIT_FUNCS(phalcon_escaper_method_entry){
 	PHP_ME(Phalcon_Escaper, escapeHtmlAttr, arginfo_phalcon_escaper_escapehtmlattr, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Escaper, cssSanitize, arginfo_phalcon_escaper_csssanitize, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Escaper, escapeCss, arginfo_phalcon_escaper_escapecss, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Escaper, escapeJs, arginfo_phalcon_escaper_escapejs, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Escaper, escapeUrl, arginfo_phalcon_escaper_escapeurl, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
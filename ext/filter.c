@@ -39,6 +39,7 @@
 #include "kernel/operators.h"
 #include "kernel/string.h"
 #include "kernel/concat.h"
+#include "kernel/filter.h"
 
 /**
  * Phalcon\Filter
@@ -53,6 +54,7 @@
  *$filter->sanitize("hello<<", "string"); // returns "hello"
  *$filter->sanitize("!100a019", "int"); // returns "100019"
  *$filter->sanitize("!100a019.01a", "float"); // returns "100019.01"
+ *$filter->sanitize("  Hello ", "trim|lower"); // returns "hello"
  *</code>
  *
  */
@@ -66,6 +68,7 @@ PHALCON_INIT_CLASS(Phalcon_Filter){
 	PHALCON_REGISTER_CLASS(Phalcon, Filter, filter, phalcon_filter_method_entry, 0);
 
 	zend_declare_property_null(phalcon_filter_ce, SL("_filters"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_filter_ce, SL("_chains"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_filter_ce TSRMLS_CC, 1, phalcon_filterinterface_ce);
 
@@ -115,11 +118,215 @@ PHP_METHOD(Phalcon_Filter, add){
 	phalcon_array_update_zval(&t0, name, &handler, PH_COPY TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_filters"), t0 TSRMLS_CC);
 	
+	/**
+	 * Compiled chains may refer to a built-in filter with the same name
+	 */
+	phalcon_update_property_null(this_ptr, SL("_chains") TSRMLS_CC);
+	
 	RETURN_CTOR(this_ptr);
 }
 
 /**
- * Sanizites a value with a specified single or set of filters
+ * Appends a filter name to a compiled chain. Built-in filters are stored as their code, user-defined
+ * filters and unknown names are kept as strings and resolved by _sanitize
+ */
+static void phalcon_filter_compile_name(zval *chain, const char *name, unsigned int name_length, zval *user_filters){
+
+	char *key;
+	int filter = 0;
+
+	key = estrndup(name, name_length);
+	if (Z_TYPE_P(user_filters) != IS_ARRAY || !zend_symtable_exists(Z_ARRVAL_P(user_filters), key, name_length + 1)) {
+		filter = phalcon_filter_lookup(key, name_length);
+	}
+
+	if (filter) {
+		add_next_index_long(chain, filter);
+		efree(key);
+	} else {
+		add_next_index_stringl(chain, key, name_length, 0);
+	}
+}
+
+/**
+ * Compiles a filter, a "name|name" chain or an array of them into a flat list of filters
+ */
+static void phalcon_filter_compile(zval *chain, zval *filters, zval *user_filters){
+
+	unsigned int start, end, next = 0, length;
+	const char *names;
+	HashPosition pos;
+	zval **filter;
+
+	if (Z_TYPE_P(filters) == IS_ARRAY) {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(filters), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(filters), (void **) &filter, &pos) == SUCCESS) {
+			if (Z_TYPE_PP(filter) == IS_STRING) {
+				phalcon_filter_compile(chain, *filter, user_filters);
+			} else {
+				Z_ADDREF_PP(filter);
+				add_next_index_zval(chain, *filter);
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(filters), &pos);
+		}
+		return;
+	}
+
+	if (Z_TYPE_P(filters) != IS_STRING) {
+		Z_ADDREF_P(filters);
+		add_next_index_zval(chain, filters);
+		return;
+	}
+
+	names = Z_STRVAL_P(filters);
+	length = Z_STRLEN_P(filters);
+	while (next <= length) {
+
+		start = next;
+		end = start;
+		while (end < length && names[end] != '|') {
+			end++;
+		}
+		next = end + 1;
+
+		while (start < end && (names[start] == ' ' || names[start] == '\t')) {
+			start++;
+		}
+		while (end > start && (names[end - 1] == ' ' || names[end - 1] == '\t')) {
+			end--;
+		}
+
+		if (start < end) {
+			phalcon_filter_compile_name(chain, names + start, end - start, user_filters);
+		}
+	}
+}
+
+/**
+ * Returns the compiled chain for the passed filters, chains passed as strings are compiled once
+ * per instance. The caller owns a reference to the returned chain
+ */
+static zval *phalcon_filter_get_chain(zval *object, zval *filters TSRMLS_DC){
+
+	zval *user_filters, *chains = NULL, *chain, **cached;
+
+	if (Z_TYPE_P(filters) == IS_STRING) {
+		chains = zend_read_property(phalcon_filter_ce, object, SL("_chains"), 1 TSRMLS_CC);
+		if (Z_TYPE_P(chains) == IS_ARRAY) {
+			if (zend_symtable_find(Z_ARRVAL_P(chains), Z_STRVAL_P(filters), Z_STRLEN_P(filters) + 1, (void **) &cached) == SUCCESS) {
+				Z_ADDREF_PP(cached);
+				return *cached;
+			}
+		}
+	}
+
+	user_filters = zend_read_property(phalcon_filter_ce, object, SL("_filters"), 1 TSRMLS_CC);
+
+	MAKE_STD_ZVAL(chain);
+	array_init(chain);
+	phalcon_filter_compile(chain, filters, user_filters);
+
+	if (Z_TYPE_P(filters) == IS_STRING) {
+
+		if (Z_TYPE_P(chains) != IS_ARRAY) {
+			MAKE_STD_ZVAL(chains);
+			array_init(chains);
+			zend_update_property(phalcon_filter_ce, object, SL("_chains"), chains TSRMLS_CC);
+			zval_ptr_dtor(&chains);
+			chains = zend_read_property(phalcon_filter_ce, object, SL("_chains"), 1 TSRMLS_CC);
+		}
+
+		/**
+		 * The cache is only updated in place when nobody else holds the array
+		 */
+		if (Z_TYPE_P(chains) == IS_ARRAY && Z_REFCOUNT_P(chains) == 1) {
+			Z_ADDREF_P(chain);
+			zend_symtable_update(Z_ARRVAL_P(chains), Z_STRVAL_P(filters), Z_STRLEN_P(filters) + 1, &chain, sizeof(zval *), NULL);
+		}
+	}
+
+	return chain;
+}
+
+/**
+ * Checks whether the built-in filters can be applied natively, this isn't possible if a
+ * subclass has overridden _sanitize
+ */
+static int phalcon_filter_is_native(zval *object TSRMLS_DC){
+
+	zend_function *method;
+
+	if (Z_OBJCE_P(object) == phalcon_filter_ce) {
+		return 1;
+	}
+
+	if (zend_hash_find(&Z_OBJCE_P(object)->function_table, SS("_sanitize"), (void **) &method) == SUCCESS) {
+		return method->common.scope == phalcon_filter_ce;
+	}
+
+	return 0;
+}
+
+/**
+ * Applies a compiled chain to a value. Built-in filters run natively, user-defined filters and
+ * values the native filters don't handle go through _sanitize
+ */
+static int phalcon_filter_apply(zval *return_value, zval *object, zval *value, zval *chain, int native TSRMLS_DC){
+
+	zval *current, *filtered, *name, **filter;
+	HashPosition pos;
+	int status;
+
+	current = value;
+	Z_ADDREF_P(current);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(chain), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(chain), (void **) &filter, &pos) == SUCCESS) {
+
+		ALLOC_INIT_ZVAL(filtered);
+
+		status = FAILURE;
+		if (native && Z_TYPE_PP(filter) == IS_LONG) {
+			status = phalcon_filter_native(filtered, current, Z_LVAL_PP(filter));
+		}
+
+		if (status == FAILURE) {
+
+			if (Z_TYPE_PP(filter) == IS_LONG) {
+				MAKE_STD_ZVAL(name);
+				ZVAL_STRING(name, phalcon_filter_name(Z_LVAL_PP(filter)), 1);
+			} else {
+				name = *filter;
+				Z_ADDREF_P(name);
+			}
+
+			status = phalcon_call_method_two_params(filtered, object, SL("_sanitize"), current, name, PH_NO_CHECK, 1 TSRMLS_CC);
+			zval_ptr_dtor(&name);
+			if (status == FAILURE) {
+				zval_ptr_dtor(&filtered);
+				zval_ptr_dtor(&current);
+				return FAILURE;
+			}
+		}
+
+		zval_ptr_dtor(&current);
+		current = filtered;
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(chain), &pos);
+	}
+
+	RETVAL_ZVAL(current, 1, 1);
+	return SUCCESS;
+}
+
+/**
+ * Sanizites a value with a specified single or set of filters. Filters can be chained
+ * using a pipe, the chain is compiled once and built-in filters are applied natively
+ *
+ *<code>
+ * $filter->sanitize(" 100 ", "trim|int");
+ * $filter->sanitize(" Hello ", array("trim", "lower"));
+ *</code>
  *
  * @param  mixed $value
  * @param  mixed $filters
@@ -127,11 +334,8 @@ PHP_METHOD(Phalcon_Filter, add){
  */
 PHP_METHOD(Phalcon_Filter, sanitize){
 
-	zval *value, *filters, *new_value = NULL, *filter = NULL, *filter_value = NULL;
-	zval *sanizited_value;
-	HashTable *ah0;
-	HashPosition hp0;
-	zval **hd;
+	zval *value, *filters, *chain;
+	int status;
 
 	PHALCON_MM_GROW();
 
@@ -140,45 +344,84 @@ PHP_METHOD(Phalcon_Filter, sanitize){
 		RETURN_NULL();
 	}
 
-	if (Z_TYPE_P(filters) == IS_ARRAY) { 
-		PHALCON_CPY_WRT(new_value, value);
-		if (Z_TYPE_P(value) != IS_NULL) {
-	
-			if (!phalcon_valid_foreach(filters TSRMLS_CC)) {
-				return;
-			}
-	
-			ah0 = Z_ARRVAL_P(filters);
-			zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	
-			ph_cycle_start_0:
+	/**
+	 * Null values are left untouched when a list of filters is passed
+	 */
+	if (Z_TYPE_P(filters) == IS_ARRAY) {
+		if (Z_TYPE_P(value) == IS_NULL) {
+			RETURN_CCTOR(value);
+		}
+	}
 	
-				if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
-					goto ph_cycle_end_0;
-				}
+	chain = phalcon_filter_get_chain(this_ptr, filters TSRMLS_CC);
+	status = phalcon_filter_apply(return_value, this_ptr, value, chain, phalcon_filter_is_native(this_ptr TSRMLS_CC) TSRMLS_CC);
+	zval_ptr_dtor(&chain);
+	if (status == FAILURE) {
+		return;
+	}
 	
-				PHALCON_GET_FOREACH_VALUE(filter);
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Sanizites every value in an array with the same filter or chain of filters, keys are preserved
+ *
+ *<code>
+ * $filter->sanitizeArray(array("a" => " 1 ", "b" => "2x"), "trim|int"); // array("a" => "1", "b" => "2")
+ *</code>
+ *
+ * @param  array $values
+ * @param  mixed $filters
+ * @return array
+ */
+PHP_METHOD(Phalcon_Filter, sanitizeArray){
+
+	zval *values, *filters, *chain, *filtered, **value;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+	int native;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &values, &filters) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(values) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_filter_exception_ce, "Values to sanitize must be an array");
+		return;
+	}
 	
-				PHALCON_INIT_NVAR(filter_value);
-				PHALCON_CALL_METHOD_PARAMS_2(filter_value, this_ptr, "_sanitize", new_value, filter, PH_NO_CHECK);
-				PHALCON_CPY_WRT(new_value, filter_value);
+	chain = phalcon_filter_get_chain(this_ptr, filters TSRMLS_CC);
+	native = phalcon_filter_is_native(this_ptr TSRMLS_CC);
 	
-				zend_hash_move_forward_ex(ah0, &hp0);
-				goto ph_cycle_start_0;
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(values)));
 	
-			ph_cycle_end_0:
-			if(0){}
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(values), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(values), (void **) &value, &pos) == SUCCESS) {
 	
+		ALLOC_INIT_ZVAL(filtered);
+		if (phalcon_filter_apply(filtered, this_ptr, *value, chain, native TSRMLS_CC) == FAILURE) {
+			zval_ptr_dtor(&filtered);
+			zval_ptr_dtor(&chain);
+			return;
 		}
 	
+		if (zend_hash_get_current_key_ex(Z_ARRVAL_P(values), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+			zend_hash_update(Z_ARRVAL_P(return_value), key, key_length, &filtered, sizeof(zval *), NULL);
+		} else {
+			zend_hash_index_update(Z_ARRVAL_P(return_value), index, &filtered, sizeof(zval *), NULL);
+		}
 	
-		RETURN_CCTOR(new_value);
+		zend_hash_move_forward_ex(Z_ARRVAL_P(values), &pos);
 	}
 	
-	PHALCON_INIT_VAR(sanizited_value);
-	PHALCON_CALL_METHOD_PARAMS_2(sanizited_value, this_ptr, "_sanitize", value, filters, PH_NO_CHECK);
+	zval_ptr_dtor(&chain);
 	
-	RETURN_CCTOR(sanizited_value);
+	PHALCON_MM_RESTORE();
 }
 
 /**
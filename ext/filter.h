@@ -24,6 +24,7 @@ PHALCON_INIT_CLASS(Phalcon_Filter);
 PHP_METHOD(Phalcon_Filter, __construct);
 PHP_METHOD(Phalcon_Filter, add);
 PHP_METHOD(Phalcon_Filter, sanitize);
+PHP_METHOD(Phalcon_Filter, sanitizeArray);
 PHP_METHOD(Phalcon_Filter, _sanitize);
 PHP_METHOD(Phalcon_Filter, getFilters);
 
@@ -37,10 +38,16 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_filter_sanitize, 0, 0, 2)
 	ZEND_ARG_INFO(0, filters)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_filter_sanitizearray, 0, 0, 2)
+	ZEND_ARG_INFO(0, values)
+	ZEND_ARG_INFO(0, filters)
+ZEND_END_ARG_INFO()
+
 PHALCON_INIT_FUNCS(phalcon_filter_method_entry){
 	PHP_ME(Phalcon_Filter, __construct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Filter, add, arginfo_phalcon_filter_add, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Filter, sanitize, arginfo_phalcon_filter_sanitize, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Filter, sanitizeArray, arginfo_phalcon_filter_sanitizearray, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Filter, _sanitize, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Filter, getFilters, NULL, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
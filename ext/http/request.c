@@ -40,6 +40,7 @@
 #include "kernel/operators.h"
 #include "kernel/string.h"
 #include "kernel/file.h"
+#include "kernel/accept.h"
 
 /**
  * Phalcon\Http\Request
@@ -70,12 +71,182 @@ PHALCON_INIT_CLASS(Phalcon_Http_Request){
 
 	zend_declare_property_null(phalcon_http_request_ce, SL("_dependencyInjector"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_http_request_ce, SL("_filter"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_http_request_ce, SL("_server"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_http_request_ce, SL("_headers"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_http_request_ce TSRMLS_CC, 2, phalcon_http_requestinterface_ce, phalcon_di_injectionawareinterface_ce);
 
 	return SUCCESS;
 }
 
+/**
+ * Returns the $_SERVER array the request reads from. The snapshot shares the array with the symbol
+ * table instead of copying it: assigning to $_SERVER separates the array, so a snapshot that
+ * doesn't match the current one is stale and the views derived from it are dropped
+ */
+static zval *phalcon_http_request_server(zval *object TSRMLS_DC){
+
+	zval **server, *snapshot;
+
+	if (PG(auto_globals_jit)) {
+		zend_is_auto_global(SL("_SERVER") TSRMLS_CC);
+	}
+
+	if (zend_hash_find(&EG(symbol_table), SS("_SERVER"), (void **) &server) == FAILURE || Z_TYPE_PP(server) != IS_ARRAY) {
+		return NULL;
+	}
+
+	snapshot = zend_read_property(phalcon_http_request_ce, object, SL("_server"), 1 TSRMLS_CC);
+	if (snapshot != *server) {
+		zend_update_property(phalcon_http_request_ce, object, SL("_server"), *server TSRMLS_CC);
+		zend_update_property_null(phalcon_http_request_ce, object, SL("_headers") TSRMLS_CC);
+	}
+
+	return *server;
+}
+
+/**
+ * Fetches an entry from the server snapshot, NULL is returned if it doesn't exist
+ */
+static zval *phalcon_http_request_server_value(zval *object, char *key, unsigned int key_length TSRMLS_DC){
+
+	zval *server, **value;
+
+	server = phalcon_http_request_server(object TSRMLS_CC);
+	if (server && zend_symtable_find(Z_ARRVAL_P(server), key, key_length, (void **) &value) == SUCCESS) {
+		return *value;
+	}
+
+	return NULL;
+}
+
+/**
+ * Returns the normalized header view of the snapshot, it's built on the first access: HTTP_* entries
+ * without their prefix plus the CONTENT_* entries, which PHP doesn't prefix
+ */
+static zval *phalcon_http_request_headers(zval *object TSRMLS_DC){
+
+	zval *server, *headers, **value;
+	HashTable *ht;
+	HashPosition pos;
+	char *key;
+	uint key_length;
+	ulong index;
+
+	server = phalcon_http_request_server(object TSRMLS_CC);
+
+	headers = zend_read_property(phalcon_http_request_ce, object, SL("_headers"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(headers) == IS_ARRAY) {
+		return headers;
+	}
+
+	MAKE_STD_ZVAL(headers);
+	array_init(headers);
+
+	if (server) {
+		ht = Z_ARRVAL_P(server);
+		zend_hash_internal_pointer_reset_ex(ht, &pos);
+		while (zend_hash_get_current_data_ex(ht, (void **) &value, &pos) == SUCCESS) {
+			if (zend_hash_get_current_key_ex(ht, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+				if (key_length > sizeof("HTTP_") && !memcmp(key, "HTTP_", sizeof("HTTP_") - 1)) {
+					Z_ADDREF_PP(value);
+					zend_symtable_update(Z_ARRVAL_P(headers), key + sizeof("HTTP_") - 1, key_length - sizeof("HTTP_") + 1, value, sizeof(zval *), NULL);
+				} else if (key_length > sizeof("CONTENT_") && !memcmp(key, "CONTENT_", sizeof("CONTENT_") - 1)) {
+					Z_ADDREF_PP(value);
+					zend_symtable_update(Z_ARRVAL_P(headers), key, key_length, value, sizeof(zval *), NULL);
+				}
+			}
+			zend_hash_move_forward_ex(ht, &pos);
+		}
+	}
+
+	zend_update_property(phalcon_http_request_ce, object, SL("_headers"), headers TSRMLS_CC);
+	zval_ptr_dtor(&headers);
+
+	return headers;
+}
+
+/**
+ * Compares a snapshot entry with a string the way the == operator does, missing entries compare
+ * as empty strings
+ */
+static int phalcon_http_request_equals(zval *value, char *str, unsigned int str_length TSRMLS_DC){
+
+	zval result, literal;
+
+	if (!value) {
+		return !str_length;
+	}
+
+	if (Z_TYPE_P(value) == IS_STRING) {
+		return Z_STRLEN_P(value) == (int) str_length && !memcmp(Z_STRVAL_P(value), str, str_length);
+	}
+
+	INIT_ZVAL(literal);
+	ZVAL_STRINGL(&literal, str, str_length, 0);
+	is_equal_function(&result, value, &literal TSRMLS_CC);
+
+	return Z_BVAL(result);
+}
+
+/**
+ * Checks if a method is the one implemented here and not an override, so the data it returns can
+ * be read directly instead of calling it
+ */
+static int phalcon_http_request_native_method(zval *object, char *name, unsigned int name_length TSRMLS_DC){
+
+	zend_function *method;
+
+	if (Z_OBJCE_P(object) == phalcon_http_request_ce) {
+		return 1;
+	}
+
+	if (zend_hash_find(&Z_OBJCE_P(object)->function_table, name, name_length, (void **) &method) == SUCCESS) {
+		return method->common.scope == phalcon_http_request_ce;
+	}
+
+	return 0;
+}
+
+/**
+ * Checks if the negotiation of a header can use the parsed header cache: the list method and the
+ * protected helpers it relies on must not be overridden
+ */
+static int phalcon_http_request_native_accept(zval *object, char *list_method, unsigned int list_method_length TSRMLS_DC){
+
+	if (Z_OBJCE_P(object) == phalcon_http_request_ce) {
+		return 1;
+	}
+
+	return phalcon_http_request_native_method(object, list_method, list_method_length TSRMLS_CC)
+		&& phalcon_http_request_native_method(object, SS("_getqualityheader") TSRMLS_CC)
+		&& phalcon_http_request_native_method(object, SS("_getbestquality") TSRMLS_CC);
+}
+
+/**
+ * Checks the request method against a name, shared by the is<Method> methods
+ */
+static void phalcon_http_request_is_method(zval *return_value, zval *object, char *name, unsigned int name_length TSRMLS_DC){
+
+	zval *method, literal;
+
+	if (phalcon_http_request_native_method(object, SS("getmethod") TSRMLS_CC)) {
+		method = phalcon_http_request_server_value(object, SS("REQUEST_METHOD") TSRMLS_CC);
+		RETURN_BOOL(phalcon_http_request_equals(method, name, name_length TSRMLS_CC));
+	}
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(method);
+	PHALCON_CALL_METHOD(method, object, "getmethod", PH_NO_CHECK);
+
+	INIT_ZVAL(literal);
+	ZVAL_STRINGL(&literal, name, name_length, 0);
+	is_equal_function(return_value, method, &literal TSRMLS_CC);
+
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Sets the dependency injector
  *
@@ -340,8 +511,7 @@ PHP_METHOD(Phalcon_Http_Request, getQuery){
  */
 PHP_METHOD(Phalcon_Http_Request, getServer){
 
-	zval *name, *server_value;
-	zval *g0 = NULL;
+	zval *name, *server, *server_value;
 	int eval_int;
 
 	PHALCON_MM_GROW();
@@ -351,13 +521,15 @@ PHP_METHOD(Phalcon_Http_Request, getServer){
 		RETURN_NULL();
 	}
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	eval_int = phalcon_array_isset(g0, name);
-	if (eval_int) {
-		PHALCON_INIT_VAR(server_value);
-		phalcon_array_fetch(&server_value, g0, name, PH_NOISY_CC);
+	server = phalcon_http_request_server(this_ptr TSRMLS_CC);
+	if (server) {
+		eval_int = phalcon_array_isset(server, name);
+		if (eval_int) {
+			PHALCON_INIT_VAR(server_value);
+			phalcon_array_fetch(&server_value, server, name, PH_NOISY_CC);
 	
-		RETURN_CCTOR(server_value);
+			RETURN_CCTOR(server_value);
+		}
 	}
 	PHALCON_MM_RESTORE();
 	RETURN_NULL();
@@ -455,24 +627,18 @@ PHP_METHOD(Phalcon_Http_Request, hasQuery){
  */
 PHP_METHOD(Phalcon_Http_Request, hasServer){
 
-	zval *name;
-	zval *g0 = NULL;
-	zval *r0 = NULL;
-	int eval_int;
-
-	PHALCON_MM_GROW();
+	zval *name, *server;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &name) == FAILURE) {
-		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	eval_int = phalcon_array_isset(g0, name);
-	PHALCON_INIT_VAR(r0);
-	ZVAL_BOOL(r0, eval_int);
-	
-	RETURN_NCTOR(r0);
+	server = phalcon_http_request_server(this_ptr TSRMLS_CC);
+	if (server) {
+		RETURN_BOOL(phalcon_array_isset(server, name));
+	}
+
+	RETURN_FALSE;
 }
 
 /**
@@ -483,39 +649,80 @@ PHP_METHOD(Phalcon_Http_Request, hasServer){
  */
 PHP_METHOD(Phalcon_Http_Request, getHeader){
 
-	zval *header, *server_value = NULL, *key;
-	zval *g0 = NULL;
-	int eval_int;
+	zval *header, *server, *headers, **value;
+	char *key;
+	int i, found;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &header) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	server = phalcon_http_request_server(this_ptr TSRMLS_CC);
+	if (!server) {
+		RETURN_STRING("", 1);
+	}
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &header) == FAILURE) {
+	if (Z_TYPE_P(header) != IS_STRING) {
+		PHALCON_SEPARATE_PARAM(header);
+		convert_to_string(header);
+	}
+
+	/** 
+	 * Raw $_SERVER entries are looked up first
+	 */
+	if (zend_symtable_find(Z_ARRVAL_P(server), Z_STRVAL_P(header), Z_STRLEN_P(header) + 1, (void **) &value) == SUCCESS) {
+		RETVAL_ZVAL(*value, 1, 0);
 		PHALCON_MM_RESTORE();
-		RETURN_NULL();
+		return;
 	}
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	eval_int = phalcon_array_isset(g0, header);
-	if (eval_int) {
-		PHALCON_INIT_VAR(server_value);
-		phalcon_array_fetch(&server_value, g0, header, PH_NOISY_CC);
-	
-		RETURN_CCTOR(server_value);
-	} else {
-		PHALCON_INIT_VAR(key);
-		PHALCON_CONCAT_SV(key, "HTTP_", header);
-		eval_int = phalcon_array_isset(g0, key);
-		if (eval_int) {
-			PHALCON_INIT_NVAR(server_value);
-			phalcon_array_fetch(&server_value, g0, key, PH_NOISY_CC);
-	
-			RETURN_CCTOR(server_value);
+	/** 
+	 * Then the normalized headers: 'Content-Type', 'content_type' and 'CONTENT_TYPE' are the same header
+	 */
+	key = estrndup(Z_STRVAL_P(header), Z_STRLEN_P(header));
+	for (i = 0; i < Z_STRLEN_P(header); i++) {
+		if (key[i] == '-') {
+			key[i] = '_';
+		} else if (key[i] >= 'a' && key[i] <= 'z') {
+			key[i] -= 'a' - 'A';
 		}
 	}
+
+	headers = phalcon_http_request_headers(this_ptr TSRMLS_CC);
+	found = zend_symtable_find(Z_ARRVAL_P(headers), key, Z_STRLEN_P(header) + 1, (void **) &value);
+	efree(key);
+
+	if (found == SUCCESS) {
+		RETVAL_ZVAL(*value, 1, 0);
+		PHALCON_MM_RESTORE();
+		return;
+	}
+
 	PHALCON_MM_RESTORE();
 	RETURN_STRING("", 1);
 }
 
+/**
+ * Returns the HTTP headers sent with the request, keyed by their upper-case, underscore separated names
+ *
+ *<code>
+ *	$headers = $request->getHeaders();
+ *	echo $headers['USER_AGENT'];
+ *</code>
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Http_Request, getHeaders){
+
+	zval *headers;
+
+	headers = phalcon_http_request_headers(this_ptr TSRMLS_CC);
+
+	RETURN_ZVAL(headers, 1, 0);
+}
+
 /**
  * Gets HTTP schema (http/https)
  *
@@ -523,25 +730,14 @@ PHP_METHOD(Phalcon_Http_Request, getHeader){
  */
 PHP_METHOD(Phalcon_Http_Request, getScheme){
 
-	zval *https_header, *https, *scheme = NULL;
-
-	PHALCON_MM_GROW();
+	zval *https;
 
-	PHALCON_INIT_VAR(https_header);
-	ZVAL_STRING(https_header, "HTTP_HTTPS", 1);
-	
-	PHALCON_INIT_VAR(https);
-	PHALCON_CALL_METHOD_PARAMS_1(https, this_ptr, "getserver", https_header, PH_NO_CHECK);
-	if (PHALCON_COMPARE_STRING(https, "on")) {
-		PHALCON_INIT_VAR(scheme);
-		ZVAL_STRING(scheme, "https", 1);
-	} else {
-		PHALCON_INIT_NVAR(scheme);
-		ZVAL_STRING(scheme, "http", 1);
+	https = phalcon_http_request_server_value(this_ptr, SS("HTTP_HTTPS") TSRMLS_CC);
+	if (https && PHALCON_COMPARE_STRING(https, "on")) {
+		RETURN_STRING("https", 1);
 	}
-	
-	
-	RETURN_CTOR(scheme);
+
+	RETURN_STRING("http", 1);
 }
 
 /**
@@ -551,24 +747,11 @@ PHP_METHOD(Phalcon_Http_Request, getScheme){
  */
 PHP_METHOD(Phalcon_Http_Request, isAjax){
 
-	zval *requested_header, *xml_http_request;
-	zval *requested_with, *is_ajax;
+	zval *requested_with;
 
-	PHALCON_MM_GROW();
+	requested_with = phalcon_http_request_server_value(this_ptr, SS("HTTP_X_REQUESTED_WITH") TSRMLS_CC);
 
-	PHALCON_INIT_VAR(requested_header);
-	ZVAL_STRING(requested_header, "HTTP_X_REQUESTED_WITH", 1);
-	
-	PHALCON_INIT_VAR(xml_http_request);
-	ZVAL_STRING(xml_http_request, "XMLHttpRequest", 1);
-	
-	PHALCON_INIT_VAR(requested_with);
-	PHALCON_CALL_METHOD_PARAMS_1(requested_with, this_ptr, "getheader", requested_header, PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_ajax);
-	is_equal_function(is_ajax, requested_with, xml_http_request TSRMLS_CC);
-	
-	RETURN_NCTOR(is_ajax);
+	RETURN_BOOL(phalcon_http_request_equals(requested_with, SL("XMLHttpRequest") TSRMLS_CC));
 }
 
 /**
@@ -578,31 +761,17 @@ PHP_METHOD(Phalcon_Http_Request, isAjax){
  */
 PHP_METHOD(Phalcon_Http_Request, isSoapRequested){
 
-	zval *server = NULL, *content_type;
-	zval *g0 = NULL;
-	int eval_int;
+	zval *content_type;
 
-	PHALCON_MM_GROW();
+	if (phalcon_http_request_server_value(this_ptr, SS("HTTP_SOAPACTION") TSRMLS_CC)) {
+		RETURN_TRUE;
+	}
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	PHALCON_CPY_WRT(server, g0);
-	eval_int = phalcon_array_isset_string(server, SS("HTTP_SOAPACTION"));
-	if (eval_int) {
-		PHALCON_MM_RESTORE();
+	content_type = phalcon_http_request_server_value(this_ptr, SS("CONTENT_TYPE") TSRMLS_CC);
+	if (content_type && phalcon_memnstr_str(content_type, SL("application/soap+xml") TSRMLS_CC)) {
 		RETURN_TRUE;
-	} else {
-		eval_int = phalcon_array_isset_string(server, SS("CONTENT_TYPE"));
-		if (eval_int) {
-			PHALCON_INIT_VAR(content_type);
-			phalcon_array_fetch_string(&content_type, server, SL("CONTENT_TYPE"), PH_NOISY_CC);
-			if (phalcon_memnstr_str(content_type, SL("application/soap+xml") TSRMLS_CC)) {
-				PHALCON_MM_RESTORE();
-				RETURN_TRUE;
-			}
-		}
 	}
-	
-	PHALCON_MM_RESTORE();
+
 	RETURN_FALSE;
 }
 
@@ -656,29 +825,26 @@ PHP_METHOD(Phalcon_Http_Request, getRawBody){
  */
 PHP_METHOD(Phalcon_Http_Request, getServerAddress){
 
-	zval *server = NULL, *server_addr = NULL, *localhost;
-	zval *g0 = NULL;
-	int eval_int;
+	zval *server_addr;
 
-	PHALCON_MM_GROW();
+	server_addr = phalcon_http_request_server_value(this_ptr, SS("SERVER_ADDR") TSRMLS_CC);
+	if (server_addr) {
+		RETURN_ZVAL(server_addr, 1, 0);
+	}
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	PHALCON_CPY_WRT(server, g0);
-	eval_int = phalcon_array_isset_string(server, SS("SERVER_ADDR"));
-	if (eval_int) {
-		PHALCON_INIT_VAR(server_addr);
-		phalcon_array_fetch_string(&server_addr, server, SL("SERVER_ADDR"), PH_NOISY_CC);
-	
-		RETURN_CCTOR(server_addr);
+	/** 
+	 * IIS reports the interface the request arrived on as LOCAL_ADDR
+	 */
+	server_addr = phalcon_http_request_server_value(this_ptr, SS("LOCAL_ADDR") TSRMLS_CC);
+	if (server_addr) {
+		RETURN_ZVAL(server_addr, 1, 0);
 	}
-	
-	PHALCON_INIT_VAR(localhost);
-	ZVAL_STRING(localhost, "localhost", 1);
-	
-	PHALCON_INIT_NVAR(server_addr);
-	PHALCON_CALL_FUNC_PARAMS_1(server_addr, "gethostbyname", localhost);
-	
-	RETURN_CCTOR(server_addr);
+
+	/** 
+	 * Without a web server (CLI) the address is the loopback one, resolving 'localhost' here would
+	 * block the request on the system resolver
+	 */
+	RETURN_STRING("127.0.0.1", 1);
 }
 
 /**
@@ -688,26 +854,14 @@ PHP_METHOD(Phalcon_Http_Request, getServerAddress){
  */
 PHP_METHOD(Phalcon_Http_Request, getServerName){
 
-	zval *server = NULL, *server_name = NULL;
-	zval *g0 = NULL;
-	int eval_int;
+	zval *server_name;
 
-	PHALCON_MM_GROW();
-
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	PHALCON_CPY_WRT(server, g0);
-	eval_int = phalcon_array_isset_string(server, SS("SERVER_NAME"));
-	if (eval_int) {
-		PHALCON_INIT_VAR(server_name);
-		phalcon_array_fetch_string(&server_name, server, SL("SERVER_NAME"), PH_NOISY_CC);
-	
-		RETURN_CCTOR(server_name);
+	server_name = phalcon_http_request_server_value(this_ptr, SS("SERVER_NAME") TSRMLS_CC);
+	if (server_name) {
+		RETURN_ZVAL(server_name, 1, 0);
 	}
-	
-	PHALCON_INIT_NVAR(server_name);
-	ZVAL_STRING(server_name, "localhost", 1);
-	
-	RETURN_CCTOR(server_name);
+
+	RETURN_STRING("localhost", 1);
 }
 
 /**
@@ -731,20 +885,20 @@ PHP_METHOD(Phalcon_Http_Request, getHttpHost){
 	/** 
 	 * Get the server name from _SERVER['HTTP_SERVER_NAME']
 	 */
-	PHALCON_INIT_VAR(server_name);
-	ZVAL_STRING(server_name, "HTTP_SERVER_NAME", 1);
-	
 	PHALCON_INIT_VAR(name);
-	PHALCON_CALL_METHOD_PARAMS_1(name, this_ptr, "getserver", server_name, PH_NO_CHECK);
+	server_name = phalcon_http_request_server_value(this_ptr, SS("HTTP_SERVER_NAME") TSRMLS_CC);
+	if (server_name) {
+		ZVAL_ZVAL(name, server_name, 1, 0);
+	}
 	
 	/** 
 	 * Get the server port from _SERVER['HTTP_SERVER_PORT']
 	 */
-	PHALCON_INIT_VAR(server_port);
-	ZVAL_STRING(server_port, "HTTP_SERVER_PORT", 1);
-	
 	PHALCON_INIT_VAR(port);
-	PHALCON_CALL_METHOD_PARAMS_1(port, this_ptr, "getserver", server_port, PH_NO_CHECK);
+	server_port = phalcon_http_request_server_value(this_ptr, SS("HTTP_SERVER_PORT") TSRMLS_CC);
+	if (server_port) {
+		ZVAL_ZVAL(port, server_port, 1, 0);
+	}
 	
 	PHALCON_INIT_VAR(http);
 	ZVAL_STRING(http, "http", 1);
@@ -812,10 +966,8 @@ PHP_METHOD(Phalcon_Http_Request, getHttpHost){
  */
 PHP_METHOD(Phalcon_Http_Request, getClientAddress){
 
-	zval *trust_forwarded_header = NULL, *server = NULL, *address = NULL;
+	zval *trust_forwarded_header = NULL, *address = NULL;
 	zval *comma, *addresses, *first;
-	zval *g0 = NULL;
-	int eval_int;
 
 	PHALCON_MM_GROW();
 
@@ -829,26 +981,20 @@ PHP_METHOD(Phalcon_Http_Request, getClientAddress){
 		ZVAL_BOOL(trust_forwarded_header, 0);
 	}
 	
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	PHALCON_CPY_WRT(server, g0);
-	
 	/** 
 	 * Proxies uses this IP
 	 */
 	if (PHALCON_IS_TRUE(trust_forwarded_header)) {
-		eval_int = phalcon_array_isset_string(server, SS("HTTP_X_FORWARDED_FOR"));
-		if (eval_int) {
-			PHALCON_INIT_VAR(address);
-			phalcon_array_fetch_string(&address, server, SL("HTTP_X_FORWARDED_FOR"), PH_NOISY_CC);
-	
-			RETURN_CCTOR(address);
+		address = phalcon_http_request_server_value(this_ptr, SS("HTTP_X_FORWARDED_FOR") TSRMLS_CC);
+		if (address) {
+			RETVAL_ZVAL(address, 1, 0);
+			PHALCON_MM_RESTORE();
+			return;
 		}
 	}
 	
-	eval_int = phalcon_array_isset_string(server, SS("REMOTE_ADDR"));
-	if (eval_int) {
-		PHALCON_INIT_NVAR(address);
-		phalcon_array_fetch_string(&address, server, SL("REMOTE_ADDR"), PH_NOISY_CC);
+	address = phalcon_http_request_server_value(this_ptr, SS("REMOTE_ADDR") TSRMLS_CC);
+	if (address) {
 		if (phalcon_memnstr_str(address, SL(",") TSRMLS_CC)) {
 			/** 
 			 * The client address has multiples parts, only return the first part
@@ -865,8 +1011,9 @@ PHP_METHOD(Phalcon_Http_Request, getClientAddress){
 			RETURN_CCTOR(first);
 		}
 	
-	
-		RETURN_CCTOR(address);
+		RETVAL_ZVAL(address, 1, 0);
+		PHALCON_MM_RESTORE();
+		return;
 	}
 	
 	PHALCON_MM_RESTORE();
@@ -880,25 +1027,14 @@ PHP_METHOD(Phalcon_Http_Request, getClientAddress){
  */
 PHP_METHOD(Phalcon_Http_Request, getMethod){
 
-	zval *server = NULL, *request_method = NULL;
-	zval *g0 = NULL;
-	int eval_int;
+	zval *request_method;
 
-	PHALCON_MM_GROW();
-
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	PHALCON_CPY_WRT(server, g0);
-	eval_int = phalcon_array_isset_string(server, SS("REQUEST_METHOD"));
-	if (eval_int) {
-		PHALCON_INIT_VAR(request_method);
-		phalcon_array_fetch_string(&request_method, server, SL("REQUEST_METHOD"), PH_NOISY_CC);
-	} else {
-		PHALCON_INIT_NVAR(request_method);
-		ZVAL_STRING(request_method, "", 1);
+	request_method = phalcon_http_request_server_value(this_ptr, SS("REQUEST_METHOD") TSRMLS_CC);
+	if (request_method) {
+		RETURN_ZVAL(request_method, 1, 0);
 	}
-	
-	
-	RETURN_CCTOR(request_method);
+
+	RETURN_STRING("", 1);
 }
 
 /**
@@ -908,25 +1044,14 @@ PHP_METHOD(Phalcon_Http_Request, getMethod){
  */
 PHP_METHOD(Phalcon_Http_Request, getUserAgent){
 
-	zval *server = NULL, *user_agent = NULL;
-	zval *g0 = NULL;
-	int eval_int;
-
-	PHALCON_MM_GROW();
+	zval *user_agent;
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	PHALCON_CPY_WRT(server, g0);
-	eval_int = phalcon_array_isset_string(server, SS("HTTP_USER_AGENT"));
-	if (eval_int) {
-		PHALCON_INIT_VAR(user_agent);
-		phalcon_array_fetch_string(&user_agent, server, SL("HTTP_USER_AGENT"), PH_NOISY_CC);
-	} else {
-		PHALCON_INIT_NVAR(user_agent);
-		ZVAL_STRING(user_agent, "", 1);
+	user_agent = phalcon_http_request_server_value(this_ptr, SS("HTTP_USER_AGENT") TSRMLS_CC);
+	if (user_agent) {
+		RETURN_ZVAL(user_agent, 1, 0);
 	}
-	
-	
-	RETURN_CCTOR(user_agent);
+
+	RETURN_STRING("", 1);
 }
 
 /**
@@ -938,6 +1063,7 @@ PHP_METHOD(Phalcon_Http_Request, getUserAgent){
 PHP_METHOD(Phalcon_Http_Request, isMethod){
 
 	zval *methods, *http_method, *is_equals = NULL, *method = NULL;
+	zval *request_method;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -950,7 +1076,16 @@ PHP_METHOD(Phalcon_Http_Request, isMethod){
 	}
 
 	PHALCON_INIT_VAR(http_method);
-	PHALCON_CALL_METHOD(http_method, this_ptr, "getmethod", PH_NO_CHECK);
+	if (phalcon_http_request_native_method(this_ptr, SS("getmethod") TSRMLS_CC)) {
+		request_method = phalcon_http_request_server_value(this_ptr, SS("REQUEST_METHOD") TSRMLS_CC);
+		if (request_method) {
+			ZVAL_ZVAL(http_method, request_method, 1, 0);
+		} else {
+			ZVAL_STRING(http_method, "", 1);
+		}
+	} else {
+		PHALCON_CALL_METHOD(http_method, this_ptr, "getmethod", PH_NO_CHECK);
+	}
 	if (Z_TYPE_P(methods) == IS_STRING) {
 		PHALCON_INIT_VAR(is_equals);
 		is_equal_function(is_equals, methods, http_method TSRMLS_CC);
@@ -999,20 +1134,7 @@ PHP_METHOD(Phalcon_Http_Request, isMethod){
  */
 PHP_METHOD(Phalcon_Http_Request, isPost){
 
-	zval *post, *method, *is_post;
-
-	PHALCON_MM_GROW();
-
-	PHALCON_INIT_VAR(post);
-	ZVAL_STRING(post, "POST", 1);
-	
-	PHALCON_INIT_VAR(method);
-	PHALCON_CALL_METHOD(method, this_ptr, "getmethod", PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_post);
-	is_equal_function(is_post, method, post TSRMLS_CC);
-	
-	RETURN_NCTOR(is_post);
+	phalcon_http_request_is_method(return_value, this_ptr, SL("POST") TSRMLS_CC);
 }
 
 /**
@@ -1023,20 +1145,7 @@ PHP_METHOD(Phalcon_Http_Request, isPost){
  */
 PHP_METHOD(Phalcon_Http_Request, isGet){
 
-	zval *get, *method, *is_get;
-
-	PHALCON_MM_GROW();
-
-	PHALCON_INIT_VAR(get);
-	ZVAL_STRING(get, "GET", 1);
-	
-	PHALCON_INIT_VAR(method);
-	PHALCON_CALL_METHOD(method, this_ptr, "getmethod", PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_get);
-	is_equal_function(is_get, method, get TSRMLS_CC);
-	
-	RETURN_NCTOR(is_get);
+	phalcon_http_request_is_method(return_value, this_ptr, SL("GET") TSRMLS_CC);
 }
 
 /**
@@ -1046,20 +1155,7 @@ PHP_METHOD(Phalcon_Http_Request, isGet){
  */
 PHP_METHOD(Phalcon_Http_Request, isPut){
 
-	zval *put, *method, *is_put;
-
-	PHALCON_MM_GROW();
-
-	PHALCON_INIT_VAR(put);
-	ZVAL_STRING(put, "PUT", 1);
-	
-	PHALCON_INIT_VAR(method);
-	PHALCON_CALL_METHOD(method, this_ptr, "getmethod", PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_put);
-	is_equal_function(is_put, method, put TSRMLS_CC);
-	
-	RETURN_NCTOR(is_put);
+	phalcon_http_request_is_method(return_value, this_ptr, SL("PUT") TSRMLS_CC);
 }
 
 /**
@@ -1069,20 +1165,7 @@ PHP_METHOD(Phalcon_Http_Request, isPut){
  */
 PHP_METHOD(Phalcon_Http_Request, isHead){
 
-	zval *head, *method, *is_head;
-
-	PHALCON_MM_GROW();
-
-	PHALCON_INIT_VAR(head);
-	ZVAL_STRING(head, "HEAD", 1);
-	
-	PHALCON_INIT_VAR(method);
-	PHALCON_CALL_METHOD(method, this_ptr, "getmethod", PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_head);
-	is_equal_function(is_head, method, head TSRMLS_CC);
-	
-	RETURN_NCTOR(is_head);
+	phalcon_http_request_is_method(return_value, this_ptr, SL("HEAD") TSRMLS_CC);
 }
 
 /**
@@ -1092,20 +1175,7 @@ PHP_METHOD(Phalcon_Http_Request, isHead){
  */
 PHP_METHOD(Phalcon_Http_Request, isDelete){
 
-	zval *delete, *method, *is_delete;
-
-	PHALCON_MM_GROW();
-
-	PHALCON_INIT_VAR(delete);
-	ZVAL_STRING(delete, "DELETE", 1);
-	
-	PHALCON_INIT_VAR(method);
-	PHALCON_CALL_METHOD(method, this_ptr, "getmethod", PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_delete);
-	is_equal_function(is_delete, method, delete TSRMLS_CC);
-	
-	RETURN_NCTOR(is_delete);
+	phalcon_http_request_is_method(return_value, this_ptr, SL("DELETE") TSRMLS_CC);
 }
 
 /**
@@ -1115,20 +1185,7 @@ PHP_METHOD(Phalcon_Http_Request, isDelete){
  */
 PHP_METHOD(Phalcon_Http_Request, isOptions){
 
-	zval *options, *method, *is_options;
-
-	PHALCON_MM_GROW();
-
-	PHALCON_INIT_VAR(options);
-	ZVAL_STRING(options, "OPTIONS", 1);
-	
-	PHALCON_INIT_VAR(method);
-	PHALCON_CALL_METHOD(method, this_ptr, "getmethod", PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(is_options);
-	is_equal_function(is_options, method, options TSRMLS_CC);
-	
-	RETURN_NCTOR(is_options);
+	phalcon_http_request_is_method(return_value, this_ptr, SL("OPTIONS") TSRMLS_CC);
 }
 
 /**
@@ -1224,20 +1281,12 @@ PHP_METHOD(Phalcon_Http_Request, getUploadedFiles){
 PHP_METHOD(Phalcon_Http_Request, getHTTPReferer){
 
 	zval *http_referer;
-	zval *g0 = NULL;
-	int eval_int;
-
-	PHALCON_MM_GROW();
 
-	phalcon_get_global(&g0, SL("_SERVER")+1 TSRMLS_CC);
-	eval_int = phalcon_array_isset_string(g0, SS("HTTP_REFERER"));
-	if (eval_int) {
-		PHALCON_INIT_VAR(http_referer);
-		phalcon_array_fetch_string(&http_referer, g0, SL("HTTP_REFERER"), PH_NOISY_CC);
-	
-		RETURN_CCTOR(http_referer);
+	http_referer = phalcon_http_request_server_value(this_ptr, SS("HTTP_REFERER") TSRMLS_CC);
+	if (http_referer) {
+		RETURN_ZVAL(http_referer, 1, 0);
 	}
-	PHALCON_MM_RESTORE();
+
 	RETURN_STRING("", 1);
 }
 
@@ -1250,14 +1299,7 @@ PHP_METHOD(Phalcon_Http_Request, getHTTPReferer){
  */
 PHP_METHOD(Phalcon_Http_Request, _getQualityHeader){
 
-	zval *server_index, *name, *quality_one, *returned_parts;
-	zval *http_server, *pattern, *parts, *two, *dot_comma;
-	zval *part = NULL, *header_parts = NULL, *quality_part = NULL, *quality = NULL;
-	zval *header_name = NULL;
-	HashTable *ah0;
-	HashPosition hp0;
-	zval **hd;
-	int eval_int;
+	zval *server_index, *name, *header;
 
 	PHALCON_MM_GROW();
 
@@ -1266,70 +1308,20 @@ PHP_METHOD(Phalcon_Http_Request, _getQualityHeader){
 		RETURN_NULL();
 	}
 
-	PHALCON_INIT_VAR(quality_one);
-	ZVAL_DOUBLE(quality_one, 1);
-	
-	PHALCON_INIT_VAR(returned_parts);
-	array_init(returned_parts);
-	
-	PHALCON_INIT_VAR(http_server);
-	PHALCON_CALL_METHOD_PARAMS_1(http_server, this_ptr, "getserver", server_index, PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(pattern);
-	ZVAL_STRING(pattern, "/,\\s*/", 1);
-	PHALCON_INIT_VAR(parts);
-	PHALCON_CALL_FUNC_PARAMS_2(parts, "preg_split", pattern, http_server);
-	
-	PHALCON_INIT_VAR(two);
-	ZVAL_LONG(two, 2);
-	
-	PHALCON_INIT_VAR(dot_comma);
-	ZVAL_STRING(dot_comma, ";", 1);
-	
-	if (!phalcon_valid_foreach(parts TSRMLS_CC)) {
-		return;
+	if (Z_TYPE_P(server_index) != IS_STRING) {
+		PHALCON_SEPARATE_PARAM(server_index);
+		convert_to_string(server_index);
 	}
 	
-	ah0 = Z_ARRVAL_P(parts);
-	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	
-	ph_cycle_start_0:
-	
-		if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
-			goto ph_cycle_end_0;
-		}
-	
-		PHALCON_GET_FOREACH_VALUE(part);
-	
-		PHALCON_INIT_NVAR(header_parts);
-		phalcon_fast_explode(header_parts, dot_comma, part TSRMLS_CC);
-		eval_int = phalcon_array_isset_long(header_parts, 1);
-		if (eval_int) {
-			PHALCON_INIT_NVAR(quality_part);
-			phalcon_array_fetch_long(&quality_part, header_parts, 1, PH_NOISY_CC);
-	
-			PHALCON_INIT_NVAR(quality);
-			PHALCON_CALL_FUNC_PARAMS_2(quality, "substr", quality_part, two);
-		} else {
-			PHALCON_CPY_WRT(quality, quality_one);
-		}
-	
-		PHALCON_INIT_NVAR(header_name);
-		phalcon_array_fetch_long(&header_name, header_parts, 0, PH_NOISY_CC);
-	
-		PHALCON_INIT_NVAR(quality_part);
-		array_init(quality_part);
-		phalcon_array_update_zval(&quality_part, name, &header_name, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_update_string(&quality_part, SL("quality"), &quality, PH_COPY | PH_SEPARATE TSRMLS_CC);
-		phalcon_array_append(&returned_parts, quality_part, PH_SEPARATE TSRMLS_CC);
-	
-		zend_hash_move_forward_ex(ah0, &hp0);
-		goto ph_cycle_start_0;
-	
-	ph_cycle_end_0:
+	if (Z_TYPE_P(name) != IS_STRING) {
+		PHALCON_SEPARATE_PARAM(name);
+		convert_to_string(name);
+	}
 	
+	header = phalcon_http_request_server_value(this_ptr, Z_STRVAL_P(server_index), Z_STRLEN_P(server_index) + 1 TSRMLS_CC);
+	phalcon_accept_list(return_value, header, Z_STRVAL_P(name), Z_STRLEN_P(name) TSRMLS_CC);
 	
-	RETURN_CTOR(returned_parts);
+	PHALCON_MM_RESTORE();
 }
 
 /**
@@ -1416,7 +1408,13 @@ PHP_METHOD(Phalcon_Http_Request, _getBestQuality){
  */
 PHP_METHOD(Phalcon_Http_Request, getAcceptableContent){
 
-	zval *accept_header, *quality_index, *quality_header;
+	zval *header, *accept_header, *quality_index, *quality_header;
+
+	if (phalcon_http_request_native_method(this_ptr, SS("_getqualityheader") TSRMLS_CC)) {
+		header = phalcon_http_request_server_value(this_ptr, SS("HTTP_ACCEPT") TSRMLS_CC);
+		phalcon_accept_list(return_value, header, SL("accept") TSRMLS_CC);
+		return;
+	}
 
 	PHALCON_MM_GROW();
 
@@ -1439,9 +1437,15 @@ PHP_METHOD(Phalcon_Http_Request, getAcceptableContent){
  */
 PHP_METHOD(Phalcon_Http_Request, getBestAccept){
 
-	zval *quality_index, *acceptable_content;
+	zval *header, *quality_index, *acceptable_content;
 	zval *best_quality;
 
+	if (phalcon_http_request_native_accept(this_ptr, SS("getacceptablecontent") TSRMLS_CC)) {
+		header = phalcon_http_request_server_value(this_ptr, SS("HTTP_ACCEPT") TSRMLS_CC);
+		phalcon_accept_best(return_value, header TSRMLS_CC);
+		return;
+	}
+
 	PHALCON_MM_GROW();
 
 	PHALCON_INIT_VAR(quality_index);
@@ -1463,7 +1467,13 @@ PHP_METHOD(Phalcon_Http_Request, getBestAccept){
  */
 PHP_METHOD(Phalcon_Http_Request, getClientCharsets){
 
-	zval *charset_header, *quality_index, *quality_charset;
+	zval *header, *charset_header, *quality_index, *quality_charset;
+
+	if (phalcon_http_request_native_method(this_ptr, SS("_getqualityheader") TSRMLS_CC)) {
+		header = phalcon_http_request_server_value(this_ptr, SS("HTTP_ACCEPT_CHARSET") TSRMLS_CC);
+		phalcon_accept_list(return_value, header, SL("charset") TSRMLS_CC);
+		return;
+	}
 
 	PHALCON_MM_GROW();
 
@@ -1486,7 +1496,13 @@ PHP_METHOD(Phalcon_Http_Request, getClientCharsets){
  */
 PHP_METHOD(Phalcon_Http_Request, getBestCharset){
 
-	zval *quality_index, *client_charsets, *best_charset;
+	zval *header, *quality_index, *client_charsets, *best_charset;
+
+	if (phalcon_http_request_native_accept(this_ptr, SS("getclientcharsets") TSRMLS_CC)) {
+		header = phalcon_http_request_server_value(this_ptr, SS("HTTP_ACCEPT_CHARSET") TSRMLS_CC);
+		phalcon_accept_best(return_value, header TSRMLS_CC);
+		return;
+	}
 
 	PHALCON_MM_GROW();
 
@@ -1509,7 +1525,13 @@ PHP_METHOD(Phalcon_Http_Request, getBestCharset){
  */
 PHP_METHOD(Phalcon_Http_Request, getLanguages){
 
-	zval *language_header, *quality_index, *languages;
+	zval *header, *language_header, *quality_index, *languages;
+
+	if (phalcon_http_request_native_method(this_ptr, SS("_getqualityheader") TSRMLS_CC)) {
+		header = phalcon_http_request_server_value(this_ptr, SS("HTTP_ACCEPT_LANGUAGE") TSRMLS_CC);
+		phalcon_accept_list(return_value, header, SL("language") TSRMLS_CC);
+		return;
+	}
 
 	PHALCON_MM_GROW();
 
@@ -1532,7 +1554,13 @@ PHP_METHOD(Phalcon_Http_Request, getLanguages){
  */
 PHP_METHOD(Phalcon_Http_Request, getBestLanguage){
 
-	zval *languages, *quality_index, *best_language;
+	zval *header, *languages, *quality_index, *best_language;
+
+	if (phalcon_http_request_native_accept(this_ptr, SS("getlanguages") TSRMLS_CC)) {
+		header = phalcon_http_request_server_value(this_ptr, SS("HTTP_ACCEPT_LANGUAGE") TSRMLS_CC);
+		phalcon_accept_best(return_value, header TSRMLS_CC);
+		return;
+	}
 
 	PHALCON_MM_GROW();
 
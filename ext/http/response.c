@@ -62,6 +62,8 @@ PHALCON_INIT_CLASS(Phalcon_Http_Response){
 	PHALCON_REGISTER_CLASS(Phalcon\\Http, Response, http_response, phalcon_http_response_method_entry, 0);
 
 	zend_declare_property_bool(phalcon_http_response_ce, SL("_sent"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_http_response_ce, SL("_headersSent"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_http_response_ce, SL("_cookiesSent"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_string(phalcon_http_response_ce, SL("_content"), "", ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_http_response_ce, SL("_headers"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_http_response_ce, SL("_cookies"), ZEND_ACC_PROTECTED TSRMLS_CC);
@@ -592,6 +594,29 @@ PHP_METHOD(Phalcon_Http_Response, sendHeaders){
 		PHALCON_CALL_METHOD_NORETURN(headers, "send", PH_NO_CHECK);
 	}
 	
+	phalcon_update_property_bool(this_ptr, SL("_headersSent"), 1 TSRMLS_CC);
+	
+	RETURN_CTOR(this_ptr);
+}
+
+/**
+ * Sends cookies to the client
+ *
+ * @return Phalcon\Http\ResponseInterface
+ */
+PHP_METHOD(Phalcon_Http_Response, sendCookies){
+
+	zval *cookies;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(cookies);
+	phalcon_read_property(&cookies, this_ptr, SL("_cookies"), PH_NOISY_CC);
+	if (Z_TYPE_P(cookies) != IS_NULL) {
+		PHALCON_CALL_METHOD_NORETURN(cookies, "send", PH_NO_CHECK);
+	}
+	
+	phalcon_update_property_bool(this_ptr, SL("_cookiesSent"), 1 TSRMLS_CC);
 	
 	RETURN_CTOR(this_ptr);
 }
@@ -603,7 +628,8 @@ PHP_METHOD(Phalcon_Http_Response, sendHeaders){
  */
 PHP_METHOD(Phalcon_Http_Response, send){
 
-	zval *sent, *headers, *cookies, *content;
+	zval *sent, *headers_sent, *headers, *cookies_sent, *cookies;
+	zval *content;
 
 	PHALCON_MM_GROW();
 
@@ -611,18 +637,26 @@ PHP_METHOD(Phalcon_Http_Response, send){
 	phalcon_read_property(&sent, this_ptr, SL("_sent"), PH_NOISY_CC);
 	if (PHALCON_IS_FALSE(sent)) {
 		/** 
-		 * Sent headers
+		 * Sent headers, they could be already sent by a streamed view
 		 */
-		PHALCON_INIT_VAR(headers);
-		phalcon_read_property(&headers, this_ptr, SL("_headers"), PH_NOISY_CC);
-		if (Z_TYPE_P(headers) != IS_NULL) {
-			PHALCON_CALL_METHOD_NORETURN(headers, "send", PH_NO_CHECK);
+		PHALCON_INIT_VAR(headers_sent);
+		phalcon_read_property(&headers_sent, this_ptr, SL("_headersSent"), PH_NOISY_CC);
+		if (PHALCON_IS_FALSE(headers_sent)) {
+			PHALCON_INIT_VAR(headers);
+			phalcon_read_property(&headers, this_ptr, SL("_headers"), PH_NOISY_CC);
+			if (Z_TYPE_P(headers) != IS_NULL) {
+				PHALCON_CALL_METHOD_NORETURN(headers, "send", PH_NO_CHECK);
+			}
 		}
 	
-		PHALCON_INIT_VAR(cookies);
-		phalcon_read_property(&cookies, this_ptr, SL("_cookies"), PH_NOISY_CC);
-		if (Z_TYPE_P(cookies) != IS_NULL) {
-			PHALCON_CALL_METHOD_NORETURN(cookies, "send", PH_NO_CHECK);
+		PHALCON_INIT_VAR(cookies_sent);
+		phalcon_read_property(&cookies_sent, this_ptr, SL("_cookiesSent"), PH_NOISY_CC);
+		if (PHALCON_IS_FALSE(cookies_sent)) {
+			PHALCON_INIT_VAR(cookies);
+			phalcon_read_property(&cookies, this_ptr, SL("_cookies"), PH_NOISY_CC);
+			if (Z_TYPE_P(cookies) != IS_NULL) {
+				PHALCON_CALL_METHOD_NORETURN(cookies, "send", PH_NO_CHECK);
+			}
 		}
 	
 		/** 
@@ -0,0 +1,293 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#include "php.h"
+#include "php_phalcon.h"
+
+#include "Zend/zend_strtod.h"
+
+#include "kernel/main.h"
+#include "kernel/accept.h"
+
+#define PHALCON_ACCEPT_IS_OWS(c) ((c) == ' ' || (c) == '\t')
+
+/**
+ * Parses an Accept, Accept-Charset, Accept-Encoding or Accept-Language header (RFC 7231, 5.3).
+ * Elements are split on commas outside quoted strings, the value of an element is the text before
+ * its first ';' and its quality the "q" parameter, 1 if it's missing
+ */
+static phalcon_accept_header *phalcon_accept_parse(const char *value, unsigned int length, int persistent){
+
+	phalcon_accept_header *header;
+	phalcon_accept_item *item;
+	const char *cursor, *end, *element, *element_end, *name_end, *param, *param_end;
+	unsigned int capacity = 1, i;
+	int quoted;
+	double quality;
+
+	for (i = 0; i < length; i++) {
+		if (value[i] == ',') {
+			capacity++;
+		}
+	}
+
+	header = pemalloc(sizeof(phalcon_accept_header), persistent);
+	header->value = pemalloc(length + 1, persistent);
+	memcpy(header->value, value, length);
+	header->value[length] = '\0';
+	header->value_length = length;
+	header->hash = zend_inline_hash_func(value, length + 1);
+	header->hits = 0;
+	header->count = 0;
+	header->best = 0;
+	header->items = pemalloc(sizeof(phalcon_accept_item) * capacity, persistent);
+
+	cursor = value;
+	end = value + length;
+	while (cursor < end) {
+
+		/**
+		 * Find the end of the element, commas inside quoted strings don't count
+		 */
+		element = cursor;
+		quoted = 0;
+		while (cursor < end && (quoted || *cursor != ',')) {
+			if (*cursor == '"') {
+				quoted = !quoted;
+			} else if (*cursor == '\\' && quoted && cursor + 1 < end) {
+				cursor++;
+			}
+			cursor++;
+		}
+		element_end = cursor;
+		cursor++;
+
+		while (element < element_end && PHALCON_ACCEPT_IS_OWS(*element)) {
+			element++;
+		}
+
+		name_end = element;
+		while (name_end < element_end && *name_end != ';') {
+			name_end++;
+		}
+
+		param = name_end;
+		while (name_end > element && PHALCON_ACCEPT_IS_OWS(*(name_end - 1))) {
+			name_end--;
+		}
+
+		/**
+		 * Empty list elements are allowed by the grammar and ignored
+		 */
+		if (name_end == element) {
+			continue;
+		}
+
+		quality = 1;
+		while (param < element_end) {
+
+			param++;
+			while (param < element_end && PHALCON_ACCEPT_IS_OWS(*param)) {
+				param++;
+			}
+
+			param_end = param;
+			while (param_end < element_end && *param_end != ';') {
+				param_end++;
+			}
+
+			if (param_end - param >= 2 && (*param == 'q' || *param == 'Q')) {
+				const char *equals = param + 1;
+				while (equals < param_end && PHALCON_ACCEPT_IS_OWS(*equals)) {
+					equals++;
+				}
+				if (equals < param_end && *equals == '=') {
+					equals++;
+					while (equals < param_end && PHALCON_ACCEPT_IS_OWS(*equals)) {
+						equals++;
+					}
+					quality = zend_strtod(equals, NULL);
+					if (quality < 0) {
+						quality = 0;
+					} else if (quality > 1) {
+						quality = 1;
+					}
+					break;
+				}
+			}
+
+			param = param_end;
+		}
+
+		item = &header->items[header->count];
+		item->name = pemalloc(name_end - element + 1, persistent);
+		memcpy(item->name, element, name_end - element);
+		item->name[name_end - element] = '\0';
+		item->name_length = name_end - element;
+		item->quality = quality;
+
+		/**
+		 * The first element with the highest quality is the best one
+		 */
+		if (header->count && quality > header->items[header->best].quality) {
+			header->best = header->count;
+		}
+
+		header->count++;
+	}
+
+	return header;
+}
+
+static void phalcon_accept_free(phalcon_accept_header *header, int persistent){
+
+	unsigned int i;
+
+	for (i = 0; i < header->count; i++) {
+		pefree(header->items[i].name, persistent);
+	}
+
+	pefree(header->items, persistent);
+	pefree(header->value, persistent);
+	pefree(header, persistent);
+}
+
+/**
+ * Returns the parsed form of a header value. Short values are kept in a small per-process cache
+ * because clients send a handful of distinct values, when the cache is full the least used entry
+ * is replaced. Values that aren't cached are returned as a request allocation the caller must
+ * release with phalcon_accept_release
+ */
+static phalcon_accept_header *phalcon_accept_fetch(const char *value, unsigned int length TSRMLS_DC){
+
+	phalcon_accept_header *header, **cache;
+	ulong hash;
+	unsigned int i, victim = 0;
+
+	if (length > PHALCON_ACCEPT_CACHE_MAX_LENGTH) {
+		return phalcon_accept_parse(value, length, 0);
+	}
+
+	cache = PHALCON_GLOBAL(accept_cache);
+	hash = zend_inline_hash_func(value, length + 1);
+
+	for (i = 0; i < PHALCON_ACCEPT_CACHE_SIZE; i++) {
+		header = cache[i];
+		if (!header) {
+			victim = i;
+			break;
+		}
+		if (header->hash == hash && header->value_length == length && !memcmp(header->value, value, length)) {
+			header->hits++;
+			return header;
+		}
+		if (header->hits < cache[victim]->hits) {
+			victim = i;
+		}
+	}
+
+	if (cache[victim]) {
+		phalcon_accept_free(cache[victim], 1);
+	}
+
+	header = phalcon_accept_parse(value, length, 1);
+	header->hits = 1;
+	cache[victim] = header;
+
+	return header;
+}
+
+static void phalcon_accept_release(phalcon_accept_header *header){
+
+	if (header->value_length > PHALCON_ACCEPT_CACHE_MAX_LENGTH) {
+		phalcon_accept_free(header, 0);
+	}
+}
+
+/**
+ * Builds the list of the elements in a header: array(array($name => 'text/html', 'quality' => 1.0), ...)
+ * in the order the client sent them. A missing header produces an empty list
+ */
+void phalcon_accept_list(zval *return_value, zval *value, char *name, unsigned int name_length TSRMLS_DC){
+
+	phalcon_accept_header *header;
+	phalcon_accept_item *item;
+	zval *element;
+	unsigned int i;
+
+	array_init(return_value);
+
+	if (!value || Z_TYPE_P(value) != IS_STRING || !Z_STRLEN_P(value)) {
+		return;
+	}
+
+	header = phalcon_accept_fetch(Z_STRVAL_P(value), Z_STRLEN_P(value) TSRMLS_CC);
+
+	for (i = 0; i < header->count; i++) {
+		item = &header->items[i];
+
+		MAKE_STD_ZVAL(element);
+		array_init_size(element, 2);
+		add_assoc_stringl_ex(element, name, name_length + 1, item->name, item->name_length, 1);
+		add_assoc_double_ex(element, SS("quality"), item->quality);
+		add_next_index_zval(return_value, element);
+	}
+
+	phalcon_accept_release(header);
+}
+
+/**
+ * Returns the element with the highest quality in a header, the first one wins on ties. An empty
+ * string is returned if the header is missing
+ */
+void phalcon_accept_best(zval *return_value, zval *value TSRMLS_DC){
+
+	phalcon_accept_header *header;
+	phalcon_accept_item *item;
+
+	if (!value || Z_TYPE_P(value) != IS_STRING || !Z_STRLEN_P(value)) {
+		RETURN_EMPTY_STRING();
+	}
+
+	header = phalcon_accept_fetch(Z_STRVAL_P(value), Z_STRLEN_P(value) TSRMLS_CC);
+
+	if (header->count) {
+		item = &header->items[header->best];
+		RETVAL_STRINGL(item->name, item->name_length, 1);
+	} else {
+		RETVAL_EMPTY_STRING();
+	}
+
+	phalcon_accept_release(header);
+}
+
+/**
+ * Releases the cached headers, called when the module globals are destroyed
+ */
+void phalcon_accept_cache_clean(phalcon_accept_header **cache){
+
+	unsigned int i;
+
+	for (i = 0; i < PHALCON_ACCEPT_CACHE_SIZE; i++) {
+		if (cache[i]) {
+			phalcon_accept_free(cache[i], 1);
+			cache[i] = NULL;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/** Values longer than this are parsed on every call instead of being cached */
+#define PHALCON_ACCEPT_CACHE_MAX_LENGTH 512
+
+typedef struct _phalcon_accept_item {
+	char *name;
+	unsigned int name_length;
+	double quality;
+} phalcon_accept_item;
+
+typedef struct _phalcon_accept_header {
+	char *value;
+	unsigned int value_length;
+	ulong hash;
+	ulong hits;
+	unsigned int count;
+	unsigned int best;
+	phalcon_accept_item *items;
+} phalcon_accept_header;
+
+extern void phalcon_accept_list(zval *return_value, zval *value, char *name, unsigned int name_length TSRMLS_DC);
+extern void phalcon_accept_best(zval *return_value, zval *value TSRMLS_DC);
+extern void phalcon_accept_cache_clean(phalcon_accept_header **cache);
@@ -26,6 +26,7 @@
 #include "php_main.h"
 #include "main/php_streams.h"
 #include "ext/standard/php_filestat.h"
+#include "ext/standard/php_lcg.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -87,4 +88,50 @@ void phalcon_fast_filemtime(zval *return_value, zval *filename TSRMLS_DC){
 	}
 
 	php_stat(Z_STRVAL_P(filename), (php_stat_len) Z_STRLEN_P(filename), FS_MTIME, return_value TSRMLS_CC);
-}
\ No newline at end of file
+}
+/**
+ * Writes a file atomically. The data is written to a temporary file in the same directory
+ * which is renamed to the final name, so readers never see a partially written file
+ */
+int phalcon_file_put_contents_atomic(zval *filename, zval *data TSRMLS_DC){
+
+	php_stream *stream;
+	char *temp_name;
+	size_t written;
+
+	if (Z_TYPE_P(filename) != IS_STRING || Z_TYPE_P(data) != IS_STRING) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Invalid arguments supplied for file_put_contents_atomic()");
+		return FAILURE;
+	}
+
+	if (php_check_open_basedir(Z_STRVAL_P(filename) TSRMLS_CC)) {
+		return FAILURE;
+	}
+
+	spprintf(&temp_name, 0, "%s.%ld.%lx.tmp", Z_STRVAL_P(filename), (long) getpid(), (unsigned long) (php_combined_lcg(TSRMLS_C) * 0xFFFFFFF));
+
+	stream = php_stream_open_wrapper(temp_name, "wb", REPORT_ERRORS, NULL);
+	if (!stream) {
+		efree(temp_name);
+		return FAILURE;
+	}
+
+	written = php_stream_write(stream, Z_STRVAL_P(data), Z_STRLEN_P(data));
+	php_stream_close(stream);
+
+	if (written != (size_t) Z_STRLEN_P(data)) {
+		VCWD_UNLINK(temp_name);
+		efree(temp_name);
+		return FAILURE;
+	}
+
+	if (VCWD_RENAME(temp_name, Z_STRVAL_P(filename))) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Cannot rename %s to %s", temp_name, Z_STRVAL_P(filename));
+		VCWD_UNLINK(temp_name);
+		efree(temp_name);
+		return FAILURE;
+	}
+
+	efree(temp_name);
+	return SUCCESS;
+}
@@ -18,4 +18,5 @@
 */
 
 extern int phalcon_file_exists(zval *filename TSRMLS_DC);
-extern int phalcon_compare_mtime(zval *filename1, zval *filename2 TSRMLS_DC);
\ No newline at end of file
+extern int phalcon_compare_mtime(zval *filename1, zval *filename2 TSRMLS_DC);
+extern int phalcon_file_put_contents_atomic(zval *filename, zval *data TSRMLS_DC);
@@ -0,0 +1,221 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#include "php.h"
+#include "php_phalcon.h"
+
+#include "kernel/main.h"
+#include "kernel/filter.h"
+
+static const char *phalcon_filter_names[] = {
+	NULL, "email", "int", "string", "float", "alphanum", "trim", "striptags", "lower", "upper"
+};
+
+/**
+ * Returns the code of a built-in filter or 0 if the name isn't a built-in filter
+ */
+int phalcon_filter_lookup(const char *name, unsigned int name_length){
+
+	int i;
+
+	for (i = PHALCON_FILTER_EMAIL; i <= PHALCON_FILTER_UPPER; i++) {
+		if (strlen(phalcon_filter_names[i]) == name_length && !memcmp(phalcon_filter_names[i], name, name_length)) {
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Returns the name of a built-in filter
+ */
+const char *phalcon_filter_name(int filter){
+
+	if (filter < PHALCON_FILTER_EMAIL || filter > PHALCON_FILTER_UPPER) {
+		return NULL;
+	}
+
+	return phalcon_filter_names[filter];
+}
+
+/**
+ * Checks if a byte is kept by a character-class sanitizer, these are the same classes used
+ * by FILTER_SANITIZE_NUMBER_INT, FILTER_SANITIZE_NUMBER_FLOAT + FILTER_FLAG_ALLOW_FRACTION and
+ * FILTER_SANITIZE_EMAIL (the 'email' filter additionally removes single quotes)
+ */
+static int phalcon_filter_keep(unsigned char ch, int filter){
+
+	if (ch >= '0' && ch <= '9') {
+		return 1;
+	}
+
+	switch (filter) {
+
+		case PHALCON_FILTER_INT:
+			return ch == '+' || ch == '-';
+
+		case PHALCON_FILTER_FLOAT:
+			return ch == '+' || ch == '-' || ch == '.';
+
+		case PHALCON_FILTER_ALPHANUM:
+			return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+
+		case PHALCON_FILTER_EMAIL:
+			if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')) {
+				return 1;
+			}
+			return ch != '\0' && strchr("!#$%&*+-=?^_`{|}~@.[]", ch) != NULL;
+	}
+
+	return 0;
+}
+
+/**
+ * Removes the bytes not allowed by a character-class sanitizer
+ */
+static void phalcon_filter_chars(zval *return_value, const char *str, unsigned int length, int filter){
+
+	unsigned int i, j;
+	char *filtered;
+
+	for (i = 0; i < length; i++) {
+		if (!phalcon_filter_keep((unsigned char) str[i], filter)) {
+			break;
+		}
+	}
+
+	if (i == length) {
+		ZVAL_STRINGL(return_value, str, length, 1);
+		return;
+	}
+
+	filtered = emalloc(length + 1);
+	memcpy(filtered, str, i);
+	for (j = i; i < length; i++) {
+		if (phalcon_filter_keep((unsigned char) str[i], filter)) {
+			filtered[j++] = str[i];
+		}
+	}
+	filtered[j] = '\0';
+
+	ZVAL_STRINGL(return_value, filtered, j, 0);
+}
+
+/**
+ * Strips the same whitespace trim() strips by default
+ */
+static void phalcon_filter_trim(zval *return_value, const char *str, unsigned int length){
+
+	unsigned int start = 0, end = length;
+
+	while (start < end && (str[start] == ' ' || str[start] == '\t' || str[start] == '\n' || str[start] == '\r' || str[start] == '\0' || str[start] == '\x0B')) {
+		start++;
+	}
+
+	while (end > start && (str[end - 1] == ' ' || str[end - 1] == '\t' || str[end - 1] == '\n' || str[end - 1] == '\r' || str[end - 1] == '\0' || str[end - 1] == '\x0B')) {
+		end--;
+	}
+
+	ZVAL_STRINGL(return_value, str + start, end - start, 1);
+}
+
+/**
+ * Changes the case of an ASCII string, returns FAILURE for multi-byte strings so they can be
+ * handled by mbstring
+ */
+static int phalcon_filter_case(zval *return_value, const char *str, unsigned int length, int filter){
+
+	unsigned int i;
+	char *converted;
+
+	for (i = 0; i < length; i++) {
+		if ((unsigned char) str[i] >= 0x80) {
+			return FAILURE;
+		}
+	}
+
+	converted = estrndup(str, length);
+	for (i = 0; i < length; i++) {
+		if (filter == PHALCON_FILTER_LOWER) {
+			if (converted[i] >= 'A' && converted[i] <= 'Z') {
+				converted[i] += 32;
+			}
+		} else {
+			if (converted[i] >= 'a' && converted[i] <= 'z') {
+				converted[i] -= 32;
+			}
+		}
+	}
+
+	ZVAL_STRINGL(return_value, converted, length, 0);
+	return SUCCESS;
+}
+
+/**
+ * Applies a built-in filter without leaving the extension. Only strings and numbers are handled,
+ * FAILURE is returned for any value or filter that must go through the PHP functions
+ */
+int phalcon_filter_native(zval *return_value, zval *value, int filter){
+
+	zval copy;
+	int use_copy = 0, status = SUCCESS;
+
+	switch (Z_TYPE_P(value)) {
+		case IS_STRING:
+			break;
+		case IS_LONG:
+		case IS_DOUBLE:
+			zend_make_printable_zval(value, &copy, &use_copy);
+			if (use_copy) {
+				value = &copy;
+			}
+			break;
+		default:
+			return FAILURE;
+	}
+
+	switch (filter) {
+
+		case PHALCON_FILTER_EMAIL:
+		case PHALCON_FILTER_INT:
+		case PHALCON_FILTER_FLOAT:
+		case PHALCON_FILTER_ALPHANUM:
+			phalcon_filter_chars(return_value, Z_STRVAL_P(value), Z_STRLEN_P(value), filter);
+			break;
+
+		case PHALCON_FILTER_TRIM:
+			phalcon_filter_trim(return_value, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			break;
+
+		case PHALCON_FILTER_LOWER:
+		case PHALCON_FILTER_UPPER:
+			status = phalcon_filter_case(return_value, Z_STRVAL_P(value), Z_STRLEN_P(value), filter);
+			break;
+
+		default:
+			status = FAILURE;
+	}
+
+	if (use_copy) {
+		zval_dtor(&copy);
+	}
+
+	return status;
+}
@@ -0,0 +1,33 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/** Built-in sanitizers */
+#define PHALCON_FILTER_EMAIL 1
+#define PHALCON_FILTER_INT 2
+#define PHALCON_FILTER_STRING 3
+#define PHALCON_FILTER_FLOAT 4
+#define PHALCON_FILTER_ALPHANUM 5
+#define PHALCON_FILTER_TRIM 6
+#define PHALCON_FILTER_STRIPTAGS 7
+#define PHALCON_FILTER_LOWER 8
+#define PHALCON_FILTER_UPPER 9
+
+extern int phalcon_filter_lookup(const char *name, unsigned int name_length);
+extern const char *phalcon_filter_name(int filter);
+extern int phalcon_filter_native(zval *return_value, zval *value, int filter);
@@ -28,6 +28,7 @@
 #include "kernel/main.h"
 #include "kernel/memory.h"
 #include "kernel/fcall.h"
+#include "kernel/accept.h"
 
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
@@ -38,12 +39,36 @@
 void php_phalcon_init_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC){
     phalcon_globals->start_memory = NULL;
 	phalcon_globals->active_memory = NULL;
+	memset(phalcon_globals->accept_cache, 0, sizeof(phalcon_globals->accept_cache));
+	phalcon_globals->config_cache = NULL;
+	phalcon_globals->translate_cache = NULL;
+	phalcon_globals->trace_active = 0;
+	phalcon_globals->trace_spans = NULL;
+	phalcon_globals->trace_count = 0;
+	phalcon_globals->trace_size = 0;
 	#ifndef PHALCON_RELEASE
 	phalcon_globals->phalcon_stack_stats = 0;
 	phalcon_globals->phalcon_number_grows = 0;
 	#endif
 }
 
+/**
+ * Releases the memory held by the globals when the module or the thread shuts down
+ */
+void php_phalcon_destroy_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC){
+	phalcon_accept_cache_clean(phalcon_globals->accept_cache);
+	if (phalcon_globals->config_cache) {
+		zend_hash_destroy(phalcon_globals->config_cache);
+		pefree(phalcon_globals->config_cache, 1);
+		phalcon_globals->config_cache = NULL;
+	}
+	if (phalcon_globals->translate_cache) {
+		zend_hash_destroy(phalcon_globals->translate_cache);
+		pefree(phalcon_globals->translate_cache, 1);
+		phalcon_globals->translate_cache = NULL;
+	}
+}
+
 /**
  * Initializes internal interface with extends
  */
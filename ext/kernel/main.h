@@ -50,6 +50,7 @@ extern PHPAPI zend_class_entry *spl_ce_SeekableIterator;
 
 /** Startup functions */
 extern void php_phalcon_init_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC);
+extern void php_phalcon_destroy_globals(zend_phalcon_globals *phalcon_globals TSRMLS_DC);
 extern zend_class_entry *phalcon_register_internal_interface_ex(zend_class_entry *orig_class_entry, char *parent_name TSRMLS_DC);
 
 /** Globals functions */
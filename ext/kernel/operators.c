@@ -274,4 +274,31 @@ void phalcon_cast(zval *result, zval *var, zend_uint type){
 			break;
 	}
 
-}
\ No newline at end of file
+}
+/**
+ * Returns the long value of a zval without modifying it
+ */
+long phalcon_get_intval(zval *op){
+
+	long long_value;
+	double double_value;
+
+	switch (Z_TYPE_P(op)) {
+		case IS_LONG:
+			return Z_LVAL_P(op);
+		case IS_BOOL:
+			return Z_BVAL_P(op);
+		case IS_DOUBLE:
+			return (long) Z_DVAL_P(op);
+		case IS_STRING:
+			switch (is_numeric_string(Z_STRVAL_P(op), Z_STRLEN_P(op), &long_value, &double_value, 0)) {
+				case IS_LONG:
+					return long_value;
+				case IS_DOUBLE:
+					return (long) double_value;
+			}
+			return 0;
+	}
+
+	return 0;
+}
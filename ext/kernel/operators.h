@@ -46,3 +46,4 @@ extern int phalcon_is_smaller_strict_long(zval *op1, long op2 TSRMLS_DC);
 extern int phalcon_is_smaller_or_equal_strict_long(zval *op1, long op2 TSRMLS_DC);
 
 extern void phalcon_cast(zval *result, zval *var, zend_uint type);
+extern long phalcon_get_intval(zval *op);
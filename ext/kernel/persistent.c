@@ -24,35 +24,245 @@
 #include "php.h"
 #include "php_phalcon.h"
 
-/* represents a connection to a database */
-struct _phalcon_persist_obj {
-	char *data;
-} phalcon_persist_obj;
+#include "kernel/main.h"
+#include "kernel/persistent.h"
 
-int phalcon_persistent_fetch(zval *return_value, zval *service TSRMLS_DC){
-	zend_rsrc_list_entry *le;
+/**
+ * Pools live in the persistent list of the worker, they survive the requests like the PDO
+ * persistent handlers they track. The handlers themselves are kept by PDO, a pool only tells
+ * which of the persistent ids of a descriptor are free, warm or stale
+ */
+#define PHALCON_PERSISTENT_PREFIX "phalcon_pool:"
+
+static int phalcon_persistent_le_pool;
 
-	/* try to find if we already have this link in our persistent list */
-	if (zend_hash_find(&EG(persistent_list), Z_STRVAL_P(service), Z_STRLEN_P(service)+1, (void **) &le)==FAILURE) {
+static void phalcon_persistent_pool_dtor(zend_rsrc_list_entry *rsrc TSRMLS_DC){
 
+	phalcon_persistent_pool *pool = (phalcon_persistent_pool *) rsrc->ptr;
+
+	if (pool) {
+		pefree(pool->slots, 1);
+		pefree(pool, 1);
+		rsrc->ptr = NULL;
 	}
 }
 
-int phalcon_persistent_store(zval *service, zval *object TSRMLS_DC){
+/**
+ * Registers the type of the pools in the persistent list
+ */
+void phalcon_persistent_startup(int module_number){
+	phalcon_persistent_le_pool = zend_register_list_destructors_ex(NULL, phalcon_persistent_pool_dtor, "Phalcon connection pool", module_number);
+}
 
-	//pdo_dbh_t *dbh = NULL;
+/**
+ * Returns the pool of a key, NULL if it doesn't exist
+ */
+phalcon_persistent_pool *phalcon_persistent_pool_find(const char *key, unsigned int key_length TSRMLS_DC){
 
-	//zend_object_store_set_object(object, dbh TSRMLS_CC);
+	zend_rsrc_list_entry *le;
+	char *hash_key;
+	int hash_key_length, status;
+
+	hash_key_length = spprintf(&hash_key, 0, "%s%.*s", PHALCON_PERSISTENT_PREFIX, key_length, key);
+	status = zend_hash_find(&EG(persistent_list), hash_key, hash_key_length + 1, (void **) &le);
+	efree(hash_key);
 
+	if (status == SUCCESS && Z_TYPE_P(le) == phalcon_persistent_le_pool) {
+		return (phalcon_persistent_pool *) le->ptr;
+	}
 
+	return NULL;
+}
+
+/**
+ * Returns the pool of a key creating it if needed. The size can change between requests,
+ * slots beyond the size are not leased anymore but PDO keeps their handlers
+ */
+phalcon_persistent_pool *phalcon_persistent_pool_get(const char *key, unsigned int key_length, unsigned int size TSRMLS_DC){
+
+	phalcon_persistent_pool *pool;
 	zend_rsrc_list_entry new_le;
+	char *hash_key;
+	int hash_key_length;
+
+	if (size < 1) {
+		size = 1;
+	}
+
+	pool = phalcon_persistent_pool_find(key, key_length TSRMLS_CC);
+	if (pool) {
+		if (size > pool->capacity) {
+			pool->slots = perealloc(pool->slots, size * sizeof(phalcon_persistent_slot), 1);
+			memset(pool->slots + pool->capacity, 0, (size - pool->capacity) * sizeof(phalcon_persistent_slot));
+			pool->capacity = size;
+		}
+		pool->size = size;
+		return pool;
+	}
+
+	pool = pecalloc(1, sizeof(phalcon_persistent_pool), 1);
+	pool->slots = pecalloc(size, sizeof(phalcon_persistent_slot), 1);
+	pool->size = size;
+	pool->capacity = size;
+
+	hash_key_length = spprintf(&hash_key, 0, "%s%.*s", PHALCON_PERSISTENT_PREFIX, key_length, key);
+
+	new_le.type = phalcon_persistent_le_pool;
+	new_le.ptr = pool;
+	if (zend_hash_update(&EG(persistent_list), hash_key, hash_key_length + 1, (void *) &new_le, sizeof(zend_rsrc_list_entry), NULL) == FAILURE) {
+		efree(hash_key);
+		pefree(pool->slots, 1);
+		pefree(pool, 1);
+		return NULL;
+	}
+
+	efree(hash_key);
+	return pool;
+}
+
+/**
+ * Leases a slot of the pool for the current request. The most recently used free slot is
+ * preferred so the warm connections are reused and the cold ones expire. Returns -1 if all
+ * the slots are leased, the state tells if the handler of the slot is new, warm or was idle
+ * for too long
+ */
+int phalcon_persistent_acquire(phalcon_persistent_pool *pool, long idle_timeout, int *state){
+
+	phalcon_persistent_slot *slot;
+	unsigned int i;
+	int best = -1;
+	time_t now;
+
+	for (i = 0; i < pool->size; i++) {
+		slot = &pool->slots[i];
+		if (slot->leased) {
+			continue;
+		}
+		if (best < 0 || slot->last_used > pool->slots[best].last_used) {
+			best = i;
+		}
+	}
+
+	if (best < 0) {
+		pool->exhausted++;
+		return -1;
+	}
+
+	slot = &pool->slots[best];
+	now = time(NULL);
 
-	Z_TYPE(new_le) = 1;
-	new_le.ptr = pestrdup("hello", 1);
-	if (zend_hash_update(&EG(persistent_list), Z_STRVAL_P(service), Z_STRLEN_P(service)+1, (void *) &new_le, sizeof(zend_rsrc_list_entry), NULL)==FAILURE) {
-		//goto err;
+	if (!slot->last_used) {
+		*state = PHALCON_PERSISTENT_NEW;
+		pool->misses++;
+	} else {
+		if (idle_timeout > 0 && (now - slot->last_used) > idle_timeout) {
+			*state = PHALCON_PERSISTENT_EXPIRED;
+			pool->expired++;
+			pool->misses++;
+		} else {
+			*state = PHALCON_PERSISTENT_REUSED;
+			pool->hits++;
+		}
 	}
 
-	//phalcon_persistent_store
+	slot->leased = 1;
+	slot->last_used = now;
+	slot->uses++;
+
+	return best;
+}
 
+/**
+ * Returns a slot to the pool
+ */
+void phalcon_persistent_release(phalcon_persistent_pool *pool, int slot){
+
+	if (slot >= 0 && (unsigned int) slot < pool->capacity) {
+		pool->slots[slot].leased = 0;
+		pool->slots[slot].last_used = time(NULL);
+	}
+}
+
+/**
+ * Frees every slot leased by the request, adapters don't need to be closed explicitly
+ */
+void phalcon_persistent_release_all(TSRMLS_D){
+
+	zend_rsrc_list_entry *le;
+	phalcon_persistent_pool *pool;
+	HashPosition pos;
+	unsigned int i;
+	time_t now = 0;
+
+	zend_hash_internal_pointer_reset_ex(&EG(persistent_list), &pos);
+	while (zend_hash_get_current_data_ex(&EG(persistent_list), (void **) &le, &pos) == SUCCESS) {
+		if (Z_TYPE_P(le) == phalcon_persistent_le_pool && le->ptr) {
+			pool = (phalcon_persistent_pool *) le->ptr;
+			for (i = 0; i < pool->capacity; i++) {
+				if (pool->slots[i].leased) {
+					if (!now) {
+						now = time(NULL);
+					}
+					pool->slots[i].leased = 0;
+					pool->slots[i].last_used = now;
+				}
+			}
+		}
+		zend_hash_move_forward_ex(&EG(persistent_list), &pos);
+	}
+}
+
+/**
+ * Returns the statistics of the pools of the worker indexed by their keys
+ */
+void phalcon_persistent_stats(zval *return_value TSRMLS_DC){
+
+	zend_rsrc_list_entry *le;
+	phalcon_persistent_pool *pool;
+	HashPosition pos;
+	zval *stats;
+	char *key;
+	uint key_length;
+	ulong index;
+	unsigned int i, open, leased;
+	int prefix_length = sizeof(PHALCON_PERSISTENT_PREFIX) - 1;
+
+	array_init(return_value);
+
+	zend_hash_internal_pointer_reset_ex(&EG(persistent_list), &pos);
+	while (zend_hash_get_current_data_ex(&EG(persistent_list), (void **) &le, &pos) == SUCCESS) {
+
+		if (Z_TYPE_P(le) == phalcon_persistent_le_pool && le->ptr) {
+			if (zend_hash_get_current_key_ex(&EG(persistent_list), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+
+				pool = (phalcon_persistent_pool *) le->ptr;
+
+				open = 0;
+				leased = 0;
+				for (i = 0; i < pool->size; i++) {
+					if (pool->slots[i].last_used) {
+						open++;
+					}
+					if (pool->slots[i].leased) {
+						leased++;
+					}
+				}
+
+				MAKE_STD_ZVAL(stats);
+				array_init_size(stats, 8);
+				add_assoc_long_ex(stats, SS("size"), pool->size);
+				add_assoc_long_ex(stats, SS("open"), open);
+				add_assoc_long_ex(stats, SS("leased"), leased);
+				add_assoc_long_ex(stats, SS("hits"), pool->hits);
+				add_assoc_long_ex(stats, SS("misses"), pool->misses);
+				add_assoc_long_ex(stats, SS("expired"), pool->expired);
+				add_assoc_long_ex(stats, SS("rollbacks"), pool->rollbacks);
+				add_assoc_long_ex(stats, SS("exhausted"), pool->exhausted);
+
+				add_assoc_zval_ex(return_value, key + prefix_length, key_length - prefix_length, stats);
+			}
+		}
+
+		zend_hash_move_forward_ex(&EG(persistent_list), &pos);
+	}
 }
@@ -1,3 +1,55 @@
 
-int phalcon_persistent_store(zval *service, zval *object TSRMLS_DC);
-int phalcon_persistent_fetch(zval *return_value, zval *service TSRMLS_DC);
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+/** Connections a pool keeps per descriptor when the descriptor doesn't set a size */
+#define PHALCON_PERSISTENT_POOL_SIZE 4
+
+/** Seconds a pooled connection can stay unused before it is replaced by a new one */
+#define PHALCON_PERSISTENT_IDLE_TIMEOUT 300
+
+/** States of the handler of a leased slot */
+#define PHALCON_PERSISTENT_NEW 0
+#define PHALCON_PERSISTENT_REUSED 1
+#define PHALCON_PERSISTENT_EXPIRED 2
+
+typedef struct _phalcon_persistent_slot {
+	time_t last_used;
+	unsigned long uses;
+	zend_bool leased;
+} phalcon_persistent_slot;
+
+typedef struct _phalcon_persistent_pool {
+	unsigned int size;
+	unsigned int capacity;
+	phalcon_persistent_slot *slots;
+	unsigned long hits;
+	unsigned long misses;
+	unsigned long expired;
+	unsigned long rollbacks;
+	unsigned long exhausted;
+} phalcon_persistent_pool;
+
+extern void phalcon_persistent_startup(int module_number);
+extern void phalcon_persistent_release_all(TSRMLS_D);
+
+extern phalcon_persistent_pool *phalcon_persistent_pool_get(const char *key, unsigned int key_length, unsigned int size TSRMLS_DC);
+extern phalcon_persistent_pool *phalcon_persistent_pool_find(const char *key, unsigned int key_length TSRMLS_DC);
+extern int phalcon_persistent_acquire(phalcon_persistent_pool *pool, long idle_timeout, int *state);
+extern void phalcon_persistent_release(phalcon_persistent_pool *pool, int slot);
+extern void phalcon_persistent_stats(zval *return_value TSRMLS_DC);
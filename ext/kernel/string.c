@@ -23,8 +23,13 @@
 #include "ext/standard/php_smart_str.h"
 #include "ext/standard/php_string.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "kernel/main.h"
 #include "kernel/memory.h"
+#include "kernel/string.h"
 
 /**
  * Fast call to php strlen
@@ -586,11 +591,14 @@ void phalcon_extract_named_params(zval *return_value, zval *str, zval *matches){
 
 }
 
-zval *phalcon_replace_marker(int named, zval *paths, zval *replacements, ulong *position, char *cursor, char *marker){
+/**
+ * Resolves the name of the replacement that fills a marker in a route pattern. Returns NULL
+ * if the marker isn't valid or the route doesn't have a path at that position
+ */
+static char *phalcon_url_template_key(int named, zval *paths, ulong *position, char *cursor, char *marker, unsigned int *key_length){
 
-	zval **zv, **tmp;
-	int result = FAILURE;
-	unsigned int length, variable_length, ch;
+	zval **zv;
+	unsigned int length, variable_length = 0, ch;
 	char *item = NULL, *cursor_var, *variable = NULL;
 	int not_valid = 0, j;
 
@@ -623,27 +631,20 @@ zval *phalcon_replace_marker(int named, zval *paths, zval *replacements, ulong *
 
 		if (zend_hash_index_exists(Z_ARRVAL_P(paths), *position)) {
 			if (named) {
+				(*position)++;
 				if (variable) {
 					efree(item);
-					item = variable;
-					length = variable_length;
-				}
-				if (zend_hash_exists(Z_ARRVAL_P(replacements), item, length+1)) {
-					if ((result = zend_hash_find(Z_ARRVAL_P(replacements), item, length+1, (void**) &zv)) == SUCCESS) {
-						efree(item);
-						(*position)++;
-						return *zv;
-					}
+					*key_length = variable_length;
+					return variable;
 				}
+				*key_length = length;
+				return item;
 			} else {
-				if ((result = zend_hash_index_find(Z_ARRVAL_P(paths), *position, (void**) &zv)) == SUCCESS) {
+				if (zend_hash_index_find(Z_ARRVAL_P(paths), *position, (void**) &zv) == SUCCESS) {
 					if (Z_TYPE_PP(zv) == IS_STRING) {
-						if (zend_hash_exists(Z_ARRVAL_P(replacements), Z_STRVAL_PP(zv), Z_STRLEN_PP(zv)+1)) {
-							if ((result = zend_hash_find(Z_ARRVAL_P(replacements), Z_STRVAL_PP(zv), Z_STRLEN_PP(zv)+1, (void**) &tmp)) == SUCCESS) {
-								(*position)++;
-								return *tmp;
-							}
-						}
+						(*position)++;
+						*key_length = Z_STRLEN_PP(zv);
+						return estrndup(Z_STRVAL_PP(zv), Z_STRLEN_PP(zv));
 					}
 				}
 			}
@@ -655,25 +656,52 @@ zval *phalcon_replace_marker(int named, zval *paths, zval *replacements, ulong *
 	if (item) {
 		efree(item);
 	}
+	if (variable) {
+		efree(variable);
+	}
 
 	return NULL;
 }
 
 /**
- * Replaces placeholders and named variables with their corresponding values in an array
+ * Adds a slot to a URL template, the literal text collected so far is stored before it
  */
-void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval *replacements TSRMLS_DC){
+static void phalcon_url_template_slot(zval *template, smart_str *literal, char *key, unsigned int key_length){
 
-	char *cursor, *marker;
-	unsigned int ch, bracket_count = 0, parentheses_count = 0, intermediate;
-	smart_str route_str = {0};
+	if (!key) {
+		return;
+	}
+
+	smart_str_0(literal);
+	if (literal->len) {
+		add_next_index_stringl(template, literal->c, literal->len, 0);
+	} else {
+		smart_str_free(literal);
+		add_next_index_stringl(template, "", 0, 1);
+	}
+	literal->c = NULL;
+	literal->len = 0;
+	literal->a = 0;
+
+	add_next_index_stringl(template, key, key_length, 0);
+}
+
+/**
+ * Compiles a route pattern into a URL template. The template is an array alternating literal
+ * segments and the names of the replacements that fill the slots between them, so a URL
+ * can be generated from it with a single concatenation pass
+ */
+void phalcon_compile_url_template(zval *return_value, zval *pattern, zval *paths TSRMLS_DC){
+
+	char *cursor, *marker, *key;
+	unsigned int ch, bracket_count = 0, parentheses_count = 0, intermediate, key_length;
+	smart_str literal = {0};
 	ulong position = 1;
-	zval *replace, replace_copy;
-	int i, use_copy, looking_placeholder = 0;
+	int i, looking_placeholder = 0;
 
-	if (Z_TYPE_P(pattern) != IS_STRING || Z_TYPE_P(replacements) != IS_ARRAY || Z_TYPE_P(paths) != IS_ARRAY) {
+	if (Z_TYPE_P(pattern) != IS_STRING || Z_TYPE_P(paths) != IS_ARRAY) {
 		ZVAL_NULL(return_value);
-		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Invalid arguments supplied for phalcon_replace_paths()");
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Invalid arguments supplied for phalcon_compile_url_template()");
 		return;
 	}
 
@@ -682,8 +710,10 @@ void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval
 		return;
 	}
 
+	array_init(return_value);
+
 	if (!zend_hash_num_elements(Z_ARRVAL_P(paths))) {
-		ZVAL_STRINGL(return_value, Z_STRVAL_P(pattern), Z_STRLEN_P(pattern), 1);
+		add_next_index_stringl(return_value, Z_STRVAL_P(pattern), Z_STRLEN_P(pattern), 1);
 		return;
 	}
 
@@ -703,20 +733,8 @@ void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval
 					bracket_count--;
 					if (intermediate > 0) {
 						if (bracket_count == 0) {
-							replace = phalcon_replace_marker(1, paths, replacements, &position, cursor, marker);
-							if (replace) {
-								use_copy = 0;
-								if (Z_TYPE_P(replace) != IS_STRING) {
-									zend_make_printable_zval(replace, &replace_copy, &use_copy);
-									if (use_copy) {
-										replace = &replace_copy;
-									}
-								}
-								smart_str_appendl(&route_str, Z_STRVAL_P(replace), Z_STRLEN_P(replace));
-								if (use_copy) {
-									zval_dtor(&replace_copy);
-								}
-							}
+							key = phalcon_url_template_key(1, paths, &position, cursor, marker, &key_length);
+							phalcon_url_template_slot(return_value, &literal, key, key_length);
 							cursor++;
 							continue;
 						}
@@ -737,20 +755,8 @@ void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval
 					parentheses_count--;
 					if (intermediate > 0) {
 						if (parentheses_count == 0) {
-							replace = phalcon_replace_marker(0, paths, replacements, &position, cursor, marker);
-							if (replace) {
-								use_copy = 0;
-								if (Z_TYPE_P(replace) != IS_STRING) {
-									zend_make_printable_zval(replace, &replace_copy, &use_copy);
-									if (use_copy) {
-										replace = &replace_copy;
-									}
-								}
-								smart_str_appendl(&route_str, Z_STRVAL_P(replace), Z_STRLEN_P(replace));
-								if (use_copy) {
-									zval_dtor(&replace_copy);
-								}
-							}
+							key = phalcon_url_template_key(0, paths, &position, cursor, marker, &key_length);
+							phalcon_url_template_slot(return_value, &literal, key, key_length);
 							cursor++;
 							continue;
 						}
@@ -763,20 +769,8 @@ void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval
 			if (looking_placeholder) {
 				if (intermediate > 0) {
 					if (ch < 'a' || ch > 'z' || i == (Z_STRLEN_P(pattern)-1)) {
-						replace = phalcon_replace_marker(0, paths, replacements, &position, cursor, marker);
-						if (replace) {
-							use_copy = 0;
-							if (Z_TYPE_P(replace) != IS_STRING) {
-								zend_make_printable_zval(replace, &replace_copy, &use_copy);
-								if (use_copy) {
-									replace = &replace_copy;
-								}
-							}
-							smart_str_appendl(&route_str, Z_STRVAL_P(replace), Z_STRLEN_P(replace));
-							if (use_copy) {
-								zval_dtor(&replace_copy);
-							}
-						}
+						key = phalcon_url_template_key(0, paths, &position, cursor, marker, &key_length);
+						phalcon_url_template_slot(return_value, &literal, key, key_length);
 						looking_placeholder = 0;
 						continue;
 					}
@@ -793,20 +787,93 @@ void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval
 		if (bracket_count > 0 || parentheses_count > 0 || looking_placeholder) {
 			intermediate++;
 		} else {
-			smart_str_appendc(&route_str, ch);
+			smart_str_appendc(&literal, ch);
 		}
 
 		cursor++;
 	}
-	smart_str_0(&route_str);
+	smart_str_0(&literal);
 
-	if (route_str.len) {
-		RETURN_STRINGL(route_str.c, route_str.len, 0);
+	if (literal.len) {
+		add_next_index_stringl(return_value, literal.c, literal.len, 0);
 	} else {
-		smart_str_free(&route_str);
+		smart_str_free(&literal);
+		add_next_index_stringl(return_value, "", 0, 1);
+	}
+}
+
+/**
+ * Generates a URL from a compiled URL template and an array of replacements
+ */
+void phalcon_build_url(zval *return_value, zval *template, zval *replacements TSRMLS_DC){
+
+	HashPosition pos;
+	zval **segment, **replace, replace_copy;
+	smart_str url = {0};
+	int is_slot = 0, use_copy;
+
+	if (Z_TYPE_P(template) != IS_ARRAY) {
+		ZVAL_ZVAL(return_value, template, 1, 0);
+		return;
+	}
+
+	if (Z_TYPE_P(replacements) != IS_ARRAY) {
+		ZVAL_NULL(return_value);
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Invalid arguments supplied for phalcon_build_url()");
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(template), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(template), (void **) &segment, &pos) == SUCCESS) {
+
+		if (!is_slot) {
+			smart_str_appendl(&url, Z_STRVAL_PP(segment), Z_STRLEN_PP(segment));
+		} else {
+			if (zend_hash_find(Z_ARRVAL_P(replacements), Z_STRVAL_PP(segment), Z_STRLEN_PP(segment) + 1, (void **) &replace) == SUCCESS) {
+				if (Z_TYPE_PP(replace) == IS_STRING) {
+					smart_str_appendl(&url, Z_STRVAL_PP(replace), Z_STRLEN_PP(replace));
+				} else {
+					zend_make_printable_zval(*replace, &replace_copy, &use_copy);
+					if (use_copy) {
+						smart_str_appendl(&url, Z_STRVAL(replace_copy), Z_STRLEN(replace_copy));
+						zval_dtor(&replace_copy);
+					} else {
+						smart_str_appendl(&url, Z_STRVAL_PP(replace), Z_STRLEN_PP(replace));
+					}
+				}
+			}
+		}
+
+		is_slot = !is_slot;
+		zend_hash_move_forward_ex(Z_ARRVAL_P(template), &pos);
+	}
+	smart_str_0(&url);
+
+	if (url.len) {
+		RETURN_STRINGL(url.c, url.len, 0);
+	} else {
+		smart_str_free(&url);
 		RETURN_EMPTY_STRING();
 	}
+}
+
+/**
+ * Replaces placeholders and named variables with their corresponding values in an array
+ */
+void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval *replacements TSRMLS_DC){
+
+	zval template;
+
+	if (Z_TYPE_P(pattern) != IS_STRING || Z_TYPE_P(replacements) != IS_ARRAY || Z_TYPE_P(paths) != IS_ARRAY) {
+		ZVAL_NULL(return_value);
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "Invalid arguments supplied for phalcon_replace_paths()");
+		return;
+	}
 
+	INIT_ZVAL(template);
+	phalcon_compile_url_template(&template, pattern, paths TSRMLS_CC);
+	phalcon_build_url(return_value, &template, replacements TSRMLS_CC);
+	zval_dtor(&template);
 }
 
 /**
@@ -866,3 +933,334 @@ int phalcon_start_with_str(zval *str, char *compared, unsigned int compared_leng
 
 	return 1;
 }
+
+/**
+ * Decodes the UTF-8 sequence at the start of str. Only well-formed sequences are accepted (no
+ * overlong forms, surrogates or code points above U+10FFFF), on malformed input the code point
+ * is set to -1 and a single byte is consumed
+ */
+static int phalcon_utf8_decode(const unsigned char *str, unsigned int length, long *code_point){
+
+	unsigned char c = str[0], lower = 0x80, upper = 0xBF;
+
+	if (c < 0x80) {
+		*code_point = c;
+		return 1;
+	}
+
+	if (c >= 0xC2 && c <= 0xDF) {
+		if (length >= 2 && (str[1] & 0xC0) == 0x80) {
+			*code_point = ((c & 0x1F) << 6) | (str[1] & 0x3F);
+			return 2;
+		}
+	} else {
+		if (c >= 0xE0 && c <= 0xEF) {
+			if (c == 0xE0) {
+				lower = 0xA0;
+			} else {
+				if (c == 0xED) {
+					upper = 0x9F;
+				}
+			}
+			if (length >= 3 && str[1] >= lower && str[1] <= upper && (str[2] & 0xC0) == 0x80) {
+				*code_point = ((c & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+				return 3;
+			}
+		} else {
+			if (c >= 0xF0 && c <= 0xF4) {
+				if (c == 0xF0) {
+					lower = 0x90;
+				} else {
+					if (c == 0xF4) {
+						upper = 0x8F;
+					}
+				}
+				if (length >= 4 && str[1] >= lower && str[1] <= upper && (str[2] & 0xC0) == 0x80 && (str[3] & 0xC0) == 0x80) {
+					*code_point = ((c & 0x07) << 18) | ((str[1] & 0x3F) << 12) | ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+					return 4;
+				}
+			}
+		}
+	}
+
+	*code_point = -1;
+	return 1;
+}
+
+/**
+ * Returns the position of the first byte that may need to be escaped by phalcon_escape_html
+ */
+static unsigned int phalcon_escape_html_scan(const unsigned char *str, unsigned int length){
+
+	unsigned int i = 0;
+	unsigned char c;
+
+#ifdef __SSE2__
+	const __m128i amp = _mm_set1_epi8('&'), lt = _mm_set1_epi8('<'), gt = _mm_set1_epi8('>');
+	const __m128i dquote = _mm_set1_epi8('"'), squote = _mm_set1_epi8('\'');
+	__m128i chunk, hits;
+
+	while (i + 16 <= length) {
+		chunk = _mm_loadu_si128((const __m128i *) (str + i));
+		hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, amp), _mm_cmpeq_epi8(chunk, lt));
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, gt));
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, dquote));
+		hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, squote));
+		/* Non-ASCII bytes have the high bit set, movemask picks them up directly */
+		if (_mm_movemask_epi8(hits) | _mm_movemask_epi8(chunk)) {
+			break;
+		}
+		i += 16;
+	}
+#endif
+
+	for (; i < length; i++) {
+		c = str[i];
+		if (c >= 0x80 || c == '&' || c == '<' || c == '>' || c == '"' || c == '\'') {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/**
+ * Escapes a string for HTML in the same way htmlspecialchars() does for UTF-8 and the quote
+ * styles ENT_NOQUOTES/ENT_COMPAT/ENT_QUOTES. Returns FAILURE when the string isn't valid UTF-8,
+ * in that case the caller must fall back to htmlspecialchars() which knows how to report it
+ */
+int phalcon_escape_html(zval *return_value, zval *str, int quote_type){
+
+	smart_str escaped = {0};
+	unsigned int length = Z_STRLEN_P(str);
+
+	if (phalcon_escape_html_scan((const unsigned char *) Z_STRVAL_P(str), length) == length) {
+		ZVAL_STRINGL(return_value, Z_STRVAL_P(str), length, 1);
+		return SUCCESS;
+	}
+
+	if (phalcon_escape_html_append(&escaped, Z_STRVAL_P(str), length, quote_type) == FAILURE) {
+		smart_str_free(&escaped);
+		return FAILURE;
+	}
+	smart_str_0(&escaped);
+
+	ZVAL_STRINGL(return_value, escaped.c, escaped.len, 0);
+	return SUCCESS;
+}
+
+/**
+ * Appends a string escaped for HTML to a buffer, when the string isn't valid UTF-8 the buffer is
+ * left as it was and FAILURE is returned
+ */
+int phalcon_escape_html_append(smart_str *escaped, const char *str, unsigned int length, int quote_type){
+
+	const unsigned char *s = (const unsigned char *) str;
+	unsigned int i, size;
+	size_t initial_length = escaped->len;
+	long code_point;
+	unsigned char c;
+
+	i = phalcon_escape_html_scan(s, length);
+
+	smart_str_appendl(escaped, (const char *) s, i);
+	while (i < length) {
+		c = s[i];
+		switch (c) {
+
+			case '&':
+				smart_str_appendl(escaped, "&amp;", 5);
+				break;
+
+			case '<':
+				smart_str_appendl(escaped, "&lt;", 4);
+				break;
+
+			case '>':
+				smart_str_appendl(escaped, "&gt;", 4);
+				break;
+
+			case '"':
+				if (quote_type & 2) {
+					smart_str_appendl(escaped, "&quot;", 6);
+				} else {
+					smart_str_appendc(escaped, c);
+				}
+				break;
+
+			case '\'':
+				if (quote_type & 1) {
+					smart_str_appendl(escaped, "&#039;", 6);
+				} else {
+					smart_str_appendc(escaped, c);
+				}
+				break;
+
+			default:
+				if (c >= 0x80) {
+					size = phalcon_utf8_decode(s + i, length - i, &code_point);
+					if (code_point < 0) {
+						escaped->len = initial_length;
+						return FAILURE;
+					}
+					smart_str_appendl(escaped, (const char *) (s + i), size);
+					i += size;
+					continue;
+				}
+				smart_str_appendc(escaped, c);
+		}
+		i++;
+	}
+	return SUCCESS;
+}
+
+/**
+ * Checks if a byte doesn't need to be escaped in CSS, JavaScript or HTML attributes
+ */
+static inline int phalcon_escape_is_safe(unsigned char c, int type){
+
+	if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+		return 1;
+	}
+
+	switch (type) {
+
+		case PHALCON_ESCAPE_JS:
+			return c == ',' || c == '.' || c == '_';
+
+		case PHALCON_ESCAPE_HTML_ATTR:
+			return c == ',' || c == '.' || c == '-' || c == '_';
+	}
+
+	return 0;
+}
+
+/**
+ * Returns the position of the first byte that must be escaped by phalcon_escape_multi
+ */
+static unsigned int phalcon_escape_multi_scan(const unsigned char *str, unsigned int length, int type){
+
+	unsigned int i = 0;
+
+#ifdef __SSE2__
+	const __m128i before_digits = _mm_set1_epi8('0' - 1), after_digits = _mm_set1_epi8('9' + 1);
+	const __m128i before_letters = _mm_set1_epi8('a' - 1), after_letters = _mm_set1_epi8('z' + 1);
+	const __m128i lower_case = _mm_set1_epi8(0x20);
+	const __m128i comma = _mm_set1_epi8(','), dot = _mm_set1_epi8('.');
+	const __m128i dash = _mm_set1_epi8('-'), underscore = _mm_set1_epi8('_');
+	__m128i chunk, folded, safe;
+
+	while (i + 16 <= length) {
+		chunk = _mm_loadu_si128((const __m128i *) (str + i));
+		/* Bytes with the high bit set are negative in the signed comparisons so they are never safe */
+		safe = _mm_and_si128(_mm_cmpgt_epi8(chunk, before_digits), _mm_cmplt_epi8(chunk, after_digits));
+		folded = _mm_or_si128(chunk, lower_case);
+		safe = _mm_or_si128(safe, _mm_and_si128(_mm_cmpgt_epi8(folded, before_letters), _mm_cmplt_epi8(folded, after_letters)));
+		if (type != PHALCON_ESCAPE_CSS) {
+			safe = _mm_or_si128(safe, _mm_cmpeq_epi8(chunk, comma));
+			safe = _mm_or_si128(safe, _mm_cmpeq_epi8(chunk, dot));
+			safe = _mm_or_si128(safe, _mm_cmpeq_epi8(chunk, underscore));
+			if (type == PHALCON_ESCAPE_HTML_ATTR) {
+				safe = _mm_or_si128(safe, _mm_cmpeq_epi8(chunk, dash));
+			}
+		}
+		if (_mm_movemask_epi8(safe) != 0xFFFF) {
+			break;
+		}
+		i += 16;
+	}
+#endif
+
+	while (i < length && phalcon_escape_is_safe(str[i], type)) {
+		i++;
+	}
+
+	return i;
+}
+
+/**
+ * Escapes a string for CSS, JavaScript or HTML attributes in a single pass. Every character
+ * outside the type's whitelist is replaced by its code point, malformed UTF-8 is replaced by U+FFFD
+ */
+void phalcon_escape_multi(zval *return_value, zval *str, int type){
+
+	const unsigned char *s = (const unsigned char *) Z_STRVAL_P(str);
+	unsigned int length = Z_STRLEN_P(str), i, size;
+	smart_str escaped = {0};
+	char buffer[24];
+	long code_point;
+
+	i = phalcon_escape_multi_scan(s, length, type);
+	if (i == length) {
+		ZVAL_STRINGL(return_value, Z_STRVAL_P(str), length, 1);
+		return;
+	}
+
+	smart_str_appendl(&escaped, (const char *) s, i);
+	while (i < length) {
+
+		if (phalcon_escape_is_safe(s[i], type)) {
+			smart_str_appendc(&escaped, s[i]);
+			i++;
+			continue;
+		}
+
+		size = phalcon_utf8_decode(s + i, length - i, &code_point);
+		if (code_point < 0) {
+			code_point = 0xFFFD;
+		}
+		i += size;
+
+		switch (type) {
+
+			case PHALCON_ESCAPE_CSS:
+				size = snprintf(buffer, sizeof(buffer), "\\%lX ", code_point);
+				break;
+
+			case PHALCON_ESCAPE_JS:
+				if (code_point < 0x100) {
+					size = snprintf(buffer, sizeof(buffer), "\\x%02lX", code_point);
+				} else {
+					if (code_point < 0x10000) {
+						size = snprintf(buffer, sizeof(buffer), "\\u%04lX", code_point);
+					} else {
+						/* JavaScript strings are UTF-16, astral code points are written as surrogate pairs */
+						code_point -= 0x10000;
+						size = snprintf(buffer, sizeof(buffer), "\\u%04lX\\u%04lX", 0xD800 + (code_point >> 10), 0xDC00 + (code_point & 0x3FF));
+					}
+				}
+				break;
+
+			default:
+				switch (code_point) {
+					case '"':
+						smart_str_appendl(&escaped, "&quot;", 6);
+						continue;
+					case '&':
+						smart_str_appendl(&escaped, "&amp;", 5);
+						continue;
+					case '<':
+						smart_str_appendl(&escaped, "&lt;", 4);
+						continue;
+					case '>':
+						smart_str_appendl(&escaped, "&gt;", 4);
+						continue;
+				}
+				/* Control characters other than whitespace are undefined in HTML */
+				if ((code_point <= 0x1F && code_point != '\t' && code_point != '\n' && code_point != '\r') || (code_point >= 0x7F && code_point <= 0x9F)) {
+					code_point = 0xFFFD;
+				}
+				if (code_point > 0xFF) {
+					size = snprintf(buffer, sizeof(buffer), "&#x%04lX;", code_point);
+				} else {
+					size = snprintf(buffer, sizeof(buffer), "&#x%02lX;", code_point);
+				}
+				break;
+		}
+
+		smart_str_appendl(&escaped, buffer, size);
+	}
+	smart_str_0(&escaped);
+
+	ZVAL_STRINGL(return_value, escaped.c, escaped.len, 0);
+}
@@ -17,6 +17,8 @@
   +------------------------------------------------------------------------+
 */
 
+#include "ext/standard/php_smart_str.h"
+
 /** Fast char position */
 extern int phalcon_memnstr(zval *haystack, zval *needle TSRMLS_DC);
 extern int phalcon_memnstr_str(zval *haystack, char *needle, int needle_length TSRMLS_DC);
@@ -38,7 +40,21 @@ extern void phalcon_uncamelize(zval *return_value, zval *str TSRMLS_DC);
 /** Extract named parameters */
 extern void phalcon_extract_named_params(zval *return_value, zval *str, zval *matches);
 extern void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval *uri TSRMLS_DC);
+extern void phalcon_compile_url_template(zval *return_value, zval *pattern, zval *paths TSRMLS_DC);
+extern void phalcon_build_url(zval *return_value, zval *template, zval *replacements TSRMLS_DC);
 
 /** Start with */
 extern int phalcon_start_with(zval *str, zval *compared);
-extern int phalcon_start_with_str(zval *str, char *compared, unsigned int compared_length);
\ No newline at end of file
+extern int phalcon_start_with_str(zval *str, char *compared, unsigned int compared_length);
+/** Escaping kernels */
+#define PHALCON_ESCAPE_CSS 1
+#define PHALCON_ESCAPE_JS 2
+#define PHALCON_ESCAPE_HTML_ATTR 3
+
+extern int phalcon_escape_html(zval *return_value, zval *str, int quote_type);
+extern int phalcon_escape_html_append(smart_str *escaped, const char *str, unsigned int length, int quote_type);
+extern void phalcon_escape_multi(zval *return_value, zval *str, int type);
+
+#define phalcon_escape_css(return_value, str) phalcon_escape_multi(return_value, str, PHALCON_ESCAPE_CSS)
+#define phalcon_escape_js(return_value, str) phalcon_escape_multi(return_value, str, PHALCON_ESCAPE_JS)
+#define phalcon_escape_htmlattr(return_value, str) phalcon_escape_multi(return_value, str, PHALCON_ESCAPE_HTML_ATTR)
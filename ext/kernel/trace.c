@@ -0,0 +1,384 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "ext/standard/php_rand.h"
+#include "ext/standard/php_smart_str.h"
+
+#include "kernel/main.h"
+#include "kernel/trace.h"
+
+#include <time.h>
+
+/**
+ * The traced methods are wrapped when the module starts, the wrappers are only installed when
+ * phalcon.trace.enabled is on so the methods don't pay anything when the tracing is disabled.
+ * Every wrapper knows its traced point by index and calls the original handler
+ */
+typedef struct _phalcon_trace_point {
+	const char *class_name;
+	const char *method;
+	void (*wrapper)(INTERNAL_FUNCTION_PARAMETERS);
+	void (*handler)(INTERNAL_FUNCTION_PARAMETERS);
+} phalcon_trace_point;
+
+static void phalcon_trace_call(unsigned int point, INTERNAL_FUNCTION_PARAMETERS);
+
+#define PHALCON_TRACE_WRAPPER(index) \
+	static void phalcon_trace_wrapper_ ##index (INTERNAL_FUNCTION_PARAMETERS){ \
+		phalcon_trace_call(index, INTERNAL_FUNCTION_PARAM_PASSTHRU); \
+	}
+
+PHALCON_TRACE_WRAPPER(0)
+PHALCON_TRACE_WRAPPER(1)
+PHALCON_TRACE_WRAPPER(2)
+PHALCON_TRACE_WRAPPER(3)
+PHALCON_TRACE_WRAPPER(4)
+PHALCON_TRACE_WRAPPER(5)
+PHALCON_TRACE_WRAPPER(6)
+PHALCON_TRACE_WRAPPER(7)
+PHALCON_TRACE_WRAPPER(8)
+PHALCON_TRACE_WRAPPER(9)
+PHALCON_TRACE_WRAPPER(10)
+PHALCON_TRACE_WRAPPER(11)
+PHALCON_TRACE_WRAPPER(12)
+PHALCON_TRACE_WRAPPER(13)
+PHALCON_TRACE_WRAPPER(14)
+PHALCON_TRACE_WRAPPER(15)
+PHALCON_TRACE_WRAPPER(16)
+PHALCON_TRACE_WRAPPER(17)
+
+static phalcon_trace_point phalcon_trace_points[] = {
+	{ "phalcon\\mvc\\router", "handle", phalcon_trace_wrapper_0, NULL },
+	{ "phalcon\\cli\\router", "handle", phalcon_trace_wrapper_1, NULL },
+	{ "phalcon\\dispatcher", "dispatch", phalcon_trace_wrapper_2, NULL },
+	{ "phalcon\\mvc\\model\\query", "parse", phalcon_trace_wrapper_3, NULL },
+	{ "phalcon\\mvc\\model\\query", "execute", phalcon_trace_wrapper_4, NULL },
+	{ "phalcon\\db\\adapter\\pdo", "query", phalcon_trace_wrapper_5, NULL },
+	{ "phalcon\\mvc\\view", "render", phalcon_trace_wrapper_6, NULL },
+	{ "phalcon\\mvc\\view", "_enginerender", phalcon_trace_wrapper_7, NULL },
+	{ "phalcon\\mvc\\view\\engine\\volt\\compiler", "compile", phalcon_trace_wrapper_8, NULL },
+	{ "phalcon\\cache\\backend\\file", "get", phalcon_trace_wrapper_9, NULL },
+	{ "phalcon\\cache\\backend\\file", "save", phalcon_trace_wrapper_10, NULL },
+	{ "phalcon\\cache\\backend\\apc", "get", phalcon_trace_wrapper_11, NULL },
+	{ "phalcon\\cache\\backend\\apc", "save", phalcon_trace_wrapper_12, NULL },
+	{ "phalcon\\cache\\backend\\memcache", "get", phalcon_trace_wrapper_13, NULL },
+	{ "phalcon\\cache\\backend\\memcache", "save", phalcon_trace_wrapper_14, NULL },
+	{ "phalcon\\cache\\backend\\mongo", "get", phalcon_trace_wrapper_15, NULL },
+	{ "phalcon\\cache\\backend\\mongo", "save", phalcon_trace_wrapper_16, NULL },
+	{ "phalcon\\loader", "autoload", phalcon_trace_wrapper_17, NULL },
+	{ NULL, NULL, NULL, NULL }
+};
+
+/**
+ * Returns a monotonic time in microseconds, the wall clock is used where there is no monotonic clock
+ */
+static double phalcon_trace_now(void){
+
+	struct timeval tv;
+#if defined(HAVE_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+	}
+#endif
+
+	gettimeofday(&tv, NULL);
+	return (double) tv.tv_sec * 1000000.0 + (double) tv.tv_usec;
+}
+
+/**
+ * Opens a span, returns -1 when the buffer of the request is full
+ */
+static int phalcon_trace_begin(unsigned int point, zval *this_ptr, int ht TSRMLS_DC){
+
+	phalcon_trace_span *span;
+	unsigned int size;
+	zval **args[1];
+
+	if (PHALCON_GLOBAL(trace_count) >= PHALCON_GLOBAL(trace_size)) {
+		if (PHALCON_GLOBAL(trace_size) >= (unsigned int) PHALCON_GLOBAL(trace_max_spans)) {
+			PHALCON_GLOBAL(trace_dropped)++;
+			return -1;
+		}
+		size = PHALCON_GLOBAL(trace_size) ? PHALCON_GLOBAL(trace_size) * 2 : 64;
+		if (size > (unsigned int) PHALCON_GLOBAL(trace_max_spans)) {
+			size = (unsigned int) PHALCON_GLOBAL(trace_max_spans);
+		}
+		PHALCON_GLOBAL(trace_spans) = erealloc(PHALCON_GLOBAL(trace_spans), size * sizeof(phalcon_trace_span));
+		PHALCON_GLOBAL(trace_size) = size;
+	}
+
+	span = &PHALCON_GLOBAL(trace_spans)[PHALCON_GLOBAL(trace_count)];
+	span->point = point;
+	span->scope = this_ptr ? Z_OBJCE_P(this_ptr) : NULL;
+	span->depth = PHALCON_GLOBAL(trace_depth);
+	span->duration = -1;
+	span->detail = NULL;
+	span->detail_length = 0;
+
+	/**
+	 * The first argument tells the SQL, the URI, the view or the key involved
+	 */
+	if (ht > 0 && zend_get_parameters_array_ex(1, args TSRMLS_CC) == SUCCESS) {
+		if (Z_TYPE_PP(args[0]) == IS_STRING) {
+			span->detail_length = Z_STRLEN_PP(args[0]) > PHALCON_TRACE_DETAIL_LENGTH ? PHALCON_TRACE_DETAIL_LENGTH : Z_STRLEN_PP(args[0]);
+			span->detail = estrndup(Z_STRVAL_PP(args[0]), span->detail_length);
+		}
+	}
+
+	span->start = phalcon_trace_now();
+
+	PHALCON_GLOBAL(trace_depth)++;
+	return PHALCON_GLOBAL(trace_count)++;
+}
+
+static void phalcon_trace_call(unsigned int point, INTERNAL_FUNCTION_PARAMETERS){
+
+	int span;
+
+	if (!PHALCON_GLOBAL(trace_active)) {
+		phalcon_trace_points[point].handler(INTERNAL_FUNCTION_PARAM_PASSTHRU);
+		return;
+	}
+
+	span = phalcon_trace_begin(point, this_ptr, ht TSRMLS_CC);
+
+	phalcon_trace_points[point].handler(INTERNAL_FUNCTION_PARAM_PASSTHRU);
+
+	if (span >= 0) {
+		PHALCON_GLOBAL(trace_spans)[span].duration = phalcon_trace_now() - PHALCON_GLOBAL(trace_spans)[span].start;
+		PHALCON_GLOBAL(trace_depth)--;
+	}
+}
+
+/**
+ * Replaces the handlers of the traced methods by their wrappers, the classes that inherit a traced
+ * method get the wrapper too
+ */
+void phalcon_trace_startup(TSRMLS_D){
+
+	phalcon_trace_point *point;
+	zend_class_entry **ce;
+	zend_function *method, *inherited;
+	HashPosition pos;
+
+	for (point = phalcon_trace_points; point->class_name; point++) {
+
+		if (zend_hash_find(CG(class_table), point->class_name, strlen(point->class_name) + 1, (void **) &ce) == FAILURE) {
+			continue;
+		}
+
+		if (zend_hash_find(&(*ce)->function_table, point->method, strlen(point->method) + 1, (void **) &method) == FAILURE) {
+			continue;
+		}
+
+		if (method->type != ZEND_INTERNAL_FUNCTION) {
+			continue;
+		}
+
+		point->handler = method->internal_function.handler;
+
+		zend_hash_internal_pointer_reset_ex(CG(class_table), &pos);
+		while (zend_hash_get_current_data_ex(CG(class_table), (void **) &ce, &pos) == SUCCESS) {
+			if (zend_hash_find(&(*ce)->function_table, point->method, strlen(point->method) + 1, (void **) &inherited) == SUCCESS) {
+				if (inherited->type == ZEND_INTERNAL_FUNCTION && inherited->internal_function.handler == point->handler) {
+					inherited->internal_function.handler = point->wrapper;
+				}
+			}
+			zend_hash_move_forward_ex(CG(class_table), &pos);
+		}
+	}
+}
+
+/**
+ * Decides whether the request is traced, one of every phalcon.trace.sampling requests is
+ */
+void phalcon_trace_request_startup(TSRMLS_D){
+
+	long sampling;
+
+	PHALCON_GLOBAL(trace_active) = 0;
+	PHALCON_GLOBAL(trace_spans) = NULL;
+	PHALCON_GLOBAL(trace_count) = 0;
+	PHALCON_GLOBAL(trace_size) = 0;
+	PHALCON_GLOBAL(trace_depth) = 0;
+	PHALCON_GLOBAL(trace_dropped) = 0;
+
+	if (!PHALCON_GLOBAL(trace_enabled) || PHALCON_GLOBAL(trace_max_spans) <= 0) {
+		return;
+	}
+
+	if (!PHALCON_GLOBAL(trace_output) || !*PHALCON_GLOBAL(trace_output)) {
+		return;
+	}
+
+	sampling = PHALCON_GLOBAL(trace_sampling);
+	if (sampling <= 0) {
+		return;
+	}
+
+	if (sampling > 1 && (php_rand(TSRMLS_C) % sampling) != 0) {
+		return;
+	}
+
+	PHALCON_GLOBAL(trace_active) = 1;
+	PHALCON_GLOBAL(trace_start) = phalcon_trace_now();
+}
+
+static void phalcon_trace_json_string(smart_str *buffer, const char *str, unsigned int length){
+
+	unsigned int i;
+	unsigned char ch;
+	char escaped[8];
+
+	smart_str_appendc(buffer, '"');
+	for (i = 0; i < length; i++) {
+		ch = (unsigned char) str[i];
+		if (ch == '"' || ch == '\\') {
+			smart_str_appendc(buffer, '\\');
+			smart_str_appendc(buffer, ch);
+		} else {
+			if (ch < 0x20) {
+				snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+				smart_str_appendl(buffer, escaped, 6);
+			} else {
+				smart_str_appendc(buffer, ch);
+			}
+		}
+	}
+	smart_str_appendc(buffer, '"');
+}
+
+/**
+ * Writes the spans of the request as a Chrome trace (chrome://tracing, Perfetto), spans still open
+ * because the request was aborted end when the request ends
+ */
+static void phalcon_trace_export(TSRMLS_D){
+
+	phalcon_trace_span *span;
+	phalcon_trace_point *point;
+	smart_str buffer = {0};
+	char path[MAXPATHLEN], number[64];
+	const char *class_name;
+	unsigned int i;
+	double end;
+	long pid;
+	php_stream *stream;
+
+	end = phalcon_trace_now();
+	pid = (long) getpid();
+
+	smart_str_appends(&buffer, "{\"traceEvents\":[");
+	for (i = 0; i < PHALCON_GLOBAL(trace_count); i++) {
+
+		span = &PHALCON_GLOBAL(trace_spans)[i];
+		point = &phalcon_trace_points[span->point];
+
+		if (i) {
+			smart_str_appendc(&buffer, ',');
+		}
+
+		smart_str_appends(&buffer, "{\"name\":\"");
+		if (span->scope) {
+			for (class_name = span->scope->name; *class_name; class_name++) {
+				if (*class_name == '\\') {
+					smart_str_appendc(&buffer, '\\');
+				}
+				smart_str_appendc(&buffer, *class_name);
+			}
+			smart_str_appendl(&buffer, "::", 2);
+		}
+		smart_str_appends(&buffer, point->method);
+		smart_str_appends(&buffer, "\",\"cat\":\"phalcon\",\"ph\":\"X\",\"ts\":");
+		snprintf(number, sizeof(number), "%.3F", span->start - PHALCON_GLOBAL(trace_start));
+		smart_str_appends(&buffer, number);
+		smart_str_appends(&buffer, ",\"dur\":");
+		snprintf(number, sizeof(number), "%.3F", span->duration < 0 ? end - span->start : span->duration);
+		smart_str_appends(&buffer, number);
+		smart_str_appends(&buffer, ",\"pid\":");
+		smart_str_append_long(&buffer, pid);
+		smart_str_appends(&buffer, ",\"tid\":0,\"args\":{\"depth\":");
+		smart_str_append_unsigned(&buffer, span->depth);
+		if (span->detail) {
+			smart_str_appends(&buffer, ",\"detail\":");
+			phalcon_trace_json_string(&buffer, span->detail, span->detail_length);
+		}
+		if (span->duration < 0) {
+			smart_str_appends(&buffer, ",\"aborted\":true");
+		}
+		smart_str_appends(&buffer, "}}");
+	}
+
+	smart_str_appends(&buffer, "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":");
+	smart_str_append_unsigned(&buffer, PHALCON_GLOBAL(trace_dropped));
+	smart_str_appends(&buffer, "}}\n");
+	smart_str_0(&buffer);
+
+	/**
+	 * Every traced request gets its own file, workers never write the same file
+	 */
+	snprintf(path, sizeof(path), "%s/phalcon-trace-%ld-%.0F.json", PHALCON_GLOBAL(trace_output), pid, PHALCON_GLOBAL(trace_start));
+
+	stream = php_stream_open_wrapper(path, "wb", REPORT_ERRORS, NULL);
+	if (stream) {
+		php_stream_write(stream, buffer.c, buffer.len);
+		php_stream_close(stream);
+	}
+
+	smart_str_free(&buffer);
+}
+
+/**
+ * Exports and releases the spans of the request
+ */
+void phalcon_trace_request_shutdown(TSRMLS_D){
+
+	unsigned int i;
+
+	if (!PHALCON_GLOBAL(trace_active)) {
+		return;
+	}
+
+	PHALCON_GLOBAL(trace_active) = 0;
+
+	if (PHALCON_GLOBAL(trace_count) && PHALCON_GLOBAL(trace_output) && *PHALCON_GLOBAL(trace_output)) {
+		phalcon_trace_export(TSRMLS_C);
+	}
+
+	for (i = 0; i < PHALCON_GLOBAL(trace_count); i++) {
+		if (PHALCON_GLOBAL(trace_spans)[i].detail) {
+			efree(PHALCON_GLOBAL(trace_spans)[i].detail);
+		}
+	}
+
+	if (PHALCON_GLOBAL(trace_spans)) {
+		efree(PHALCON_GLOBAL(trace_spans));
+		PHALCON_GLOBAL(trace_spans) = NULL;
+	}
+
+	PHALCON_GLOBAL(trace_count) = 0;
+	PHALCON_GLOBAL(trace_size) = 0;
+}
@@ -0,0 +1,43 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifndef PHALCON_KERNEL_TRACE_H
+#define PHALCON_KERNEL_TRACE_H
+
+/** Spans kept per request when phalcon.trace.max_spans is not set, the default of the ini entry */
+#define PHALCON_TRACE_MAX_SPANS "4096"
+
+/** Bytes of the first argument kept as the detail of a span */
+#define PHALCON_TRACE_DETAIL_LENGTH 128
+
+typedef struct _phalcon_trace_span {
+	unsigned int point;
+	zend_class_entry *scope;
+	double start;
+	double duration;
+	unsigned int depth;
+	char *detail;
+	unsigned int detail_length;
+} phalcon_trace_span;
+
+extern void phalcon_trace_startup(TSRMLS_D);
+extern void phalcon_trace_request_startup(TSRMLS_D);
+extern void phalcon_trace_request_shutdown(TSRMLS_D);
+
+#endif
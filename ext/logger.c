@@ -67,6 +67,10 @@ PHALCON_INIT_CLASS(Phalcon_Logger){
 	zend_declare_class_constant_long(phalcon_logger_ce, SL("CRITICAL"), 1 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_logger_ce, SL("EMERGENCE"), 0 TSRMLS_CC);
 
+	zend_declare_class_constant_long(phalcon_logger_ce, SL("ENCODING_LINE"), 0 TSRMLS_CC);
+	zend_declare_class_constant_long(phalcon_logger_ce, SL("ENCODING_JSON"), 1 TSRMLS_CC);
+	zend_declare_class_constant_long(phalcon_logger_ce, SL("ENCODING_LOGFMT"), 2 TSRMLS_CC);
+
 	return SUCCESS;
 }
 
@@ -38,10 +38,28 @@
 #include "kernel/operators.h"
 #include "kernel/exception.h"
 
+#include "ext/standard/php_smart_str.h"
+
+#define PHALCON_LOGGER_ENCODING_LINE 0
+#define PHALCON_LOGGER_ENCODING_JSON 1
+#define PHALCON_LOGGER_ENCODING_LOGFMT 2
+
+#define PHALCON_LOGGER_MAX_DEPTH 32
+#define PHALCON_LOGGER_MAX_PLACEHOLDER 64
+
 /**
  * Phalcon\Logger\Adapter
  *
  * Base class for Phalcon\Logger adapters
+ *
+ * Messages may contain {placeholders} which are replaced by the values in the context passed to
+ * log(). Entries are written with the _format template by default, setEncoding switches to JSON
+ * lines or logfmt
+ *
+ *<code>
+ *$logger->setEncoding(Phalcon\Logger::ENCODING_JSON);
+ *$logger->error("Payment {id} failed", array('id' => 1022, 'gateway' => 'paypal'));
+ *</code>
  */
 
 
@@ -54,10 +72,474 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Adapter){
 
 	zend_declare_property_string(phalcon_logger_adapter_ce, SL("_dateFormat"), "D, d M y H:i:s O", ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_string(phalcon_logger_adapter_ce, SL("_format"), "[%date%][%type%] %message%", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_adapter_ce, SL("_cachedTime"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_adapter_ce, SL("_cachedDate"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_adapter_ce, SL("_cachedDateFormat"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_logger_adapter_ce, SL("_encoding"), PHALCON_LOGGER_ENCODING_LINE, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
 
+/**
+ * Current unix timestamp
+ */
+static long phalcon_logger_adapter_now(void){
+	return (long) time(NULL);
+}
+
+/**
+ * Writes a string escaped for the active encoding
+ */
+static void phalcon_logger_encode_string(smart_str *buffer, const char *str, unsigned int length, int encoding){
+
+	static const char hex[] = "0123456789abcdef";
+	const unsigned char *cursor = (const unsigned char *) str, *end = cursor + length, *start;
+
+	if (encoding == PHALCON_LOGGER_ENCODING_LINE) {
+		smart_str_appendl(buffer, str, length);
+		return;
+	}
+
+	while (cursor < end) {
+
+		/** 
+		 * Copy runs of characters that don't need escaping at once
+		 */
+		start = cursor;
+		while (cursor < end && *cursor >= 0x20 && *cursor != '"' && *cursor != '\\') {
+			cursor++;
+		}
+		if (cursor > start) {
+			smart_str_appendl(buffer, (const char *) start, cursor - start);
+		}
+		if (cursor == end) {
+			break;
+		}
+
+		switch (*cursor) {
+			case '"':
+				smart_str_appendl(buffer, "\\\"", 2);
+				break;
+			case '\\':
+				smart_str_appendl(buffer, "\\\\", 2);
+				break;
+			case '\n':
+				smart_str_appendl(buffer, "\\n", 2);
+				break;
+			case '\r':
+				smart_str_appendl(buffer, "\\r", 2);
+				break;
+			case '\t':
+				smart_str_appendl(buffer, "\\t", 2);
+				break;
+			default:
+				smart_str_appendl(buffer, "\\u00", 4);
+				smart_str_appendc(buffer, hex[*cursor >> 4]);
+				smart_str_appendc(buffer, hex[*cursor & 15]);
+				break;
+		}
+		cursor++;
+	}
+}
+
+/**
+ * Checks if a logfmt value has to be quoted
+ */
+static int phalcon_logger_logfmt_quote(const char *str, unsigned int length){
+
+	unsigned int i;
+
+	if (!length) {
+		return 1;
+	}
+
+	for (i = 0; i < length; i++) {
+		if ((unsigned char) str[i] <= ' ' || str[i] == '=' || str[i] == '"' || str[i] == '\\') {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Writes the string form of a scalar, the same text a (string) cast produces. Returns 0 for
+ * values without a string form (arrays, objects, resources)
+ */
+static int phalcon_logger_encode_scalar(smart_str *buffer, zval *value, int encoding TSRMLS_DC){
+
+	char *str;
+	int length;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_NULL:
+			return 1;
+
+		case IS_BOOL:
+			if (Z_BVAL_P(value)) {
+				smart_str_appendc(buffer, '1');
+			}
+			return 1;
+
+		case IS_LONG:
+			smart_str_append_long(buffer, Z_LVAL_P(value));
+			return 1;
+
+		case IS_DOUBLE:
+			length = spprintf(&str, 0, "%.*G", (int) EG(precision), Z_DVAL_P(value));
+			smart_str_appendl(buffer, str, length);
+			efree(str);
+			return 1;
+
+		case IS_STRING:
+			phalcon_logger_encode_string(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value), encoding);
+			return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Writes a message replacing the {placeholders} found in the context, the message and the
+ * values are escaped while they are copied so the interpolated message is never built apart
+ */
+static void phalcon_logger_encode_message(smart_str *buffer, zval *message, zval *context, int encoding TSRMLS_DC){
+
+	const char *str, *end, *cursor, *start, *key;
+	char name[PHALCON_LOGGER_MAX_PLACEHOLDER];
+	unsigned int name_length;
+	zval **value;
+	int has_context;
+
+	if (Z_TYPE_P(message) != IS_STRING) {
+		if (!phalcon_logger_encode_scalar(buffer, message, encoding TSRMLS_CC)) {
+			smart_str_appendl(buffer, "Array", 5);
+		}
+		return;
+	}
+
+	has_context = context && Z_TYPE_P(context) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(context));
+
+	str = Z_STRVAL_P(message);
+	end = str + Z_STRLEN_P(message);
+	start = str;
+
+	if (has_context) {
+		for (cursor = str; cursor < end; cursor++) {
+
+			if (*cursor != '{') {
+				continue;
+			}
+
+			key = cursor + 1;
+			while (key < end && ((*key >= 'a' && *key <= 'z') || (*key >= 'A' && *key <= 'Z') || (*key >= '0' && *key <= '9') || *key == '_' || *key == '.')) {
+				key++;
+			}
+			if (key == end || *key != '}' || key == cursor + 1) {
+				continue;
+			}
+
+			name_length = key - cursor - 1;
+			if (name_length >= sizeof(name)) {
+				continue;
+			}
+			memcpy(name, cursor + 1, name_length);
+			name[name_length] = '\0';
+
+			if (zend_symtable_find(Z_ARRVAL_P(context), name, name_length + 1, (void **) &value) == SUCCESS) {
+				if (Z_TYPE_PP(value) <= IS_BOOL || Z_TYPE_PP(value) == IS_STRING) {
+					phalcon_logger_encode_string(buffer, start, cursor - start, encoding);
+					phalcon_logger_encode_scalar(buffer, *value, encoding TSRMLS_CC);
+					start = key + 1;
+					cursor = key;
+				}
+			}
+		}
+	}
+
+	phalcon_logger_encode_string(buffer, start, end - start, encoding);
+}
+
+/**
+ * Writes a context value as JSON
+ */
+static void phalcon_logger_encode_json(smart_str *buffer, zval *value, int depth TSRMLS_DC){
+
+	HashTable *ht;
+	HashPosition pos;
+	zval **item;
+	char *key;
+	uint key_length;
+	ulong index, expected = 0;
+	int is_list = 1, first = 1;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_NULL:
+			smart_str_appendl(buffer, "null", 4);
+			return;
+
+		case IS_BOOL:
+			if (Z_BVAL_P(value)) {
+				smart_str_appendl(buffer, "true", 4);
+			} else {
+				smart_str_appendl(buffer, "false", 5);
+			}
+			return;
+
+		case IS_LONG:
+			smart_str_append_long(buffer, Z_LVAL_P(value));
+			return;
+
+		case IS_DOUBLE:
+			if (zend_isinf(Z_DVAL_P(value)) || zend_isnan(Z_DVAL_P(value))) {
+				smart_str_appendl(buffer, "null", 4);
+			} else {
+				phalcon_logger_encode_scalar(buffer, value, PHALCON_LOGGER_ENCODING_JSON TSRMLS_CC);
+			}
+			return;
+
+		case IS_STRING:
+			smart_str_appendc(buffer, '"');
+			phalcon_logger_encode_string(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value), PHALCON_LOGGER_ENCODING_JSON);
+			smart_str_appendc(buffer, '"');
+			return;
+
+		case IS_OBJECT:
+			smart_str_appendl(buffer, "\"object(", 8);
+			phalcon_logger_encode_string(buffer, Z_OBJCE_P(value)->name, Z_OBJCE_P(value)->name_length, PHALCON_LOGGER_ENCODING_JSON);
+			smart_str_appendl(buffer, ")\"", 2);
+			return;
+
+		case IS_ARRAY:
+			break;
+
+		default:
+			smart_str_appendl(buffer, "null", 4);
+			return;
+	}
+
+	/** 
+	 * Nested arrays are cut at a fixed depth, this also stops recursive arrays
+	 */
+	if (depth > PHALCON_LOGGER_MAX_DEPTH) {
+		smart_str_appendl(buffer, "null", 4);
+		return;
+	}
+
+	ht = Z_ARRVAL_P(value);
+
+	zend_hash_internal_pointer_reset_ex(ht, &pos);
+	while (zend_hash_get_current_key_ex(ht, &key, &key_length, &index, 0, &pos) != HASH_KEY_NON_EXISTANT) {
+		if (zend_hash_get_current_key_type_ex(ht, &pos) != HASH_KEY_IS_LONG || index != expected++) {
+			is_list = 0;
+			break;
+		}
+		zend_hash_move_forward_ex(ht, &pos);
+	}
+
+	smart_str_appendc(buffer, is_list ? '[' : '{');
+
+	zend_hash_internal_pointer_reset_ex(ht, &pos);
+	while (zend_hash_get_current_data_ex(ht, (void **) &item, &pos) == SUCCESS) {
+
+		if (!first) {
+			smart_str_appendc(buffer, ',');
+		}
+		first = 0;
+
+		if (!is_list) {
+			smart_str_appendc(buffer, '"');
+			if (zend_hash_get_current_key_ex(ht, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+				phalcon_logger_encode_string(buffer, key, key_length - 1, PHALCON_LOGGER_ENCODING_JSON);
+			} else {
+				smart_str_append_unsigned(buffer, index);
+			}
+			smart_str_appendl(buffer, "\":", 2);
+		}
+
+		phalcon_logger_encode_json(buffer, *item, depth + 1 TSRMLS_CC);
+
+		zend_hash_move_forward_ex(ht, &pos);
+	}
+
+	smart_str_appendc(buffer, is_list ? ']' : '}');
+}
+
+/**
+ * Writes a context value as a logfmt value
+ */
+static void phalcon_logger_encode_logfmt(smart_str *buffer, zval *value TSRMLS_DC){
+
+	smart_str nested = { NULL, 0, 0 };
+
+	if (Z_TYPE_P(value) == IS_STRING) {
+		if (phalcon_logger_logfmt_quote(Z_STRVAL_P(value), Z_STRLEN_P(value))) {
+			smart_str_appendc(buffer, '"');
+			phalcon_logger_encode_string(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value), PHALCON_LOGGER_ENCODING_LOGFMT);
+			smart_str_appendc(buffer, '"');
+		} else {
+			smart_str_appendl(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value));
+		}
+		return;
+	}
+
+	if (Z_TYPE_P(value) == IS_BOOL) {
+		if (Z_BVAL_P(value)) {
+			smart_str_appendl(buffer, "true", 4);
+		} else {
+			smart_str_appendl(buffer, "false", 5);
+		}
+		return;
+	}
+
+	if (Z_TYPE_P(value) == IS_NULL) {
+		smart_str_appendl(buffer, "null", 4);
+		return;
+	}
+
+	if (Z_TYPE_P(value) == IS_LONG || Z_TYPE_P(value) == IS_DOUBLE) {
+		phalcon_logger_encode_scalar(buffer, value, PHALCON_LOGGER_ENCODING_LOGFMT TSRMLS_CC);
+		return;
+	}
+
+	/** 
+	 * Arrays and objects are written as quoted JSON
+	 */
+	phalcon_logger_encode_json(&nested, value, 0 TSRMLS_CC);
+	smart_str_appendc(buffer, '"');
+	phalcon_logger_encode_string(buffer, nested.c, nested.len, PHALCON_LOGGER_ENCODING_LOGFMT);
+	smart_str_appendc(buffer, '"');
+	smart_str_free(&nested);
+}
+
+/**
+ * Encodes a log entry in a single pass
+ *
+ * line:   the _format template, %date%, %type% and %message% are replaced
+ * json:   {"time":"...","type":"ERROR","message":"...","context":{...}}
+ * logfmt: time="..." type=ERROR message="..." key=value ...
+ */
+static void phalcon_logger_encode(zval *return_value, int encoding, zval *format, zval *date, zval *type, zval *message, zval *context TSRMLS_DC){
+
+	smart_str buffer = { NULL, 0, 0 };
+	const char *cursor, *end, *start;
+	HashPosition pos;
+	zval **value;
+	char *key;
+	uint key_length, i;
+	ulong index;
+
+	if (encoding == PHALCON_LOGGER_ENCODING_JSON) {
+
+		smart_str_appendl(&buffer, "{\"time\":", 8);
+		phalcon_logger_encode_json(&buffer, date, 0 TSRMLS_CC);
+		smart_str_appendl(&buffer, ",\"type\":", 8);
+		phalcon_logger_encode_json(&buffer, type, 0 TSRMLS_CC);
+		smart_str_appendl(&buffer, ",\"message\":\"", 12);
+		phalcon_logger_encode_message(&buffer, message, context, encoding TSRMLS_CC);
+		smart_str_appendc(&buffer, '"');
+		if (context && Z_TYPE_P(context) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(context))) {
+			smart_str_appendl(&buffer, ",\"context\":", 11);
+			phalcon_logger_encode_json(&buffer, context, 0 TSRMLS_CC);
+		}
+		smart_str_appendc(&buffer, '}');
+
+	} else if (encoding == PHALCON_LOGGER_ENCODING_LOGFMT) {
+
+		smart_str_appendl(&buffer, "time=", 5);
+		phalcon_logger_encode_logfmt(&buffer, date TSRMLS_CC);
+		smart_str_appendl(&buffer, " type=", 6);
+		phalcon_logger_encode_logfmt(&buffer, type TSRMLS_CC);
+		smart_str_appendl(&buffer, " message=\"", 10);
+		phalcon_logger_encode_message(&buffer, message, context, encoding TSRMLS_CC);
+		smart_str_appendc(&buffer, '"');
+
+		if (context && Z_TYPE_P(context) == IS_ARRAY) {
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(context), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(context), (void **) &value, &pos) == SUCCESS) {
+				smart_str_appendc(&buffer, ' ');
+				if (zend_hash_get_current_key_ex(Z_ARRVAL_P(context), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+					for (i = 0; i < key_length - 1; i++) {
+						if ((unsigned char) key[i] <= ' ' || key[i] == '=' || key[i] == '"') {
+							smart_str_appendc(&buffer, '_');
+						} else {
+							smart_str_appendc(&buffer, key[i]);
+						}
+					}
+				} else {
+					smart_str_append_unsigned(&buffer, index);
+				}
+				smart_str_appendc(&buffer, '=');
+				phalcon_logger_encode_logfmt(&buffer, *value TSRMLS_CC);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(context), &pos);
+			}
+		}
+
+	} else {
+
+		/** 
+		 * A single scan of the template replaces the three wildcards
+		 */
+		if (Z_TYPE_P(format) == IS_STRING) {
+			cursor = start = Z_STRVAL_P(format);
+			end = cursor + Z_STRLEN_P(format);
+			while (cursor < end) {
+				if (*cursor == '%') {
+					if (end - cursor >= 6 && !memcmp(cursor, "%date%", 6)) {
+						smart_str_appendl(&buffer, start, cursor - start);
+						phalcon_logger_encode_scalar(&buffer, date, encoding TSRMLS_CC);
+						cursor += 6;
+						start = cursor;
+						continue;
+					}
+					if (end - cursor >= 6 && !memcmp(cursor, "%type%", 6)) {
+						smart_str_appendl(&buffer, start, cursor - start);
+						phalcon_logger_encode_scalar(&buffer, type, encoding TSRMLS_CC);
+						cursor += 6;
+						start = cursor;
+						continue;
+					}
+					if (end - cursor >= 9 && !memcmp(cursor, "%message%", 9)) {
+						smart_str_appendl(&buffer, start, cursor - start);
+						phalcon_logger_encode_message(&buffer, message, context, encoding TSRMLS_CC);
+						cursor += 9;
+						start = cursor;
+						continue;
+					}
+				}
+				cursor++;
+			}
+			smart_str_appendl(&buffer, start, end - start);
+		}
+	}
+
+	smart_str_0(&buffer);
+
+	if (buffer.c) {
+		RETURN_STRINGL(buffer.c, buffer.len, 0);
+	}
+
+	RETURN_EMPTY_STRING();
+}
+
+/**
+ * Returns the name of a log type, the same names getTypeString returns
+ */
+static const char *phalcon_logger_type_name(long type){
+
+	static const char *names[] = {
+		"EMERGENCE", "CRITICAL", "ALERT", "ERROR", "WARNING", "NOTICE", "INFO", "DEBUG", "CUSTOM", "SPECIAL"
+	};
+
+	if (type < 0 || type > 9) {
+		return "CUSTOM";
+	}
+
+	return names[type];
+}
+
 /**
  * Set the log format
  *
@@ -86,23 +568,65 @@ PHP_METHOD(Phalcon_Logger_Adapter, getFormat){
 	RETURN_MEMBER(this_ptr, "_format");
 }
 
+/**
+ * Sets how the entries are encoded: Phalcon\Logger::ENCODING_LINE (the format template),
+ * Phalcon\Logger::ENCODING_JSON or Phalcon\Logger::ENCODING_LOGFMT
+ *
+ * @param int $encoding
+ */
+PHP_METHOD(Phalcon_Logger_Adapter, setEncoding){
+
+	zval *encoding;
+	long value;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &encoding) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	value = phalcon_get_intval(encoding);
+	if (value < PHALCON_LOGGER_ENCODING_LINE || value > PHALCON_LOGGER_ENCODING_LOGFMT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_logger_exception_ce, "Unknown log encoding");
+		return;
+	}
+	
+	phalcon_update_property_long(this_ptr, SL("_encoding"), value TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns how the entries are encoded
+ *
+ * @return int
+ */
+PHP_METHOD(Phalcon_Logger_Adapter, getEncoding){
+
+
+	RETURN_MEMBER(this_ptr, "_encoding");
+}
+
 /**
  * Applies the internal format to the message
  *
  * @param  string $message
  * @param  int $type
  * @param  int $time
+ * @param  array $context
  * @return string
  */
 PHP_METHOD(Phalcon_Logger_Adapter, _applyFormat){
 
-	zval *message, *type, *time = NULL, *format = NULL, *date_format;
-	zval *date, *date_wildcard, *new_format = NULL, *type_string;
-	zval *type_wildcard, *message_wildcard;
+	zval *message, *type, *time = NULL, *context = NULL, *format = NULL;
+	zval *date_format, *date = NULL, *type_string, *cached_time;
+	zval *cached_date_format, *encoding;
+	zend_function *method;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|z", &message, &type, &time) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|zz", &message, &type, &time, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -116,7 +640,7 @@ PHP_METHOD(Phalcon_Logger_Adapter, _applyFormat){
 	
 	if (!zend_is_true(time)) {
 		PHALCON_INIT_NVAR(time);
-		PHALCON_CALL_FUNC(time, "time");
+		ZVAL_LONG(time, phalcon_logger_adapter_now());
 	}
 	
 	PHALCON_INIT_VAR(format);
@@ -125,31 +649,50 @@ PHP_METHOD(Phalcon_Logger_Adapter, _applyFormat){
 	PHALCON_INIT_VAR(date_format);
 	phalcon_read_property(&date_format, this_ptr, SL("_dateFormat"), PH_NOISY_CC);
 	
-	PHALCON_INIT_VAR(date);
-	PHALCON_CALL_FUNC_PARAMS_2(date, "date", date_format, time);
-	
-	PHALCON_INIT_VAR(date_wildcard);
-	ZVAL_STRING(date_wildcard, "%date%", 1);
+	/** 
+	 * The date only changes once per second, the last formatted one is reused while the
+	 * timestamp and the date format stay the same
+	 */
+	PHALCON_INIT_VAR(cached_time);
+	phalcon_read_property(&cached_time, this_ptr, SL("_cachedTime"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(cached_date_format);
+	phalcon_read_property(&cached_date_format, this_ptr, SL("_cachedDateFormat"), PH_NOISY_CC);
+	if (Z_TYPE_P(time) == IS_LONG && Z_TYPE_P(cached_time) == IS_LONG && Z_LVAL_P(time) == Z_LVAL_P(cached_time)) {
+		if (Z_TYPE_P(date_format) == IS_STRING && Z_TYPE_P(cached_date_format) == IS_STRING) {
+			if (Z_STRLEN_P(date_format) == Z_STRLEN_P(cached_date_format) && !memcmp(Z_STRVAL_P(date_format), Z_STRVAL_P(cached_date_format), Z_STRLEN_P(date_format))) {
+				PHALCON_INIT_VAR(date);
+				phalcon_read_property(&date, this_ptr, SL("_cachedDate"), PH_NOISY_CC);
+			}
+		}
+	}
 	
-	PHALCON_INIT_VAR(new_format);
-	phalcon_fast_str_replace(new_format, date_wildcard, date, format TSRMLS_CC);
+	if (!date) {
+		PHALCON_INIT_VAR(date);
+		PHALCON_CALL_FUNC_PARAMS_2(date, "date", date_format, time);
+		if (Z_TYPE_P(time) == IS_LONG) {
+			phalcon_update_property_zval(this_ptr, SL("_cachedTime"), time TSRMLS_CC);
+			phalcon_update_property_zval(this_ptr, SL("_cachedDate"), date TSRMLS_CC);
+			phalcon_update_property_zval(this_ptr, SL("_cachedDateFormat"), date_format TSRMLS_CC);
+		}
+	}
 	
+	/** 
+	 * Type names are resolved natively unless getTypeString is overridden
+	 */
 	PHALCON_INIT_VAR(type_string);
-	PHALCON_CALL_METHOD_PARAMS_1(type_string, this_ptr, "gettypestring", type, PH_NO_CHECK);
-	
-	PHALCON_INIT_VAR(type_wildcard);
-	ZVAL_STRING(type_wildcard, "%type%", 1);
-	
-	PHALCON_INIT_NVAR(format);
-	phalcon_fast_str_replace(format, type_wildcard, type_string, new_format TSRMLS_CC);
+	if (Z_TYPE_P(type) == IS_LONG && zend_hash_find(&Z_OBJCE_P(this_ptr)->function_table, SS("gettypestring"), (void **) &method) == SUCCESS && method->common.scope == phalcon_logger_adapter_ce) {
+		ZVAL_STRING(type_string, phalcon_logger_type_name(Z_LVAL_P(type)), 1);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_1(type_string, this_ptr, "gettypestring", type, PH_NO_CHECK);
+	}
 	
-	PHALCON_INIT_VAR(message_wildcard);
-	ZVAL_STRING(message_wildcard, "%message%", 1);
+	PHALCON_INIT_VAR(encoding);
+	phalcon_read_property(&encoding, this_ptr, SL("_encoding"), PH_NOISY_CC);
 	
-	PHALCON_INIT_NVAR(new_format);
-	phalcon_fast_str_replace(new_format, message_wildcard, message, format TSRMLS_CC);
+	phalcon_logger_encode(return_value, phalcon_get_intval(encoding), format, date, type_string, message, context TSRMLS_CC);
 	
-	RETURN_CTOR(new_format);
+	PHALCON_MM_RESTORE();
 }
 
 /**
@@ -270,22 +813,26 @@ PHP_METHOD(Phalcon_Logger_Adapter, getTypeString){
   * Sends/Writes a debug message to the log
   *
   * @param string $message
-  * @param ing $type
+  * @param array $context
   */
 PHP_METHOD(Phalcon_Logger_Adapter, debug){
 
-	zval *message, *type;
+	zval *message, *context = NULL, *type;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &message) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_INIT_VAR(type);
 	phalcon_get_class_constant(type, phalcon_logger_ce, SS("DEBUG") TSRMLS_CC);
-	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	if (context) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "log", message, type, context, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -294,22 +841,26 @@ PHP_METHOD(Phalcon_Logger_Adapter, debug){
   * Sends/Writes an error message to the log
   *
   * @param string $message
-  * @param ing $type
+  * @param array $context
   */
 PHP_METHOD(Phalcon_Logger_Adapter, error){
 
-	zval *message, *type;
+	zval *message, *context = NULL, *type;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &message) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_INIT_VAR(type);
 	phalcon_get_class_constant(type, phalcon_logger_ce, SS("ERROR") TSRMLS_CC);
-	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	if (context) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "log", message, type, context, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -318,22 +869,26 @@ PHP_METHOD(Phalcon_Logger_Adapter, error){
   * Sends/Writes an info message to the log
   *
   * @param string $message
-  * @param ing $type
+  * @param array $context
   */
 PHP_METHOD(Phalcon_Logger_Adapter, info){
 
-	zval *message, *type;
+	zval *message, *context = NULL, *type;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &message) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_INIT_VAR(type);
 	phalcon_get_class_constant(type, phalcon_logger_ce, SS("INFO") TSRMLS_CC);
-	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	if (context) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "log", message, type, context, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -342,22 +897,26 @@ PHP_METHOD(Phalcon_Logger_Adapter, info){
   * Sends/Writes a notice message to the log
   *
   * @param string $message
-  * @param ing $type
+  * @param array $context
   */
 PHP_METHOD(Phalcon_Logger_Adapter, notice){
 
-	zval *message, *type;
+	zval *message, *context = NULL, *type;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &message) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_INIT_VAR(type);
 	phalcon_get_class_constant(type, phalcon_logger_ce, SS("NOTICE") TSRMLS_CC);
-	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	if (context) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "log", message, type, context, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -366,22 +925,26 @@ PHP_METHOD(Phalcon_Logger_Adapter, notice){
   * Sends/Writes a warning message to the log
   *
   * @param string $message
-  * @param ing $type
+  * @param array $context
   */
 PHP_METHOD(Phalcon_Logger_Adapter, warning){
 
-	zval *message, *type;
+	zval *message, *context = NULL, *type;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &message) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_INIT_VAR(type);
 	phalcon_get_class_constant(type, phalcon_logger_ce, SS("WARNING") TSRMLS_CC);
-	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	if (context) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "log", message, type, context, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -390,22 +953,26 @@ PHP_METHOD(Phalcon_Logger_Adapter, warning){
   * Sends/Writes an alert message to the log
   *
   * @param string $message
-  * @param ing $type
+  * @param array $context
   */
 PHP_METHOD(Phalcon_Logger_Adapter, alert){
 
-	zval *message, *type;
+	zval *message, *context = NULL, *type;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &message) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	PHALCON_INIT_VAR(type);
 	phalcon_get_class_constant(type, phalcon_logger_ce, SS("ALERT") TSRMLS_CC);
-	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	if (context) {
+		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(this_ptr, "log", message, type, context, PH_NO_CHECK);
+	} else {
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "log", message, type, PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
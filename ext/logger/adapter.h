@@ -23,6 +23,8 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Adapter);
 
 PHP_METHOD(Phalcon_Logger_Adapter, setFormat);
 PHP_METHOD(Phalcon_Logger_Adapter, getFormat);
+PHP_METHOD(Phalcon_Logger_Adapter, setEncoding);
+PHP_METHOD(Phalcon_Logger_Adapter, getEncoding);
 PHP_METHOD(Phalcon_Logger_Adapter, _applyFormat);
 PHP_METHOD(Phalcon_Logger_Adapter, setDateFormat);
 PHP_METHOD(Phalcon_Logger_Adapter, getDateFormat);
@@ -39,6 +41,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_setformat, 0, 0, 1)
 	ZEND_ARG_INFO(0, format)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_setencoding, 0, 0, 1)
+	ZEND_ARG_INFO(0, encoding)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_setdateformat, 0, 0, 1)
 	ZEND_ARG_INFO(0, date)
 ZEND_END_ARG_INFO()
@@ -49,26 +55,32 @@ ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_debug, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_error, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_info, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_notice, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_warning, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_alert, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_log, 0, 0, 2)
@@ -79,6 +91,8 @@ ZEND_END_ARG_INFO()
 PHALCON_INIT_FUNCS(phalcon_logger_adapter_method_entry){
 	PHP_ME(Phalcon_Logger_Adapter, setFormat, arginfo_phalcon_logger_adapter_setformat, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter, getFormat, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter, setEncoding, arginfo_phalcon_logger_adapter_setencoding, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter, getEncoding, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter, _applyFormat, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Logger_Adapter, setDateFormat, arginfo_phalcon_logger_adapter_setdateformat, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter, getDateFormat, NULL, ZEND_ACC_PUBLIC) 
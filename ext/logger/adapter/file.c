@@ -38,6 +38,7 @@
 #include "kernel/exception.h"
 #include "kernel/fcall.h"
 #include "kernel/concat.h"
+#include "kernel/operators.h"
 
 /**
  * Phalcon\Logger\Adapter\File
@@ -51,6 +52,14 @@
  *$logger->error("This is another error");
  *$logger->close();
  *</code>
+ *
+ * The "buffer" option keeps the formatted lines in memory and writes them at once when they reach
+ * that many bytes, when an error (or more severe) message is logged, on flush/close and when the
+ * logger is destroyed at the end of the request
+ *
+ *<code>
+ *$logger = new Phalcon\Logger\Adapter\File("app/logs/debug.log", array('buffer' => 65536));
+ *</code>
  */
 
 
@@ -66,6 +75,9 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Adapter_File){
 	zend_declare_property_null(phalcon_logger_adapter_file_ce, SL("_path"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_logger_adapter_file_ce, SL("_options"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_logger_adapter_file_ce, SL("_quenue"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_adapter_file_ce, SL("_buffer"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_logger_adapter_file_ce, SL("_bufferSize"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_logger_adapter_file_ce, SL("_bufferLimit"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_logger_adapter_file_ce TSRMLS_CC, 1, phalcon_logger_adapterinterface_ce);
 
@@ -81,11 +93,13 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Adapter_File){
 PHP_METHOD(Phalcon_Logger_Adapter_File, __construct){
 
 	zval *name, *options = NULL, *mode = NULL, *handler, *exception_message;
+	zval *buffer_limit;
 	int eval_int;
 
 	PHALCON_MM_GROW();
 
 	phalcon_update_property_empty_array(phalcon_logger_adapter_file_ce, this_ptr, SL("_quenue") TSRMLS_CC);
+	phalcon_update_property_empty_array(phalcon_logger_adapter_file_ce, this_ptr, SL("_buffer") TSRMLS_CC);
 	
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &name, &options) == FAILURE) {
 		PHALCON_MM_RESTORE();
@@ -119,6 +133,16 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, __construct){
 		return;
 	}
 	
+	/** 
+	 * Lines are buffered up to this number of bytes
+	 */
+	eval_int = phalcon_array_isset_string(options, SS("buffer"));
+	if (eval_int) {
+		PHALCON_INIT_VAR(buffer_limit);
+		phalcon_array_fetch_string(&buffer_limit, options, SL("buffer"), PH_NOISY_CC);
+		phalcon_update_property_long(this_ptr, SL("_bufferLimit"), phalcon_get_intval(buffer_limit) TSRMLS_CC);
+	}
+	
 	phalcon_update_property_zval(this_ptr, SL("_path"), name TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_options"), options TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_fileHandler"), handler TSRMLS_CC);
@@ -131,17 +155,18 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, __construct){
  *
  * @param string $message
  * @param int $type
+ * @param array $context
  */
 PHP_METHOD(Phalcon_Logger_Adapter_File, log){
 
-	zval *message, *type = NULL, *file_handler, *transaction;
+	zval *message, *type = NULL, *context = NULL, *file_handler, *transaction;
 	zval *time, *quenue_item, *applied_format, *eol;
-	zval *applied_eol;
+	zval *applied_eol, *buffer_limit, *buffer, *buffer_size;
 	zval *t0 = NULL;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &message, &type) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|zz", &message, &type, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -151,6 +176,10 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, log){
 		ZVAL_LONG(type, 7);
 	}
 	
+	if (!context) {
+		PHALCON_INIT_NVAR(context);
+	}
+	
 	PHALCON_INIT_VAR(file_handler);
 	phalcon_read_property(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
 	if (!zend_is_true(file_handler)) {
@@ -166,25 +195,89 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, log){
 	
 		PHALCON_INIT_VAR(quenue_item);
 		object_init_ex(quenue_item, phalcon_logger_item_ce);
-		PHALCON_CALL_METHOD_PARAMS_3_NORETURN(quenue_item, "__construct", message, type, time, PH_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_4_NORETURN(quenue_item, "__construct", message, type, time, context, PH_CHECK);
 	
 		PHALCON_INIT_VAR(t0);
 		phalcon_read_property(&t0, this_ptr, SL("_quenue"), PH_NOISY_CC);
 		phalcon_array_append(&t0, quenue_item, 0 TSRMLS_CC);
 		phalcon_update_property_zval(this_ptr, SL("_quenue"), t0 TSRMLS_CC);
 	} else {
+		PHALCON_INIT_VAR(time);
+	
 		PHALCON_INIT_VAR(applied_format);
-		PHALCON_CALL_METHOD_PARAMS_2(applied_format, this_ptr, "_applyformat", message, type, PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_4(applied_format, this_ptr, "_applyformat", message, type, time, context, PH_NO_CHECK);
 	
 		PHALCON_INIT_VAR(eol);
 		zend_get_constant(SL("PHP_EOL"), eol TSRMLS_CC);
 	
 		PHALCON_INIT_VAR(applied_eol);
 		PHALCON_CONCAT_VV(applied_eol, applied_format, eol);
-		PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", file_handler, applied_eol);
+	
+		PHALCON_INIT_VAR(buffer_limit);
+		phalcon_read_property(&buffer_limit, this_ptr, SL("_bufferLimit"), PH_NOISY_CC);
+		if (phalcon_get_intval(buffer_limit) > 0) {
+	
+			/** 
+			 * Buffered mode: the line is kept until the buffer is full or the message is severe
+			 */
+			PHALCON_INIT_VAR(buffer);
+			phalcon_read_property(&buffer, this_ptr, SL("_buffer"), PH_NOISY_CC);
+			if (Z_TYPE_P(buffer) != IS_ARRAY) {
+				PHALCON_INIT_NVAR(buffer);
+				array_init(buffer);
+			}
+			phalcon_array_append(&buffer, applied_eol, 0 TSRMLS_CC);
+			phalcon_update_property_zval(this_ptr, SL("_buffer"), buffer TSRMLS_CC);
+	
+			PHALCON_INIT_VAR(buffer_size);
+			phalcon_read_property(&buffer_size, this_ptr, SL("_bufferSize"), PH_NOISY_CC);
+			phalcon_update_property_long(this_ptr, SL("_bufferSize"), phalcon_get_intval(buffer_size) + Z_STRLEN_P(applied_eol) TSRMLS_CC);
+	
+			if (phalcon_get_intval(buffer_size) + Z_STRLEN_P(applied_eol) >= phalcon_get_intval(buffer_limit) || phalcon_get_intval(type) <= 3) {
+				PHALCON_CALL_METHOD_NORETURN(this_ptr, "flush", PH_NO_CHECK);
+			}
+		} else {
+			PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", file_handler, applied_eol);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Writes the buffered lines to the file in a single write
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Logger_Adapter_File, flush){
+
+	zval *buffer, *file_handler, *lines;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(buffer);
+	phalcon_read_property(&buffer, this_ptr, SL("_buffer"), PH_NOISY_CC);
+	if (Z_TYPE_P(buffer) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(buffer))) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(file_handler);
+	phalcon_read_property(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
+	if (!zend_is_true(file_handler)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_logger_exception_ce, "Cannot send message to the log because it is invalid");
+		return;
 	}
 	
+	PHALCON_INIT_VAR(lines);
+	phalcon_fast_join_str(lines, SL(""), buffer TSRMLS_CC);
+	
+	phalcon_update_property_empty_array(phalcon_logger_adapter_file_ce, this_ptr, SL("_buffer") TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_bufferSize"), 0 TSRMLS_CC);
+	PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", file_handler, lines);
+	
 	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
 }
 
 /**
@@ -205,8 +298,9 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, begin){
 PHP_METHOD(Phalcon_Logger_Adapter_File, commit){
 
 	zval *transaction, *file_handler, *quenue, *eol;
-	zval *message = NULL, *message_str = NULL, *type = NULL, *time = NULL, *applied_format = NULL;
-	zval *applied_eol = NULL;
+	zval *message = NULL, *message_str = NULL, *type = NULL, *time = NULL, *context = NULL;
+	zval *applied_format = NULL;
+	zval *applied_eol = NULL, *lines, *contents;
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
@@ -228,12 +322,28 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, commit){
 	PHALCON_INIT_VAR(quenue);
 	phalcon_read_property(&quenue, this_ptr, SL("_quenue"), PH_NOISY_CC);
 	
+	/** 
+	 * The buffered lines are only taken once the queue is known to be valid
+	 */
+	if (!phalcon_valid_foreach(quenue TSRMLS_CC)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	PHALCON_INIT_VAR(eol);
 	zend_get_constant(SL("PHP_EOL"), eol TSRMLS_CC);
 	
-	if (!phalcon_valid_foreach(quenue TSRMLS_CC)) {
-		return;
+	/** 
+	 * Pending buffered lines go first, the transaction is written with a single write
+	 */
+	PHALCON_INIT_VAR(lines);
+	phalcon_read_property(&lines, this_ptr, SL("_buffer"), PH_NOISY_CC);
+	if (Z_TYPE_P(lines) != IS_ARRAY) {
+		PHALCON_INIT_NVAR(lines);
+		array_init(lines);
 	}
+	phalcon_update_property_empty_array(phalcon_logger_adapter_file_ce, this_ptr, SL("_buffer") TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_bufferSize"), 0 TSRMLS_CC);
 	
 	ah0 = Z_ARRVAL_P(quenue);
 	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
@@ -255,19 +365,28 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, commit){
 		PHALCON_INIT_NVAR(time);
 		PHALCON_CALL_METHOD(time, message, "gettime", PH_NO_CHECK);
 	
+		PHALCON_INIT_NVAR(context);
+		PHALCON_CALL_METHOD(context, message, "getcontext", PH_NO_CHECK);
+	
 		PHALCON_INIT_NVAR(applied_format);
-		PHALCON_CALL_METHOD_PARAMS_3(applied_format, this_ptr, "_applyformat", message_str, type, time, PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_4(applied_format, this_ptr, "_applyformat", message_str, type, time, context, PH_NO_CHECK);
 	
 		PHALCON_INIT_NVAR(applied_eol);
 		PHALCON_CONCAT_VV(applied_eol, applied_format, eol);
-		PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", file_handler, applied_eol);
+		phalcon_array_append(&lines, applied_eol, PH_SEPARATE TSRMLS_CC);
 	
 		zend_hash_move_forward_ex(ah0, &hp0);
 		goto ph_cycle_start_0;
 	
 	ph_cycle_end_0:
-	if(0){}
 	
+	phalcon_update_property_empty_array(phalcon_logger_adapter_file_ce, this_ptr, SL("_quenue") TSRMLS_CC);
+	
+	if (zend_hash_num_elements(Z_ARRVAL_P(lines))) {
+		PHALCON_INIT_VAR(contents);
+		phalcon_fast_join_str(contents, SL(""), lines TSRMLS_CC);
+		PHALCON_CALL_FUNC_PARAMS_2_NORETURN("fwrite", file_handler, contents);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -309,6 +428,8 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, close){
 
 	PHALCON_MM_GROW();
 
+	PHALCON_CALL_METHOD_NORETURN(this_ptr, "flush", PH_NO_CHECK);
+	
 	PHALCON_INIT_VAR(file_handler);
 	phalcon_read_property(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
 	
@@ -346,6 +467,26 @@ PHP_METHOD(Phalcon_Logger_Adapter_File, __wakeup){
 	PHALCON_INIT_VAR(file_handler);
 	PHALCON_CALL_FUNC_PARAMS_2(file_handler, "fopen", path, mode);
 	phalcon_update_property_zval(this_ptr, SL("_fileHandler"), file_handler TSRMLS_CC);
+	phalcon_update_property_empty_array(phalcon_logger_adapter_file_ce, this_ptr, SL("_buffer") TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_bufferSize"), 0 TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Writes the buffered lines when the logger is destroyed
+ */
+PHP_METHOD(Phalcon_Logger_Adapter_File, __destruct){
+
+	zval *file_handler;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(file_handler);
+	phalcon_read_property(&file_handler, this_ptr, SL("_fileHandler"), PH_NOISY_CC);
+	if (Z_TYPE_P(file_handler) == IS_RESOURCE) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "flush", PH_NO_CHECK);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -23,11 +23,13 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Adapter_File);
 
 PHP_METHOD(Phalcon_Logger_Adapter_File, __construct);
 PHP_METHOD(Phalcon_Logger_Adapter_File, log);
+PHP_METHOD(Phalcon_Logger_Adapter_File, flush);
 PHP_METHOD(Phalcon_Logger_Adapter_File, begin);
 PHP_METHOD(Phalcon_Logger_Adapter_File, commit);
 PHP_METHOD(Phalcon_Logger_Adapter_File, rollback);
 PHP_METHOD(Phalcon_Logger_Adapter_File, close);
 PHP_METHOD(Phalcon_Logger_Adapter_File, __wakeup);
+PHP_METHOD(Phalcon_Logger_Adapter_File, __destruct);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_file___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, name)
@@ -37,16 +39,19 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_adapter_file_log, 0, 0, 1)
 	ZEND_ARG_INFO(0, message)
 	ZEND_ARG_INFO(0, type)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 PHALCON_INIT_FUNCS(phalcon_logger_adapter_file_method_entry){
 	PHP_ME(Phalcon_Logger_Adapter_File, __construct, arginfo_phalcon_logger_adapter_file___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Logger_Adapter_File, log, arginfo_phalcon_logger_adapter_file_log, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter_File, flush, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_File, begin, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_File, commit, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_File, rollback, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_File, close, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Adapter_File, __wakeup, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Adapter_File, __destruct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_DTOR) 
 	PHP_FE_END
 };
 
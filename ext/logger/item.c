@@ -52,6 +52,7 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Item){
 	zend_declare_property_null(phalcon_logger_item_ce, SL("_type"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_logger_item_ce, SL("_message"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_logger_item_ce, SL("_time"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_logger_item_ce, SL("_context"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
@@ -62,14 +63,15 @@ PHALCON_INIT_CLASS(Phalcon_Logger_Item){
  * @param string $message
  * @param integer $type
  * @param integer $time
+ * @param array $context
  */
 PHP_METHOD(Phalcon_Logger_Item, __construct){
 
-	zval *message, *type, *time = NULL;
+	zval *message, *type, *time = NULL, *context = NULL;
 
 	PHALCON_MM_GROW();
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|z", &message, &type, &time) == FAILURE) {
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|zz", &message, &type, &time, &context) == FAILURE) {
 		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
@@ -82,6 +84,9 @@ PHP_METHOD(Phalcon_Logger_Item, __construct){
 	phalcon_update_property_zval(this_ptr, SL("_message"), message TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_type"), type TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_time"), time TSRMLS_CC);
+	if (context) {
+		phalcon_update_property_zval(this_ptr, SL("_context"), context TSRMLS_CC);
+	}
 	
 	PHALCON_MM_RESTORE();
 }
@@ -119,3 +124,14 @@ PHP_METHOD(Phalcon_Logger_Item, getTime){
 	RETURN_MEMBER(this_ptr, "_time");
 }
 
+/**
+ * Returns the context of the message
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Logger_Item, getContext){
+
+
+	RETURN_MEMBER(this_ptr, "_context");
+}
+
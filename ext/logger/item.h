@@ -25,11 +25,13 @@ PHP_METHOD(Phalcon_Logger_Item, __construct);
 PHP_METHOD(Phalcon_Logger_Item, getMessage);
 PHP_METHOD(Phalcon_Logger_Item, getType);
 PHP_METHOD(Phalcon_Logger_Item, getTime);
+PHP_METHOD(Phalcon_Logger_Item, getContext);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_logger_item___construct, 0, 0, 2)
 	ZEND_ARG_INFO(0, message)
 	ZEND_ARG_INFO(0, type)
 	ZEND_ARG_INFO(0, time)
+	ZEND_ARG_INFO(0, context)
 ZEND_END_ARG_INFO()
 
 PHALCON_INIT_FUNCS(phalcon_logger_item_method_entry){
@@ -37,6 +39,7 @@ PHALCON_INIT_FUNCS(phalcon_logger_item_method_entry){
 	PHP_ME(Phalcon_Logger_Item, getMessage, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Item, getType, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Logger_Item, getTime, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Logger_Item, getContext, NULL, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -91,6 +91,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model){
 	zend_declare_property_bool(phalcon_mvc_model_ce, SL("_forceExists"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_ce, SL("_connection"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_string(phalcon_mvc_model_ce, SL("_connectionService"), "db", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_ce, SL("_readConnectionService"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_ce, SL("_transaction"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_ce, SL("_uniqueKey"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_ce, SL("_uniqueParams"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_ce, SL("_uniqueTypes"), ZEND_ACC_PROTECTED TSRMLS_CC);
@@ -216,6 +218,73 @@ PHP_METHOD(Phalcon_Mvc_Model, getEventsManager){
 	RETURN_MEMBER(this_ptr, "_eventsManager");
 }
 
+/**
+ * Passes the model to a method of the models manager, managers that don't implement the method
+ * are skipped
+ */
+static void phalcon_mvc_model_notify_manager(zval *model, char *method_name, unsigned int method_length TSRMLS_DC){
+
+	zval *dependency_injector, *service, *manager;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(dependency_injector);
+	phalcon_read_property(&dependency_injector, model, SL("_dependencyInjector"), PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(service);
+	ZVAL_STRING(service, "modelsManager", 1);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", service, PH_NO_CHECK);
+	if (Z_TYPE_P(manager) == IS_OBJECT) {
+		if (phalcon_method_exists_ex(manager, method_name, method_length TSRMLS_CC) == SUCCESS) {
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, method_name, model, PH_NO_CHECK);
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Tells the models manager that the table of the model was written, cached PHQL results
+ * with automatic keys that read the table are not used anymore and the following reads
+ * go to the primary connection
+ */
+static void phalcon_mvc_model_notify_write(zval *model TSRMLS_DC){
+
+	zval *transaction;
+
+	phalcon_mvc_model_notify_manager(model, SS("invalidatecache") TSRMLS_CC);
+	if (EG(exception)) {
+		return;
+	}
+
+	phalcon_mvc_model_notify_manager(model, SS("markwritten") TSRMLS_CC);
+	if (EG(exception)) {
+		return;
+	}
+
+	/** 
+	 * Other requests can cache the old rows under the new generation until the transaction
+	 * ends, the transaction gives the table another generation when it commits or rolls back
+	 */
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(transaction);
+	phalcon_read_property(&transaction, model, SL("_transaction"), PH_NOISY_CC);
+	if (Z_TYPE_P(transaction) == IS_OBJECT) {
+		if (phalcon_method_exists_ex(transaction, SS("addwrittenmodel") TSRMLS_CC) == SUCCESS) {
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(transaction, "addwrittenmodel", model, PH_NO_CHECK);
+		}
+	}
+
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Sets a transaction related to the Model instance
  *
@@ -268,6 +337,12 @@ PHP_METHOD(Phalcon_Mvc_Model, setTransaction){
 		PHALCON_INIT_VAR(connection);
 		PHALCON_CALL_METHOD(connection, transaction, "getconnection", PH_NO_CHECK);
 		phalcon_update_property_zval(this_ptr, SL("_connection"), connection TSRMLS_CC);
+		phalcon_update_property_zval(this_ptr, SL("_transaction"), transaction TSRMLS_CC);
+	
+		/** 
+		 * Reads are not sent to the replicas while a transaction is involved
+		 */
+		phalcon_mvc_model_notify_manager(this_ptr, SS("markwritten") TSRMLS_CC);
 	} else {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Transaction should be an object");
 		return;
@@ -381,6 +456,37 @@ PHP_METHOD(Phalcon_Mvc_Model, getConnectionService){
 	RETURN_MEMBER(this_ptr, "_connectionService");
 }
 
+/**
+ * Sets the DependencyInjection connection service used for reads. It can be a list of
+ * services, the SELECTs are balanced among them. Writes always use the connection service
+ *
+ * @param string|array $connectionService
+ * @return Phalcon\Mvc\Model
+ */
+PHP_METHOD(Phalcon_Mvc_Model, setReadConnectionService){
+
+	zval *connection_service;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &connection_service) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	phalcon_update_property_zval(this_ptr, SL("_readConnectionService"), connection_service TSRMLS_CC);
+	
+	RETURN_CTORW(this_ptr);
+}
+
+/**
+ * Returns the DependencyInjection connection service used for reads
+ *
+ * @return string|array
+ */
+PHP_METHOD(Phalcon_Mvc_Model, getReadConnectionService){
+
+
+	RETURN_MEMBER(this_ptr, "_readConnectionService");
+}
+
 /**
  * Forces that model doesn't need to be checked if exists before store it
  *
@@ -427,6 +533,45 @@ PHP_METHOD(Phalcon_Mvc_Model, getConnection){
 	RETURN_CCTOR(connection);
 }
 
+/**
+ * Gets the connection used to read the model, the internal database connection is
+ * returned if there is no read connection service
+ *
+ * @return Phalcon\Db\AdapterInterface
+ */
+PHP_METHOD(Phalcon_Mvc_Model, getReadConnection){
+
+	zval *read_service, *connection = NULL, *dependency_injector;
+	zval *service, *manager;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(read_service);
+	PHALCON_CALL_METHOD(read_service, this_ptr, "getreadconnectionservice", PH_NO_CHECK);
+	if (!zend_is_true(read_service)) {
+		PHALCON_INIT_VAR(connection);
+		PHALCON_CALL_METHOD(connection, this_ptr, "getconnection", PH_NO_CHECK);
+		RETURN_CCTOR(connection);
+	}
+	
+	/** 
+	 * The models manager balances the replicas and knows if the request already wrote
+	 */
+	PHALCON_INIT_VAR(dependency_injector);
+	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(service);
+	ZVAL_STRING(service, "modelsManager", 1);
+	
+	PHALCON_INIT_VAR(manager);
+	PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", service, PH_NO_CHECK);
+	
+	PHALCON_INIT_NVAR(connection);
+	PHALCON_CALL_METHOD_PARAMS_1(connection, manager, "getreadconnection", this_ptr, PH_NO_CHECK);
+	
+	RETURN_CCTOR(connection);
+}
+
 /**
  * Assigns values to a model from an array returning a new model.
  *
@@ -2778,6 +2923,9 @@ PHP_METHOD(Phalcon_Mvc_Model, _doLowInsert){
 		phalcon_update_property_zval_zval(this_ptr, attribute_field, last_insert_id TSRMLS_CC);
 	}
 	
+	if (zend_is_true(success)) {
+		phalcon_mvc_model_notify_write(this_ptr TSRMLS_CC);
+	}
 	
 	RETURN_CCTOR(success);
 }
@@ -2929,6 +3077,9 @@ PHP_METHOD(Phalcon_Mvc_Model, _doLowUpdate){
 	 */
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_METHOD_PARAMS_5(success, connection, "update", table, fields, values, conditions, bind_types, PH_NO_CHECK);
+	if (zend_is_true(success)) {
+		phalcon_mvc_model_notify_write(this_ptr TSRMLS_CC);
+	}
 	
 	RETURN_CCTOR(success);
 }
@@ -3668,6 +3819,7 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_METHOD_PARAMS_4(success, connection, "delete", table, conditions, values, bind_types, PH_NO_CHECK);
 	if (zend_is_true(success)) {
+		phalcon_mvc_model_notify_write(this_ptr TSRMLS_CC);
 		if (!zend_is_true(disable_events)) {
 			PHALCON_INIT_NVAR(event_name);
 			ZVAL_STRING(event_name, "afterDelete", 1);
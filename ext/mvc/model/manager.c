@@ -28,6 +28,8 @@
 #include "Zend/zend_operators.h"
 #include "Zend/zend_exceptions.h"
 #include "Zend/zend_interfaces.h"
+#include "ext/standard/php_rand.h"
+#include "ext/standard/php_lcg.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -60,6 +62,49 @@
  * </code>
  */
 
+/**
+ * Generations are unique values, a table that gets a new one is never seen again with an old one
+ * even if the previous generation was evicted from the cache. The random part keeps them unique
+ * among hosts whose clocks are not in sync
+ */
+static void phalcon_mvc_model_manager_new_generation(zval *generation TSRMLS_DC){
+
+	struct timeval tv;
+	unsigned long random;
+
+	gettimeofday(&tv, NULL);
+	random = (unsigned long) (php_combined_lcg(TSRMLS_C) * 0xFFFFFFFFUL);
+	Z_STRLEN_P(generation) = spprintf(&Z_STRVAL_P(generation), 0, "%lx%05lx%08lx", (long) tv.tv_sec, (long) tv.tv_usec, random);
+	Z_TYPE_P(generation) = IS_STRING;
+}
+
+/**
+ * Builds the key where the generation of the table of a model is kept, tables are namespaced by
+ * the connection service of the model so equally named tables in other databases don't share it
+ */
+static void phalcon_mvc_model_manager_generation_key(zval *key, zval *model TSRMLS_DC){
+
+	zval *connection_service, *schema, *source;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(connection_service);
+	PHALCON_CALL_METHOD(connection_service, model, "getconnectionservice", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(schema);
+	PHALCON_CALL_METHOD(schema, model, "getschema", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(source);
+	PHALCON_CALL_METHOD(source, model, "getsource", PH_NO_CHECK);
+	
+	if (zend_is_true(schema)) {
+		PHALCON_CONCAT_SVSVSV(key, "phalcon-gen-", connection_service, ":", schema, ".", source);
+	} else {
+		PHALCON_CONCAT_SVSV(key, "phalcon-gen-", connection_service, ":", source);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
 
 /**
  * Phalcon\Mvc\Model\Manager initializer
@@ -75,6 +120,9 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Manager){
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_belongsTo"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_initialized"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_lastInitialized"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_cacheService"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_readPositions"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_written"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_model_manager_ce TSRMLS_CC, 3, phalcon_mvc_model_managerinterface_ce, phalcon_di_injectionawareinterface_ce, phalcon_events_eventsawareinterface_ce);
 
@@ -95,6 +143,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, __construct){
 	
 	phalcon_update_property_empty_array(phalcon_mvc_model_manager_ce, this_ptr, SL("_initialized") TSRMLS_CC);
 	
+	phalcon_update_property_empty_array(phalcon_mvc_model_manager_ce, this_ptr, SL("_readPositions") TSRMLS_CC);
+	
+	phalcon_update_property_empty_array(phalcon_mvc_model_manager_ce, this_ptr, SL("_written") TSRMLS_CC);
+	
 }
 
 /**
@@ -1386,3 +1438,308 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, createBuilder){
 	RETURN_CTOR(query);
 }
 
+/**
+ * Sets the cache service where the generations of the tables are kept. Cached PHQL results
+ * using the 'auto' option are keyed by the generations of the tables they read, writes
+ * made through the ORM give a new generation to the table
+ *
+ *<code>
+ * $manager->setCacheService('modelsCache');
+ *
+ * $robots = Robots::find(array(
+ *     "type = 'mechanical'",
+ *     "cache" => array("auto" => true)
+ * ));
+ *</code>
+ *
+ * @param string $service
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, setCacheService){
+
+	zval *service;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &service) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	phalcon_update_property_zval(this_ptr, SL("_cacheService"), service TSRMLS_CC);
+	
+}
+
+/**
+ * Returns the cache service where the generations of the tables are kept
+ *
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getCacheService){
+
+
+	RETURN_MEMBER(this_ptr, "_cacheService");
+}
+
+/**
+ * Returns the current generations of the tables of the passed models, tables without a
+ * generation get a new one
+ *
+ * @param array $models
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getCacheGenerations){
+
+	zval *models, *cache_service, *dependency_injector, *cache;
+	zval *generations, *model = NULL, *key = NULL, *generation = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &models) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(cache_service);
+	phalcon_read_property(&cache_service, this_ptr, SL("_cacheService"), PH_NOISY_CC);
+	if (Z_TYPE_P(cache_service) == IS_NULL) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A cache service for the table generations must be set with setCacheService()");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injection object is required to access ORM services");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(cache);
+	PHALCON_CALL_METHOD_PARAMS_1(cache, dependency_injector, "getshared", cache_service, PH_NO_CHECK);
+	if (Z_TYPE_P(cache) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The cache service must be an object");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(generations);
+	array_init(generations);
+	
+	if (Z_TYPE_P(models) != IS_ARRAY) {
+		RETURN_CTOR(generations);
+	}
+	
+	ah0 = Z_ARRVAL_P(models);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	
+	ph_cycle_start_0:
+	
+		if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
+			goto ph_cycle_end_0;
+		}
+	
+		PHALCON_GET_FOREACH_VALUE(model);
+	
+		PHALCON_INIT_NVAR(key);
+		phalcon_mvc_model_manager_generation_key(key, model TSRMLS_CC);
+	
+		/** 
+		 * Tables read through several aliases are fetched once
+		 */
+		eval_int = phalcon_array_isset(generations, key);
+		if (!eval_int) {
+			PHALCON_INIT_NVAR(generation);
+			PHALCON_CALL_METHOD_PARAMS_1(generation, cache, "get", key, PH_NO_CHECK);
+			if (Z_TYPE_P(generation) == IS_NULL) {
+				PHALCON_INIT_NVAR(generation);
+				phalcon_mvc_model_manager_new_generation(generation TSRMLS_CC);
+				PHALCON_CALL_METHOD_PARAMS_2_NORETURN(cache, "save", key, generation, PH_NO_CHECK);
+			}
+			phalcon_array_update_zval(&generations, key, &generation, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto ph_cycle_start_0;
+	
+	ph_cycle_end_0:
+	
+	RETURN_CTOR(generations);
+}
+
+/**
+ * Gives a new generation to the table of a model, cached PHQL results that read the table are
+ * not used anymore. Nothing is done if no cache service was set
+ *
+ * @param Phalcon\Mvc\ModelInterface $model
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, invalidateCache){
+
+	zval *model, *cache_service, *dependency_injector, *cache;
+	zval *key, *generation;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &model) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(cache_service);
+	phalcon_read_property(&cache_service, this_ptr, SL("_cacheService"), PH_NOISY_CC);
+	if (Z_TYPE_P(cache_service) == IS_NULL) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injection object is required to access ORM services");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(cache);
+	PHALCON_CALL_METHOD_PARAMS_1(cache, dependency_injector, "getshared", cache_service, PH_NO_CHECK);
+	if (Z_TYPE_P(cache) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The cache service must be an object");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(key);
+	phalcon_mvc_model_manager_generation_key(key, model TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(generation);
+	phalcon_mvc_model_manager_new_generation(generation TSRMLS_CC);
+	PHALCON_CALL_METHOD_PARAMS_2_NORETURN(cache, "save", key, generation, PH_NO_CHECK);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the connection where the SELECTs of a model are sent. The read connection service
+ * of the model can be a service name or a list of them, lists are used round-robin starting
+ * at a random replica. Once the request wrote to the primary connection of the model its reads
+ * stick to the primary
+ *
+ *<code>
+ * class Robots extends Phalcon\Mvc\Model
+ * {
+ *     public function getReadConnectionService()
+ *     {
+ *         return array('dbReplica1', 'dbReplica2');
+ *     }
+ * }
+ *</code>
+ *
+ * @param Phalcon\Mvc\ModelInterface $model
+ * @return Phalcon\Db\AdapterInterface
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnection){
+
+	zval *model, *write_service, *written, *read_service;
+	zval *number_services, *pool_key, *positions, *position = NULL;
+	zval *service = NULL, *next_position, *dependency_injector;
+	zval *connection = NULL;
+	long number, current;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &model) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(write_service);
+	PHALCON_CALL_METHOD(write_service, model, "getconnectionservice", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(written);
+	phalcon_read_property(&written, this_ptr, SL("_written"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(read_service);
+	PHALCON_CALL_METHOD(read_service, model, "getreadconnectionservice", PH_NO_CHECK);
+	
+	/** 
+	 * Reads after a write go to the primary so they see the written data
+	 */
+	eval_int = phalcon_array_isset(written, write_service);
+	if (eval_int || !zend_is_true(read_service)) {
+		PHALCON_INIT_VAR(connection);
+		PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+		RETURN_CCTOR(connection);
+	}
+	
+	if (Z_TYPE_P(read_service) == IS_ARRAY) { 
+	
+		PHALCON_INIT_VAR(number_services);
+		phalcon_fast_count(number_services, read_service TSRMLS_CC);
+		number = Z_LVAL_P(number_services);
+	
+		PHALCON_INIT_VAR(pool_key);
+		phalcon_fast_join_str(pool_key, SL(","), read_service TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(positions);
+		phalcon_read_property(&positions, this_ptr, SL("_readPositions"), PH_NOISY_CC);
+	
+		/** 
+		 * Every request starts at a random replica so the load is spread among them
+		 */
+		eval_int = phalcon_array_isset(positions, pool_key);
+		if (eval_int) {
+			PHALCON_INIT_VAR(position);
+			phalcon_array_fetch(&position, positions, pool_key, PH_NOISY_CC);
+			current = phalcon_get_intval(position) % number;
+		} else {
+			current = php_rand(TSRMLS_C) % number;
+		}
+	
+		PHALCON_INIT_VAR(service);
+		phalcon_array_fetch_long(&service, read_service, current, PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(next_position);
+		ZVAL_LONG(next_position, (current + 1) % number);
+		phalcon_array_update_zval(&positions, pool_key, &next_position, PH_COPY | PH_SEPARATE TSRMLS_CC);
+		phalcon_update_property_zval(this_ptr, SL("_readPositions"), positions TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(service, read_service);
+	}
+	
+	PHALCON_INIT_VAR(dependency_injector);
+	phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+	if (Z_TYPE_P(dependency_injector) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A dependency injection object is required to access ORM services");
+		return;
+	}
+	
+	PHALCON_INIT_NVAR(connection);
+	PHALCON_CALL_METHOD_PARAMS_1(connection, dependency_injector, "getshared", service, PH_NO_CHECK);
+	
+	RETURN_CCTOR(connection);
+}
+
+/**
+ * Marks the primary connection of a model as written, the following reads of the models using
+ * that connection are sent to the primary until the request ends
+ *
+ * @param Phalcon\Mvc\ModelInterface $model
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, markWritten){
+
+	zval *model, *write_service, *written;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &model) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(write_service);
+	PHALCON_CALL_METHOD(write_service, model, "getconnectionservice", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(written);
+	phalcon_read_property(&written, this_ptr, SL("_written"), PH_NOISY_CC);
+	phalcon_array_update_zval_bool(&written, write_service, 1, PH_SEPARATE TSRMLS_CC);
+	phalcon_update_property_zval(this_ptr, SL("_written"), written TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
@@ -67,6 +67,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_MetaData){
 
 	zend_declare_property_null(phalcon_mvc_model_metadata_ce, SL("_metaData"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_metadata_ce, SL("_columnMap"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_metadata_ce, SL("_describedSchemas"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_declare_class_constant_long(phalcon_mvc_model_metadata_ce, SL("MODELS_ATTRIBUTES"), 0 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_model_metadata_ce, SL("MODELS_PRIMARY_KEY"), 1 TSRMLS_CC);
@@ -98,7 +99,8 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initialize){
 
 	zval *model, *key, *table, *schema, *class_name = NULL, *meta_data = NULL;
 	zval *data = NULL, *table_metadata = NULL, *exception_message = NULL;
-	zval *connection, *exists, *complete_table = NULL, *columns;
+	zval *connection, *dialect, *exists, *complete_table = NULL, *columns = NULL;
+	zval *described, *connection_id, *described_key, *schema_columns = NULL;
 	zval *attributes, *primary_keys, *non_primary_keys;
 	zval *numeric_typed, *not_null, *field_types;
 	zval *field_bind_types, *automatic_default;
@@ -162,27 +164,73 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, _initialize){
 					PHALCON_INIT_VAR(connection);
 					PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
 	
-					PHALCON_INIT_VAR(exists);
-					PHALCON_CALL_METHOD_PARAMS_2(exists, connection, "tableexists", table, schema, PH_NO_CHECK);
-					if (!zend_is_true(exists)) {
-						if (zend_is_true(schema)) {
-							PHALCON_INIT_VAR(complete_table);
-							PHALCON_CONCAT_VSV(complete_table, schema, "\".\"", table);
-						} else {
-							PHALCON_CPY_WRT(complete_table, table);
+					PHALCON_INIT_VAR(columns);
+	
+					/** 
+					 * While warming, the tables of every schema are described with a single query
+					 */
+					PHALCON_INIT_VAR(described);
+					phalcon_read_property(&described, this_ptr, SL("_describedSchemas"), PH_NOISY_CC);
+					if (Z_TYPE_P(described) == IS_ARRAY) {
+	
+						/** 
+						 * Only dialects that describe a whole schema in one query are worth it, the
+						 * generic fallback describes every table of the schema
+						 */
+						PHALCON_INIT_VAR(dialect);
+						if (phalcon_method_exists_ex(connection, SS("describeschemacolumns") TSRMLS_CC) == SUCCESS && phalcon_method_exists_ex(connection, SS("getdialect") TSRMLS_CC) == SUCCESS) {
+							PHALCON_CALL_METHOD(dialect, connection, "getdialect", PH_NO_CHECK);
 						}
 	
-						PHALCON_INIT_NVAR(exception_message);
-						PHALCON_CONCAT_SVSV(exception_message, "Table \"", complete_table, "\" doesn't exist on database when dumping meta-data for ", class_name);
-						PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, exception_message);
-						return;
+						if (Z_TYPE_P(dialect) == IS_OBJECT && phalcon_method_exists_ex(dialect, SS("describeschemacolumns") TSRMLS_CC) == SUCCESS) {
+	
+							PHALCON_INIT_VAR(connection_id);
+							PHALCON_CALL_METHOD(connection_id, connection, "getconnectionid", PH_NO_CHECK);
+	
+							PHALCON_INIT_VAR(described_key);
+							PHALCON_CONCAT_VSV(described_key, connection_id, ":", schema);
+							if (phalcon_array_isset(described, described_key)) {
+								PHALCON_INIT_VAR(schema_columns);
+								phalcon_array_fetch(&schema_columns, described, described_key, PH_NOISY_CC);
+							} else {
+								PHALCON_INIT_NVAR(schema_columns);
+								PHALCON_CALL_METHOD_PARAMS_1(schema_columns, connection, "describeschemacolumns", schema, PH_NO_CHECK);
+								phalcon_array_update_zval(&described, described_key, &schema_columns, PH_COPY | PH_SEPARATE TSRMLS_CC);
+								phalcon_update_property_zval(this_ptr, SL("_describedSchemas"), described TSRMLS_CC);
+							}
+	
+							if (phalcon_array_isset(schema_columns, table)) {
+								PHALCON_INIT_NVAR(columns);
+								phalcon_array_fetch(&columns, schema_columns, table, PH_NOISY_CC);
+							}
+						}
+					}
+	
+					if (Z_TYPE_P(columns) == IS_NULL) {
+	
+						PHALCON_INIT_VAR(exists);
+						PHALCON_CALL_METHOD_PARAMS_2(exists, connection, "tableexists", table, schema, PH_NO_CHECK);
+						if (!zend_is_true(exists)) {
+							if (zend_is_true(schema)) {
+								PHALCON_INIT_VAR(complete_table);
+								PHALCON_CONCAT_VSV(complete_table, schema, "\".\"", table);
+							} else {
+								PHALCON_CPY_WRT(complete_table, table);
+							}
+	
+							PHALCON_INIT_NVAR(exception_message);
+							PHALCON_CONCAT_SVSV(exception_message, "Table \"", complete_table, "\" doesn't exist on database when dumping meta-data for ", class_name);
+							PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, exception_message);
+							return;
+						}
+	
+						/** 
+						 * Try to describe the table
+						 */
+						PHALCON_INIT_NVAR(columns);
+						PHALCON_CALL_METHOD_PARAMS_2(columns, connection, "describecolumns", table, schema, PH_NO_CHECK);
 					}
 	
-					/** 
-					 * Try to describe the table
-					 */
-					PHALCON_INIT_VAR(columns);
-					PHALCON_CALL_METHOD_PARAMS_2(columns, connection, "describecolumns", table, schema, PH_NO_CHECK);
 					if (!phalcon_fast_count_ev(columns TSRMLS_CC)) {
 						if (zend_is_true(schema)) {
 							PHALCON_INIT_NVAR(complete_table);
@@ -1163,3 +1211,88 @@ PHP_METHOD(Phalcon_Mvc_Model_MetaData, reset){
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Initializes the meta-data of many models at once. Instead of describing every table, the tables
+ * of each connection and schema involved are described with a single query, models whose meta-data
+ * is already stored by the adapter don't reach the database
+ *
+ *<code>
+ *	$metaData->warm(array(new Robots(), new Parts(), new RobotsParts()));
+ *</code>
+ *
+ * @param Phalcon\Mvc\ModelInterface[] $models
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData, warm){
+
+	zval *models, *described, *model = NULL, *table = NULL, *schema = NULL;
+	zval *key = NULL, *meta_data = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &models) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(models) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Models to warm must be passed as an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(described);
+	array_init(described);
+	phalcon_update_property_zval(this_ptr, SL("_describedSchemas"), described TSRMLS_CC);
+	
+	ah0 = Z_ARRVAL_P(models);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	while (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) == SUCCESS) {
+	
+		PHALCON_GET_FOREACH_VALUE(model);
+	
+		if (Z_TYPE_P(model) != IS_OBJECT) {
+			phalcon_update_property_null(this_ptr, SL("_describedSchemas") TSRMLS_CC);
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A model instance is required to retrieve the meta-data");
+			return;
+		}
+	
+		/** 
+		 * A failed call already released the memory frame, the descriptions must not outlive
+		 * the warming, tables created later would not be found in them
+		 */
+		PHALCON_INIT_NVAR(table);
+		if (phalcon_call_method(table, model, SL("getsource"), PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+			phalcon_update_property_null(this_ptr, SL("_describedSchemas") TSRMLS_CC);
+			return;
+		}
+	
+		PHALCON_INIT_NVAR(schema);
+		if (phalcon_call_method(schema, model, SL("getschema"), PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+			phalcon_update_property_null(this_ptr, SL("_describedSchemas") TSRMLS_CC);
+			return;
+		}
+	
+		PHALCON_INIT_NVAR(key);
+		PHALCON_CONCAT_VV(key, schema, table);
+	
+		PHALCON_INIT_NVAR(meta_data);
+		phalcon_read_property(&meta_data, this_ptr, SL("_metaData"), PH_NOISY_CC);
+		if (!phalcon_array_isset(meta_data, key)) {
+			if (phalcon_call_method_four_params(NULL, this_ptr, SL("_initialize"), model, key, table, schema, PH_NO_CHECK, 0 TSRMLS_CC) == FAILURE) {
+				phalcon_update_property_null(this_ptr, SL("_describedSchemas") TSRMLS_CC);
+				return;
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+	}
+	
+	/** 
+	 * The descriptions are only kept while warming
+	 */
+	phalcon_update_property_null(this_ptr, SL("_describedSchemas") TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
@@ -3154,8 +3154,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 			phalcon_array_fetch(&model, models_instances, model_name, PH_NOISY_CC);
 		}
 	
+		/** 
+		 * SELECTs are sent to the read connection of the model, the primary is used if
+		 * there is no read connection or the request already wrote to the primary
+		 */
 		PHALCON_INIT_VAR(connection);
-		PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+		if (phalcon_method_exists_ex(model, SS("getreadconnection") TSRMLS_CC) == SUCCESS) {
+			PHALCON_CALL_METHOD(connection, model, "getreadconnection", PH_NO_CHECK);
+		} else {
+			PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+		}
 		phalcon_array_update_zval(&models_instances, model_name, &model, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	} else {
 		/** 
@@ -3189,7 +3197,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 			}
 	
 			PHALCON_INIT_NVAR(connection);
-			PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+			if (phalcon_method_exists_ex(model, SS("getreadconnection") TSRMLS_CC) == SUCCESS) {
+				PHALCON_CALL_METHOD(connection, model, "getreadconnection", PH_NO_CHECK);
+			} else {
+				PHALCON_CALL_METHOD(connection, model, "getconnection", PH_NO_CHECK);
+			}
 	
 			PHALCON_INIT_NVAR(type);
 			PHALCON_CALL_METHOD(type, connection, "gettype", PH_NO_CHECK);
@@ -3969,7 +3981,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeUpdate){
 
 	zval *intermediate, *bind_params, *bind_types;
 	zval *models, *model_name, *models_instances;
-	zval *model = NULL, *manager, *connection, *dialect, *double_colon;
+	zval *model = NULL, *manager = NULL, *connection, *dialect, *double_colon;
 	zval *empty_string, *fields, *values, *update_values;
 	zval *select_bind_params = NULL, *select_bind_types = NULL;
 	zval *null_value, *field = NULL, *number = NULL, *field_name = NULL;
@@ -4177,6 +4189,15 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeUpdate){
 	
 	ph_cycle_end_0:
 	
+	/** 
+	 * The records are read from the primary, the request sticks to it from now on
+	 */
+	PHALCON_INIT_NVAR(manager);
+	phalcon_read_property(&manager, this_ptr, SL("_manager"), PH_NOISY_CC);
+	if (phalcon_method_exists_ex(manager, SS("markwritten") TSRMLS_CC) == SUCCESS) {
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "markwritten", model, PH_NO_CHECK);
+	}
+	
 	/** 
 	 * We need to query the records related to the update
 	 */
@@ -4247,7 +4268,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeDelete){
 
 	zval *intermediate, *bind_params, *bind_types;
 	zval *models, *model_name, *models_instances;
-	zval *model = NULL, *manager, *records, *success = NULL, *null_value = NULL;
+	zval *model = NULL, *manager = NULL, *records, *success = NULL, *null_value = NULL;
 	zval *status = NULL, *record = NULL;
 	zval *r0 = NULL;
 	int eval_int;
@@ -4287,6 +4308,15 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeDelete){
 		PHALCON_CALL_METHOD_PARAMS_1(model, manager, "load", model_name, PH_NO_CHECK);
 	}
 	
+	/** 
+	 * The records are read from the primary, the request sticks to it from now on
+	 */
+	PHALCON_INIT_NVAR(manager);
+	phalcon_read_property(&manager, this_ptr, SL("_manager"), PH_NOISY_CC);
+	if (phalcon_method_exists_ex(manager, SS("markwritten") TSRMLS_CC) == SUCCESS) {
+		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "markwritten", model, PH_NO_CHECK);
+	}
+	
 	/** 
 	 * Get the records to be deleted
 	 */
@@ -4360,9 +4390,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeDelete){
 PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 
 	zval *bind_params = NULL, *bind_types = NULL, *cache_options;
-	zval *key, *lifetime = NULL, *cache_service = NULL, *dependency_injector;
-	zval *cache, *result = NULL, *is_fresh, *intermediate;
-	zval *type, *exception_message;
+	zval *key = NULL, *lifetime = NULL, *cache_service = NULL, *dependency_injector;
+	zval *cache, *result = NULL, *is_fresh, *intermediate = NULL;
+	zval *type, *exception_message, *auto_key = NULL, *manager;
+	zval *models_instances, *generations, *phql, *key_parts;
+	zval *serialized, *hash, *key_prefix = NULL;
 	int eval_int;
 
 	PHALCON_MM_GROW();
@@ -4389,15 +4421,31 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 		}
 	
 		/** 
-		 * The user must set a cache key
+		 * Automatic keys are derived from the statement and the generations of its tables
+		 */
+		eval_int = phalcon_array_isset_string(cache_options, SS("auto"));
+		if (eval_int) {
+			PHALCON_INIT_VAR(auto_key);
+			phalcon_array_fetch_string(&auto_key, cache_options, SL("auto"), PH_NOISY_CC);
+		} else {
+			PHALCON_INIT_NVAR(auto_key);
+			ZVAL_BOOL(auto_key, 0);
+		}
+	
+		/** 
+		 * The user must set a cache key, with automatic keys it's only a prefix
 		 */
 		eval_int = phalcon_array_isset_string(cache_options, SS("key"));
 		if (eval_int) {
 			PHALCON_INIT_VAR(key);
 			phalcon_array_fetch_string(&key, cache_options, SL("key"), PH_NOISY_CC);
 		} else {
-			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A cache key must be provided to identify the cached resultset in the cache backend");
-			return;
+			if (!zend_is_true(auto_key)) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "A cache key must be provided to identify the cached resultset in the cache backend");
+				return;
+			}
+			PHALCON_INIT_NVAR(key);
+			ZVAL_STRING(key, "phql", 1);
 		}
 	
 		/** 
@@ -4424,6 +4472,49 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 			ZVAL_STRING(cache_service, "modelsCache", 1);
 		}
 	
+		/** 
+		 * A write gives a new generation to its table so the keys of the results that read
+		 * the table change and the old entries are never read again
+		 */
+		if (zend_is_true(auto_key)) {
+			PHALCON_INIT_VAR(intermediate);
+			PHALCON_CALL_METHOD(intermediate, this_ptr, "parse", PH_NO_CHECK);
+	
+			PHALCON_INIT_VAR(models_instances);
+			phalcon_read_property(&models_instances, this_ptr, SL("_sqlAliasesModelsInstances"), PH_NOISY_CC);
+			if (Z_TYPE_P(models_instances) != IS_ARRAY) { 
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Automatic cache keys can only be generated for statements that read models");
+				return;
+			}
+	
+			PHALCON_INIT_VAR(manager);
+			phalcon_read_property(&manager, this_ptr, SL("_manager"), PH_NOISY_CC);
+	
+			PHALCON_INIT_VAR(generations);
+			PHALCON_CALL_METHOD_PARAMS_1(generations, manager, "getcachegenerations", models_instances, PH_NO_CHECK);
+	
+			PHALCON_INIT_VAR(phql);
+			phalcon_read_property(&phql, this_ptr, SL("_phql"), PH_NOISY_CC);
+	
+			PHALCON_INIT_VAR(key_parts);
+			array_init(key_parts);
+			phalcon_array_append(&key_parts, phql, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&key_parts, bind_params, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&key_parts, bind_types, PH_SEPARATE TSRMLS_CC);
+			phalcon_array_append(&key_parts, generations, PH_SEPARATE TSRMLS_CC);
+	
+			PHALCON_INIT_VAR(serialized);
+			PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", key_parts);
+	
+			PHALCON_INIT_VAR(hash);
+			PHALCON_CALL_FUNC_PARAMS_1(hash, "md5", serialized);
+	
+			PHALCON_CPY_WRT(key_prefix, key);
+	
+			PHALCON_INIT_NVAR(key);
+			PHALCON_CONCAT_VSV(key, key_prefix, "-", hash);
+		}
+	
 		PHALCON_INIT_VAR(dependency_injector);
 		phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
 	
@@ -4455,7 +4546,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 	/** 
 	 * The statement is parsed from its PHQL string or a previously processed IR
 	 */
-	PHALCON_INIT_VAR(intermediate);
+	PHALCON_INIT_NVAR(intermediate);
 	PHALCON_CALL_METHOD(intermediate, this_ptr, "parse", PH_NO_CHECK);
 	
 	PHALCON_INIT_VAR(type);
@@ -80,22 +80,54 @@ const phql_token_names phql_tokens[] =
   {  0, NULL }
 };
 
-static void *phql_wrapper_alloc(size_t bytes){
-	return emalloc(bytes);
+/**
+ * The parser lives on the stack of phql_internal_parse_phql, it's never released
+ */
+static void phql_wrapper_free(void *pointer){
 }
 
-static void phql_wrapper_free(void *pointer){
-	efree(pointer);
+/**
+ * Takes a token from the arena of the parser, the first block is on the stack and covers most
+ * statements, more blocks are allocated when it's exhausted
+ */
+static phql_parser_token *phql_arena_token(phql_parser_status *parser_status){
+
+	phql_token_arena *arena = parser_status->arena;
+
+	if (arena->used == PHQL_ARENA_TOKENS) {
+		arena = emalloc(sizeof(phql_token_arena));
+		arena->used = 0;
+		arena->prev = parser_status->arena;
+		parser_status->arena = arena;
+	}
+
+	return &arena->tokens[arena->used++];
+}
+
+/**
+ * Releases the blocks allocated by phql_arena_token, the last one is the one on the stack
+ */
+static void phql_arena_free(phql_parser_status *parser_status){
+
+	phql_token_arena *arena = parser_status->arena, *prev;
+
+	while (arena->prev) {
+		prev = arena->prev;
+		efree(arena);
+		arena = prev;
+	}
+
+	parser_status->arena = arena;
 }
 
 static void phql_parse_with_token(void* phql_parser, int opcode, int parsercode, phql_scanner_token *token, phql_parser_status *parser_status){
 	phql_parser_token *pToken;
-	pToken = emalloc(sizeof(phql_parser_token));
+	pToken = phql_arena_token(parser_status);
 	pToken->opcode = opcode;
-	pToken->token = estrndup(token->value, token->len);
+	pToken->token = token->value;
 	pToken->token_len = token->len;
+	pToken->free_flag = 0;
 	phql_(phql_parser, parsercode, pToken, parser_status);
-	efree(token->value);
 }
 
 /**
@@ -121,10 +153,12 @@ int phql_parse_phql(zval *result, zval *phql TSRMLS_DC){
 int phql_internal_parse_phql(zval **result, char *phql, zval **error_msg TSRMLS_DC) {
 
 	char *error;
-	phql_scanner_state *state;
-	phql_scanner_token *token;
+	phql_scanner_state state_memory, *state = &state_memory;
+	phql_scanner_token token_memory, *token = &token_memory;
 	int scanner_status, status = SUCCESS;
-	phql_parser_status *parser_status = NULL;
+	phql_parser_status status_memory, *parser_status = &status_memory;
+	phql_token_arena arena;
+	yyParser parser_memory;
 	void* phql_parser;
 
 	if (!phql) {
@@ -133,13 +167,18 @@ int phql_internal_parse_phql(zval **result, char *phql, zval **error_msg TSRMLS_
 		return FAILURE;
 	}
 
-	phql_parser = phql_Alloc(phql_wrapper_alloc);
+	/** 
+	 * The parser, the scanner and the first block of tokens are allocated on the stack, tokens
+	 * point to the statement instead of copying it
+	 */
+	parser_memory.yyidx = -1;
+	phql_parser = &parser_memory;
 
-	parser_status = emalloc(sizeof(phql_parser_status));
-	state = emalloc(sizeof(phql_scanner_state));
-	token = emalloc(sizeof(phql_scanner_token));
+	arena.used = 0;
+	arena.prev = NULL;
 
 	parser_status->status = PHQL_PARSING_OK;
+	parser_status->arena = &arena;
 	parser_status->scanner_state = state;
 	parser_status->ret = NULL;
 	parser_status->syntax_error = NULL;
@@ -397,9 +436,7 @@ int phql_internal_parse_phql(zval **result, char *phql, zval **error_msg TSRMLS_
 		}
 	}
 
-	efree(parser_status);
-	efree(state);
-	efree(token);
+	phql_arena_free(parser_status);
 
 	return status;
 }
\ No newline at end of file
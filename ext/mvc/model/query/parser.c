@@ -33,8 +33,6 @@ static zval *phql_ret_literal_zval(int type, phql_parser_token *T)
 	add_assoc_long(ret, "type", type);
 	if (T) {
 		add_assoc_stringl(ret, "value", T->token, T->token_len, 1);
-		efree(T->token);
-		efree(T);
 	}
 
 	return ret;
@@ -48,8 +46,6 @@ static zval *phql_ret_placeholder_zval(int type, phql_parser_token *T)
 	array_init(ret);
 	add_assoc_long(ret, "type", type);
 	add_assoc_stringl(ret, "value", T->token, T->token_len, 1);
-	efree(T->token);
-	efree(T);
 
 	return ret;
 }
@@ -64,13 +60,9 @@ static zval *phql_ret_qualified_name(phql_parser_token *A, phql_parser_token *B)
 	if (B != NULL) {
 		add_assoc_stringl(ret, "domain", A->token, A->token_len, 1);
 		add_assoc_stringl(ret, "name", B->token, B->token_len, 1);
-		efree(B->token);
-		efree(B);
 	} else {
 		add_assoc_stringl(ret, "name", A->token, A->token_len, 1);
 	}
-	efree(A->token);
-	efree(A);
 
 	return ret;
 }
@@ -141,13 +133,9 @@ static zval *phql_ret_limit_clause(phql_parser_token *L, phql_parser_token *O)
 	array_init(ret);
 
 	add_assoc_stringl(ret, "number", L->token, L->token_len, 1);
-	efree(L->token);
-	efree(L);
 
 	if (O != NULL) {
 		add_assoc_stringl(ret, "offset", O->token, O->token_len, 1);
-		efree(O->token);
-		efree(O);
 	}
 
 	return ret;
@@ -292,13 +280,9 @@ static zval *phql_ret_column_item(int type, zval *column, phql_parser_token *ide
 	}
 	if (identifier_column) {
 		add_assoc_stringl(ret, "column", identifier_column->token, identifier_column->token_len, 1);
-		efree(identifier_column->token);
-		efree(identifier_column);
 	}
 	if (alias) {
 		add_assoc_stringl(ret, "alias", alias->token, alias->token_len, 1);
-		efree(alias->token);
-		efree(alias);
 	}
 
 	return ret;
@@ -314,8 +298,6 @@ static zval *phql_ret_assoc_name(zval *qualified_name, phql_parser_token *alias)
 	add_assoc_zval(ret, "qualifiedName", qualified_name);
 	if (alias) {
 		add_assoc_stringl(ret, "alias", alias->token, alias->token_len, 1);
-		efree(alias->token);
-		efree(alias);
 	}
 
 	return ret;
@@ -383,8 +365,6 @@ static zval *phql_ret_func_call(phql_parser_token *name, zval *arguments)
 	array_init(ret);
 	add_assoc_long(ret, "type", PHQL_T_FCALL);
 	add_assoc_stringl(ret, "name", name->token, name->token_len, 1);
-	efree(name->token);
-	efree(name);
 
 	if (arguments) {
 		add_assoc_zval(ret, "arguments", arguments);
@@ -394,7 +374,7 @@ static zval *phql_ret_func_call(phql_parser_token *name, zval *arguments)
 }
 
 
-// 398 "parser.c"
+// 378 "parser.c"
 /* Next is all token values, in a form suitable for use by makeheaders.
 ** This section will be null unless lemon is run with the -m switch.
 */
@@ -1023,71 +1003,6 @@ static void yy_destructor(YYCODETYPE yymajor, YYMINORTYPE *yypminor){
     ** which appear on the RHS of the rule, but which are not used
     ** inside the C code.
     */
-    case 1:
-    case 2:
-    case 3:
-    case 4:
-    case 5:
-    case 6:
-    case 7:
-    case 8:
-    case 9:
-    case 10:
-    case 11:
-    case 12:
-    case 13:
-    case 14:
-    case 15:
-    case 16:
-    case 17:
-    case 18:
-    case 19:
-    case 20:
-    case 21:
-    case 22:
-    case 23:
-    case 24:
-    case 25:
-    case 26:
-    case 27:
-    case 28:
-    case 29:
-    case 30:
-    case 31:
-    case 32:
-    case 33:
-    case 34:
-    case 35:
-    case 36:
-    case 37:
-    case 38:
-    case 39:
-    case 40:
-    case 41:
-    case 42:
-    case 43:
-    case 44:
-    case 45:
-    case 46:
-    case 47:
-    case 48:
-    case 49:
-    case 50:
-    case 51:
-    case 52:
-    case 53:
-    case 54:
-    case 55:
-    case 56:
-// 476 "parser.lemon"
-{
-	if ((yypminor->yy0)) {
-		efree((yypminor->yy0)->token);
-		efree((yypminor->yy0));
-	}
-}
-// 1090 "parser.c"
-      break;
     case 59:
     case 60:
     case 61:
@@ -1126,9 +1041,9 @@ static void yy_destructor(YYCODETYPE yymajor, YYMINORTYPE *yypminor){
     case 98:
     case 99:
     case 100:
-// 487 "parser.lemon"
+// 460 "parser.lemon"
 { zval_ptr_dtor(&(yypminor->yy42)); }
-// 1132 "parser.c"
+// 1047 "parser.c"
       break;
     default:  break;   /* If no destructor action specified: do nothing */
   }
@@ -1484,11 +1399,11 @@ static void yy_reduce(
   **     break;
   */
       case 0:
-// 483 "parser.lemon"
+// 456 "parser.lemon"
 {
 	status->ret = yymsp[0].minor.yy42;
 }
-// 1492 "parser.c"
+// 1407 "parser.c"
         break;
       case 1:
       case 2:
@@ -1498,210 +1413,211 @@ static void yy_reduce(
       case 39:
       case 41:
       case 42:
+      case 58:
       case 62:
       case 63:
       case 65:
       case 73:
       case 75:
+      case 84:
+      case 85:
       case 87:
       case 91:
+      case 93:
       case 95:
       case 96:
+      case 98:
       case 121:
       case 125:
       case 127:
       case 134:
-// 489 "parser.lemon"
+// 462 "parser.lemon"
 {
 	yygotominor.yy42 = yymsp[0].minor.yy42;
 }
-// 1519 "parser.c"
+// 1439 "parser.c"
         break;
       case 5:
-// 507 "parser.lemon"
+// 480 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[0].minor.yy42, NULL, NULL, NULL, NULL, NULL);
 }
-// 1526 "parser.c"
+// 1446 "parser.c"
         break;
       case 6:
-// 511 "parser.lemon"
+// 484 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL, NULL, NULL, NULL);
 }
-// 1533 "parser.c"
+// 1453 "parser.c"
         break;
       case 7:
-// 515 "parser.lemon"
+// 488 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL, NULL, NULL);
 }
-// 1540 "parser.c"
+// 1460 "parser.c"
         break;
       case 8:
-// 519 "parser.lemon"
+// 492 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42, NULL, NULL);
 }
-// 1547 "parser.c"
+// 1467 "parser.c"
         break;
       case 9:
-// 523 "parser.lemon"
+// 496 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, NULL, yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL);
 }
-// 1554 "parser.c"
+// 1474 "parser.c"
         break;
       case 10:
-// 527 "parser.lemon"
+// 500 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, yymsp[0].minor.yy42, yymsp[-1].minor.yy42, NULL, NULL);
 }
-// 1561 "parser.c"
+// 1481 "parser.c"
         break;
       case 11:
-// 531 "parser.lemon"
+// 504 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-4].minor.yy42, yymsp[-3].minor.yy42, yymsp[-1].minor.yy42, yymsp[-2].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1568 "parser.c"
+// 1488 "parser.c"
         break;
       case 12:
-// 535 "parser.lemon"
+// 508 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-4].minor.yy42, yymsp[-3].minor.yy42, yymsp[0].minor.yy42, yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, NULL);
 }
-// 1575 "parser.c"
+// 1495 "parser.c"
         break;
       case 13:
-// 539 "parser.lemon"
+// 512 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, NULL, NULL, NULL, yymsp[0].minor.yy42);
 }
-// 1582 "parser.c"
+// 1502 "parser.c"
         break;
       case 14:
-// 543 "parser.lemon"
+// 516 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, NULL, NULL, yymsp[0].minor.yy42);
 }
-// 1589 "parser.c"
+// 1509 "parser.c"
         break;
       case 15:
-// 547 "parser.lemon"
+// 520 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, NULL, yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1596 "parser.c"
+// 1516 "parser.c"
         break;
       case 16:
-// 551 "parser.lemon"
+// 524 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-4].minor.yy42, yymsp[-3].minor.yy42, NULL, yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1603 "parser.c"
+// 1523 "parser.c"
         break;
       case 17:
-// 555 "parser.lemon"
+// 528 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42, NULL, NULL, NULL);
 }
-// 1610 "parser.c"
+// 1530 "parser.c"
         break;
       case 18:
-// 559 "parser.lemon"
+// 532 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, NULL, yymsp[0].minor.yy42, yymsp[-1].minor.yy42, NULL, NULL);
 }
-// 1617 "parser.c"
+// 1537 "parser.c"
         break;
       case 19:
-// 563 "parser.lemon"
+// 536 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, NULL, yymsp[0].minor.yy42, yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, NULL);
 }
-// 1624 "parser.c"
+// 1544 "parser.c"
         break;
       case 20:
-// 567 "parser.lemon"
+// 540 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, NULL, yymsp[-1].minor.yy42, NULL, NULL, yymsp[0].minor.yy42);
 }
-// 1631 "parser.c"
+// 1551 "parser.c"
         break;
       case 21:
-// 571 "parser.lemon"
+// 544 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, NULL, yymsp[-1].minor.yy42, yymsp[-2].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1638 "parser.c"
+// 1558 "parser.c"
         break;
       case 22:
-// 575 "parser.lemon"
+// 548 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-5].minor.yy42, yymsp[-4].minor.yy42, yymsp[-1].minor.yy42, yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1645 "parser.c"
+// 1565 "parser.c"
         break;
       case 23:
-// 579 "parser.lemon"
+// 552 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-1].minor.yy42, NULL, NULL, yymsp[0].minor.yy42, NULL, NULL);
 }
-// 1652 "parser.c"
+// 1572 "parser.c"
         break;
       case 24:
-// 583 "parser.lemon"
+// 556 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, NULL, NULL, yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1659 "parser.c"
+// 1579 "parser.c"
         break;
       case 25:
-// 587 "parser.lemon"
+// 560 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-2].minor.yy42, NULL, NULL, yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL);
 }
-// 1666 "parser.c"
+// 1586 "parser.c"
         break;
       case 26:
-// 591 "parser.lemon"
+// 564 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-3].minor.yy42, NULL, NULL, yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1673 "parser.c"
+// 1593 "parser.c"
         break;
       case 27:
-// 595 "parser.lemon"
+// 568 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-4].minor.yy42, NULL, yymsp[-1].minor.yy42, yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1680 "parser.c"
+// 1600 "parser.c"
         break;
       case 28:
-// 599 "parser.lemon"
+// 572 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_statement(yymsp[-1].minor.yy42, NULL, NULL, NULL, NULL, yymsp[0].minor.yy42);
 }
-// 1687 "parser.c"
+// 1607 "parser.c"
         break;
       case 29:
-// 605 "parser.lemon"
+// 578 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_clause(yymsp[-2].minor.yy42, yymsp[0].minor.yy42, NULL);
-  yy_destructor(20,&yymsp[-3].minor);
-  yy_destructor(21,&yymsp[-1].minor);
 }
-// 1696 "parser.c"
+// 1614 "parser.c"
         break;
       case 30:
-// 609 "parser.lemon"
+// 582 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_select_clause(yymsp[-3].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(20,&yymsp[-4].minor);
-  yy_destructor(21,&yymsp[-2].minor);
 }
-// 1705 "parser.c"
+// 1621 "parser.c"
         break;
       case 31:
       case 38:
@@ -1711,682 +1627,519 @@ static void yy_reduce(
       case 86:
       case 94:
       case 124:
-// 615 "parser.lemon"
+// 588 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_zval_list(yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(22,&yymsp[-1].minor);
 }
-// 1720 "parser.c"
+// 1635 "parser.c"
         break;
       case 33:
       case 126:
-// 625 "parser.lemon"
+// 598 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_column_item(PHQL_T_ALL, NULL, NULL, NULL);
-  yy_destructor(12,&yymsp[0].minor);
 }
-// 1729 "parser.c"
+// 1643 "parser.c"
         break;
       case 34:
-// 629 "parser.lemon"
+// 602 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_column_item(PHQL_T_DOMAINALL, NULL, yymsp[-2].minor.yy0, NULL);
-  yy_destructor(24,&yymsp[-1].minor);
-  yy_destructor(12,&yymsp[0].minor);
 }
-// 1738 "parser.c"
+// 1650 "parser.c"
         break;
       case 35:
-// 633 "parser.lemon"
+// 606 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_column_item(PHQL_T_EXPR, yymsp[-2].minor.yy42, NULL, yymsp[0].minor.yy0);
-  yy_destructor(25,&yymsp[-1].minor);
 }
-// 1746 "parser.c"
+// 1657 "parser.c"
         break;
       case 36:
-// 637 "parser.lemon"
+// 610 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_column_item(PHQL_T_EXPR, yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy0);
 }
-// 1753 "parser.c"
+// 1664 "parser.c"
         break;
       case 37:
-// 641 "parser.lemon"
+// 614 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_column_item(PHQL_T_EXPR, yymsp[0].minor.yy42, NULL, NULL);
 }
-// 1760 "parser.c"
+// 1671 "parser.c"
         break;
       case 40:
-// 657 "parser.lemon"
+// 630 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_zval_list(yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1767 "parser.c"
+// 1678 "parser.c"
         break;
       case 43:
-// 674 "parser.lemon"
+// 647 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_item(yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL, NULL);
 }
-// 1774 "parser.c"
+// 1685 "parser.c"
         break;
       case 44:
-// 679 "parser.lemon"
+// 652 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_item(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL);
 }
-// 1781 "parser.c"
+// 1692 "parser.c"
         break;
       case 45:
-// 684 "parser.lemon"
+// 657 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_item(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1788 "parser.c"
+// 1699 "parser.c"
         break;
       case 46:
-// 689 "parser.lemon"
+// 662 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_item(yymsp[-3].minor.yy42, yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1795 "parser.c"
+// 1706 "parser.c"
         break;
       case 47:
-// 695 "parser.lemon"
-{
-	yygotominor.yy42 = phql_ret_qualified_name(yymsp[0].minor.yy0, NULL);
-  yy_destructor(25,&yymsp[-1].minor);
-}
-// 1803 "parser.c"
-        break;
       case 48:
       case 66:
       case 142:
-// 699 "parser.lemon"
+// 668 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_qualified_name(yymsp[0].minor.yy0, NULL);
 }
-// 1812 "parser.c"
+// 1716 "parser.c"
         break;
       case 49:
-// 705 "parser.lemon"
-{
-	yygotominor.yy42 = phql_ret_join_type(PHQL_T_INNERJOIN);
-  yy_destructor(26,&yymsp[0].minor);
-}
-// 1820 "parser.c"
-        break;
       case 50:
-// 709 "parser.lemon"
+// 678 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_type(PHQL_T_INNERJOIN);
-  yy_destructor(27,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
 }
-// 1829 "parser.c"
+// 1724 "parser.c"
         break;
       case 51:
-// 713 "parser.lemon"
+// 686 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_type(PHQL_T_CROSSJOIN);
-  yy_destructor(28,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
 }
-// 1838 "parser.c"
+// 1731 "parser.c"
         break;
       case 52:
-// 717 "parser.lemon"
-{
-	yygotominor.yy42 = phql_ret_join_type(PHQL_T_LEFTJOIN);
-  yy_destructor(29,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
-}
-// 1847 "parser.c"
-        break;
       case 53:
-// 721 "parser.lemon"
+// 690 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_type(PHQL_T_LEFTJOIN);
-  yy_destructor(29,&yymsp[-2].minor);
-  yy_destructor(30,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
 }
-// 1857 "parser.c"
+// 1739 "parser.c"
         break;
       case 54:
-// 725 "parser.lemon"
-{
-	yygotominor.yy42 = phql_ret_join_type(PHQL_T_RIGHTJOIN);
-  yy_destructor(31,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
-}
-// 1866 "parser.c"
-        break;
       case 55:
-// 729 "parser.lemon"
+// 698 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_type(PHQL_T_RIGHTJOIN);
-  yy_destructor(31,&yymsp[-2].minor);
-  yy_destructor(30,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
 }
-// 1876 "parser.c"
+// 1747 "parser.c"
         break;
       case 56:
-// 733 "parser.lemon"
-{
-	yygotominor.yy42 = phql_ret_join_type(PHQL_T_FULLJOIN);
-  yy_destructor(32,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
-}
-// 1885 "parser.c"
-        break;
       case 57:
-// 737 "parser.lemon"
+// 706 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_join_type(PHQL_T_FULLJOIN);
-  yy_destructor(32,&yymsp[-2].minor);
-  yy_destructor(30,&yymsp[-1].minor);
-  yy_destructor(26,&yymsp[0].minor);
 }
-// 1895 "parser.c"
-        break;
-      case 58:
-// 743 "parser.lemon"
-{
-	yygotominor.yy42 = yymsp[0].minor.yy42;
-  yy_destructor(33,&yymsp[-1].minor);
-}
-// 1903 "parser.c"
+// 1755 "parser.c"
         break;
       case 59:
-// 750 "parser.lemon"
+// 723 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_insert_statement(yymsp[-4].minor.yy42, NULL, yymsp[-1].minor.yy42);
-  yy_destructor(34,&yymsp[-6].minor);
-  yy_destructor(35,&yymsp[-5].minor);
-  yy_destructor(36,&yymsp[-3].minor);
-  yy_destructor(37,&yymsp[-2].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 1915 "parser.c"
+// 1762 "parser.c"
         break;
       case 60:
-// 754 "parser.lemon"
+// 727 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_insert_statement(yymsp[-7].minor.yy42, yymsp[-5].minor.yy42, yymsp[-1].minor.yy42);
-  yy_destructor(34,&yymsp[-9].minor);
-  yy_destructor(35,&yymsp[-8].minor);
-  yy_destructor(37,&yymsp[-6].minor);
-  yy_destructor(38,&yymsp[-4].minor);
-  yy_destructor(36,&yymsp[-3].minor);
-  yy_destructor(37,&yymsp[-2].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 1929 "parser.c"
+// 1769 "parser.c"
         break;
       case 67:
-// 792 "parser.lemon"
+// 765 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_update_statement(yymsp[0].minor.yy42, NULL, NULL);
 }
-// 1936 "parser.c"
+// 1776 "parser.c"
         break;
       case 68:
-// 796 "parser.lemon"
+// 769 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_update_statement(yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL);
 }
-// 1943 "parser.c"
+// 1783 "parser.c"
         break;
       case 69:
-// 800 "parser.lemon"
+// 773 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_update_statement(yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1950 "parser.c"
+// 1790 "parser.c"
         break;
       case 70:
-// 804 "parser.lemon"
+// 777 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_update_statement(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
 }
-// 1957 "parser.c"
+// 1797 "parser.c"
         break;
       case 71:
-// 810 "parser.lemon"
+// 783 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_update_clause(yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(39,&yymsp[-3].minor);
-  yy_destructor(40,&yymsp[-1].minor);
 }
-// 1966 "parser.c"
+// 1804 "parser.c"
         break;
       case 74:
-// 826 "parser.lemon"
+// 799 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_update_item(yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(2,&yymsp[-1].minor);
 }
-// 1974 "parser.c"
+// 1811 "parser.c"
         break;
       case 76:
-// 838 "parser.lemon"
+// 811 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_delete_statement(yymsp[0].minor.yy42, NULL, NULL);
 }
-// 1981 "parser.c"
+// 1818 "parser.c"
         break;
       case 77:
-// 842 "parser.lemon"
+// 815 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_delete_statement(yymsp[-1].minor.yy42, yymsp[0].minor.yy42, NULL);
 }
-// 1988 "parser.c"
+// 1825 "parser.c"
         break;
       case 78:
-// 846 "parser.lemon"
+// 819 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_delete_statement(yymsp[-1].minor.yy42, NULL, yymsp[0].minor.yy42);
 }
-// 1995 "parser.c"
+// 1832 "parser.c"
         break;
       case 79:
-// 850 "parser.lemon"
+// 823 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_delete_statement(yymsp[-2].minor.yy42, yymsp[-1].minor.yy42, yymsp[0].minor.yy42);
 }
-// 2002 "parser.c"
+// 1839 "parser.c"
         break;
       case 80:
-// 856 "parser.lemon"
+// 829 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_delete_clause(yymsp[0].minor.yy42);
-  yy_destructor(41,&yymsp[-2].minor);
-  yy_destructor(21,&yymsp[-1].minor);
 }
-// 2011 "parser.c"
+// 1846 "parser.c"
         break;
       case 81:
-// 862 "parser.lemon"
+// 835 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_assoc_name(yymsp[-2].minor.yy42, yymsp[0].minor.yy0);
-  yy_destructor(25,&yymsp[-1].minor);
 }
-// 2019 "parser.c"
+// 1853 "parser.c"
         break;
       case 82:
-// 866 "parser.lemon"
+// 839 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_assoc_name(yymsp[-1].minor.yy42, yymsp[0].minor.yy0);
 }
-// 2026 "parser.c"
+// 1860 "parser.c"
         break;
       case 83:
-// 870 "parser.lemon"
+// 843 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_assoc_name(yymsp[0].minor.yy42, NULL);
 }
-// 2033 "parser.c"
-        break;
-      case 84:
-// 876 "parser.lemon"
-{
-	yygotominor.yy42 = yymsp[0].minor.yy42;
-  yy_destructor(42,&yymsp[-1].minor);
-}
-// 2041 "parser.c"
-        break;
-      case 85:
-// 882 "parser.lemon"
-{
-	yygotominor.yy42 = yymsp[0].minor.yy42;
-  yy_destructor(43,&yymsp[-2].minor);
-  yy_destructor(44,&yymsp[-1].minor);
-}
-// 2050 "parser.c"
+// 1867 "parser.c"
         break;
       case 88:
-// 898 "parser.lemon"
+// 871 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_order_item(yymsp[0].minor.yy42, 0);
 }
-// 2057 "parser.c"
+// 1874 "parser.c"
         break;
       case 89:
-// 902 "parser.lemon"
+// 875 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_order_item(yymsp[-1].minor.yy42, PHQL_T_ASC);
-  yy_destructor(45,&yymsp[0].minor);
 }
-// 2065 "parser.c"
+// 1881 "parser.c"
         break;
       case 90:
-// 906 "parser.lemon"
+// 879 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_order_item(yymsp[-1].minor.yy42, PHQL_T_DESC);
-  yy_destructor(46,&yymsp[0].minor);
 }
-// 2073 "parser.c"
+// 1888 "parser.c"
         break;
       case 92:
       case 97:
       case 135:
-// 914 "parser.lemon"
+// 887 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_literal_zval(PHQL_T_INTEGER, yymsp[0].minor.yy0);
 }
-// 2082 "parser.c"
-        break;
-      case 93:
-// 920 "parser.lemon"
-{
-	yygotominor.yy42 = yymsp[0].minor.yy42;
-  yy_destructor(48,&yymsp[-2].minor);
-  yy_destructor(44,&yymsp[-1].minor);
-}
-// 2091 "parser.c"
-        break;
-      case 98:
-// 946 "parser.lemon"
-{
-	yygotominor.yy42 = yymsp[0].minor.yy42;
-  yy_destructor(49,&yymsp[-1].minor);
-}
-// 2099 "parser.c"
+// 1897 "parser.c"
         break;
       case 99:
       case 102:
-// 952 "parser.lemon"
+// 925 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_limit_clause(yymsp[0].minor.yy0, NULL);
-  yy_destructor(50,&yymsp[-1].minor);
 }
-// 2108 "parser.c"
+// 1905 "parser.c"
         break;
       case 100:
-// 956 "parser.lemon"
+// 929 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_limit_clause(yymsp[0].minor.yy0, yymsp[-2].minor.yy0);
-  yy_destructor(50,&yymsp[-3].minor);
-  yy_destructor(22,&yymsp[-1].minor);
 }
-// 2117 "parser.c"
+// 1912 "parser.c"
         break;
       case 101:
-// 960 "parser.lemon"
+// 933 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_limit_clause(yymsp[-2].minor.yy0, yymsp[0].minor.yy0);
-  yy_destructor(50,&yymsp[-3].minor);
-  yy_destructor(51,&yymsp[-1].minor);
 }
-// 2126 "parser.c"
+// 1919 "parser.c"
         break;
       case 103:
-// 972 "parser.lemon"
+// 945 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_MINUS, NULL, yymsp[0].minor.yy42);
-  yy_destructor(15,&yymsp[-1].minor);
 }
-// 2134 "parser.c"
+// 1926 "parser.c"
         break;
       case 104:
-// 976 "parser.lemon"
+// 949 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_SUB, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(15,&yymsp[-1].minor);
 }
-// 2142 "parser.c"
+// 1933 "parser.c"
         break;
       case 105:
-// 980 "parser.lemon"
+// 953 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_ADD, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(14,&yymsp[-1].minor);
 }
-// 2150 "parser.c"
+// 1940 "parser.c"
         break;
       case 106:
-// 984 "parser.lemon"
+// 957 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_MUL, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(12,&yymsp[-1].minor);
 }
-// 2158 "parser.c"
+// 1947 "parser.c"
         break;
       case 107:
-// 988 "parser.lemon"
+// 961 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_DIV, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(11,&yymsp[-1].minor);
 }
-// 2166 "parser.c"
+// 1954 "parser.c"
         break;
       case 108:
-// 992 "parser.lemon"
+// 965 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_MOD, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(13,&yymsp[-1].minor);
 }
-// 2174 "parser.c"
+// 1961 "parser.c"
         break;
       case 109:
-// 996 "parser.lemon"
+// 969 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_AND, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(8,&yymsp[-1].minor);
 }
-// 2182 "parser.c"
+// 1968 "parser.c"
         break;
       case 110:
-// 1000 "parser.lemon"
+// 973 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_OR, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(9,&yymsp[-1].minor);
 }
-// 2190 "parser.c"
+// 1975 "parser.c"
         break;
       case 111:
-// 1004 "parser.lemon"
+// 977 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_EQUALS, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(2,&yymsp[-1].minor);
 }
-// 2198 "parser.c"
+// 1982 "parser.c"
         break;
       case 112:
-// 1008 "parser.lemon"
+// 981 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_NOTEQUALS, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(3,&yymsp[-1].minor);
 }
-// 2206 "parser.c"
+// 1989 "parser.c"
         break;
       case 113:
-// 1012 "parser.lemon"
+// 985 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_LESS, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(4,&yymsp[-1].minor);
 }
-// 2214 "parser.c"
+// 1996 "parser.c"
         break;
       case 114:
-// 1016 "parser.lemon"
+// 989 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_GREATER, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(5,&yymsp[-1].minor);
 }
-// 2222 "parser.c"
+// 2003 "parser.c"
         break;
       case 115:
-// 1020 "parser.lemon"
+// 993 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_GREATEREQUAL, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(6,&yymsp[-1].minor);
 }
-// 2230 "parser.c"
+// 2010 "parser.c"
         break;
       case 116:
-// 1024 "parser.lemon"
+// 997 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_LESSEQUAL, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(7,&yymsp[-1].minor);
 }
-// 2238 "parser.c"
+// 2017 "parser.c"
         break;
       case 117:
-// 1028 "parser.lemon"
+// 1001 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_LIKE, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(10,&yymsp[-1].minor);
 }
-// 2246 "parser.c"
+// 2024 "parser.c"
         break;
       case 118:
-// 1032 "parser.lemon"
+// 1005 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_NLIKE, yymsp[-3].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(19,&yymsp[-2].minor);
-  yy_destructor(10,&yymsp[-1].minor);
 }
-// 2255 "parser.c"
+// 2031 "parser.c"
         break;
       case 119:
-// 1036 "parser.lemon"
+// 1009 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_IN, yymsp[-4].minor.yy42, yymsp[-1].minor.yy42);
-  yy_destructor(17,&yymsp[-3].minor);
-  yy_destructor(37,&yymsp[-2].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 2265 "parser.c"
+// 2038 "parser.c"
         break;
       case 120:
-// 1040 "parser.lemon"
+// 1013 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_NOTIN, yymsp[-5].minor.yy42, yymsp[-1].minor.yy42);
-  yy_destructor(19,&yymsp[-4].minor);
-  yy_destructor(17,&yymsp[-3].minor);
-  yy_destructor(37,&yymsp[-2].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 2276 "parser.c"
+// 2045 "parser.c"
         break;
       case 122:
-// 1050 "parser.lemon"
+// 1023 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_func_call(yymsp[-3].minor.yy0, yymsp[-1].minor.yy42);
-  yy_destructor(37,&yymsp[-2].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 2285 "parser.c"
+// 2052 "parser.c"
         break;
       case 123:
-// 1054 "parser.lemon"
+// 1027 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_func_call(yymsp[-2].minor.yy0, NULL);
-  yy_destructor(37,&yymsp[-1].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 2294 "parser.c"
+// 2059 "parser.c"
         break;
       case 128:
-// 1078 "parser.lemon"
+// 1051 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_ISNULL, yymsp[-2].minor.yy42, NULL);
-  yy_destructor(16,&yymsp[-1].minor);
-  yy_destructor(52,&yymsp[0].minor);
 }
-// 2303 "parser.c"
+// 2066 "parser.c"
         break;
       case 129:
-// 1082 "parser.lemon"
+// 1055 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_ISNOTNULL, yymsp[-3].minor.yy42, NULL);
-  yy_destructor(16,&yymsp[-2].minor);
-  yy_destructor(19,&yymsp[-1].minor);
-  yy_destructor(52,&yymsp[0].minor);
 }
-// 2313 "parser.c"
+// 2073 "parser.c"
         break;
       case 130:
-// 1086 "parser.lemon"
+// 1059 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_DISTINCT, NULL, yymsp[0].minor.yy42);
-  yy_destructor(18,&yymsp[-1].minor);
 }
-// 2321 "parser.c"
+// 2080 "parser.c"
         break;
       case 131:
-// 1090 "parser.lemon"
+// 1063 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_BETWEEN, yymsp[-2].minor.yy42, yymsp[0].minor.yy42);
-  yy_destructor(1,&yymsp[-1].minor);
 }
-// 2329 "parser.c"
+// 2087 "parser.c"
         break;
       case 132:
-// 1094 "parser.lemon"
+// 1067 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_NOT, NULL, yymsp[0].minor.yy42);
-  yy_destructor(19,&yymsp[-1].minor);
 }
-// 2337 "parser.c"
+// 2094 "parser.c"
         break;
       case 133:
-// 1098 "parser.lemon"
+// 1071 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_expr(PHQL_T_ENCLOSED, yymsp[-1].minor.yy42, NULL);
-  yy_destructor(37,&yymsp[-2].minor);
-  yy_destructor(38,&yymsp[0].minor);
 }
-// 2346 "parser.c"
+// 2101 "parser.c"
         break;
       case 136:
-// 1110 "parser.lemon"
+// 1083 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_literal_zval(PHQL_T_STRING, yymsp[0].minor.yy0);
 }
-// 2353 "parser.c"
+// 2108 "parser.c"
         break;
       case 137:
-// 1114 "parser.lemon"
+// 1087 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_literal_zval(PHQL_T_DOUBLE, yymsp[0].minor.yy0);
 }
-// 2360 "parser.c"
+// 2115 "parser.c"
         break;
       case 138:
-// 1118 "parser.lemon"
+// 1091 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_literal_zval(PHQL_T_NULL, NULL);
-  yy_destructor(52,&yymsp[0].minor);
 }
-// 2368 "parser.c"
+// 2122 "parser.c"
         break;
       case 139:
-// 1122 "parser.lemon"
+// 1095 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_placeholder_zval(PHQL_T_NPLACEHOLDER, yymsp[0].minor.yy0);
 }
-// 2375 "parser.c"
+// 2129 "parser.c"
         break;
       case 140:
-// 1126 "parser.lemon"
+// 1099 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_placeholder_zval(PHQL_T_SPLACEHOLDER, yymsp[0].minor.yy0);
 }
-// 2382 "parser.c"
+// 2136 "parser.c"
         break;
       case 141:
-// 1132 "parser.lemon"
+// 1105 "parser.lemon"
 {
 	yygotominor.yy42 = phql_ret_qualified_name(yymsp[-2].minor.yy0, yymsp[0].minor.yy0);
-  yy_destructor(24,&yymsp[-1].minor);
 }
-// 2390 "parser.c"
+// 2143 "parser.c"
         break;
   };
   yygoto = yyRuleInfo[yyruleno].lhs;
@@ -2428,7 +2181,7 @@ static void yy_syntax_error(
 ){
   phql_ARG_FETCH;
 #define TOKEN (yyminor.yy0)
-// 426 "parser.lemon"
+// 406 "parser.lemon"
 
 	if (status->scanner_state->start) {
 		{
@@ -2478,7 +2231,7 @@ static void yy_syntax_error(
 
 	status->status = PHQL_PARSING_FAILED;
 
-// 2482 "parser.c"
+// 2235 "parser.c"
   phql_ARG_STORE; /* Suppress warning about unused %extra_argument variable */
 }
 
@@ -2731,22 +2484,54 @@ const phql_token_names phql_tokens[] =
   {  0, NULL }
 };
 
-static void *phql_wrapper_alloc(size_t bytes){
-	return emalloc(bytes);
+/**
+ * The parser lives on the stack of phql_internal_parse_phql, it's never released
+ */
+static void phql_wrapper_free(void *pointer){
 }
 
-static void phql_wrapper_free(void *pointer){
-	efree(pointer);
+/**
+ * Takes a token from the arena of the parser, the first block is on the stack and covers most
+ * statements, more blocks are allocated when it's exhausted
+ */
+static phql_parser_token *phql_arena_token(phql_parser_status *parser_status){
+
+	phql_token_arena *arena = parser_status->arena;
+
+	if (arena->used == PHQL_ARENA_TOKENS) {
+		arena = emalloc(sizeof(phql_token_arena));
+		arena->used = 0;
+		arena->prev = parser_status->arena;
+		parser_status->arena = arena;
+	}
+
+	return &arena->tokens[arena->used++];
+}
+
+/**
+ * Releases the blocks allocated by phql_arena_token, the last one is the one on the stack
+ */
+static void phql_arena_free(phql_parser_status *parser_status){
+
+	phql_token_arena *arena = parser_status->arena, *prev;
+
+	while (arena->prev) {
+		prev = arena->prev;
+		efree(arena);
+		arena = prev;
+	}
+
+	parser_status->arena = arena;
 }
 
 static void phql_parse_with_token(void* phql_parser, int opcode, int parsercode, phql_scanner_token *token, phql_parser_status *parser_status){
 	phql_parser_token *pToken;
-	pToken = emalloc(sizeof(phql_parser_token));
+	pToken = phql_arena_token(parser_status);
 	pToken->opcode = opcode;
-	pToken->token = estrndup(token->value, token->len);
+	pToken->token = token->value;
 	pToken->token_len = token->len;
+	pToken->free_flag = 0;
 	phql_(phql_parser, parsercode, pToken, parser_status);
-	efree(token->value);
 }
 
 /**
@@ -2772,10 +2557,12 @@ int phql_parse_phql(zval *result, zval *phql TSRMLS_DC){
 int phql_internal_parse_phql(zval **result, char *phql, zval **error_msg TSRMLS_DC) {
 
 	char *error;
-	phql_scanner_state *state;
-	phql_scanner_token *token;
+	phql_scanner_state state_memory, *state = &state_memory;
+	phql_scanner_token token_memory, *token = &token_memory;
 	int scanner_status, status = SUCCESS;
-	phql_parser_status *parser_status = NULL;
+	phql_parser_status status_memory, *parser_status = &status_memory;
+	phql_token_arena arena;
+	yyParser parser_memory;
 	void* phql_parser;
 
 	if (!phql) {
@@ -2784,13 +2571,18 @@ int phql_internal_parse_phql(zval **result, char *phql, zval **error_msg TSRMLS_
 		return FAILURE;
 	}
 
-	phql_parser = phql_Alloc(phql_wrapper_alloc);
+	/** 
+	 * The parser, the scanner and the first block of tokens are allocated on the stack, tokens
+	 * point to the statement instead of copying it
+	 */
+	parser_memory.yyidx = -1;
+	phql_parser = &parser_memory;
 
-	parser_status = emalloc(sizeof(phql_parser_status));
-	state = emalloc(sizeof(phql_scanner_state));
-	token = emalloc(sizeof(phql_scanner_token));
+	arena.used = 0;
+	arena.prev = NULL;
 
 	parser_status->status = PHQL_PARSING_OK;
+	parser_status->arena = &arena;
 	parser_status->scanner_state = state;
 	parser_status->ret = NULL;
 	parser_status->syntax_error = NULL;
@@ -3048,9 +2840,7 @@ int phql_internal_parse_phql(zval **result, char *phql, zval **error_msg TSRMLS_
 		}
 	}
 
-	efree(parser_status);
-	efree(state);
-	efree(token);
+	phql_arena_free(parser_status);
 
 	return status;
 }
\ No newline at end of file
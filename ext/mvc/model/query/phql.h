@@ -17,6 +17,7 @@
   +------------------------------------------------------------------------+
 */
 
+/** Tokens point to the PHQL statement, they're not NUL terminated */
 typedef struct _phql_parser_token {
 	int opcode;
 	char *token;
@@ -24,12 +25,22 @@ typedef struct _phql_parser_token {
 	int free_flag;
 } phql_parser_token;
 
+/** Number of tokens in every block of the arena used by the parser */
+#define PHQL_ARENA_TOKENS 64
+
+typedef struct _phql_token_arena {
+	phql_parser_token tokens[PHQL_ARENA_TOKENS];
+	int used;
+	struct _phql_token_arena *prev;
+} phql_token_arena;
+
 typedef struct _phql_parser_status {
 	int status;
 	zval *ret;
 	phql_scanner_state *scanner_state;
 	char *syntax_error;
 	zend_uint syntax_error_len;
+	phql_token_arena *arena;
 } phql_parser_status;
 
 #define PHQL_PARSING_OK 1
@@ -153,7 +153,7 @@ yy3:
 // 46 "scanner.re"
 			{
 			token->opcode = PHQL_T_INTEGER;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
@@ -282,7 +282,7 @@ yy10:
 // 266 "scanner.re"
 			{
 			token->opcode = PHQL_T_IDENTIFIER;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
@@ -704,7 +704,7 @@ yy75:
 // 257 "scanner.re"
 			{
 			token->opcode = PHQL_T_STRING;
-			token->value = estrndup(q, YYCURSOR - q - 1);
+			token->value = q;
 			token->len = YYCURSOR - q - 1;
 			q = YYCURSOR;
 			return 0;
@@ -3993,7 +3993,7 @@ yy227:
 // 73 "scanner.re"
 			{
 			token->opcode = PHQL_T_SPLACEHOLDER;
-			token->value = estrndup(q, YYCURSOR - q - 1);
+			token->value = q;
 			token->len = YYCURSOR - q - 1;
 			q = YYCURSOR;
 			return 0;
@@ -4019,7 +4019,7 @@ yy231:
 // 64 "scanner.re"
 			{
 			token->opcode = PHQL_T_NPLACEHOLDER;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
@@ -4045,7 +4045,7 @@ yy234:
 // 55 "scanner.re"
 			{
 			token->opcode = PHQL_T_DOUBLE;
-			token->value = estrndup(q, YYCURSOR - q);
+			token->value = q;
 			token->len = YYCURSOR - q;
 			q = YYCURSOR;
 			return 0;
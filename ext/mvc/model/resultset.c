@@ -37,6 +37,9 @@
 #include "kernel/fcall.h"
 #include "kernel/exception.h"
 
+#include "ext/standard/php_smart_str.h"
+#include "ext/standard/php_var.h"
+
 /**
  * Phalcon\Mvc\Model\Resultset
  *
@@ -65,6 +68,498 @@
  *
  */
 
+/**
+ * Packed resultsets start with a signature and the offset of the first row, then a header with
+ * the column names, the number of rows and the serialized state of the resultset. Every row is
+ * stored with its length followed by 'R' and one typed value per column, or 'A' and the row
+ * serialized when its keys are different from the header
+ *
+ * N null, T true, F false, I integer (zigzag), i integer string, D double (little-endian), S string,
+ * O serialized
+ */
+#define PHALCON_RESULTSET_PACKED_MAGIC "PHR\x01"
+#define PHALCON_RESULTSET_PACKED_HEADER 8
+
+static void phalcon_mvc_model_resultset_varint(smart_str *buffer, unsigned long value){
+
+	while (value >= 0x80) {
+		smart_str_appendc(buffer, (char) ((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	smart_str_appendc(buffer, (char) value);
+}
+
+static int phalcon_mvc_model_resultset_read_varint(const unsigned char **cursor, const unsigned char *end, unsigned long *value){
+
+	unsigned int shift = 0;
+
+	*value = 0;
+	while (*cursor < end && shift < sizeof(unsigned long) * 8) {
+		*value |= ((unsigned long) (**cursor & 0x7f)) << shift;
+		if (!(*(*cursor)++ & 0x80)) {
+			return SUCCESS;
+		}
+		shift += 7;
+	}
+
+	return FAILURE;
+}
+
+/**
+ * Doubles are stored in little-endian byte order so packed resultsets can be shared between
+ * machines with different endianness
+ */
+static void phalcon_mvc_model_resultset_copy_double(unsigned char *dest, const unsigned char *src){
+
+#ifdef WORDS_BIGENDIAN
+	size_t i;
+
+	for (i = 0; i < sizeof(double); i++) {
+		dest[i] = src[sizeof(double) - 1 - i];
+	}
+#else
+	memcpy(dest, src, sizeof(double));
+#endif
+}
+
+/**
+ * Checks if a string is an integer written the way PHP prints it, databases return most of the
+ * numeric columns as strings
+ */
+static int phalcon_mvc_model_resultset_is_long(const char *str, int length, long *value){
+
+	int i = 0, digits;
+	long number = 0;
+
+	if (length > 0 && str[0] == '-') {
+		i = 1;
+	}
+
+	digits = length - i;
+	if (digits < 1 || digits > (sizeof(long) == 8 ? 18 : 9)) {
+		return 0;
+	}
+
+	if (str[i] == '0' && (digits > 1 || i)) {
+		return 0;
+	}
+
+	for (; i < length; i++) {
+		if (str[i] < '0' || str[i] > '9') {
+			return 0;
+		}
+		number = number * 10 + (str[i] - '0');
+	}
+
+	*value = str[0] == '-' ? -number : number;
+	return 1;
+}
+
+static void phalcon_mvc_model_resultset_pack_long(smart_str *buffer, char type, long number){
+
+	smart_str_appendc(buffer, type);
+	phalcon_mvc_model_resultset_varint(buffer, ((unsigned long) number << 1) ^ (unsigned long) (number >> (sizeof(long) * 8 - 1)));
+}
+
+static void phalcon_mvc_model_resultset_pack_value(smart_str *buffer, zval *value TSRMLS_DC){
+
+	long number;
+	double dval;
+	unsigned char bytes[sizeof(double)];
+	smart_str serialized = { NULL, 0, 0 };
+	php_serialize_data_t var_hash;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_NULL:
+			smart_str_appendc(buffer, 'N');
+			break;
+
+		case IS_BOOL:
+			smart_str_appendc(buffer, Z_BVAL_P(value) ? 'T' : 'F');
+			break;
+
+		case IS_LONG:
+			phalcon_mvc_model_resultset_pack_long(buffer, 'I', Z_LVAL_P(value));
+			break;
+
+		case IS_DOUBLE:
+			dval = Z_DVAL_P(value);
+			phalcon_mvc_model_resultset_copy_double(bytes, (const unsigned char *) &dval);
+			smart_str_appendc(buffer, 'D');
+			smart_str_appendl(buffer, (const char *) bytes, sizeof(double));
+			break;
+
+		case IS_STRING:
+			if (phalcon_mvc_model_resultset_is_long(Z_STRVAL_P(value), Z_STRLEN_P(value), &number)) {
+				phalcon_mvc_model_resultset_pack_long(buffer, 'i', number);
+			} else {
+				smart_str_appendc(buffer, 'S');
+				phalcon_mvc_model_resultset_varint(buffer, Z_STRLEN_P(value));
+				smart_str_appendl(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			}
+			break;
+
+		default:
+			PHP_VAR_SERIALIZE_INIT(var_hash);
+			php_var_serialize(&serialized, &value, &var_hash TSRMLS_CC);
+			PHP_VAR_SERIALIZE_DESTROY(var_hash);
+			smart_str_appendc(buffer, 'O');
+			phalcon_mvc_model_resultset_varint(buffer, serialized.len);
+			smart_str_appendl(buffer, serialized.c, serialized.len);
+			smart_str_free(&serialized);
+			break;
+	}
+}
+
+static int phalcon_mvc_model_resultset_unpack_value(const unsigned char **cursor, const unsigned char *end, zval *result TSRMLS_DC){
+
+	unsigned long length, number;
+	unsigned char type;
+	long lval;
+	double dval;
+	char buf[MAX_LENGTH_OF_LONG + 1];
+	php_unserialize_data_t var_hash;
+	const unsigned char *start;
+	int status;
+
+	if (*cursor >= end) {
+		return FAILURE;
+	}
+
+	type = *(*cursor)++;
+	switch (type) {
+
+		case 'N':
+			ZVAL_NULL(result);
+			return SUCCESS;
+
+		case 'T':
+			ZVAL_BOOL(result, 1);
+			return SUCCESS;
+
+		case 'F':
+			ZVAL_BOOL(result, 0);
+			return SUCCESS;
+
+		case 'I':
+		case 'i':
+			if (phalcon_mvc_model_resultset_read_varint(cursor, end, &number) == FAILURE) {
+				return FAILURE;
+			}
+			lval = (long) ((number >> 1) ^ (~(number & 1) + 1));
+			if (type == 'I') {
+				ZVAL_LONG(result, lval);
+			} else {
+				ZVAL_STRINGL(result, buf, slprintf(buf, sizeof(buf), "%ld", lval), 1);
+			}
+			return SUCCESS;
+
+		case 'D':
+			if ((size_t) (end - *cursor) < sizeof(double)) {
+				return FAILURE;
+			}
+			phalcon_mvc_model_resultset_copy_double((unsigned char *) &dval, *cursor);
+			*cursor += sizeof(double);
+			ZVAL_DOUBLE(result, dval);
+			return SUCCESS;
+
+		case 'S':
+			if (phalcon_mvc_model_resultset_read_varint(cursor, end, &length) == FAILURE || (unsigned long) (end - *cursor) < length) {
+				return FAILURE;
+			}
+			ZVAL_STRINGL(result, (char *) *cursor, length, 1);
+			*cursor += length;
+			return SUCCESS;
+
+		case 'O':
+			if (phalcon_mvc_model_resultset_read_varint(cursor, end, &length) == FAILURE || (unsigned long) (end - *cursor) < length) {
+				return FAILURE;
+			}
+			start = *cursor;
+			PHP_VAR_UNSERIALIZE_INIT(var_hash);
+			status = php_var_unserialize(&result, &start, *cursor + length, &var_hash TSRMLS_CC);
+			PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+			*cursor += length;
+			return status ? SUCCESS : FAILURE;
+	}
+
+	return FAILURE;
+}
+
+static unsigned long phalcon_mvc_model_resultset_packed_first(zval *packed){
+
+	const unsigned char *data = (const unsigned char *) Z_STRVAL_P(packed);
+	unsigned long first;
+
+	first = data[4] | (data[5] << 8) | ((unsigned long) data[6] << 16) | ((unsigned long) data[7] << 24);
+	if (first > (unsigned long) Z_STRLEN_P(packed)) {
+		return Z_STRLEN_P(packed);
+	}
+
+	return first;
+}
+
+/**
+ * Checks if a string was produced by phalcon_mvc_model_resultset_pack
+ */
+int phalcon_mvc_model_resultset_is_packed(zval *data){
+
+	return Z_TYPE_P(data) == IS_STRING && Z_STRLEN_P(data) >= PHALCON_RESULTSET_PACKED_HEADER && !memcmp(Z_STRVAL_P(data), PHALCON_RESULTSET_PACKED_MAGIC, 4);
+}
+
+/**
+ * Packs the rows of a resultset and the state needed to restore it into a string
+ */
+void phalcon_mvc_model_resultset_pack(zval *return_value, zval *rows, zval *state TSRMLS_DC){
+
+	HashTable *ht = NULL, *columns = NULL;
+	HashPosition pos;
+	Bucket *p, *q;
+	zval **row;
+	smart_str packed = { NULL, 0, 0 }, *buffer = &packed;
+	smart_str body = { NULL, 0, 0 };
+	php_serialize_data_t var_hash;
+	size_t offset;
+	int same;
+
+	/**
+	 * The keys of the first row are the columns in the header
+	 */
+	if (Z_TYPE_P(rows) == IS_ARRAY) {
+		ht = Z_ARRVAL_P(rows);
+		zend_hash_internal_pointer_reset_ex(ht, &pos);
+		if (zend_hash_get_current_data_ex(ht, (void **) &row, &pos) == SUCCESS && Z_TYPE_PP(row) == IS_ARRAY) {
+			columns = Z_ARRVAL_PP(row);
+			for (p = columns->pListHead; p; p = p->pListNext) {
+				if (!p->nKeyLength) {
+					columns = NULL;
+					break;
+				}
+			}
+		}
+	}
+
+	smart_str_appendl(buffer, PHALCON_RESULTSET_PACKED_MAGIC, 4);
+	smart_str_appendl(buffer, "\0\0\0\0", 4);
+
+	if (columns) {
+		phalcon_mvc_model_resultset_varint(buffer, zend_hash_num_elements(columns));
+		for (p = columns->pListHead; p; p = p->pListNext) {
+			phalcon_mvc_model_resultset_varint(buffer, p->nKeyLength - 1);
+			smart_str_appendl(buffer, p->arKey, p->nKeyLength);
+		}
+	} else {
+		phalcon_mvc_model_resultset_varint(buffer, 0);
+	}
+
+	phalcon_mvc_model_resultset_varint(buffer, ht ? zend_hash_num_elements(ht) : 0);
+
+	PHP_VAR_SERIALIZE_INIT(var_hash);
+	php_var_serialize(&body, &state, &var_hash TSRMLS_CC);
+	PHP_VAR_SERIALIZE_DESTROY(var_hash);
+	phalcon_mvc_model_resultset_varint(buffer, body.len);
+	smart_str_appendl(buffer, body.c, body.len);
+
+	offset = buffer->len;
+	buffer->c[4] = (char) (offset & 0xff);
+	buffer->c[5] = (char) ((offset >> 8) & 0xff);
+	buffer->c[6] = (char) ((offset >> 16) & 0xff);
+	buffer->c[7] = (char) ((offset >> 24) & 0xff);
+
+	if (ht) {
+		zend_hash_internal_pointer_reset_ex(ht, &pos);
+		while (zend_hash_get_current_data_ex(ht, (void **) &row, &pos) == SUCCESS) {
+
+			same = 0;
+			if (columns && Z_TYPE_PP(row) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_PP(row)) == zend_hash_num_elements(columns)) {
+				same = 1;
+				for (p = columns->pListHead, q = Z_ARRVAL_PP(row)->pListHead; p; p = p->pListNext, q = q->pListNext) {
+					if (p->h != q->h || p->nKeyLength != q->nKeyLength || (p->arKey != q->arKey && memcmp(p->arKey, q->arKey, p->nKeyLength))) {
+						same = 0;
+						break;
+					}
+				}
+			}
+
+			body.len = 0;
+			if (same) {
+				smart_str_appendc(&body, 'R');
+				for (q = Z_ARRVAL_PP(row)->pListHead; q; q = q->pListNext) {
+					phalcon_mvc_model_resultset_pack_value(&body, *((zval **) q->pData) TSRMLS_CC);
+				}
+			} else {
+				smart_str_appendc(&body, 'A');
+				PHP_VAR_SERIALIZE_INIT(var_hash);
+				php_var_serialize(&body, row, &var_hash TSRMLS_CC);
+				PHP_VAR_SERIALIZE_DESTROY(var_hash);
+			}
+
+			phalcon_mvc_model_resultset_varint(buffer, body.len);
+			smart_str_appendl(buffer, body.c, body.len);
+
+			zend_hash_move_forward_ex(ht, &pos);
+		}
+	}
+
+	smart_str_free(&body);
+	smart_str_0(buffer);
+
+	RETVAL_STRINGL(packed.c, packed.len, 0);
+}
+
+/**
+ * Checks the header of a packed resultset and restores the state saved with it, the rows are
+ * decoded one at a time while the resultset is traversed
+ */
+int phalcon_mvc_model_resultset_unpack(zval *this_ptr, zval *data, zval *state TSRMLS_DC){
+
+	const unsigned char *cursor, *end, *start;
+	unsigned long columns, length, count;
+	php_unserialize_data_t var_hash;
+	int status;
+
+	if (!phalcon_mvc_model_resultset_is_packed(data)) {
+		return FAILURE;
+	}
+
+	cursor = (const unsigned char *) Z_STRVAL_P(data) + PHALCON_RESULTSET_PACKED_HEADER;
+	end = (const unsigned char *) Z_STRVAL_P(data) + Z_STRLEN_P(data);
+
+	if (phalcon_mvc_model_resultset_read_varint(&cursor, end, &columns) == FAILURE) {
+		return FAILURE;
+	}
+
+	while (columns--) {
+		if (phalcon_mvc_model_resultset_read_varint(&cursor, end, &length) == FAILURE || (unsigned long) (end - cursor) <= length || cursor[length] != '\0') {
+			return FAILURE;
+		}
+		cursor += length + 1;
+	}
+
+	if (phalcon_mvc_model_resultset_read_varint(&cursor, end, &count) == FAILURE) {
+		return FAILURE;
+	}
+
+	if (phalcon_mvc_model_resultset_read_varint(&cursor, end, &length) == FAILURE || (unsigned long) (end - cursor) < length) {
+		return FAILURE;
+	}
+
+	if (cursor + length != (const unsigned char *) Z_STRVAL_P(data) + phalcon_mvc_model_resultset_packed_first(data)) {
+		return FAILURE;
+	}
+
+	start = cursor;
+	PHP_VAR_UNSERIALIZE_INIT(var_hash);
+	status = php_var_unserialize(&state, &start, cursor + length, &var_hash TSRMLS_CC);
+	PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+	if (!status || Z_TYPE_P(state) != IS_ARRAY) {
+		return FAILURE;
+	}
+
+	phalcon_update_property_zval(this_ptr, SL("_packed"), data TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_packedOffset"), cursor + length - (const unsigned char *) Z_STRVAL_P(data) TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_count"), count TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_rows") TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_type"), 0 TSRMLS_CC);
+
+	return SUCCESS;
+}
+
+/**
+ * Decodes the row at the cursor of a packed resultset and moves the cursor to the next one, the
+ * row is false after the last one
+ */
+int phalcon_mvc_model_resultset_unpack_row(zval *this_ptr, zval *packed, zval *row TSRMLS_DC){
+
+	zval *offset, *value;
+	const unsigned char *data, *cursor, *end, *names;
+	unsigned long length, columns;
+	php_unserialize_data_t var_hash;
+	int status;
+
+	data = (const unsigned char *) Z_STRVAL_P(packed);
+	end = data + Z_STRLEN_P(packed);
+
+	offset = zend_read_property(phalcon_mvc_model_resultset_ce, this_ptr, SL("_packedOffset"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(offset) != IS_LONG || Z_LVAL_P(offset) < PHALCON_RESULTSET_PACKED_HEADER || Z_LVAL_P(offset) >= end - data) {
+		ZVAL_BOOL(row, 0);
+		return SUCCESS;
+	}
+
+	cursor = data + Z_LVAL_P(offset);
+	if (phalcon_mvc_model_resultset_read_varint(&cursor, end, &length) == FAILURE || !length || (unsigned long) (end - cursor) < length) {
+		goto corrupted;
+	}
+
+	end = cursor + length;
+	phalcon_update_property_long(this_ptr, SL("_packedOffset"), end - data TSRMLS_CC);
+
+	switch (*cursor++) {
+
+		case 'R':
+			names = data + PHALCON_RESULTSET_PACKED_HEADER;
+			phalcon_mvc_model_resultset_read_varint(&names, cursor, &columns);
+
+			array_init_size(row, columns);
+			while (columns--) {
+				phalcon_mvc_model_resultset_read_varint(&names, cursor, &length);
+
+				MAKE_STD_ZVAL(value);
+				ZVAL_NULL(value);
+				if (phalcon_mvc_model_resultset_unpack_value(&cursor, end, value TSRMLS_CC) == FAILURE) {
+					zval_ptr_dtor(&value);
+					goto corrupted;
+				}
+
+				zend_hash_update(Z_ARRVAL_P(row), (char *) names, length + 1, &value, sizeof(zval *), NULL);
+				names += length + 1;
+			}
+			break;
+
+		case 'A':
+			PHP_VAR_UNSERIALIZE_INIT(var_hash);
+			status = php_var_unserialize(&row, &cursor, end, &var_hash TSRMLS_CC);
+			PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+			if (!status) {
+				goto corrupted;
+			}
+			break;
+
+		default:
+			goto corrupted;
+	}
+
+	return SUCCESS;
+
+corrupted:
+	zend_throw_exception_ex(phalcon_mvc_model_exception_ce, 0 TSRMLS_CC, "Invalid serialization data");
+	return FAILURE;
+}
+
+/**
+ * Moves the cursor of a packed resultset to a row, the rows before it are skipped by their length
+ */
+void phalcon_mvc_model_resultset_packed_seek(zval *this_ptr, zval *packed, long position TSRMLS_DC){
+
+	const unsigned char *data, *cursor, *end;
+	unsigned long length;
+
+	data = (const unsigned char *) Z_STRVAL_P(packed);
+	end = data + Z_STRLEN_P(packed);
+	cursor = data + phalcon_mvc_model_resultset_packed_first(packed);
+
+	while (position-- > 0 && cursor < end) {
+		if (phalcon_mvc_model_resultset_read_varint(&cursor, end, &length) == FAILURE || (unsigned long) (end - cursor) < length) {
+			cursor = end;
+			break;
+		}
+		cursor += length;
+	}
+
+	phalcon_update_property_long(this_ptr, SL("_packedOffset"), cursor - data TSRMLS_CC);
+}
+
 
 /**
  * Phalcon\Mvc\Model\Resultset initializer
@@ -81,6 +576,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset){
 	zend_declare_property_null(phalcon_mvc_model_resultset_ce, SL("_count"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_resultset_ce, SL("_activeRow"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_resultset_ce, SL("_rows"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_resultset_ce, SL("_packed"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_mvc_model_resultset_ce, SL("_packedOffset"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_model_resultset_ce TSRMLS_CC, 6, phalcon_mvc_model_resultsetinterface_ce, zend_ce_iterator, spl_ce_SeekableIterator, spl_ce_Countable, zend_ce_arrayaccess, zend_ce_serializable);
 
@@ -116,6 +613,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, key){
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
 
 	zval *type, *result = NULL, *active_row, *zero, *rows = NULL;
+	zval *packed;
 
 	PHALCON_MM_GROW();
 
@@ -143,12 +641,21 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
 		PHALCON_INIT_VAR(rows);
 		phalcon_read_property(&rows, this_ptr, SL("_rows"), PH_NOISY_CC);
 		if (Z_TYPE_P(rows) == IS_NULL) {
-			PHALCON_INIT_NVAR(result);
-			phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
-			if (PHALCON_IS_NOT_FALSE(result)) {
-				PHALCON_INIT_NVAR(rows);
-				PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
-				phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
+			/** 
+			 * Unserialized resultsets decode their rows from the packed data
+			 */
+			PHALCON_INIT_VAR(packed);
+			phalcon_read_property(&packed, this_ptr, SL("_packed"), PH_NOISY_CC);
+			if (phalcon_mvc_model_resultset_is_packed(packed)) {
+				phalcon_mvc_model_resultset_packed_seek(this_ptr, packed, 0 TSRMLS_CC);
+			} else {
+				PHALCON_INIT_NVAR(result);
+				phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+				if (PHALCON_IS_NOT_FALSE(result)) {
+					PHALCON_INIT_NVAR(rows);
+					PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
+					phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
+				}
 			}
 		}
 	
@@ -173,7 +680,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, seek){
 
 	long i;
 	zval *type, *result, *rows, *position;
-	zval *pointer, *is_different;
+	zval *pointer, *is_different, *packed;
 	HashTable *ah0;
 
 	PHALCON_MM_GROW();
@@ -212,21 +719,28 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, seek){
 			PHALCON_INIT_VAR(rows);
 			phalcon_read_property(&rows, this_ptr, SL("_rows"), PH_NOISY_CC);
 
+			convert_to_long(position);
+
 			/**
-			 * We need to fetch the records because rows is null
+			 * We need to fetch the records because rows is null, unserialized resultsets
+			 * skip the packed rows before the position
 			 */
 			if (Z_TYPE_P(rows) == IS_NULL) {
-				PHALCON_INIT_VAR(result);
-				phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
-				if (PHALCON_IS_NOT_FALSE(result)) {
-					PHALCON_INIT_NVAR(rows);
-					PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
-					phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
+				PHALCON_INIT_VAR(packed);
+				phalcon_read_property(&packed, this_ptr, SL("_packed"), PH_NOISY_CC);
+				if (phalcon_mvc_model_resultset_is_packed(packed)) {
+					phalcon_mvc_model_resultset_packed_seek(this_ptr, packed, Z_LVAL_P(position) TSRMLS_CC);
+				} else {
+					PHALCON_INIT_VAR(result);
+					phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+					if (PHALCON_IS_NOT_FALSE(result)) {
+						PHALCON_INIT_NVAR(rows);
+						PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
+						phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
+					}
 				}
 			}
 
-			convert_to_long(position);
-
 			if(Z_TYPE_P(rows) == IS_ARRAY){
 
 				ah0 = Z_ARRVAL_P(rows);
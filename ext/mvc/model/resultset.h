@@ -21,6 +21,12 @@ extern zend_class_entry *phalcon_mvc_model_resultset_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset);
 
+int phalcon_mvc_model_resultset_is_packed(zval *data);
+void phalcon_mvc_model_resultset_pack(zval *return_value, zval *rows, zval *state TSRMLS_DC);
+int phalcon_mvc_model_resultset_unpack(zval *this_ptr, zval *data, zval *state TSRMLS_DC);
+int phalcon_mvc_model_resultset_unpack_row(zval *this_ptr, zval *packed, zval *row TSRMLS_DC);
+void phalcon_mvc_model_resultset_packed_seek(zval *this_ptr, zval *packed, long position TSRMLS_DC);
+
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, next);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, key);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind);
@@ -47,6 +47,464 @@
  * This class builds every complex row as the're required
  */
 
+/**
+ * Columns of the hydration plan
+ */
+#define PHALCON_COMPLEX_COLUMN_OBJECT 1
+#define PHALCON_COMPLEX_COLUMN_SCALAR 2
+
+/**
+ * A value read from the row and the property that receives it. 'offset' is the position of the
+ * key in the first row, rows of the same result keep their columns in the same order
+ */
+typedef struct _phalcon_complex_attribute {
+	char *key;
+	uint key_length;
+	ulong hash;
+	uint offset;
+	zval *name;
+	zend_class_entry *scope;
+} phalcon_complex_attribute;
+
+typedef struct _phalcon_complex_column {
+	int type;
+	zval *instance;
+	zval *alias;
+	int call_force_exists;
+	uint count;
+	phalcon_complex_attribute *attributes;
+} phalcon_complex_column;
+
+typedef struct _phalcon_mvc_model_resultset_complex_object {
+	zend_object std;
+	int compiled;
+	uint plan_count;
+	phalcon_complex_column *plan;
+	uint buckets_size;
+	Bucket **buckets;
+	zval *force_exists_name;
+} phalcon_mvc_model_resultset_complex_object;
+
+static zend_object_handlers phalcon_mvc_model_resultset_complex_handlers;
+
+/**
+ * Finds the class declaring a property, values are written with its scope so protected
+ * properties can be assigned
+ */
+static zend_class_entry *phalcon_complex_property_scope(zend_class_entry *ce, char *name, int name_length){
+
+	zend_class_entry *original_ce = ce;
+
+	while (ce) {
+		if (zend_hash_exists(&ce->properties_info, name, name_length + 1)) {
+			return ce;
+		}
+		ce = ce->parent;
+	}
+
+	return original_ce;
+}
+
+/**
+ * Prepares an attribute reading 'key' from the rows
+ */
+static void phalcon_complex_attribute_init(phalcon_complex_attribute *attribute, char *key, uint key_length, char *name, int name_length, zend_class_entry *scope, HashTable *first_row){
+
+	Bucket *bucket;
+	uint position = 0;
+
+	attribute->key = key;
+	attribute->key_length = key_length + 1;
+	attribute->hash = zend_get_hash_value(key, key_length + 1);
+	attribute->offset = (uint) -1;
+
+	for (bucket = first_row->pListHead; bucket; bucket = bucket->pListNext) {
+		if (bucket->h == attribute->hash && bucket->nKeyLength == attribute->key_length && !memcmp(bucket->arKey, key, key_length + 1)) {
+			attribute->offset = position;
+			break;
+		}
+		position++;
+	}
+
+	MAKE_STD_ZVAL(attribute->name);
+	ZVAL_STRINGL(attribute->name, name, name_length, 1);
+	attribute->scope = scope;
+}
+
+/**
+ * Releases the hydration plan
+ */
+static void phalcon_mvc_model_resultset_complex_reset(phalcon_mvc_model_resultset_complex_object *intern){
+
+	uint i, j;
+	phalcon_complex_column *column;
+
+	for (i = 0; i < intern->plan_count; i++) {
+		column = &intern->plan[i];
+		if (column->instance) {
+			zval_ptr_dtor(&column->instance);
+		}
+		if (column->alias) {
+			zval_ptr_dtor(&column->alias);
+		}
+		for (j = 0; j < column->count; j++) {
+			if (column->attributes[j].key) {
+				efree(column->attributes[j].key);
+			}
+			if (column->attributes[j].name) {
+				zval_ptr_dtor(&column->attributes[j].name);
+			}
+		}
+		if (column->attributes) {
+			efree(column->attributes);
+		}
+	}
+
+	if (intern->plan) {
+		efree(intern->plan);
+	}
+	if (intern->buckets) {
+		efree(intern->buckets);
+	}
+	if (intern->force_exists_name) {
+		zval_ptr_dtor(&intern->force_exists_name);
+	}
+
+	intern->compiled = 0;
+	intern->plan_count = 0;
+	intern->plan = NULL;
+	intern->buckets_size = 0;
+	intern->buckets = NULL;
+	intern->force_exists_name = NULL;
+}
+
+/**
+ * Compiles _columnTypes into the hydration plan, the keys of the first row locate the columns
+ * of the following ones
+ */
+static int phalcon_mvc_model_resultset_complex_compile(phalcon_mvc_model_resultset_complex_object *intern, zval *this_ptr, HashTable *first_row TSRMLS_DC){
+
+	zval *columns_types, **column_type, **type, **source, **instance, **attributes, **column_map;
+	zval **balias, **sql_alias, **attribute, **mapped, alias, attribute_name;
+	phalcon_complex_column *column;
+	phalcon_complex_attribute *plan_attribute;
+	zend_function *method;
+	HashPosition hp0, hp1;
+	char *key, *str_key, *name;
+	uint str_key_length, key_length, i;
+	ulong num_key;
+	int name_length;
+
+	phalcon_mvc_model_resultset_complex_reset(intern);
+
+	columns_types = zend_read_property(phalcon_mvc_model_resultset_complex_ce, this_ptr, SL("_columnTypes"), 0 TSRMLS_CC);
+	if (Z_TYPE_P(columns_types) != IS_ARRAY) {
+		intern->compiled = 1;
+		return SUCCESS;
+	}
+
+	intern->plan = ecalloc(zend_hash_num_elements(Z_ARRVAL_P(columns_types)) + 1, sizeof(phalcon_complex_column));
+	intern->buckets_size = zend_hash_num_elements(first_row);
+	intern->buckets = ecalloc(intern->buckets_size + 1, sizeof(Bucket *));
+
+	MAKE_STD_ZVAL(intern->force_exists_name);
+	ZVAL_STRINGL(intern->force_exists_name, "_forceExists", sizeof("_forceExists") - 1, 1);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(columns_types), &hp0);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(columns_types), (void **) &column_type, &hp0) == SUCCESS) {
+
+		INIT_ZVAL(alias);
+		if (zend_hash_get_current_key_ex(Z_ARRVAL_P(columns_types), &str_key, &str_key_length, &num_key, 0, &hp0) == HASH_KEY_IS_STRING) {
+			ZVAL_STRINGL(&alias, str_key, str_key_length - 1, 1);
+		} else {
+			ZVAL_LONG(&alias, num_key);
+			convert_to_string(&alias);
+		}
+
+		if (Z_TYPE_PP(column_type) != IS_ARRAY || zend_hash_find(Z_ARRVAL_PP(column_type), SS("type"), (void **) &type) == FAILURE) {
+			zval_dtor(&alias);
+			zend_throw_exception_ex(phalcon_mvc_model_exception_ce, 0 TSRMLS_CC, "Invalid column type");
+			return FAILURE;
+		}
+
+		column = &intern->plan[intern->plan_count++];
+
+		if (Z_TYPE_PP(type) == IS_STRING && Z_STRLEN_PP(type) == 6 && !memcmp(Z_STRVAL_PP(type), "object", 6)) {
+
+			if (zend_hash_find(Z_ARRVAL_PP(column_type), SS("column"), (void **) &source) == FAILURE
+				|| zend_hash_find(Z_ARRVAL_PP(column_type), SS("instance"), (void **) &instance) == FAILURE
+				|| zend_hash_find(Z_ARRVAL_PP(column_type), SS("attributes"), (void **) &attributes) == FAILURE
+				|| zend_hash_find(Z_ARRVAL_PP(column_type), SS("columnMap"), (void **) &column_map) == FAILURE
+				|| zend_hash_find(Z_ARRVAL_PP(column_type), SS("balias"), (void **) &balias) == FAILURE
+				|| Z_TYPE_PP(instance) != IS_OBJECT || Z_TYPE_PP(attributes) != IS_ARRAY) {
+				zval_dtor(&alias);
+				zend_throw_exception_ex(phalcon_mvc_model_exception_ce, 0 TSRMLS_CC, "Invalid column type");
+				return FAILURE;
+			}
+
+			column->type = PHALCON_COMPLEX_COLUMN_OBJECT;
+
+			Z_ADDREF_PP(instance);
+			column->instance = *instance;
+
+			MAKE_STD_ZVAL(column->alias);
+			ZVAL_ZVAL(column->alias, *balias, 1, 0);
+			convert_to_string(column->alias);
+
+			/**
+			 * Models that override setForceExists still receive the call
+			 */
+			column->call_force_exists = 1;
+			if (zend_hash_find(&Z_OBJCE_PP(instance)->function_table, SS("setforceexists"), (void **) &method) == SUCCESS) {
+				if (method->common.scope == phalcon_mvc_model_ce) {
+					column->call_force_exists = 0;
+				}
+			}
+
+			column->attributes = ecalloc(zend_hash_num_elements(Z_ARRVAL_PP(attributes)) + 1, sizeof(phalcon_complex_attribute));
+
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_PP(attributes), &hp1);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_PP(attributes), (void **) &attribute, &hp1) == SUCCESS) {
+
+				attribute_name = **attribute;
+				zval_copy_ctor(&attribute_name);
+				convert_to_string(&attribute_name);
+
+				/**
+				 * Values come in the _source_attribute notation
+				 */
+				key_length = Z_STRLEN_PP(source) + Z_STRLEN(attribute_name) + 2;
+				key = emalloc(key_length + 1);
+				key[0] = '_';
+				memcpy(key + 1, Z_STRVAL_PP(source), Z_STRLEN_PP(source));
+				key[Z_STRLEN_PP(source) + 1] = '_';
+				memcpy(key + Z_STRLEN_PP(source) + 2, Z_STRVAL(attribute_name), Z_STRLEN(attribute_name));
+				key[key_length] = '\0';
+
+				name = Z_STRVAL(attribute_name);
+				name_length = Z_STRLEN(attribute_name);
+
+				/**
+				 * Attributes are renamed using the column map
+				 */
+				if (Z_TYPE_PP(column_map) == IS_ARRAY) {
+					if (zend_symtable_find(Z_ARRVAL_PP(column_map), name, name_length + 1, (void **) &mapped) == FAILURE || Z_TYPE_PP(mapped) != IS_STRING) {
+						zend_throw_exception_ex(phalcon_mvc_model_exception_ce, 0 TSRMLS_CC, "Column \"%s\" doesn't make part of the column map", name);
+						efree(key);
+						zval_dtor(&attribute_name);
+						zval_dtor(&alias);
+						return FAILURE;
+					}
+					name = Z_STRVAL_PP(mapped);
+					name_length = Z_STRLEN_PP(mapped);
+				}
+
+				plan_attribute = &column->attributes[column->count++];
+				phalcon_complex_attribute_init(plan_attribute, key, key_length, name, name_length, phalcon_complex_property_scope(Z_OBJCE_PP(instance), name, name_length), first_row);
+
+				zval_dtor(&attribute_name);
+				zend_hash_move_forward_ex(Z_ARRVAL_PP(attributes), &hp1);
+			}
+
+		} else {
+
+			column->type = PHALCON_COMPLEX_COLUMN_SCALAR;
+			column->attributes = ecalloc(1, sizeof(phalcon_complex_attribute));
+
+			if (zend_hash_find(Z_ARRVAL_PP(column_type), SS("sqlAlias"), (void **) &sql_alias) == SUCCESS) {
+				attribute_name = **sql_alias;
+				zval_copy_ctor(&attribute_name);
+				convert_to_string(&attribute_name);
+			} else {
+				attribute_name = alias;
+				zval_copy_ctor(&attribute_name);
+			}
+
+			/**
+			 * If a 'balias' is defined is not an unnamed scalar, unnamed ones lose their underscores
+			 */
+			name = estrndup(Z_STRVAL(alias), Z_STRLEN(alias));
+			name_length = Z_STRLEN(alias);
+			if (!zend_hash_exists(Z_ARRVAL_PP(column_type), SS("balias"))) {
+				name_length = 0;
+				for (i = 0; i < (uint) Z_STRLEN(alias); i++) {
+					if (Z_STRVAL(alias)[i] != '_') {
+						name[name_length++] = Z_STRVAL(alias)[i];
+					}
+				}
+				name[name_length] = '\0';
+			}
+
+			column->count = 1;
+			phalcon_complex_attribute_init(column->attributes, Z_STRVAL(attribute_name), Z_STRLEN(attribute_name), name, name_length, phalcon_mvc_model_row_ce, first_row);
+			efree(name);
+		}
+
+		zval_dtor(&alias);
+		zend_hash_move_forward_ex(Z_ARRVAL_P(columns_types), &hp0);
+	}
+
+	intern->compiled = 1;
+	return SUCCESS;
+}
+
+/**
+ * Writes a property with the scope of the class declaring it
+ */
+static inline void phalcon_complex_write_property(zval *object, zval *name, zend_class_entry *scope, zval *value TSRMLS_DC){
+
+	zend_class_entry *old_scope = EG(scope);
+
+	EG(scope) = scope;
+#if PHP_VERSION_ID < 50400
+	Z_OBJ_HT_P(object)->write_property(object, name, value TSRMLS_CC);
+#else
+	Z_OBJ_HT_P(object)->write_property(object, name, value, NULL TSRMLS_CC);
+#endif
+	EG(scope) = old_scope;
+}
+
+/**
+ * Builds a row following the plan, the row is walked once to find the position of its values
+ */
+static int phalcon_mvc_model_resultset_complex_hydrate(phalcon_mvc_model_resultset_complex_object *intern, HashTable *row, zval *active_row TSRMLS_DC){
+
+	phalcon_complex_column *column, *end;
+	phalcon_complex_attribute *attribute, *attributes_end;
+	Bucket *bucket;
+	zval **value, *null_value, *object, *true_value, *retval = NULL;
+	uint position = 0;
+
+	for (bucket = row->pListHead; bucket && position < intern->buckets_size; bucket = bucket->pListNext) {
+		intern->buckets[position++] = bucket;
+	}
+	while (position < intern->buckets_size) {
+		intern->buckets[position++] = NULL;
+	}
+
+	end = intern->plan + intern->plan_count;
+	for (column = intern->plan; column < end; column++) {
+
+		if (column->type == PHALCON_COMPLEX_COLUMN_OBJECT) {
+
+			/**
+			 * The model is cloned from the prototype and its attributes are assigned directly
+			 */
+			ALLOC_INIT_ZVAL(object);
+			Z_OBJVAL_P(object) = Z_OBJ_HT_P(column->instance)->clone_obj(column->instance TSRMLS_CC);
+			Z_TYPE_P(object) = IS_OBJECT;
+			if (EG(exception)) {
+				zval_ptr_dtor(&object);
+				return FAILURE;
+			}
+
+			ALLOC_INIT_ZVAL(true_value);
+			ZVAL_BOOL(true_value, 1);
+			if (column->call_force_exists) {
+				zend_call_method_with_1_params(&object, Z_OBJCE_P(object), NULL, "setforceexists", &retval, true_value);
+				if (retval) {
+					zval_ptr_dtor(&retval);
+					retval = NULL;
+				}
+				if (EG(exception)) {
+					zval_ptr_dtor(&true_value);
+					zval_ptr_dtor(&object);
+					return FAILURE;
+				}
+			} else {
+				phalcon_complex_write_property(object, intern->force_exists_name, phalcon_mvc_model_ce, true_value TSRMLS_CC);
+			}
+			zval_ptr_dtor(&true_value);
+		} else {
+			object = active_row;
+		}
+
+		attributes_end = column->attributes + column->count;
+		for (attribute = column->attributes; attribute < attributes_end; attribute++) {
+
+			value = NULL;
+			if (attribute->offset < intern->buckets_size) {
+				bucket = intern->buckets[attribute->offset];
+				if (bucket && bucket->h == attribute->hash && bucket->nKeyLength == attribute->key_length && !memcmp(bucket->arKey, attribute->key, attribute->key_length)) {
+					value = (zval **) bucket->pData;
+				}
+			}
+
+			if (!value) {
+				if (zend_hash_quick_find(row, attribute->key, attribute->key_length, attribute->hash, (void **) &value) == FAILURE) {
+					php_error_docref(NULL TSRMLS_CC, E_NOTICE, "Undefined index: %s", attribute->key);
+					ALLOC_INIT_ZVAL(null_value);
+					phalcon_complex_write_property(object, attribute->name, attribute->scope, null_value TSRMLS_CC);
+					zval_ptr_dtor(&null_value);
+					continue;
+				}
+			}
+
+			phalcon_complex_write_property(object, attribute->name, attribute->scope, *value TSRMLS_CC);
+		}
+
+		/**
+		 * The complete object is assigned to an attribute with the name of the alias or
+		 * the model name
+		 */
+		if (column->type == PHALCON_COMPLEX_COLUMN_OBJECT) {
+			phalcon_complex_write_property(active_row, column->alias, phalcon_mvc_model_row_ce, object TSRMLS_CC);
+			zval_ptr_dtor(&object);
+		}
+	}
+
+	return SUCCESS;
+}
+
+static void phalcon_mvc_model_resultset_complex_object_free(void *object TSRMLS_DC){
+
+	phalcon_mvc_model_resultset_complex_object *intern = (phalcon_mvc_model_resultset_complex_object *) object;
+
+	phalcon_mvc_model_resultset_complex_reset(intern);
+
+	zend_object_std_dtor(&intern->std TSRMLS_CC);
+	efree(intern);
+}
+
+static zend_object_value phalcon_mvc_model_resultset_complex_object_new(zend_class_entry *class_type TSRMLS_DC){
+
+	phalcon_mvc_model_resultset_complex_object *intern;
+	zend_object_value retval;
+#if PHP_VERSION_ID < 50400
+	zval *tmp;
+#endif
+
+	intern = ecalloc(1, sizeof(phalcon_mvc_model_resultset_complex_object));
+	zend_object_std_init(&intern->std, class_type TSRMLS_CC);
+#if PHP_VERSION_ID >= 50400
+	object_properties_init(&intern->std, class_type);
+#else
+	zend_hash_copy(intern->std.properties, &class_type->default_properties, (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+#endif
+
+	retval.handle = zend_objects_store_put(intern, (zend_objects_store_dtor_t) zend_objects_destroy_object, phalcon_mvc_model_resultset_complex_object_free, NULL TSRMLS_CC);
+	retval.handlers = &phalcon_mvc_model_resultset_complex_handlers;
+
+	return retval;
+}
+
+/**
+ * Clones copy the properties, the plan is compiled again by the clone
+ */
+static zend_object_value phalcon_mvc_model_resultset_complex_object_clone(zval *object TSRMLS_DC){
+
+	zend_object_value retval;
+	zend_object *old_object, *new_object;
+
+	old_object = zend_objects_get_address(object TSRMLS_CC);
+	retval = phalcon_mvc_model_resultset_complex_object_new(old_object->ce TSRMLS_CC);
+	new_object = (zend_object *) zend_object_store_get_object_by_handle(retval.handle TSRMLS_CC);
+
+	zend_objects_clone_members(new_object, retval, old_object, Z_OBJ_HANDLE_P(object) TSRMLS_CC);
+
+	return retval;
+}
+
 
 /**
  * Phalcon\Mvc\Model\Resultset\Complex initializer
@@ -57,6 +515,11 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset_Complex){
 
 	zend_declare_property_null(phalcon_mvc_model_resultset_complex_ce, SL("_columnTypes"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
+	phalcon_mvc_model_resultset_complex_ce->create_object = phalcon_mvc_model_resultset_complex_object_new;
+
+	memcpy(&phalcon_mvc_model_resultset_complex_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	phalcon_mvc_model_resultset_complex_handlers.clone_obj = phalcon_mvc_model_resultset_complex_object_clone;
+
 	zend_class_implements(phalcon_mvc_model_resultset_complex_ce TSRMLS_CC, 1, phalcon_mvc_model_resultsetinterface_ce);
 
 	return SUCCESS;
@@ -84,6 +547,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, __construct){
 		PHALCON_INIT_NVAR(cache);
 	}
 	
+	/** 
+	 * The hydration plan is compiled again from the new column types
+	 */
+	phalcon_mvc_model_resultset_complex_reset((phalcon_mvc_model_resultset_complex_object *) zend_object_store_get_object(this_ptr TSRMLS_CC));
 	phalcon_update_property_zval(this_ptr, SL("_columnTypes"), columns_types TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_result"), result TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_cache"), cache TSRMLS_CC);
@@ -104,19 +571,8 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, __construct){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, valid){
 
-	zval *type = NULL, *result, *row = NULL, *rows, *underscore, *empty_str;
-	zval *active_row, *columns_types, *column = NULL, *alias = NULL;
-	zval *source = NULL, *instance = NULL, *attributes = NULL, *column_map = NULL;
-	zval *row_model = NULL, *attribute = NULL, *column_alias = NULL, *value = NULL;
-	zval *model_attribute = NULL, *sql_alias = NULL, *n_alias = NULL;
-	HashTable *ah0, *ah1;
-	HashPosition hp0, hp1;
-	zval **hd;
-	char *hash_index;
-	uint hash_index_len;
-	ulong hash_num;
-	int hash_type;
-	int eval_int;
+	zval *type, *result, *row = NULL, *rows, *packed, *active_row;
+	phalcon_mvc_model_resultset_complex_object *intern;
 
 	PHALCON_MM_GROW();
 
@@ -135,208 +591,151 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, valid){
 	} else {
 		PHALCON_INIT_VAR(rows);
 		phalcon_read_property(&rows, this_ptr, SL("_rows"), PH_NOISY_CC);
-		Z_SET_ISREF_P(rows);
-	
-		PHALCON_INIT_NVAR(row);
-		PHALCON_CALL_FUNC_PARAMS_1(row, "current", rows);
-		Z_UNSET_ISREF_P(rows);
-		if (zend_is_true(row)) {
+
+		PHALCON_INIT_VAR(packed);
+		phalcon_read_property(&packed, this_ptr, SL("_packed"), PH_NOISY_CC);
+		if (Z_TYPE_P(rows) == IS_NULL && phalcon_mvc_model_resultset_is_packed(packed)) {
+			/**
+			 * Unserialized resultsets decode one row at a time
+			 */
+			PHALCON_INIT_NVAR(row);
+			if (phalcon_mvc_model_resultset_unpack_row(this_ptr, packed, row TSRMLS_CC) == FAILURE) {
+				PHALCON_MM_RESTORE();
+				return;
+			}
+		} else {
 			Z_SET_ISREF_P(rows);
-			PHALCON_CALL_FUNC_PARAMS_1_NORETURN("next", rows);
+
+			PHALCON_INIT_NVAR(row);
+			PHALCON_CALL_FUNC_PARAMS_1(row, "current", rows);
 			Z_UNSET_ISREF_P(rows);
+			if (zend_is_true(row)) {
+				Z_SET_ISREF_P(rows);
+				PHALCON_CALL_FUNC_PARAMS_1_NORETURN("next", rows);
+				Z_UNSET_ISREF_P(rows);
+			}
 		}
 	}
-	
+
 	if (PHALCON_IS_NOT_FALSE(row)) {
-		PHALCON_INIT_VAR(underscore);
-		ZVAL_STRING(underscore, "_", 1);
-	
-		PHALCON_INIT_VAR(empty_str);
-		ZVAL_STRING(empty_str, "", 1);
-	
+
+		/**
+		 * Rows restored from resultsets serialized by previous versions are already built
+		 */
+		if (Z_TYPE_P(row) == IS_OBJECT) {
+			phalcon_update_property_zval(this_ptr, SL("_activeRow"), row TSRMLS_CC);
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
+		}
+
+		if (Z_TYPE_P(row) != IS_ARRAY) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Invalid row in the resultset");
+			return;
+		}
+
+		/**
+		 * The column types are compiled into a plan when the first row arrives, the
+		 * following rows are built without reading the column types again
+		 */
+		intern = (phalcon_mvc_model_resultset_complex_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+		if (!intern->compiled) {
+			if (phalcon_mvc_model_resultset_complex_compile(intern, this_ptr, Z_ARRVAL_P(row) TSRMLS_CC) == FAILURE) {
+				PHALCON_MM_RESTORE();
+				return;
+			}
+		}
+
 		PHALCON_INIT_VAR(active_row);
 		object_init_ex(active_row, phalcon_mvc_model_row_ce);
-	
-		PHALCON_INIT_VAR(columns_types);
-		phalcon_read_property(&columns_types, this_ptr, SL("_columnTypes"), PH_NOISY_CC);
-	
-		if (!phalcon_valid_foreach(columns_types TSRMLS_CC)) {
+		if (phalcon_mvc_model_resultset_complex_hydrate(intern, Z_ARRVAL_P(row), active_row TSRMLS_CC) == FAILURE) {
+			PHALCON_MM_RESTORE();
 			return;
 		}
-	
-		ah0 = Z_ARRVAL_P(columns_types);
-		zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	
-		ph_cycle_start_0:
-	
-			if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
-				goto ph_cycle_end_0;
-			}
-	
-			PHALCON_GET_FOREACH_KEY(alias, ah0, hp0);
-			PHALCON_GET_FOREACH_VALUE(column);
-	
-			PHALCON_INIT_NVAR(type);
-			phalcon_array_fetch_string(&type, column, SL("type"), PH_NOISY_CC);
-			if (PHALCON_COMPARE_STRING(type, "object")) {
-				/** 
-				 * Object columns are assigned column by column
-				 */
-				PHALCON_INIT_NVAR(source);
-				phalcon_array_fetch_string(&source, column, SL("column"), PH_NOISY_CC);
-	
-				PHALCON_INIT_NVAR(instance);
-				phalcon_array_fetch_string(&instance, column, SL("instance"), PH_NOISY_CC);
-	
-				PHALCON_INIT_NVAR(attributes);
-				phalcon_array_fetch_string(&attributes, column, SL("attributes"), PH_NOISY_CC);
-	
-				PHALCON_INIT_NVAR(column_map);
-				phalcon_array_fetch_string(&column_map, column, SL("columnMap"), PH_NOISY_CC);
-	
-				/** 
-				 * Assign the values from the _source_attribute notation to its real column name
-				 */
-				PHALCON_INIT_NVAR(row_model);
-				array_init(row_model);
-	
-				if (!phalcon_valid_foreach(attributes TSRMLS_CC)) {
-					return;
-				}
-	
-				ah1 = Z_ARRVAL_P(attributes);
-				zend_hash_internal_pointer_reset_ex(ah1, &hp1);
-	
-				ph_cycle_start_1:
-	
-					if (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) != SUCCESS) {
-						goto ph_cycle_end_1;
-					}
-	
-					PHALCON_GET_FOREACH_VALUE(attribute);
-	
-					PHALCON_INIT_NVAR(column_alias);
-					PHALCON_CONCAT_VVVV(column_alias, underscore, source, underscore, attribute);
-	
-					PHALCON_INIT_NVAR(value);
-					phalcon_array_fetch(&value, row, column_alias, PH_NOISY_CC);
-					phalcon_array_update_zval(&row_model, attribute, &value, PH_COPY | PH_SEPARATE TSRMLS_CC);
-	
-					zend_hash_move_forward_ex(ah1, &hp1);
-					goto ph_cycle_start_1;
-	
-				ph_cycle_end_1:
-	
-				/** 
-				 * Assign the values to the attributes using a column map
-				 */
-				PHALCON_INIT_NVAR(model_attribute);
-				PHALCON_CALL_STATIC_PARAMS_3(model_attribute, "phalcon\\mvc\\model", "dumpresultmap", instance, row_model, column_map);
-	
-				/** 
-				 * The complete object is assigned to an attribute with the name of the alias or
-				 * the model name
-				 */
-				PHALCON_INIT_NVAR(attribute);
-				phalcon_array_fetch_string(&attribute, column, SL("balias"), PH_NOISY_CC);
-				phalcon_update_property_zval_zval(active_row, attribute, model_attribute TSRMLS_CC);
-			} else {
-				/** 
-				 * Scalar columns are simply assigned to the result object
-				 */
-				eval_int = phalcon_array_isset_string(column, SS("sqlAlias"));
-				if (eval_int) {
-					PHALCON_INIT_NVAR(sql_alias);
-					phalcon_array_fetch_string(&sql_alias, column, SL("sqlAlias"), PH_NOISY_CC);
-	
-					PHALCON_INIT_NVAR(value);
-					phalcon_array_fetch(&value, row, sql_alias, PH_NOISY_CC);
-				} else {
-					PHALCON_INIT_NVAR(value);
-					phalcon_array_fetch(&value, row, alias, PH_NOISY_CC);
-				}
-	
-				/** 
-				 * If a 'balias' is defined is not an unnamed scalar
-				 */
-				eval_int = phalcon_array_isset_string(column, SS("balias"));
-				if (eval_int) {
-					phalcon_update_property_zval_zval(active_row, alias, value TSRMLS_CC);
-				} else {
-					PHALCON_INIT_NVAR(n_alias);
-					phalcon_fast_str_replace(n_alias, underscore, empty_str, alias TSRMLS_CC);
-					phalcon_update_property_zval_zval(active_row, n_alias, value TSRMLS_CC);
-				}
-			}
-	
-			zend_hash_move_forward_ex(ah0, &hp0);
-			goto ph_cycle_start_0;
-	
-		ph_cycle_end_0:
-	
+
 		phalcon_update_property_zval(this_ptr, SL("_activeRow"), active_row TSRMLS_CC);
 		PHALCON_MM_RESTORE();
 		RETURN_TRUE;
 	} else {
 		phalcon_update_property_bool(this_ptr, SL("_activeRow"), 0 TSRMLS_CC);
 	}
-	
+
 	PHALCON_MM_RESTORE();
 	RETURN_FALSE;
 }
 
 /**
- * Serializing a resultset will dump all related rows into a big array
+ * Serializing a resultset packs the rows as the database returned them along with the column
+ * types, rows are built again from them when the resultset is unserialized
  *
  * @return string
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, serialize){
 
-	zval *records, *valid = NULL, *current = NULL, *cache, *data, *serialized;
-	zval *r0 = NULL;
+	zval *packed, *type, *result, *records = NULL, *cache, *columns_types;
+	zval *data;
 
 	PHALCON_MM_GROW();
 
-	PHALCON_INIT_VAR(records);
-	array_init(records);
-	PHALCON_CALL_METHOD_NORETURN(this_ptr, "rewind", PH_NO_CHECK);
-	ph_cycle_start_0:
-	
-		PHALCON_INIT_NVAR(r0);
-		PHALCON_CALL_METHOD(r0, this_ptr, "valid", PH_NO_CHECK);
-		PHALCON_CPY_WRT(valid, r0);
-		if (PHALCON_IS_NOT_TRUE(valid)) {
-			goto ph_cycle_end_0;
+	/**
+	 * Resultsets restored from packed data are serialized again as they are
+	 */
+	PHALCON_INIT_VAR(packed);
+	phalcon_read_property(&packed, this_ptr, SL("_packed"), PH_NOISY_CC);
+	if (phalcon_mvc_model_resultset_is_packed(packed)) {
+		RETURN_CCTOR(packed);
+	}
+
+	PHALCON_INIT_VAR(type);
+	phalcon_read_property(&type, this_ptr, SL("_type"), PH_NOISY_CC);
+	if (zend_is_true(type)) {
+		PHALCON_INIT_VAR(result);
+		phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+		if (PHALCON_IS_NOT_FALSE(result)) {
+			PHALCON_CALL_METHOD_NORETURN(result, "execute", PH_NO_CHECK);
+
+			PHALCON_INIT_VAR(records);
+			PHALCON_CALL_METHOD(records, result, "fetchall", PH_NO_CHECK);
+
+			/**
+			 * The cursor is at the end, the next rewind seeks the first row again
+			 */
+			phalcon_update_property_bool(this_ptr, SL("_activeRow"), 0 TSRMLS_CC);
 		}
-		PHALCON_INIT_NVAR(current);
-		PHALCON_CALL_METHOD(current, this_ptr, "current", PH_NO_CHECK);
-		phalcon_array_append(&records, current, PH_SEPARATE TSRMLS_CC);
-		PHALCON_CALL_METHOD_NORETURN(this_ptr, "next", PH_NO_CHECK);
-		goto ph_cycle_start_0;
-	ph_cycle_end_0:
-	
+	} else {
+		PHALCON_INIT_VAR(records);
+		phalcon_read_property(&records, this_ptr, SL("_rows"), PH_NOISY_CC);
+	}
+
+	if (!records || Z_TYPE_P(records) != IS_ARRAY) {
+		PHALCON_INIT_NVAR(records);
+		array_init(records);
+	}
+
 	PHALCON_INIT_VAR(cache);
 	phalcon_read_property(&cache, this_ptr, SL("_cache"), PH_NOISY_CC);
-	
+
+	PHALCON_INIT_VAR(columns_types);
+	phalcon_read_property(&columns_types, this_ptr, SL("_columnTypes"), PH_NOISY_CC);
+
 	PHALCON_INIT_VAR(data);
 	array_init(data);
 	phalcon_array_update_string(&data, SL("cache"), &cache, PH_COPY | PH_SEPARATE TSRMLS_CC);
-	phalcon_array_update_string(&data, SL("rows"), &records, PH_COPY | PH_SEPARATE TSRMLS_CC);
-	
-	PHALCON_INIT_VAR(serialized);
-	PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", data);
-	
-	RETURN_CCTOR(serialized);
+	phalcon_array_update_string(&data, SL("columnTypes"), &columns_types, PH_COPY | PH_SEPARATE TSRMLS_CC);
+
+	phalcon_mvc_model_resultset_pack(return_value, records, data TSRMLS_CC);
+
+	PHALCON_MM_RESTORE();
 }
 
 /**
- * Unserializing a resultset will allow to only works on the rows present in the saved state
+ * Unserializing a resultset will allow to only works on the rows present in the saved state,
+ * packed rows are decoded and built one by one while the resultset is traversed
  *
  * @param string $data
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, unserialize){
 
-	zval *data, *resultset, *rows, *cache;
+	zval *data, *state, *resultset, *rows, *cache = NULL, *columns_types;
 
 	PHALCON_MM_GROW();
 
@@ -346,7 +745,28 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, unserialize){
 	}
 
 	phalcon_update_property_long(this_ptr, SL("_type"), 0 TSRMLS_CC);
-	
+
+	PHALCON_INIT_VAR(state);
+	if (phalcon_mvc_model_resultset_unpack(this_ptr, data, state TSRMLS_CC) == SUCCESS) {
+		PHALCON_INIT_VAR(cache);
+		phalcon_array_fetch_string(&cache, state, SL("cache"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_cache"), cache TSRMLS_CC);
+
+		/**
+		 * The hydration plan is compiled from the restored column types
+		 */
+		PHALCON_INIT_VAR(columns_types);
+		phalcon_array_fetch_string(&columns_types, state, SL("columnTypes"), PH_NOISY_CC);
+		phalcon_mvc_model_resultset_complex_reset((phalcon_mvc_model_resultset_complex_object *) zend_object_store_get_object(this_ptr TSRMLS_CC));
+		phalcon_update_property_zval(this_ptr, SL("_columnTypes"), columns_types TSRMLS_CC);
+
+		PHALCON_MM_RESTORE();
+		return;
+	}
+
+	/**
+	 * Resultsets serialized by previous versions keep the built rows
+	 */
 	PHALCON_INIT_VAR(resultset);
 	PHALCON_CALL_FUNC_PARAMS_1(resultset, "unserialize", data);
 	if (Z_TYPE_P(resultset) == IS_ARRAY) { 
@@ -354,7 +774,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, unserialize){
 		phalcon_array_fetch_string(&rows, resultset, SL("rows"), PH_NOISY_CC);
 		phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
 	
-		PHALCON_INIT_VAR(cache);
+		PHALCON_INIT_NVAR(cache);
 		phalcon_array_fetch_string(&cache, resultset, SL("cache"), PH_NOISY_CC);
 		phalcon_update_property_zval(this_ptr, SL("_cache"), cache TSRMLS_CC);
 	} else {
@@ -364,4 +784,3 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, unserialize){
 	
 	PHALCON_MM_RESTORE();
 }
-
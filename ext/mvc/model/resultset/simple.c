@@ -123,7 +123,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 
 	zval *type, *result = NULL, *row = NULL, *rows = NULL, *model, *column_map;
-	zval *active_row;
+	zval *active_row, *packed;
 
 	PHALCON_MM_GROW();
 
@@ -142,29 +142,43 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 	} else {
 		PHALCON_INIT_VAR(rows);
 		phalcon_read_property(&rows, this_ptr, SL("_rows"), PH_NOISY_CC);
-		if (Z_TYPE_P(rows) == IS_NULL) {
-			PHALCON_INIT_NVAR(result);
-			phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
-			if (PHALCON_IS_NOT_FALSE(result)) {
-				PHALCON_INIT_NVAR(rows);
-				PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
-				phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
+
+		PHALCON_INIT_VAR(packed);
+		phalcon_read_property(&packed, this_ptr, SL("_packed"), PH_NOISY_CC);
+		if (Z_TYPE_P(rows) == IS_NULL && phalcon_mvc_model_resultset_is_packed(packed)) {
+			/** 
+			 * Unserialized resultsets decode one row at a time
+			 */
+			PHALCON_INIT_NVAR(row);
+			if (phalcon_mvc_model_resultset_unpack_row(this_ptr, packed, row TSRMLS_CC) == FAILURE) {
+				PHALCON_MM_RESTORE();
+				return;
+			}
+		} else {
+			if (Z_TYPE_P(rows) == IS_NULL) {
+				PHALCON_INIT_NVAR(result);
+				phalcon_read_property(&result, this_ptr, SL("_result"), PH_NOISY_CC);
+				if (PHALCON_IS_NOT_FALSE(result)) {
+					PHALCON_INIT_NVAR(rows);
+					PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
+					phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
+				}
 			}
-		}
 	
-		if (Z_TYPE_P(rows) == IS_ARRAY) { 
-			Z_SET_ISREF_P(rows);
-			PHALCON_INIT_NVAR(row);
-			PHALCON_CALL_FUNC_PARAMS_1(row, "current", rows);
-			Z_UNSET_ISREF_P(rows);
-			if (PHALCON_IS_NOT_FALSE(row)) {
+			if (Z_TYPE_P(rows) == IS_ARRAY) { 
 				Z_SET_ISREF_P(rows);
-				PHALCON_CALL_FUNC_PARAMS_1_NORETURN("next", rows);
+				PHALCON_INIT_NVAR(row);
+				PHALCON_CALL_FUNC_PARAMS_1(row, "current", rows);
 				Z_UNSET_ISREF_P(rows);
+				if (PHALCON_IS_NOT_FALSE(row)) {
+					Z_SET_ISREF_P(rows);
+					PHALCON_CALL_FUNC_PARAMS_1_NORETURN("next", rows);
+					Z_UNSET_ISREF_P(rows);
+				}
+			} else {
+				PHALCON_INIT_NVAR(row);
+				ZVAL_BOOL(row, 0);
 			}
-		} else {
-			PHALCON_INIT_NVAR(row);
-			ZVAL_BOOL(row, 0);
 		}
 	}
 	
@@ -189,17 +203,27 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 }
 
 /**
- * Serializing a resultset will dump all related rows into a big array
+ * Serializing a resultset packs the column names once and every row with typed values, along
+ * with the model and the column map
  *
  * @return string
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, serialize){
 
-	zval *type, *result = NULL, *records = NULL, *row_count, *model;
-	zval *cache, *data, *serialized;
+	zval *packed, *type, *result = NULL, *records = NULL, *model;
+	zval *cache, *column_map, *data;
 
 	PHALCON_MM_GROW();
 
+	/** 
+	 * Resultsets restored from packed data are serialized again as they are
+	 */
+	PHALCON_INIT_VAR(packed);
+	phalcon_read_property(&packed, this_ptr, SL("_packed"), PH_NOISY_CC);
+	if (phalcon_mvc_model_resultset_is_packed(packed)) {
+		RETURN_CCTOR(packed);
+	}
+
 	PHALCON_INIT_VAR(type);
 	phalcon_read_property(&type, this_ptr, SL("_type"), PH_NOISY_CC);
 	if (zend_is_true(type)) {
@@ -210,6 +234,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, serialize){
 	
 			PHALCON_INIT_VAR(records);
 			PHALCON_CALL_METHOD(records, result, "fetchall", PH_NO_CHECK);
+	
+			/** 
+			 * The cursor is at the end, the next rewind seeks the first row again
+			 */
+			phalcon_update_property_bool(this_ptr, SL("_activeRow"), 0 TSRMLS_CC);
 		} else {
 			PHALCON_INIT_NVAR(records);
 			array_init(records);
@@ -223,10 +252,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, serialize){
 			if (PHALCON_IS_NOT_FALSE(result)) {
 				PHALCON_INIT_NVAR(records);
 				PHALCON_CALL_METHOD(records, result, "fetchall", PH_NO_CHECK);
-	
-				PHALCON_INIT_VAR(row_count);
-				phalcon_fast_count(row_count, records TSRMLS_CC);
-				phalcon_update_property_zval(this_ptr, SL("_rows"), row_count TSRMLS_CC);
+				phalcon_update_property_zval(this_ptr, SL("_rows"), records TSRMLS_CC);
 			}
 		}
 	}
@@ -237,26 +263,30 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, serialize){
 	PHALCON_INIT_VAR(cache);
 	phalcon_read_property(&cache, this_ptr, SL("_cache"), PH_NOISY_CC);
 	
+	PHALCON_INIT_VAR(column_map);
+	phalcon_read_property(&column_map, this_ptr, SL("_columnMap"), PH_NOISY_CC);
+	
 	PHALCON_INIT_VAR(data);
 	array_init(data);
 	phalcon_array_update_string(&data, SL("model"), &model, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	phalcon_array_update_string(&data, SL("cache"), &cache, PH_COPY | PH_SEPARATE TSRMLS_CC);
-	phalcon_array_update_string(&data, SL("rows"), &records, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_array_update_string(&data, SL("columnMap"), &column_map, PH_COPY | PH_SEPARATE TSRMLS_CC);
 	
-	PHALCON_INIT_VAR(serialized);
-	PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", data);
+	phalcon_mvc_model_resultset_pack(return_value, records, data TSRMLS_CC);
 	
-	RETURN_CCTOR(serialized);
+	PHALCON_MM_RESTORE();
 }
 
 /**
- * Unserializing a resultset will allow to only works on the rows present in the saved state
+ * Unserializing a resultset will allow to only works on the rows present in the saved state,
+ * packed rows are decoded one by one while the resultset is traversed
  *
  * @param string $data
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, unserialize){
 
-	zval *data, *resultset, *model, *rows, *cache;
+	zval *data, *state, *resultset, *model = NULL, *rows, *cache = NULL;
+	zval *column_map;
 
 	PHALCON_MM_GROW();
 
@@ -267,10 +297,31 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, unserialize){
 
 	phalcon_update_property_long(this_ptr, SL("_type"), 0 TSRMLS_CC);
 	
+	PHALCON_INIT_VAR(state);
+	if (phalcon_mvc_model_resultset_unpack(this_ptr, data, state TSRMLS_CC) == SUCCESS) {
+		PHALCON_INIT_VAR(model);
+		phalcon_array_fetch_string(&model, state, SL("model"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_model"), model TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(cache);
+		phalcon_array_fetch_string(&cache, state, SL("cache"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_cache"), cache TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(column_map);
+		phalcon_array_fetch_string(&column_map, state, SL("columnMap"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_columnMap"), column_map TSRMLS_CC);
+	
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	/** 
+	 * Resultsets serialized by previous versions are plain arrays
+	 */
 	PHALCON_INIT_VAR(resultset);
 	PHALCON_CALL_FUNC_PARAMS_1(resultset, "unserialize", data);
 	if (Z_TYPE_P(resultset) == IS_ARRAY) { 
-		PHALCON_INIT_VAR(model);
+		PHALCON_INIT_NVAR(model);
 		phalcon_array_fetch_string(&model, resultset, SL("model"), PH_NOISY_CC);
 		phalcon_update_property_zval(this_ptr, SL("_model"), model TSRMLS_CC);
 	
@@ -278,7 +329,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, unserialize){
 		phalcon_array_fetch_string(&rows, resultset, SL("rows"), PH_NOISY_CC);
 		phalcon_update_property_zval(this_ptr, SL("_rows"), rows TSRMLS_CC);
 	
-		PHALCON_INIT_VAR(cache);
+		PHALCON_INIT_NVAR(cache);
 		phalcon_array_fetch_string(&cache, resultset, SL("cache"), PH_NOISY_CC);
 		phalcon_update_property_zval(this_ptr, SL("_cache"), cache TSRMLS_CC);
 	} else {
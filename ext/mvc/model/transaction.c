@@ -76,6 +76,62 @@
  */
 
 
+/**
+ * Gives a new cache generation to the tables written in the transaction once it's finished
+ */
+static void phalcon_mvc_model_transaction_invalidate_written(zval *transaction TSRMLS_DC){
+
+	zval *written_models, *model = NULL, *dependency_injector = NULL;
+	zval *service, *manager = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(written_models);
+	phalcon_read_property(&written_models, transaction, SL("_writtenModels"), PH_NOISY_CC);
+	if (Z_TYPE_P(written_models) != IS_ARRAY) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	phalcon_update_property_null(transaction, SL("_writtenModels") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(service);
+	ZVAL_STRING(service, "modelsManager", 1);
+	
+	ah0 = Z_ARRVAL_P(written_models);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	
+	ph_cycle_start_0:
+	
+		if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
+			goto ph_cycle_end_0;
+		}
+	
+		PHALCON_GET_FOREACH_VALUE(model);
+	
+		PHALCON_INIT_NVAR(dependency_injector);
+		PHALCON_CALL_METHOD(dependency_injector, model, "getdi", PH_NO_CHECK);
+		if (Z_TYPE_P(dependency_injector) == IS_OBJECT) {
+			PHALCON_INIT_NVAR(manager);
+			PHALCON_CALL_METHOD_PARAMS_1(manager, dependency_injector, "getshared", service, PH_NO_CHECK);
+			if (Z_TYPE_P(manager) == IS_OBJECT) {
+				if (phalcon_method_exists_ex(manager, SS("invalidatecache") TSRMLS_CC) == SUCCESS) {
+					PHALCON_CALL_METHOD_PARAMS_1_NORETURN(manager, "invalidatecache", model, PH_NO_CHECK);
+				}
+			}
+		}
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto ph_cycle_start_0;
+	
+	ph_cycle_end_0:
+	
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Phalcon\Mvc\Model\Transaction initializer
  */
@@ -90,6 +146,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Transaction){
 	zend_declare_property_null(phalcon_mvc_model_transaction_ce, SL("_manager"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_transaction_ce, SL("_messages"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_model_transaction_ce, SL("_rollbackRecord"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_model_transaction_ce, SL("_writtenModels"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_model_transaction_ce TSRMLS_CC, 1, phalcon_mvc_model_transactioninterface_ce);
 
@@ -223,6 +280,8 @@ PHP_METHOD(Phalcon_Mvc_Model_Transaction, commit){
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_METHOD(success, connection, "commit", PH_NO_CHECK);
 	
+	phalcon_mvc_model_transaction_invalidate_written(this_ptr TSRMLS_CC);
+	
 	RETURN_CCTOR(success);
 }
 
@@ -277,6 +336,13 @@ PHP_METHOD(Phalcon_Mvc_Model_Transaction, rollback){
 	
 	PHALCON_INIT_VAR(success);
 	PHALCON_CALL_METHOD(success, connection, "rollback", PH_NO_CHECK);
+	
+	phalcon_mvc_model_transaction_invalidate_written(this_ptr TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	if (zend_is_true(success)) {
 		if (!zend_is_true(rollback_message)) {
 			PHALCON_INIT_NVAR(rollback_message);
@@ -433,3 +499,43 @@ PHP_METHOD(Phalcon_Mvc_Model_Transaction, setRollbackedRecord){
 	
 }
 
+/**
+ * Registers a model written in the transaction, the cache generation of its table is renewed
+ * again when the transaction commits or rolls back
+ *
+ * @param Phalcon\Mvc\ModelInterface $model
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Transaction, addWrittenModel){
+
+	zval *model, *written_models = NULL, *class_name;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &model) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(model) != IS_OBJECT) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_transaction_exception_ce, "Model must be an Object");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(written_models);
+	phalcon_read_property(&written_models, this_ptr, SL("_writtenModels"), PH_NOISY_CC);
+	if (Z_TYPE_P(written_models) != IS_ARRAY) {
+		PHALCON_INIT_NVAR(written_models);
+		array_init(written_models);
+	}
+	
+	/** 
+	 * Every table is renewed once however many records of it were written
+	 */
+	PHALCON_INIT_VAR(class_name);
+	phalcon_get_class(class_name, model TSRMLS_CC);
+	phalcon_array_update_zval(&written_models, class_name, &model, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	phalcon_update_property_zval(this_ptr, SL("_writtenModels"), written_models TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
@@ -70,6 +70,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Router){
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_action"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_params"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_routes"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_router_ce, SL("_namedRoutes"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_router_ce, SL("_namedRoutesVersion"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_matchedRoute"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_matches"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_mvc_router_ce, SL("_wasMatched"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
@@ -673,6 +675,7 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 	phalcon_read_property(&t0, this_ptr, SL("_routes"), PH_NOISY_CC);
 	phalcon_array_append(&t0, route, 0 TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_routes"), t0 TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_namedRoutes") TSRMLS_CC);
 	
 	RETURN_CTOR(route);
 }
@@ -875,6 +878,7 @@ PHP_METHOD(Phalcon_Mvc_Router, clear){
 	PHALCON_INIT_VAR(empty_routes);
 	array_init(empty_routes);
 	phalcon_update_property_zval(this_ptr, SL("_routes"), empty_routes TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_namedRoutes") TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -1035,16 +1039,19 @@ PHP_METHOD(Phalcon_Mvc_Router, getRouteById){
 }
 
 /**
- * Returns a route object by its name
+ * Returns a route object by its name. Routes are looked up in an index by name, the index is
+ * rebuilt only when routes are added or named after it was built
  *
  * @return Phalcon\Mvc\Router\Route
  */
 PHP_METHOD(Phalcon_Mvc_Router, getRouteByName){
 
-	zval *name, *routes, *route = NULL, *route_name = NULL, *is_equal = NULL;
-	HashTable *ah0;
-	HashPosition hp0;
+	zval *name, *routes, *version = NULL, *index_version, *named_routes = NULL;
+	zval *route = NULL, *route_name = NULL, *is_equal = NULL;
+	HashTable *ah0, *ah1;
+	HashPosition hp0, hp1;
 	zval **hd;
+	int eval_int;
 
 	PHALCON_MM_GROW();
 
@@ -1060,13 +1067,75 @@ PHP_METHOD(Phalcon_Mvc_Router, getRouteByName){
 		return;
 	}
 	
-	ah0 = Z_ARRVAL_P(routes);
-	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	/** 
+	 * Only string and integer names can be used as keys in the index
+	 */
+	if (Z_TYPE_P(name) == IS_STRING || Z_TYPE_P(name) == IS_LONG) {
 	
-	ph_cycle_start_0:
+		PHALCON_OBSERVE_VAR(version);
+		phalcon_read_static_property(&version, SL("phalcon\\mvc\\router\\route"), SL("_namesVersion") TSRMLS_CC);
 	
-		if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
-			goto ph_cycle_end_0;
+		PHALCON_INIT_VAR(index_version);
+		phalcon_read_property(&index_version, this_ptr, SL("_namedRoutesVersion"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(named_routes);
+		phalcon_read_property(&named_routes, this_ptr, SL("_namedRoutes"), PH_NOISY_CC);
+		if (Z_TYPE_P(named_routes) != IS_ARRAY || Z_TYPE_P(index_version) != IS_LONG || Z_LVAL_P(index_version) != phalcon_get_intval(version)) {
+	
+			PHALCON_INIT_NVAR(named_routes);
+			array_init(named_routes);
+	
+			ah0 = Z_ARRVAL_P(routes);
+			zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	
+			ph_cycle_start_0:
+	
+				if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
+					goto ph_cycle_end_0;
+				}
+	
+				PHALCON_GET_FOREACH_VALUE(route);
+	
+				PHALCON_INIT_NVAR(route_name);
+				PHALCON_CALL_METHOD(route_name, route, "getname", PH_NO_CHECK);
+				if (Z_TYPE_P(route_name) == IS_STRING || Z_TYPE_P(route_name) == IS_LONG) {
+					/** 
+					 * The first route with a name wins, as in a sequential search
+					 */
+					eval_int = phalcon_array_isset(named_routes, route_name);
+					if (!eval_int) {
+						phalcon_array_update_zval(&named_routes, route_name, &route, PH_COPY | PH_SEPARATE TSRMLS_CC);
+					}
+				}
+	
+				zend_hash_move_forward_ex(ah0, &hp0);
+				goto ph_cycle_start_0;
+	
+			ph_cycle_end_0:
+	
+			phalcon_update_property_zval(this_ptr, SL("_namedRoutes"), named_routes TSRMLS_CC);
+			phalcon_update_property_zval(this_ptr, SL("_namedRoutesVersion"), version TSRMLS_CC);
+		}
+	
+		eval_int = phalcon_array_isset(named_routes, name);
+		if (eval_int) {
+			PHALCON_INIT_NVAR(route);
+			phalcon_array_fetch(&route, named_routes, name, PH_NOISY_CC);
+	
+			RETURN_CCTOR(route);
+		}
+	
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	ah1 = Z_ARRVAL_P(routes);
+	zend_hash_internal_pointer_reset_ex(ah1, &hp1);
+	
+	ph_cycle_start_1:
+	
+		if (zend_hash_get_current_data_ex(ah1, (void**) &hd, &hp1) != SUCCESS) {
+			goto ph_cycle_end_1;
 		}
 	
 		PHALCON_GET_FOREACH_VALUE(route);
@@ -1081,10 +1150,10 @@ PHP_METHOD(Phalcon_Mvc_Router, getRouteByName){
 			RETURN_CCTOR(route);
 		}
 	
-		zend_hash_move_forward_ex(ah0, &hp0);
-		goto ph_cycle_start_0;
+		zend_hash_move_forward_ex(ah1, &hp1);
+		goto ph_cycle_start_1;
 	
-	ph_cycle_end_0:
+	ph_cycle_end_1:
 	
 	PHALCON_MM_RESTORE();
 	RETURN_FALSE;
@@ -60,7 +60,9 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Router_Route){
 	zend_declare_property_null(phalcon_mvc_router_route_ce, SL("_methods"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_route_ce, SL("_id"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_route_ce, SL("_name"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_router_route_ce, SL("_urlTemplate"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_router_route_ce, SL("_uniqueId"), ZEND_ACC_STATIC|ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_mvc_router_route_ce, SL("_namesVersion"), 0, ZEND_ACC_STATIC|ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_router_route_ce TSRMLS_CC, 1, phalcon_mvc_router_routeinterface_ce);
 
@@ -304,6 +306,7 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, reConfigure){
 	phalcon_update_property_zval(this_ptr, SL("_pattern"), pattern TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_compiledPattern"), compiled_pattern TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_paths"), route_paths TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_urlTemplate") TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -326,15 +329,31 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, getName){
  */
 PHP_METHOD(Phalcon_Mvc_Router_Route, setName){
 
-	zval *name;
+	zval *name, *version = NULL, *one, *next_version;
+
+	PHALCON_MM_GROW();
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &name) == FAILURE) {
+		PHALCON_MM_RESTORE();
 		RETURN_NULL();
 	}
 
 	phalcon_update_property_zval(this_ptr, SL("_name"), name TSRMLS_CC);
 	
-	RETURN_CTORW(this_ptr);
+	/** 
+	 * Routers rebuild their name index when the names version changes
+	 */
+	PHALCON_OBSERVE_VAR(version);
+	phalcon_read_static_property(&version, SL("phalcon\\mvc\\router\\route"), SL("_namesVersion") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(one);
+	ZVAL_LONG(one, 1);
+	
+	PHALCON_INIT_VAR(next_version);
+	phalcon_add_function(next_version, version, one TSRMLS_CC);
+	phalcon_update_static_property(SL("phalcon\\mvc\\router\\route"), SL("_namesVersion"), next_version TSRMLS_CC);
+	
+	RETURN_CTOR(this_ptr);
 }
 
 /**
@@ -450,6 +469,36 @@ PHP_METHOD(Phalcon_Mvc_Router_Route, getReversedPaths){
 	RETURN_CTOR(reversed);
 }
 
+/**
+ * Returns the URL template of the route. The pattern is compiled once into literal segments and
+ * the names of the parameters between them, Phalcon\Mvc\Url uses it to generate URLs in a single pass
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Router_Route, getUrlTemplate){
+
+	zval *url_template = NULL, *pattern, *reversed_paths;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(url_template);
+	phalcon_read_property(&url_template, this_ptr, SL("_urlTemplate"), PH_NOISY_CC);
+	if (Z_TYPE_P(url_template) == IS_NULL) {
+		PHALCON_INIT_VAR(pattern);
+		phalcon_read_property(&pattern, this_ptr, SL("_pattern"), PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(reversed_paths);
+		PHALCON_CALL_METHOD(reversed_paths, this_ptr, "getreversedpaths", PH_NO_CHECK);
+	
+		PHALCON_INIT_NVAR(url_template);
+		phalcon_compile_url_template(url_template, pattern, reversed_paths TSRMLS_CC);
+		phalcon_update_property_zval(this_ptr, SL("_urlTemplate"), url_template TSRMLS_CC);
+	}
+	
+	
+	RETURN_CCTOR(url_template);
+}
+
 /**
  * Returns the HTTP methods that constraint matching the route
  *
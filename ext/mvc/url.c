@@ -66,6 +66,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Url){
 	zend_declare_property_null(phalcon_mvc_url_ce, SL("_dependencyInjector"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_url_ce, SL("_baseUri"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_url_ce, SL("_basePath"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_url_ce, SL("_router"), ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_class_implements(phalcon_mvc_url_ce TSRMLS_CC, 2, phalcon_mvc_urlinterface_ce, phalcon_di_injectionawareinterface_ce);
 
@@ -93,6 +94,7 @@ PHP_METHOD(Phalcon_Mvc_Url, setDI){
 		return;
 	}
 	phalcon_update_property_zval(this_ptr, SL("_dependencyInjector"), dependency_injector TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_router") TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -231,9 +233,9 @@ PHP_METHOD(Phalcon_Mvc_Url, getBasePath){
  */
 PHP_METHOD(Phalcon_Mvc_Url, get){
 
-	zval *uri = NULL, *base_uri, *dependency_injector, *service;
-	zval *router, *route_name, *route, *exception_message;
-	zval *pattern, *paths, *final_uri = NULL;
+	zval *uri = NULL, *base_uri, *router = NULL, *dependency_injector;
+	zval *service, *route_name, *route, *exception_message;
+	zval *url_template, *pattern, *paths, *final_uri = NULL;
 	int eval_int;
 
 	PHALCON_MM_GROW();
@@ -247,8 +249,6 @@ PHP_METHOD(Phalcon_Mvc_Url, get){
 		PHALCON_INIT_NVAR(uri);
 	}
 	
-	PHALCON_INIT_VAR(base_uri);
-	PHALCON_CALL_METHOD(base_uri, this_ptr, "getbaseuri", PH_NO_CHECK);
 	if (Z_TYPE_P(uri) == IS_ARRAY) { 
 		eval_int = phalcon_array_isset_string(uri, SS("for"));
 		if (!eval_int) {
@@ -256,18 +256,27 @@ PHP_METHOD(Phalcon_Mvc_Url, get){
 			return;
 		}
 	
-		PHALCON_INIT_VAR(dependency_injector);
-		phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
-		if (!zend_is_true(dependency_injector)) {
-			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_url_exception_ce, "A dependency injector container is required to obtain the \"url\" service");
-			return;
-		}
+		/** 
+		 * The router is requested to the DI only once
+		 */
+		PHALCON_INIT_VAR(router);
+		phalcon_read_property(&router, this_ptr, SL("_router"), PH_NOISY_CC);
+		if (Z_TYPE_P(router) != IS_OBJECT) {
 	
-		PHALCON_INIT_VAR(service);
-		ZVAL_STRING(service, "router", 1);
+			PHALCON_INIT_VAR(dependency_injector);
+			phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+			if (!zend_is_true(dependency_injector)) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_url_exception_ce, "A dependency injector container is required to obtain the \"url\" service");
+				return;
+			}
 	
-		PHALCON_INIT_VAR(router);
-		PHALCON_CALL_METHOD_PARAMS_1(router, dependency_injector, "getshared", service, PH_NO_CHECK);
+			PHALCON_INIT_VAR(service);
+			ZVAL_STRING(service, "router", 1);
+	
+			PHALCON_INIT_NVAR(router);
+			PHALCON_CALL_METHOD_PARAMS_1(router, dependency_injector, "getshared", service, PH_NO_CHECK);
+			phalcon_update_property_zval(this_ptr, SL("_router"), router TSRMLS_CC);
+		}
 	
 		PHALCON_INIT_VAR(route_name);
 		phalcon_array_fetch_string(&route_name, uri, SL("for"), PH_NOISY_CC);
@@ -284,24 +293,38 @@ PHP_METHOD(Phalcon_Mvc_Url, get){
 			return;
 		}
 	
+		/** 
+		 * Phalcon\Mvc\Router\Route keeps a compiled URL template, the URL is built in a single pass
+		 */
+		if (instanceof_function(Z_OBJCE_P(route), phalcon_mvc_router_route_ce TSRMLS_CC)) {
+			PHALCON_INIT_VAR(url_template);
+			PHALCON_CALL_METHOD(url_template, route, "geturltemplate", PH_NO_CHECK);
+	
+			PHALCON_INIT_VAR(final_uri);
+			phalcon_build_url(final_uri, url_template, uri TSRMLS_CC);
+	
+			RETURN_CCTOR(final_uri);
+		}
+	
 		PHALCON_INIT_VAR(pattern);
 		PHALCON_CALL_METHOD(pattern, route, "getpattern", PH_NO_CHECK);
 	
 		PHALCON_INIT_VAR(paths);
 		PHALCON_CALL_METHOD(paths, route, "getreversedpaths", PH_NO_CHECK);
 	
-		PHALCON_INIT_VAR(final_uri);
-		phalcon_replace_paths(final_uri, pattern, paths, uri TSRMLS_CC);
-	
-		RETURN_CCTOR(final_uri);
-	} else {
 		PHALCON_INIT_NVAR(final_uri);
-		PHALCON_CONCAT_VV(final_uri, base_uri, uri);
+		phalcon_replace_paths(final_uri, pattern, paths, uri TSRMLS_CC);
 	
 		RETURN_CCTOR(final_uri);
 	}
 	
-	PHALCON_MM_RESTORE();
+	PHALCON_INIT_VAR(base_uri);
+	PHALCON_CALL_METHOD(base_uri, this_ptr, "getbaseuri", PH_NO_CHECK);
+	
+	PHALCON_INIT_NVAR(final_uri);
+	PHALCON_CONCAT_VV(final_uri, base_uri, uri);
+	
+	RETURN_CCTOR(final_uri);
 }
 
 /**
@@ -91,6 +91,10 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View){
 	zend_declare_property_long(phalcon_mvc_view_ce, SL("_cacheLevel"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_view_ce, SL("_activeRenderPath"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_disabled"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_streaming"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_streamLevels"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_mvc_view_ce, SL("_streamPosition"), -1, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_streamHeadersSent"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	zend_declare_class_constant_long(phalcon_mvc_view_ce, SL("LEVEL_MAIN_LAYOUT"), 5 TSRMLS_CC);
 	zend_declare_class_constant_long(phalcon_mvc_view_ce, SL("LEVEL_AFTER_TEMPLATE"), 4 TSRMLS_CC);
@@ -443,6 +447,7 @@ PHP_METHOD(Phalcon_Mvc_View, start){
 	PHALCON_MM_GROW();
 
 	phalcon_update_property_null(this_ptr, SL("_content") TSRMLS_CC);
+	phalcon_update_property_bool(this_ptr, SL("_streamHeadersSent"), 0 TSRMLS_CC);
 	PHALCON_CALL_FUNC_NORETURN("ob_start");
 	
 	PHALCON_MM_RESTORE();
@@ -561,6 +566,7 @@ PHP_METHOD(Phalcon_Mvc_View, _loadTemplateEngines){
  * @param boolean $silence
  * @param boolean $mustClean
  * @param Phalcon\Cache\BackendInterface $cache
+ * @return boolean
  */
 PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 
@@ -725,9 +731,12 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
 			return;
 		}
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
 	}
 	
 	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
 }
 
 /**
@@ -763,6 +772,43 @@ PHP_METHOD(Phalcon_Mvc_View, registerEngines){
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Appends a level (view path + silence flag) to the list of levels rendered in streaming mode
+ */
+static void phalcon_mvc_view_add_stream_level(zval *stream_levels, zval *view_path, int silence){
+
+	zval *stream_level;
+
+	MAKE_STD_ZVAL(stream_level);
+	array_init_size(stream_level, 2);
+	Z_ADDREF_P(view_path);
+	add_next_index_zval(stream_level, view_path);
+	add_next_index_bool(stream_level, silence);
+	add_next_index_zval(stream_levels, stream_level);
+}
+
+/**
+ * Appends the templates before/after to the list of levels rendered in streaming mode
+ */
+static void phalcon_mvc_view_add_stream_templates(zval *stream_levels, zval *layouts_dir, zval *templates TSRMLS_DC){
+
+	zval *view_path, **template_name;
+	HashPosition pos;
+
+	if (Z_TYPE_P(templates) != IS_ARRAY) {
+		return;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(templates), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(templates), (void**) &template_name, &pos) == SUCCESS) {
+		MAKE_STD_ZVAL(view_path);
+		phalcon_concat_vv(view_path, layouts_dir, *template_name, 0 TSRMLS_CC);
+		phalcon_mvc_view_add_stream_level(stream_levels, view_path, 0);
+		zval_ptr_dtor(&view_path);
+		zend_hash_move_forward_ex(Z_ARRVAL_P(templates), &pos);
+	}
+}
+
 /**
  * Executes render process from dispatching data
  *
@@ -787,12 +833,14 @@ PHP_METHOD(Phalcon_Mvc_View, render){
 	zval *silence = NULL, *render_level, *enter_level = NULL, *templates_before;
 	zval *template_before = NULL, *view_temp_path = NULL, *templates_after;
 	zval *template_after = NULL, *main_view, *is_started;
-	zval *is_fresh;
+	zval *is_fresh, *streaming, *stream_levels;
+	zval *stream_templates = NULL;
 	zval *t0 = NULL, *t1 = NULL, *t2 = NULL, *t3 = NULL, *t4 = NULL;
 	HashTable *ah0, *ah1;
 	HashPosition hp0, hp1;
 	zval **hd;
 	int eval_int;
+	long level;
 
 	PHALCON_MM_GROW();
 
@@ -890,6 +938,80 @@ PHP_METHOD(Phalcon_Mvc_View, render){
 	
 	PHALCON_INIT_VAR(render_level);
 	phalcon_read_property(&render_level, this_ptr, SL("_renderLevel"), PH_NOISY_CC);
+	
+	/** 
+	 * In streaming mode the levels are rendered from the outside in, every layout is
+	 * sent to the client as soon as it asks for the content of the inner level.
+	 * Cached views need the whole output so they are always rendered in the buffer
+	 */
+	PHALCON_INIT_VAR(streaming);
+	phalcon_read_property(&streaming, this_ptr, SL("_streaming"), PH_NOISY_CC);
+	if (zend_is_true(streaming)) {
+		if (Z_TYPE_P(cache) != IS_OBJECT) {
+			level = phalcon_get_intval(render_level);
+			if (level >= 1) {
+	
+				/** 
+				 * Levels are stored from the action view (innermost) to the main view (outermost)
+				 */
+				PHALCON_INIT_VAR(stream_levels);
+				array_init(stream_levels);
+				phalcon_mvc_view_add_stream_level(stream_levels, render_view, 1);
+	
+				if (level >= 2) {
+					PHALCON_INIT_VAR(stream_templates);
+					phalcon_read_property(&stream_templates, this_ptr, SL("_templatesBefore"), PH_NOISY_CC);
+					phalcon_mvc_view_add_stream_templates(stream_levels, layouts_dir, stream_templates TSRMLS_CC);
+				}
+	
+				if (level >= 3) {
+					PHALCON_INIT_NVAR(view_temp_path);
+					PHALCON_CONCAT_VV(view_temp_path, layouts_dir, render_controller);
+					phalcon_mvc_view_add_stream_level(stream_levels, view_temp_path, 1);
+				}
+	
+				if (level >= 4) {
+					PHALCON_INIT_NVAR(stream_templates);
+					phalcon_read_property(&stream_templates, this_ptr, SL("_templatesAfter"), PH_NOISY_CC);
+					phalcon_mvc_view_add_stream_templates(stream_levels, layouts_dir, stream_templates TSRMLS_CC);
+				}
+	
+				if (level >= 5) {
+					PHALCON_INIT_VAR(main_view);
+					phalcon_read_property(&main_view, this_ptr, SL("_mainView"), PH_NOISY_CC);
+					phalcon_mvc_view_add_stream_level(stream_levels, main_view, 1);
+				}
+	
+				phalcon_update_property_zval(this_ptr, SL("_streamLevels"), stream_levels TSRMLS_CC);
+				phalcon_update_property_long(this_ptr, SL("_streamPosition"), zend_hash_num_elements(Z_ARRVAL_P(stream_levels)) - 1 TSRMLS_CC);
+	
+				/** 
+				 * The output produced by the controller stays in _content for the action view
+				 */
+				PHALCON_CALL_FUNC_NORETURN("ob_clean");
+				PHALCON_CALL_METHOD_NORETURN(this_ptr, "_streamlevel", PH_NO_CHECK);
+	
+				/** 
+				 * Sends the tail of the outermost level
+				 */
+				PHALCON_CALL_METHOD_NORETURN(this_ptr, "_streamflush", PH_NO_CHECK);
+	
+				phalcon_update_property_null(this_ptr, SL("_streamLevels") TSRMLS_CC);
+				phalcon_update_property_long(this_ptr, SL("_streamPosition"), -1 TSRMLS_CC);
+				phalcon_update_property_string(this_ptr, SL("_content"), "" TSRMLS_CC);
+			}
+	
+			if (Z_TYPE_P(events_manager) == IS_OBJECT) {
+				PHALCON_INIT_NVAR(event_name);
+				ZVAL_STRING(event_name, "view:afterRender", 1);
+				PHALCON_CALL_METHOD_PARAMS_2_NORETURN(events_manager, "fire", event_name, this_ptr, PH_NO_CHECK);
+			}
+	
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
+		}
+	}
+	
 	if (zend_is_true(render_level)) {
 		/** 
 		 * Inserts view related to action
@@ -1107,11 +1229,10 @@ PHP_METHOD(Phalcon_Mvc_View, pick){
  * </code>
  *
  * @param string $partialPath
- * @return string
  */
 PHP_METHOD(Phalcon_Mvc_View, partial){
 
-	zval *partial_path, *zfalse, *engines, *content;
+	zval *partial_path, *zfalse, *engines;
 
 	PHALCON_MM_GROW();
 
@@ -1126,10 +1247,9 @@ PHP_METHOD(Phalcon_Mvc_View, partial){
 	PHALCON_INIT_VAR(engines);
 	PHALCON_CALL_METHOD(engines, this_ptr, "_loadtemplateengines", PH_NO_CHECK);
 	
-	PHALCON_INIT_VAR(content);
-	PHALCON_CALL_METHOD_PARAMS_5(content, this_ptr, "_enginerender", engines, partial_path, zfalse, zfalse, zfalse, PH_NO_CHECK);
+	PHALCON_CALL_METHOD_PARAMS_5_NORETURN(this_ptr, "_enginerender", engines, partial_path, zfalse, zfalse, zfalse, PH_NO_CHECK);
 	
-	RETURN_CCTOR(content);
+	PHALCON_MM_RESTORE();
 }
 
 /**
@@ -1316,6 +1436,148 @@ PHP_METHOD(Phalcon_Mvc_View, cache){
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Enables/disables the streaming mode. In streaming mode every layout is flushed to the
+ * client as soon as it requests the content of the inner level, instead of buffering
+ * the whole page. Views cached with Phalcon\Mvc\View::cache are always buffered
+ *
+ * Layouts are rendered before the views they contain, so variables an action view sets
+ * with $this->setVar() are not available to its layouts or to the main view. Set every
+ * variable the layouts need in the controller instead
+ *
+ *<code>
+ * $view->setStreaming(true);
+ *</code>
+ *
+ * @param boolean $streaming
+ */
+PHP_METHOD(Phalcon_Mvc_View, setStreaming){
+
+	zval *streaming;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &streaming) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	phalcon_update_property_bool(this_ptr, SL("_streaming"), zend_is_true(streaming) TSRMLS_CC);
+	
+}
+
+/**
+ * Checks whether the view is rendered in streaming mode
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_View, isStreaming){
+
+
+	RETURN_MEMBER(this_ptr, "_streaming");
+}
+
+/**
+ * Renders the next pending level in streaming mode. Levels whose view does not exist are skipped
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_View, _streamLevel){
+
+	zval *stream_levels, *stream_position, *engines, *must_clean;
+	zval *cache, *stream_level = NULL, *view_path = NULL, *silence = NULL;
+	zval *rendered = NULL;
+	long position;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(stream_levels);
+	phalcon_read_property(&stream_levels, this_ptr, SL("_streamLevels"), PH_NOISY_CC);
+	if (Z_TYPE_P(stream_levels) != IS_ARRAY) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	PHALCON_INIT_VAR(stream_position);
+	phalcon_read_property(&stream_position, this_ptr, SL("_streamPosition"), PH_NOISY_CC);
+	position = phalcon_get_intval(stream_position);
+	
+	PHALCON_INIT_VAR(engines);
+	PHALCON_CALL_METHOD(engines, this_ptr, "_loadtemplateengines", PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(must_clean);
+	ZVAL_BOOL(must_clean, 0);
+	
+	PHALCON_INIT_VAR(cache);
+	
+	while (position >= 0) {
+		PHALCON_INIT_NVAR(stream_level);
+		phalcon_array_fetch_long(&stream_level, stream_levels, position, PH_NOISY_CC);
+	
+		/** 
+		 * The position is moved before rendering so the getContent() made by the view
+		 * continues with the inner level
+		 */
+		position--;
+		phalcon_update_property_long(this_ptr, SL("_streamPosition"), position TSRMLS_CC);
+	
+		PHALCON_INIT_NVAR(view_path);
+		phalcon_array_fetch_long(&view_path, stream_level, 0, PH_NOISY_CC);
+	
+		PHALCON_INIT_NVAR(silence);
+		phalcon_array_fetch_long(&silence, stream_level, 1, PH_NOISY_CC);
+	
+		PHALCON_INIT_NVAR(rendered);
+		PHALCON_CALL_METHOD_PARAMS_5(rendered, this_ptr, "_enginerender", engines, view_path, silence, must_clean, cache, PH_NO_CHECK);
+		if (PHALCON_IS_TRUE(rendered)) {
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
+		}
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Sends the output produced in streaming mode to the client. The headers and cookies
+ * of the "response" service are sent before the first chunk
+ */
+PHP_METHOD(Phalcon_Mvc_View, _streamFlush){
+
+	zval *headers_sent, *dependency_injector, *service;
+	zval *has_service, *response;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(headers_sent);
+	phalcon_read_property(&headers_sent, this_ptr, SL("_streamHeadersSent"), PH_NOISY_CC);
+	if (PHALCON_IS_FALSE(headers_sent)) {
+		PHALCON_INIT_VAR(dependency_injector);
+		phalcon_read_property(&dependency_injector, this_ptr, SL("_dependencyInjector"), PH_NOISY_CC);
+		if (Z_TYPE_P(dependency_injector) == IS_OBJECT) {
+			PHALCON_INIT_VAR(service);
+			ZVAL_STRING(service, "response", 1);
+	
+			PHALCON_INIT_VAR(has_service);
+			PHALCON_CALL_METHOD_PARAMS_1(has_service, dependency_injector, "has", service, PH_NO_CHECK);
+			if (zend_is_true(has_service)) {
+				PHALCON_INIT_VAR(response);
+				PHALCON_CALL_METHOD_PARAMS_1(response, dependency_injector, "getshared", service, PH_NO_CHECK);
+				if (Z_TYPE_P(response) == IS_OBJECT) {
+					PHALCON_CALL_METHOD_NORETURN(response, "sendheaders", PH_NO_CHECK);
+					if (phalcon_method_exists_ex(response, SS("sendcookies") TSRMLS_CC) == SUCCESS) {
+						PHALCON_CALL_METHOD_NORETURN(response, "sendcookies", PH_NO_CHECK);
+					}
+				}
+			}
+		}
+		phalcon_update_property_bool(this_ptr, SL("_streamHeadersSent"), 1 TSRMLS_CC);
+	}
+	
+	PHALCON_CALL_FUNC_NORETURN("ob_flush");
+	PHALCON_CALL_FUNC_NORETURN("flush");
+	
+	PHALCON_MM_RESTORE();
+}
+
 /**
  * Externally sets the view content
  *
@@ -1346,14 +1608,32 @@ PHP_METHOD(Phalcon_Mvc_View, setContent){
 }
 
 /**
- * Returns cached ouput from another view stage
+ * Returns cached ouput from another view stage. In streaming mode the inner stage is
+ * rendered directly to the client and an empty string is returned
  *
  * @return string
  */
 PHP_METHOD(Phalcon_Mvc_View, getContent){
 
+	zval *stream_position, *rendered;
 
-	RETURN_MEMBER(this_ptr, "_content");
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(stream_position);
+	phalcon_read_property(&stream_position, this_ptr, SL("_streamPosition"), PH_NOISY_CC);
+	if (phalcon_get_intval(stream_position) >= 0) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "_streamflush", PH_NO_CHECK);
+	
+		PHALCON_INIT_VAR(rendered);
+		PHALCON_CALL_METHOD(rendered, this_ptr, "_streamlevel", PH_NO_CHECK);
+		if (PHALCON_IS_TRUE(rendered)) {
+			PHALCON_MM_RESTORE();
+			RETURN_EMPTY_STRING();
+		}
+	}
+	
+	phalcon_return_property(return_value, this_ptr, SL("_content") TSRMLS_CC);
+	PHALCON_MM_RESTORE();
 }
 
 /**
@@ -1402,6 +1682,8 @@ PHP_METHOD(Phalcon_Mvc_View, reset){
 	phalcon_update_property_long(this_ptr, SL("_renderLevel"), 5 TSRMLS_CC);
 	phalcon_update_property_long(this_ptr, SL("_cacheLevel"), 0 TSRMLS_CC);
 	phalcon_update_property_null(this_ptr, SL("_content") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_streamLevels") TSRMLS_CC);
+	phalcon_update_property_long(this_ptr, SL("_streamPosition"), -1 TSRMLS_CC);
 	
 }
 
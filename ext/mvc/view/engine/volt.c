@@ -138,9 +138,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 
 	zval *template_path, *params, *must_clean, *stat = NULL;
 	zval *compile_always = NULL, *compiled_path = NULL, *compiled_separator = NULL;
-	zval *compiled_extension = NULL, *options, *win_separator;
-	zval *unix_separator, *template_win_path;
-	zval *template_sep_path = NULL, *compiled_template_path;
+	zval *compiled_extension = NULL, *options, *compiled_template_path;
 	zval *dependency_injector = NULL, *compiler = NULL, *exception_message;
 	zval *value = NULL, *key = NULL, *contents, *view;
 	HashTable *ah0;
@@ -229,24 +227,8 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 		}
 	}
 	
-	if (Z_TYPE_P(compiled_path) != IS_NULL) {
-		PHALCON_INIT_VAR(win_separator);
-		ZVAL_STRING(win_separator, "\\", 1);
-	
-		PHALCON_INIT_VAR(unix_separator);
-		ZVAL_STRING(unix_separator, "/", 1);
-	
-		PHALCON_INIT_VAR(template_win_path);
-		phalcon_fast_str_replace(template_win_path, win_separator, compiled_separator, template_path TSRMLS_CC);
-	
-		PHALCON_INIT_VAR(template_sep_path);
-		phalcon_fast_str_replace(template_sep_path, unix_separator, compiled_separator, template_win_path TSRMLS_CC);
-	} else {
-		PHALCON_CPY_WRT(template_sep_path, template_path);
-	}
-	
 	PHALCON_INIT_VAR(compiled_template_path);
-	PHALCON_CONCAT_VVV(compiled_template_path, compiled_path, template_sep_path, compiled_extension);
+	phalcon_mvc_view_engine_volt_compiled_path(compiled_template_path, template_path, compiled_path, compiled_separator, compiled_extension TSRMLS_CC);
 	if (zend_is_true(compile_always)) {
 		/** 
 		 * Compile always must be used only in the development stage
@@ -257,6 +239,9 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 		PHALCON_INIT_VAR(compiler);
 		object_init_ex(compiler, phalcon_mvc_view_engine_volt_compiler_ce);
 		PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setdi", dependency_injector, PH_NO_CHECK);
+		if (Z_TYPE_P(options) == IS_ARRAY) { 
+			PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", options, PH_NO_CHECK);
+		}
 		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(compiler, "compile", template_path, compiled_template_path, PH_NO_CHECK);
 	} else {
 		if (PHALCON_IS_TRUE(stat)) {
@@ -271,6 +256,9 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 					PHALCON_INIT_NVAR(compiler);
 					object_init_ex(compiler, phalcon_mvc_view_engine_volt_compiler_ce);
 					PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setdi", dependency_injector, PH_NO_CHECK);
+					if (Z_TYPE_P(options) == IS_ARRAY) { 
+						PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", options, PH_NO_CHECK);
+					}
 					PHALCON_CALL_METHOD_PARAMS_2_NORETURN(compiler, "compile", template_path, compiled_template_path, PH_NO_CHECK);
 				}
 			} else {
@@ -283,6 +271,9 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt, render){
 				PHALCON_INIT_NVAR(compiler);
 				object_init_ex(compiler, phalcon_mvc_view_engine_volt_compiler_ce);
 				PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setdi", dependency_injector, PH_NO_CHECK);
+				if (Z_TYPE_P(options) == IS_ARRAY) { 
+					PHALCON_CALL_METHOD_PARAMS_1_NORETURN(compiler, "setoptions", options, PH_NO_CHECK);
+				}
 				PHALCON_CALL_METHOD_PARAMS_2_NORETURN(compiler, "compile", template_path, compiled_template_path, PH_NO_CHECK);
 			}
 		} else {
@@ -68,17 +68,45 @@ const phvolt_token_names phvolt_tokens[] =
 };
 
 /**
- * Wrapper to alloc memory within the parser
+ * phvolt_Free gets the lemon parser declared in phvolt_internal_parse_view, there is nothing to free
  */
-static void *phvolt_wrapper_alloc(size_t bytes){
-	return emalloc(bytes);
+static void phvolt_wrapper_free(void *pointer){
 }
 
 /**
- * Wrapper to free memory within the parser
+ * Every token the scanner finds in the template is handed to the parser from here. Partials and
+ * short templates fit in the block on the stack of phvolt_internal_parse_view, longer templates
+ * chain heap blocks that are kept until the whole template is parsed
  */
-static void phvolt_wrapper_free(void *pointer){
-	efree(pointer);
+static phvolt_parser_token *phvolt_arena_token(phvolt_parser_status *parser_status){
+
+	phvolt_token_arena *arena = parser_status->arena;
+
+	if (arena->used == PHVOLT_ARENA_SIZE) {
+		arena = emalloc(sizeof(phvolt_token_arena));
+		arena->used = 0;
+		arena->prev = parser_status->arena;
+		parser_status->arena = arena;
+	}
+
+	return &arena->tokens[arena->used++];
+}
+
+/**
+ * Frees the heap blocks chained while parsing the template, the parser status is left pointing
+ * to the block on the stack
+ */
+static void phvolt_arena_free(phvolt_parser_status *parser_status){
+
+	phvolt_token_arena *arena = parser_status->arena, *prev;
+
+	while (arena->prev) {
+		prev = arena->prev;
+		efree(arena);
+		arena = prev;
+	}
+
+	parser_status->arena = arena;
 }
 
 /**
@@ -86,10 +114,11 @@ static void phvolt_wrapper_free(void *pointer){
  */
 static void phvolt_parse_with_token(void* phvolt_parser, int opcode, int parsercode, phvolt_scanner_token *token, phvolt_parser_status *parser_status){
 	phvolt_parser_token *pToken;
-	pToken = emalloc(sizeof(phvolt_parser_token));
+	pToken = phvolt_arena_token(parser_status);
 	pToken->opcode = opcode;
 	pToken->token = token->value;
 	pToken->token_len = token->len;
+	pToken->free_flag = 0;
 	phvolt_(phvolt_parser, parsercode, pToken, parser_status);
 }
 
@@ -147,10 +176,12 @@ int phvolt_is_blank_string(phvolt_scanner_token *token){
 int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view_length, zval **error_msg TSRMLS_DC) {
 
 	char *error;
-	phvolt_scanner_state *state;
-	phvolt_scanner_token *token;
+	phvolt_scanner_state state_memory, *state = &state_memory;
+	phvolt_scanner_token token_memory, *token = &token_memory;
 	int scanner_status, status = SUCCESS;
-	phvolt_parser_status *parser_status = NULL;
+	phvolt_parser_status status_memory, *parser_status = &status_memory;
+	phvolt_token_arena arena;
+	yyParser parser_memory;
 	void* phvolt_parser;
 
 	if (!view_code) {
@@ -164,13 +195,18 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 		return SUCCESS;
 	}
 
-	phvolt_parser = phvolt_Alloc(phvolt_wrapper_alloc);
+	/** 
+	 * The parser, the scanner and the first block of tokens are allocated on the stack, tokens
+	 * point to the view code instead of copying it
+	 */
+	parser_memory.yyidx = -1;
+	phvolt_parser = &parser_memory;
 
-	parser_status = emalloc(sizeof(phvolt_parser_status));
-	state = emalloc(sizeof(phvolt_scanner_state));
-	token = emalloc(sizeof(phvolt_scanner_token));
+	arena.used = 0;
+	arena.prev = NULL;
 
 	parser_status->status = PHVOLT_PARSING_OK;
+	parser_status->arena = &arena;
 	parser_status->scanner_state = state;
 	parser_status->ret = NULL;
 	parser_status->syntax_error = NULL;
@@ -179,8 +215,9 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 	state->active_token = 0;
 	state->start = view_code;
 	state->mode = PHVOLT_MODE_RAW;
-	state->raw_buffer = emalloc(sizeof(char) * PHVOLT_RAW_BUFFER_SIZE);
-	state->raw_buffer_size = PHVOLT_RAW_BUFFER_SIZE;
+	state->raw_fragment = NULL;
+	state->raw_buffer = NULL;
+	state->raw_buffer_size = 0;
 	state->raw_buffer_cursor = 0;
 	state->active_line = 1;
 	state->statement_position = 0;
@@ -364,8 +401,6 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 					if(!phvolt_is_blank_string(token)){
 						phvolt_create_error_msg(parser_status, "Child templates only may contain blocks");
 						parser_status->status = PHVOLT_PARSING_FAILED;
-					} else {
-						efree(token->value);
 					}
 					break;
 				}
@@ -438,7 +473,9 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 
 	state->active_token = 0;
 	state->start = NULL;
-	efree(state->raw_buffer);
+	if (state->raw_buffer) {
+		efree(state->raw_buffer);
+	}
 
 	if (status != FAILURE) {
 		switch (scanner_status) {
@@ -487,9 +524,7 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 		}
 	}
 
-	efree(parser_status);
-	efree(state);
-	efree(token);
+	phvolt_arena_free(parser_status);
 
 	return status;
 }
\ No newline at end of file
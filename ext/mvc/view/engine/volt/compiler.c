@@ -40,6 +40,8 @@
 #include "kernel/concat.h"
 #include "kernel/string.h"
 #include "kernel/file.h"
+#include "ext/standard/php_smart_str.h"
+#include "main/php_streams.h"
 #include "mvc/view/engine/volt/scanner.h"
 #include "mvc/view/engine/volt/volt.h"
 
@@ -64,6 +66,10 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View_Engine_Volt_Compiler){
 	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_extendsNode"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_currentBlock"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_blocks"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_mvc_view_engine_volt_compiler_ce, SL("_options"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_view_engine_volt_compiler_ce, SL("_optimize"), 1, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_mvc_view_engine_volt_compiler_ce, SL("_loopLevel"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_mvc_view_engine_volt_compiler_ce, SL("_hoistEscaper"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
@@ -104,6 +110,85 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getDI){
 	RETURN_MEMBER(this_ptr, "_dependencyInjector");
 }
 
+/**
+ * Sets the compiler options
+ *
+ *<code>
+ * $compiler->setOptions(array(
+ *	"optimize" => false
+ * ));
+ *</code>
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, setOptions){
+
+	zval *options, *optimize;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &options) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(options) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "Options must be an array");
+		return;
+	}
+	
+	/** 
+	 * The optimizer folds literals and inlines filters, it is enabled by default
+	 */
+	eval_int = phalcon_array_isset_string(options, SS("optimize"));
+	if (eval_int) {
+		PHALCON_INIT_VAR(optimize);
+		phalcon_array_fetch_string(&optimize, options, SL("optimize"), PH_NOISY_CC);
+		phalcon_update_property_bool(this_ptr, SL("_optimize"), zend_is_true(optimize) TSRMLS_CC);
+	}
+	
+	phalcon_update_property_zval(this_ptr, SL("_options"), options TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Returns the compiler options
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getOptions){
+
+
+	RETURN_MEMBER(this_ptr, "_options");
+}
+
+/**
+ * Checks if a compiled expression is a plain variable that can be evaluated many times
+ * without side effects
+ */
+static int phalcon_mvc_view_engine_volt_compiler_is_variable(zval *code){
+
+	int i;
+
+	if (Z_TYPE_P(code) != IS_STRING || Z_STRLEN_P(code) < 2) {
+		return 0;
+	}
+
+	if (Z_STRVAL_P(code)[0] != '$') {
+		return 0;
+	}
+
+	for (i = 1; i < Z_STRLEN_P(code); i++) {
+		if (!isalnum((unsigned char) Z_STRVAL_P(code)[i]) && Z_STRVAL_P(code)[i] != '_') {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
 /**
  * Resolves function intermediate code into PHP function calls
  *
@@ -247,6 +332,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _functionCall){
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _filter){
 
 	zval *filter, *left, *exists = NULL, *type, *code = NULL, *name, *exception_message = NULL;
+	zval *optimize, *loop_level;
 
 	PHALCON_MM_GROW();
 
@@ -270,31 +356,38 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _filter){
 		PHALCON_INIT_VAR(name);
 		phalcon_array_fetch_string(&name, filter, SL("name"), PH_NOISY_CC);
 	
-		/** 
-		 * 'length' uses the length method implemented in the Volt adapter
-		 */
-		if (PHALCON_COMPARE_STRING(name, "length")) {
-			PHALCON_CONCAT_SVS(code, "$this->length(", left, ")");
+		PHALCON_INIT_VAR(optimize);
+		phalcon_read_property(&optimize, this_ptr, SL("_optimize"), PH_NOISY_CC);
 	
-			ZVAL_BOOL(exists, 1);
-		}
+		PHALCON_INIT_VAR(loop_level);
+		phalcon_read_property(&loop_level, this_ptr, SL("_loopLevel"), PH_NOISY_CC);
 	
 		/** 
-		 * 'e' filter uses the escaper component
+		 * 'length' uses the length method implemented in the Volt adapter, it's inlined
+		 * when it's applied to a variable
 		 */
-		if (PHALCON_COMPARE_STRING(name, "e")) {
-			PHALCON_INIT_NVAR(code);
-			PHALCON_CONCAT_SVS(code, "$this->escaper->escapeHtml(", left, ")");
+		if (PHALCON_COMPARE_STRING(name, "length")) {
+			if (zend_is_true(optimize) && phalcon_mvc_view_engine_volt_compiler_is_variable(left)) {
+				PHALCON_CONCAT_SVSVSVS(code, "(is_string(", left, ") ? strlen(", left, ") : count(", left, "))");
+			} else {
+				PHALCON_CONCAT_SVS(code, "$this->length(", left, ")");
+			}
 	
 			ZVAL_BOOL(exists, 1);
 		}
 	
 		/** 
-		 * 'escape' filter uses the escaper component
+		 * 'e' and 'escape' filters use the escaper component, inside loops the service is
+		 * read once before the outermost loop
 		 */
-		if (PHALCON_COMPARE_STRING(name, "escape")) {
+		if (PHALCON_COMPARE_STRING(name, "e") || PHALCON_COMPARE_STRING(name, "escape")) {
 			PHALCON_INIT_NVAR(code);
-			PHALCON_CONCAT_SVS(code, "$this->escaper->escapeHtml(", left, ")");
+			if (phalcon_get_intval(loop_level) > 0) {
+				PHALCON_CONCAT_SVS(code, "$__escaper->escapeHtml(", left, ")");
+				phalcon_update_property_bool(this_ptr, SL("_hoistEscaper"), 1 TSRMLS_CC);
+			} else {
+				PHALCON_CONCAT_SVS(code, "$this->escaper->escapeHtml(", left, ")");
+			}
 	
 			ZVAL_BOOL(exists, 1);
 		}
@@ -775,33 +868,79 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _expression){
 }
 
 /**
- * Traverses a statement list compiling each of its nodes
- *
- * @param array $statement
- * @return string
+ * Appends the code returned by _expression/_statementList to the compilation buffer
  */
-PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
+static void phvolt_append_code(smart_str *compilation, zval *code){
+
+	zval copy;
+	int use_copy = 0;
+
+	if (Z_TYPE_P(code) == IS_STRING) {
+		smart_str_appendl(compilation, Z_STRVAL_P(code), Z_STRLEN_P(code));
+		return;
+	}
+
+	zend_make_printable_zval(code, &copy, &use_copy);
+	if (use_copy) {
+		smart_str_appendl(compilation, Z_STRVAL(copy), Z_STRLEN(copy));
+		zval_dtor(&copy);
+	} else {
+		smart_str_appendl(compilation, Z_STRVAL_P(code), Z_STRLEN_P(code));
+	}
+}
+
+static int phvolt_compile_statements(zval *this_ptr, smart_str *compilation, zval *statements, zval *extends_mode TSRMLS_DC);
 
-	zval *statements, *extends_mode, *exec_statements = NULL;
-	zval *compilation, *statement = NULL, *expr = NULL, *expr_code = NULL;
+/**
+ * Compiles a nested statement list into the same buffer, classes overriding _statementList
+ * still receive every nested list
+ */
+static int phvolt_compile_block(zval *this_ptr, smart_str *compilation, zval *statements, zval *extends_mode TSRMLS_DC){
+
+	zval *code;
+	zend_function *method;
+
+	if (zend_hash_find(&Z_OBJCE_P(this_ptr)->function_table, SS("_statementlist"), (void **) &method) == SUCCESS) {
+		if (method->common.scope != phalcon_mvc_view_engine_volt_compiler_ce) {
+
+			PHALCON_MM_GROW();
+
+			PHALCON_INIT_VAR(code);
+			if (phalcon_call_method_two_params(code, this_ptr, SL("_statementlist"), statements, extends_mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+				return FAILURE;
+			}
+			phvolt_append_code(compilation, code);
+
+			PHALCON_MM_RESTORE();
+			return SUCCESS;
+		}
+	}
+
+	return phvolt_compile_statements(this_ptr, compilation, statements, extends_mode TSRMLS_CC);
+}
+
+/**
+ * Walks a statement list writing the generated code into a single buffer. Like the methods
+ * in the class, the memory frame of the function is released when it fails
+ */
+static int phvolt_compile_statements(zval *this_ptr, smart_str *compilation, zval *statements, zval *extends_mode TSRMLS_DC){
+
+	zval *exec_statements = NULL, *statement = NULL, *expr = NULL, *expr_code = NULL;
 	zval *type = NULL, *code = NULL, *block_statements = NULL, *qualified = NULL;
 	zval *qualified_code = NULL, *block_name = NULL, *blocks = NULL, *exception_message = NULL;
+	zval *optimize, *loop_level = NULL, *hoist_escaper = NULL;
+	smart_str block_code = {0};
 	HashTable *ah0;
 	HashPosition hp0;
 	zval **hd;
 	int eval_int;
 
-	PHALCON_MM_GROW();
-
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &statements, &extends_mode) == FAILURE) {
-		PHALCON_MM_RESTORE();
-		RETURN_NULL();
-	}
-
 	if (!phalcon_fast_count_ev(statements TSRMLS_CC)) {
-		PHALCON_MM_RESTORE();
-		RETURN_STRING("", 1);
+		return SUCCESS;
 	}
+
+	PHALCON_MM_GROW();
+
 	eval_int = phalcon_array_isset_long(statements, 0);
 	if (!eval_int) {
 		PHALCON_INIT_VAR(exec_statements);
@@ -811,12 +950,8 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 		PHALCON_CPY_WRT(exec_statements, statements);
 	}
 	
-	PHALCON_INIT_VAR(compilation);
-	ZVAL_STRING(compilation, "", 1);
-	
-	if (!phalcon_valid_foreach(exec_statements TSRMLS_CC)) {
-		return;
-	}
+	PHALCON_INIT_VAR(optimize);
+	phalcon_read_property(&optimize, this_ptr, SL("_optimize"), PH_NOISY_CC);
 	
 	ah0 = Z_ARRVAL_P(exec_statements);
 	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
@@ -835,12 +970,16 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 			phalcon_array_fetch_string(&expr, statement, SL("expr"), PH_NOISY_CC);
 	
 			PHALCON_INIT_NVAR(expr_code);
-			PHALCON_CALL_METHOD_PARAMS_2(expr_code, this_ptr, "_expression", expr, extends_mode, PH_NO_CHECK);
+			if (phalcon_call_method_two_params(expr_code, this_ptr, SL("_expression"), expr, extends_mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+				smart_str_free(&block_code);
+				return FAILURE;
+			}
 		}
 		eval_int = phalcon_array_isset_string(statement, SS("type"));
 		if (!eval_int) {
+			smart_str_free(&block_code);
 			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "Invalid statement");
-			return;
+			return FAILURE;
 		}
 	
 		PHALCON_INIT_NVAR(type);
@@ -849,31 +988,37 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 		if (phalcon_compare_strict_long(type, 357 TSRMLS_CC)) {
 			PHALCON_INIT_NVAR(code);
 			phalcon_array_fetch_string(&code, statement, SL("value"), PH_NOISY_CC);
-			phalcon_concat_self(compilation, code TSRMLS_CC);
+			phvolt_append_code(compilation, code);
 			goto ph_end_1;
 		}
 	
 		if (phalcon_compare_strict_long(type, 300 TSRMLS_CC)) {
-			PHALCON_SCONCAT_SVS(compilation, "<?php if (", expr_code, ") { ?>");
+			smart_str_appendl(compilation, SL("<?php if ("));
+			phvolt_append_code(compilation, expr_code);
+			smart_str_appendl(compilation, SL(") { ?>"));
+	
 			PHALCON_INIT_NVAR(block_statements);
 			phalcon_array_fetch_string(&block_statements, statement, SL("true_statements"), PH_NOISY_CC);
+			if (phvolt_compile_block(this_ptr, compilation, block_statements, extends_mode TSRMLS_CC) == FAILURE) {
+				smart_str_free(&block_code);
+				PHALCON_MM_RESTORE();
+				return FAILURE;
+			}
 	
-			PHALCON_INIT_NVAR(code);
-			PHALCON_CALL_METHOD_PARAMS_2(code, this_ptr, "_statementlist", block_statements, extends_mode, PH_NO_CHECK);
-			phalcon_concat_self(compilation, code TSRMLS_CC);
 			eval_int = phalcon_array_isset_string(statement, SS("false_statements"));
 			if (eval_int) {
-				phalcon_concat_self_str(compilation, SL("<?php } else { ?>") TSRMLS_CC);
+				smart_str_appendl(compilation, SL("<?php } else { ?>"));
 	
 				PHALCON_INIT_NVAR(block_statements);
 				phalcon_array_fetch_string(&block_statements, statement, SL("false_statements"), PH_NOISY_CC);
-	
-				PHALCON_INIT_NVAR(code);
-				PHALCON_CALL_METHOD_PARAMS_2(code, this_ptr, "_statementlist", block_statements, extends_mode, PH_NO_CHECK);
-				phalcon_concat_self(compilation, code TSRMLS_CC);
+				if (phvolt_compile_block(this_ptr, compilation, block_statements, extends_mode TSRMLS_CC) == FAILURE) {
+					smart_str_free(&block_code);
+					PHALCON_MM_RESTORE();
+					return FAILURE;
+				}
 			}
 	
-			phalcon_concat_self_str(compilation, SL("<?php } ?>") TSRMLS_CC);
+			smart_str_appendl(compilation, SL("<?php } ?>"));
 			goto ph_end_1;
 		}
 	
@@ -882,16 +1027,52 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 			phalcon_array_fetch_string(&qualified, statement, SL("qualified"), PH_NOISY_CC);
 	
 			PHALCON_INIT_NVAR(qualified_code);
-			PHALCON_CALL_METHOD_PARAMS_2(qualified_code, this_ptr, "_expression", qualified, extends_mode, PH_NO_CHECK);
-			PHALCON_SCONCAT_SVSVS(compilation, "<?php foreach (", expr_code, " as ", qualified_code, ") { ?>");
+			if (phalcon_call_method_two_params(qualified_code, this_ptr, SL("_expression"), qualified, extends_mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+				smart_str_free(&block_code);
+				return FAILURE;
+			}
 	
 			PHALCON_INIT_NVAR(block_statements);
 			phalcon_array_fetch_string(&block_statements, statement, SL("block_statements"), PH_NOISY_CC);
 	
-			PHALCON_INIT_NVAR(code);
-			PHALCON_CALL_METHOD_PARAMS_2(code, this_ptr, "_statementlist", block_statements, extends_mode, PH_NO_CHECK);
-			phalcon_concat_self(compilation, code TSRMLS_CC);
-			phalcon_concat_self_str(compilation, SL("<?php } ?>") TSRMLS_CC);
+			PHALCON_INIT_NVAR(loop_level);
+			phalcon_read_property(&loop_level, this_ptr, SL("_loopLevel"), PH_NOISY_CC);
+			if (zend_is_true(optimize)) {
+				phalcon_update_property_long(this_ptr, SL("_loopLevel"), phalcon_get_intval(loop_level) + 1 TSRMLS_CC);
+			}
+	
+			/** 
+			 * The body is compiled apart because the escaper used inside it is hoisted in
+			 * the head of the outermost loop
+			 */
+			if (phvolt_compile_block(this_ptr, &block_code, block_statements, extends_mode TSRMLS_CC) == FAILURE) {
+				smart_str_free(&block_code);
+				PHALCON_MM_RESTORE();
+				return FAILURE;
+			}
+			phalcon_update_property_zval(this_ptr, SL("_loopLevel"), loop_level TSRMLS_CC);
+	
+			/** 
+			 * Services used inside the loop are resolved before entering the outermost loop
+			 */
+			PHALCON_INIT_NVAR(hoist_escaper);
+			phalcon_read_property(&hoist_escaper, this_ptr, SL("_hoistEscaper"), PH_NOISY_CC);
+			if (zend_is_true(hoist_escaper) && !phalcon_get_intval(loop_level)) {
+				phalcon_update_property_bool(this_ptr, SL("_hoistEscaper"), 0 TSRMLS_CC);
+				smart_str_appendl(compilation, SL("<?php $__escaper = $this->escaper; foreach ("));
+			} else {
+				smart_str_appendl(compilation, SL("<?php foreach ("));
+			}
+			phvolt_append_code(compilation, expr_code);
+			smart_str_appendl(compilation, SL(" as "));
+			phvolt_append_code(compilation, qualified_code);
+			smart_str_appendl(compilation, SL(") { ?>"));
+	
+			if (block_code.len) {
+				smart_str_appendl(compilation, block_code.c, block_code.len);
+				block_code.len = 0;
+			}
+			smart_str_appendl(compilation, SL("<?php } ?>"));
 			goto ph_end_1;
 		}
 	
@@ -900,13 +1081,22 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 			phalcon_array_fetch_string(&qualified, statement, SL("qualified"), PH_NOISY_CC);
 	
 			PHALCON_INIT_NVAR(qualified_code);
-			PHALCON_CALL_METHOD_PARAMS_2(qualified_code, this_ptr, "_expression", qualified, extends_mode, PH_NO_CHECK);
-			PHALCON_SCONCAT_SVSVS(compilation, "<?php ", qualified_code, " = ", expr_code, "; ?>");
+			if (phalcon_call_method_two_params(qualified_code, this_ptr, SL("_expression"), qualified, extends_mode, PH_NO_CHECK, 1 TSRMLS_CC) == FAILURE) {
+				smart_str_free(&block_code);
+				return FAILURE;
+			}
+			smart_str_appendl(compilation, SL("<?php "));
+			phvolt_append_code(compilation, qualified_code);
+			smart_str_appendl(compilation, SL(" = "));
+			phvolt_append_code(compilation, expr_code);
+			smart_str_appendl(compilation, SL("; ?>"));
 			goto ph_end_1;
 		}
 	
 		if (phalcon_compare_strict_long(type, 359 TSRMLS_CC)) {
-			PHALCON_SCONCAT_SVS(compilation, "<?php echo ", expr_code, "; ?>");
+			smart_str_appendl(compilation, SL("<?php echo "));
+			phvolt_append_code(compilation, expr_code);
+			smart_str_appendl(compilation, SL("; ?>"));
 			goto ph_end_1;
 		}
 	
@@ -923,33 +1113,50 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 	
 			PHALCON_INIT_NVAR(blocks);
 			phalcon_read_property(&blocks, this_ptr, SL("_blocks"), PH_NOISY_CC);
-			if (Z_TYPE_P(blocks) != IS_ARRAY) { 
+			if (Z_TYPE_P(blocks) != IS_ARRAY) {
 				PHALCON_INIT_NVAR(blocks);
 				array_init(blocks);
 			}
 	
 			if (PHALCON_IS_FALSE(extends_mode)) {
-				if (Z_TYPE_P(block_statements) == IS_ARRAY) { 
+				if (Z_TYPE_P(block_statements) == IS_ARRAY) {
+	
+					/** 
+					 * Blocks can be placed anywhere in the extended template so they don't
+					 * share hoisted services with the enclosing loops
+					 */
+					PHALCON_INIT_NVAR(loop_level);
+					phalcon_read_property(&loop_level, this_ptr, SL("_loopLevel"), PH_NOISY_CC);
+					phalcon_update_property_long(this_ptr, SL("_loopLevel"), 0 TSRMLS_CC);
+	
+					if (phvolt_compile_block(this_ptr, &block_code, block_statements, extends_mode TSRMLS_CC) == FAILURE) {
+						smart_str_free(&block_code);
+						PHALCON_MM_RESTORE();
+						return FAILURE;
+					}
+					phalcon_update_property_zval(this_ptr, SL("_loopLevel"), loop_level TSRMLS_CC);
+	
 					PHALCON_INIT_NVAR(code);
-					PHALCON_CALL_METHOD_PARAMS_2(code, this_ptr, "_statementlist", block_statements, extends_mode, PH_NO_CHECK);
+					ZVAL_STRINGL(code, block_code.len ? block_code.c : "", block_code.len, 1);
+					block_code.len = 0;
 					phalcon_array_update_zval(&blocks, block_name, &code, PH_COPY | PH_SEPARATE TSRMLS_CC);
 				} else {
 					phalcon_array_update_zval(&blocks, block_name, &block_statements, PH_COPY | PH_SEPARATE TSRMLS_CC);
 				}
 				phalcon_update_property_zval(this_ptr, SL("_blocks"), blocks TSRMLS_CC);
 			} else {
-				PHALCON_INIT_NVAR(blocks);
-				phalcon_read_property(&blocks, this_ptr, SL("_blocks"), PH_NOISY_CC);
 				eval_int = phalcon_array_isset(blocks, block_name);
 				if (eval_int) {
 					PHALCON_INIT_NVAR(code);
 					phalcon_array_fetch(&code, blocks, block_name, PH_NOISY_CC);
-					phalcon_concat_self(compilation, code TSRMLS_CC);
+					phvolt_append_code(compilation, code);
 				} else {
-					if (Z_TYPE_P(block_statements) == IS_ARRAY) { 
-						PHALCON_INIT_NVAR(code);
-						PHALCON_CALL_METHOD_PARAMS_2(code, this_ptr, "_statementlist", block_statements, extends_mode, PH_NO_CHECK);
-						phalcon_concat_self(compilation, code TSRMLS_CC);
+					if (Z_TYPE_P(block_statements) == IS_ARRAY) {
+						if (phvolt_compile_block(this_ptr, compilation, block_statements, extends_mode TSRMLS_CC) == FAILURE) {
+							smart_str_free(&block_code);
+							PHALCON_MM_RESTORE();
+							return FAILURE;
+						}
 					}
 				}
 			}
@@ -963,10 +1170,12 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 			goto ph_end_1;
 		}
 	
+		smart_str_free(&block_code);
+	
 		PHALCON_INIT_NVAR(exception_message);
 		PHALCON_CONCAT_SV(exception_message, "Unknown statement ", type);
 		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
-		return;
+		return FAILURE;
 	
 		ph_end_1:
 		if(0){}
@@ -976,8 +1185,42 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
 	
 	ph_cycle_end_0:
 	
+	smart_str_free(&block_code);
+	
+	PHALCON_MM_RESTORE();
+	return SUCCESS;
+}
+
+/**
+ * Traverses a statement list compiling each of its nodes
+ *
+ * @param array $statement
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList){
+
+	zval *statements, *extends_mode;
+	smart_str compilation = {0};
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &statements, &extends_mode) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	/** 
+	 * The whole list, including nested blocks, is written into one buffer
+	 */
+	if (phvolt_compile_statements(this_ptr, &compilation, statements, extends_mode TSRMLS_CC) == FAILURE) {
+		smart_str_free(&compilation);
+		return;
+	}
+	
+	if (!compilation.len) {
+		smart_str_free(&compilation);
+		RETURN_EMPTY_STRING();
+	}
 	
-	RETURN_CTOR(compilation);
+	smart_str_0(&compilation);
+	RETURN_STRINGL(compilation.c, compilation.len, 0);
 }
 
 /**
@@ -993,7 +1236,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileSource){
 	zval *compilation = NULL, *extends_node, *views_dir = NULL;
 	zval *dependency_injector, *service, *view, *path;
 	zval *view_path, *exception_message, *extended;
-	zval *extends_view_code;
+	zval *extends_view_code, *optimize;
 
 	PHALCON_MM_GROW();
 
@@ -1014,6 +1257,15 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileSource){
 	if (Z_TYPE_P(intermediate) == IS_ARRAY) { 
 		phalcon_update_property_null(this_ptr, SL("_extendsNode") TSRMLS_CC);
 	
+		/** 
+		 * Fold the parts of the tree that can be resolved at compile time
+		 */
+		PHALCON_INIT_VAR(optimize);
+		phalcon_read_property(&optimize, this_ptr, SL("_optimize"), PH_NOISY_CC);
+		if (zend_is_true(optimize)) {
+			phvolt_optimize_view(intermediate TSRMLS_CC);
+		}
+	
 		PHALCON_INIT_VAR(compilation);
 		PHALCON_CALL_METHOD_PARAMS_2(compilation, this_ptr, "_statementlist", intermediate, extends_mode, PH_NO_CHECK);
 		if (PHALCON_IS_FALSE(extends_mode)) {
@@ -1100,7 +1352,8 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileString){
 }
 
 /**
- * Compiles a template into a file
+ * Compiles a template into a file. The compiled file is written to a temporary file which
+ * is renamed afterwards, so concurrent requests never include a partially written file
  *
  * @param string $path
  * @param string $compiledPath
@@ -1108,6 +1361,7 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileString){
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compile){
 
 	zval *path, *compiled_path, *same, *view_code, *compilation;
+	zval *exception_message;
 
 	PHALCON_MM_GROW();
 
@@ -1132,11 +1386,331 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compile){
 	
 	PHALCON_INIT_VAR(compilation);
 	PHALCON_CALL_METHOD_PARAMS_1(compilation, this_ptr, "_compilesource", view_code, PH_NO_CHECK);
-	PHALCON_CALL_FUNC_PARAMS_2_NORETURN("file_put_contents", compiled_path, compilation);
+	if (Z_TYPE_P(compilation) != IS_STRING) {
+		convert_to_string(compilation);
+	}
+	
+	if (phalcon_file_put_contents_atomic(compiled_path, compilation TSRMLS_CC) == FAILURE) {
+		PHALCON_INIT_VAR(exception_message);
+		PHALCON_CONCAT_SVS(exception_message, "Compiled template file ", compiled_path, " could not be written");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_view_exception_ce, exception_message);
+		return;
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Builds the path of the compiled version of a template. When the templates are compiled to
+ * another directory the separators of the template path are replaced by the compiled separator
+ */
+void phalcon_mvc_view_engine_volt_compiled_path(zval *result, zval *template_path, zval *compiled_path, zval *compiled_separator, zval *compiled_extension TSRMLS_DC){
+
+	zval *win_separator, *unix_separator, *template_win_path;
+	zval *template_sep_path = NULL;
+
+	PHALCON_MM_GROW();
+
+	if (Z_TYPE_P(compiled_path) != IS_NULL) {
+		PHALCON_INIT_VAR(win_separator);
+		ZVAL_STRING(win_separator, "\\", 1);
+	
+		PHALCON_INIT_VAR(unix_separator);
+		ZVAL_STRING(unix_separator, "/", 1);
+	
+		PHALCON_INIT_VAR(template_win_path);
+		phalcon_fast_str_replace(template_win_path, win_separator, compiled_separator, template_path TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(template_sep_path);
+		phalcon_fast_str_replace(template_sep_path, unix_separator, compiled_separator, template_win_path TSRMLS_CC);
+	} else {
+		PHALCON_CPY_WRT(template_sep_path, template_path);
+	}
+	
+	PHALCON_CONCAT_VVV(result, compiled_path, template_sep_path, compiled_extension);
 	
 	PHALCON_MM_RESTORE();
 }
 
+/**
+ * Returns the path where a template is compiled according to the compiler options. The
+ * same options used by Phalcon\Mvc\View\Engine\Volt produce the same paths
+ *
+ * @param string $templatePath
+ * @return string
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getCompiledPath){
+
+	zval *template_path, *compiled_path = NULL, *compiled_separator = NULL;
+	zval *compiled_extension = NULL, *options, *compiled_template_path;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &template_path) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	PHALCON_INIT_VAR(compiled_path);
+	
+	PHALCON_INIT_VAR(compiled_separator);
+	ZVAL_STRING(compiled_separator, "%%", 1);
+	
+	PHALCON_INIT_VAR(compiled_extension);
+	ZVAL_STRING(compiled_extension, ".php", 1);
+	
+	PHALCON_INIT_VAR(options);
+	phalcon_read_property(&options, this_ptr, SL("_options"), PH_NOISY_CC);
+	if (Z_TYPE_P(options) == IS_ARRAY) { 
+		eval_int = phalcon_array_isset_string(options, SS("compiledPath"));
+		if (eval_int) {
+			PHALCON_INIT_NVAR(compiled_path);
+			phalcon_array_fetch_string(&compiled_path, options, SL("compiledPath"), PH_NOISY_CC);
+		}
+		eval_int = phalcon_array_isset_string(options, SS("compiledSeparator"));
+		if (eval_int) {
+			PHALCON_INIT_NVAR(compiled_separator);
+			phalcon_array_fetch_string(&compiled_separator, options, SL("compiledSeparator"), PH_NOISY_CC);
+		}
+		eval_int = phalcon_array_isset_string(options, SS("compiledExtension"));
+		if (eval_int) {
+			PHALCON_INIT_NVAR(compiled_extension);
+			phalcon_array_fetch_string(&compiled_extension, options, SL("compiledExtension"), PH_NOISY_CC);
+		}
+	}
+	
+	PHALCON_INIT_VAR(compiled_template_path);
+	phalcon_mvc_view_engine_volt_compiled_path(compiled_template_path, template_path, compiled_path, compiled_separator, compiled_extension TSRMLS_CC);
+	
+	RETURN_CTOR(compiled_template_path);
+}
+
+/**
+ * Compares two template paths
+ */
+static int phalcon_mvc_view_engine_volt_compiler_compare(const void *a, const void *b TSRMLS_DC){
+
+	Bucket *first = *((Bucket **) a);
+	Bucket *second = *((Bucket **) b);
+
+	return strcmp(Z_STRVAL_PP((zval **) first->pData), Z_STRVAL_PP((zval **) second->pData));
+}
+
+/**
+ * Walks a directory recursively appending the files with the given extension
+ */
+static void phalcon_mvc_view_engine_volt_compiler_find(zval *templates, char *directory, zval *extension TSRMLS_DC){
+
+	php_stream *stream;
+	php_stream_dirent entry;
+	php_stream_statbuf statbuffer;
+	char *path;
+	int path_length, name_length;
+
+	stream = php_stream_opendir(directory, REPORT_ERRORS, NULL);
+	if (!stream) {
+		return;
+	}
+
+	while (php_stream_readdir(stream, &entry)) {
+
+		/** 
+		 * Skip the current/parent directories and hidden files
+		 */
+		if (entry.d_name[0] == '.') {
+			continue;
+		}
+
+		path_length = spprintf(&path, 0, "%s%s", directory, entry.d_name);
+
+		if (!php_stream_stat_path_ex(path, 0, &statbuffer, NULL) && S_ISDIR(statbuffer.sb.st_mode)) {
+			path = erealloc(path, path_length + 2);
+			path[path_length] = '/';
+			path[path_length + 1] = '\0';
+			phalcon_mvc_view_engine_volt_compiler_find(templates, path, extension TSRMLS_CC);
+			efree(path);
+			continue;
+		}
+
+		name_length = strlen(entry.d_name);
+		if (name_length > Z_STRLEN_P(extension)) {
+			if (!memcmp(entry.d_name + name_length - Z_STRLEN_P(extension), Z_STRVAL_P(extension), Z_STRLEN_P(extension))) {
+				add_next_index_stringl(templates, path, path_length, 0);
+				continue;
+			}
+		}
+
+		efree(path);
+	}
+
+	php_stream_closedir(stream);
+}
+
+/**
+ * Returns the templates found in a directory and its subdirectories, the paths are
+ * built as Phalcon\Mvc\View builds them from the views directory
+ *
+ *<code>
+ * $templates = $compiler->findTemplates('app/views/');
+ *</code>
+ *
+ * @param string $directory
+ * @param string $extension
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, findTemplates){
+
+	zval *directory, *extension = NULL, *path, *templates;
+	char last;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &directory, &extension) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!extension) {
+		PHALCON_INIT_NVAR(extension);
+		ZVAL_STRING(extension, ".volt", 1);
+	}
+	
+	if (Z_TYPE_P(directory) != IS_STRING || !Z_STRLEN_P(directory)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "The templates directory must be a string");
+		return;
+	}
+	
+	if (Z_TYPE_P(extension) != IS_STRING) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "The templates extension must be a string");
+		return;
+	}
+	
+	/** 
+	 * Add a trailing slash if the directory doesn't have one
+	 */
+	last = Z_STRVAL_P(directory)[Z_STRLEN_P(directory) - 1];
+	
+	PHALCON_INIT_VAR(path);
+	if (last == '/' || last == '\\') {
+		PHALCON_CPY_WRT(path, directory);
+	} else {
+		PHALCON_CONCAT_VS(path, directory, "/");
+	}
+	
+	PHALCON_INIT_VAR(templates);
+	array_init(templates);
+	
+	phalcon_mvc_view_engine_volt_compiler_find(templates, Z_STRVAL_P(path), extension TSRMLS_CC);
+	
+	/** 
+	 * Directory order depends on the filesystem
+	 */
+	zend_hash_sort(Z_ARRVAL_P(templates), zend_qsort, phalcon_mvc_view_engine_volt_compiler_compare, 1 TSRMLS_CC);
+	
+	RETURN_CTOR(templates);
+}
+
+/**
+ * Compiles a list of templates returning a manifest with the compiled path of every template
+ *
+ *<code>
+ * $manifest = $compiler->compileFiles(array('app/views/index/index.volt'));
+ *</code>
+ *
+ * @param array $templates
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileFiles){
+
+	zval *templates, *manifest, *template_path = NULL, *compiled_path = NULL;
+	HashTable *ah0;
+	HashPosition hp0;
+	zval **hd;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &templates) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(templates) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "Templates must be an array");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(manifest);
+	array_init(manifest);
+	
+	if (!phalcon_valid_foreach(templates TSRMLS_CC)) {
+		return;
+	}
+	
+	ah0 = Z_ARRVAL_P(templates);
+	zend_hash_internal_pointer_reset_ex(ah0, &hp0);
+	
+	ph_cycle_start_0:
+	
+		if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
+			goto ph_cycle_end_0;
+		}
+	
+		PHALCON_GET_FOREACH_VALUE(template_path);
+	
+		PHALCON_INIT_NVAR(compiled_path);
+		PHALCON_CALL_METHOD_PARAMS_1(compiled_path, this_ptr, "getcompiledpath", template_path, PH_NO_CHECK);
+		PHALCON_CALL_METHOD_PARAMS_2_NORETURN(this_ptr, "compile", template_path, compiled_path, PH_NO_CHECK);
+		phalcon_array_update_zval(&manifest, template_path, &compiled_path, PH_COPY | PH_SEPARATE TSRMLS_CC);
+	
+		zend_hash_move_forward_ex(ah0, &hp0);
+		goto ph_cycle_start_0;
+	
+	ph_cycle_end_0:
+	
+	RETURN_CTOR(manifest);
+}
+
+/**
+ * Compiles every template in a directory and its subdirectories returning a manifest
+ * with the compiled path of every template
+ *
+ *<code>
+ * $compiler->setOptions(array(
+ *	"compiledPath" => "app/compiled-templates/"
+ * ));
+ * $manifest = $compiler->compileDirectory('app/views/');
+ *</code>
+ *
+ * @param string $directory
+ * @param string $extension
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileDirectory){
+
+	zval *directory, *extension = NULL, *templates, *manifest;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &directory, &extension) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!extension) {
+		PHALCON_INIT_NVAR(extension);
+		ZVAL_STRING(extension, ".volt", 1);
+	}
+	
+	PHALCON_INIT_VAR(templates);
+	PHALCON_CALL_METHOD_PARAMS_2(templates, this_ptr, "findtemplates", directory, extension, PH_NO_CHECK);
+	
+	PHALCON_INIT_VAR(manifest);
+	PHALCON_CALL_METHOD_PARAMS_1(manifest, this_ptr, "compilefiles", templates, PH_NO_CHECK);
+	
+	RETURN_CCTOR(manifest);
+}
+
 /**
  * Parses a Volt template returning its intermediate representation
  *
@@ -19,10 +19,14 @@
 
 extern zend_class_entry *phalcon_mvc_view_engine_volt_compiler_ce;
 
+void phalcon_mvc_view_engine_volt_compiled_path(zval *result, zval *template_path, zval *compiled_path, zval *compiled_separator, zval *compiled_extension TSRMLS_DC);
+
 PHALCON_INIT_CLASS(Phalcon_Mvc_View_Engine_Volt_Compiler);
 
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, setDI);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getDI);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, setOptions);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getOptions);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _functionCall);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _filter);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _expression);
@@ -30,12 +34,20 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _statementList);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileSource);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileString);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compile);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, getCompiledPath);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, findTemplates);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileFiles);
+PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, compileDirectory);
 PHP_METHOD(Phalcon_Mvc_View_Engine_Volt_Compiler, parse);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_setdi, 0, 0, 1)
 	ZEND_ARG_INFO(0, dependencyInjector)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_setoptions, 0, 0, 1)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler__expression, 0, 0, 2)
 	ZEND_ARG_INFO(0, expr)
 	ZEND_ARG_INFO(0, extendsMode)
@@ -52,6 +64,24 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_compile, 0,
 	ZEND_ARG_INFO(0, compiledPath)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_getcompiledpath, 0, 0, 1)
+	ZEND_ARG_INFO(0, templatePath)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_findtemplates, 0, 0, 1)
+	ZEND_ARG_INFO(0, directory)
+	ZEND_ARG_INFO(0, extension)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_compilefiles, 0, 0, 1)
+	ZEND_ARG_INFO(0, templates)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_compiledirectory, 0, 0, 1)
+	ZEND_ARG_INFO(0, directory)
+	ZEND_ARG_INFO(0, extension)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_view_engine_volt_compiler_parse, 0, 0, 1)
 	ZEND_ARG_INFO(0, viewCode)
 ZEND_END_ARG_INFO()
@@ -59,6 +89,8 @@ ZEND_END_ARG_INFO()
 PHALCON_INIT_FUNCS(phalcon_mvc_view_engine_volt_compiler_method_entry){
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, setDI, arginfo_phalcon_mvc_view_engine_volt_compiler_setdi, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, getDI, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, setOptions, arginfo_phalcon_mvc_view_engine_volt_compiler_setoptions, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, getOptions, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, _functionCall, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, _filter, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, _expression, arginfo_phalcon_mvc_view_engine_volt_compiler__expression, ZEND_ACC_PUBLIC) 
@@ -66,6 +98,10 @@ PHALCON_INIT_FUNCS(phalcon_mvc_view_engine_volt_compiler_method_entry){
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, _compileSource, NULL, ZEND_ACC_PROTECTED) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileString, arginfo_phalcon_mvc_view_engine_volt_compiler_compilestring, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compile, arginfo_phalcon_mvc_view_engine_volt_compiler_compile, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, getCompiledPath, arginfo_phalcon_mvc_view_engine_volt_compiler_getcompiledpath, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, findTemplates, arginfo_phalcon_mvc_view_engine_volt_compiler_findtemplates, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileFiles, arginfo_phalcon_mvc_view_engine_volt_compiler_compilefiles, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, compileDirectory, arginfo_phalcon_mvc_view_engine_volt_compiler_compiledirectory, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Mvc_View_Engine_Volt_Compiler, parse, arginfo_phalcon_mvc_view_engine_volt_compiler_parse, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
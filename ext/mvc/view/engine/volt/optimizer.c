@@ -0,0 +1,807 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+
+#include <ctype.h>
+
+#include "ext/standard/php_smart_str.h"
+
+#include "kernel/main.h"
+
+#include "mvc/view/engine/volt/scanner.h"
+#include "mvc/view/engine/volt/volt.h"
+
+/**
+ * Volt optimizer
+ *
+ * Walks the intermediate representation produced by phvolt_parse_view folding the parts
+ * of the tree that can be resolved at compile time. Only transformations that produce
+ * exactly the same output as the generic code are applied:
+ *
+ * - Arithmetic between integer/double literals and concatenation of literals
+ * - 'trim', 'length', 'uppercase' and 'lowercase' filters applied to literals
+ * - Echo statements of literals are turned into raw fragments
+ * - Adjacent raw fragments are merged into a single one
+ */
+
+static void phvolt_optimize_expr(zval *expr TSRMLS_DC);
+static void phvolt_optimize_statement_list(zval *statements TSRMLS_DC);
+
+/**
+ * Returns the type of an AST node, 0 if the node doesn't have one
+ */
+static long phvolt_node_type(zval *node){
+
+	zval **type;
+
+	if (Z_TYPE_P(node) == IS_ARRAY) {
+		if (zend_hash_find(Z_ARRVAL_P(node), SS("type"), (void **) &type) == SUCCESS) {
+			if (Z_TYPE_PP(type) == IS_LONG) {
+				return Z_LVAL_PP(type);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Returns the value of a literal node
+ */
+static zval *phvolt_node_value(zval *node){
+
+	zval **value;
+
+	if (zend_hash_find(Z_ARRVAL_P(node), SS("value"), (void **) &value) == SUCCESS) {
+		if (Z_TYPE_PP(value) == IS_STRING) {
+			return *value;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Fetches a child node separating it from other references so it can be modified in place
+ */
+static zval *phvolt_separate_child(zval *node, char *key, uint key_length){
+
+	zval **child;
+
+	if (zend_hash_find(Z_ARRVAL_P(node), key, key_length, (void **) &child) == SUCCESS) {
+		SEPARATE_ZVAL(child);
+		if (Z_TYPE_PP(child) == IS_ARRAY) {
+			return *child;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Checks if an integer literal can be folded returning its value. Literals with leading
+ * zeros are octal numbers in PHP so they're left untouched
+ */
+static int phvolt_get_long(zval *node, long *lval){
+
+	zval *value;
+	char *str;
+	int length;
+	double dval;
+
+	if (phvolt_node_type(node) != PHVOLT_T_INTEGER) {
+		return 0;
+	}
+
+	value = phvolt_node_value(node);
+	if (!value) {
+		return 0;
+	}
+
+	str = Z_STRVAL_P(value);
+	length = Z_STRLEN_P(value);
+	if (length && str[0] == '-') {
+		str++;
+		length--;
+	}
+
+	if (!length || (length > 1 && str[0] == '0')) {
+		return 0;
+	}
+
+	return is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), lval, &dval, 0) == IS_LONG;
+}
+
+/**
+ * Checks if a literal is a number returning its value as a double
+ */
+static int phvolt_get_double(zval *node, double *dval){
+
+	zval *value;
+	long lval;
+
+	if (phvolt_get_long(node, &lval)) {
+		*dval = (double) lval;
+		return 1;
+	}
+
+	if (phvolt_node_type(node) != PHVOLT_T_DOUBLE) {
+		return 0;
+	}
+
+	value = phvolt_node_value(node);
+	if (!value) {
+		return 0;
+	}
+
+	switch (is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), &lval, dval, 0)) {
+		case IS_DOUBLE:
+			return 1;
+		case IS_LONG:
+			*dval = (double) lval;
+			return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Returns the text of a string literal. Strings with quotes or backslashes are skipped
+ * because the compiler emits them between single quotes as they are
+ */
+static zval *phvolt_get_string(zval *node){
+
+	zval *value;
+
+	if (phvolt_node_type(node) != PHVOLT_T_STRING) {
+		return NULL;
+	}
+
+	value = phvolt_node_value(node);
+	if (!value) {
+		return NULL;
+	}
+
+	if (memchr(Z_STRVAL_P(value), '\'', Z_STRLEN_P(value)) || memchr(Z_STRVAL_P(value), '\\', Z_STRLEN_P(value))) {
+		return NULL;
+	}
+
+	return value;
+}
+
+/**
+ * Returns the text produced by a string or an integer literal when it's converted to string
+ */
+static zval *phvolt_get_text(zval *node){
+
+	long lval;
+
+	if (phvolt_get_long(node, &lval)) {
+		return phvolt_node_value(node);
+	}
+
+	return phvolt_get_string(node);
+}
+
+/**
+ * Replaces a node by a literal, the value passed is owned by the node after this call
+ */
+static void phvolt_replace_literal(zval *node, int type, char *value, int value_length){
+
+	zval_dtor(node);
+	array_init(node);
+	add_assoc_long(node, "type", type);
+	add_assoc_stringl(node, "value", value, value_length, 0);
+}
+
+/**
+ * Replaces a node by an integer literal
+ */
+static void phvolt_replace_long(zval *node, long lval){
+
+	char *value;
+	int value_length;
+
+	value_length = spprintf(&value, 0, "%ld", lval);
+	phvolt_replace_literal(node, PHVOLT_T_INTEGER, value, value_length);
+}
+
+/**
+ * Replaces a node by a double literal, the shortest representation that produces the
+ * same value is used
+ */
+static void phvolt_replace_double(zval *node, double dval){
+
+	char *value;
+	int value_length;
+
+	if (!zend_finite(dval)) {
+		return;
+	}
+
+	value_length = spprintf(&value, 0, "%.15H", dval);
+	if (zend_strtod(value, NULL) != dval) {
+		efree(value);
+		value_length = spprintf(&value, 0, "%.17H", dval);
+	}
+
+	/**
+	 * Keep the literal as a double e.g. 2.0 instead of 2
+	 */
+	if (!strpbrk(value, ".E")) {
+		value = erealloc(value, value_length + 3);
+		memcpy(value + value_length, ".0", 3);
+		value_length += 2;
+	}
+
+	phvolt_replace_literal(node, PHVOLT_T_DOUBLE, value, value_length);
+}
+
+/**
+ * Replaces a node by a copy of other node
+ */
+static void phvolt_replace_node(zval *node, zval *other){
+
+	zval copy;
+
+	copy = *other;
+	zval_copy_ctor(&copy);
+
+	zval_dtor(node);
+	node->value = copy.value;
+	Z_TYPE_P(node) = Z_TYPE(copy);
+}
+
+/**
+ * Folds arithmetic operations between numeric literals
+ */
+static void phvolt_fold_arithmetic(zval *expr, long type, zval *left, zval *right){
+
+	long lleft, lright;
+	double dleft, dright, dresult;
+
+	if (phvolt_get_long(left, &lleft) && phvolt_get_long(right, &lright)) {
+
+		switch (type) {
+
+			case PHVOLT_T_ADD:
+				dresult = (double) lleft + (double) lright;
+				if (dresult > LONG_MIN && dresult < LONG_MAX) {
+					phvolt_replace_long(expr, lleft + lright);
+				}
+				return;
+
+			case PHVOLT_T_SUB:
+				dresult = (double) lleft - (double) lright;
+				if (dresult > LONG_MIN && dresult < LONG_MAX) {
+					phvolt_replace_long(expr, lleft - lright);
+				}
+				return;
+
+			case PHVOLT_T_MUL:
+				dresult = (double) lleft * (double) lright;
+				if (dresult > LONG_MIN && dresult < LONG_MAX) {
+					phvolt_replace_long(expr, lleft * lright);
+				}
+				return;
+
+			case PHVOLT_T_DIV:
+				if (!lright || (lright == -1 && lleft == LONG_MIN)) {
+					return;
+				}
+				if (!(lleft % lright)) {
+					phvolt_replace_long(expr, lleft / lright);
+				} else {
+					phvolt_replace_double(expr, ((double) lleft) / lright);
+				}
+				return;
+
+			case PHVOLT_T_MOD:
+				if (!lright || lright == -1) {
+					return;
+				}
+				phvolt_replace_long(expr, lleft % lright);
+				return;
+		}
+
+		return;
+	}
+
+	if (phvolt_get_double(left, &dleft) && phvolt_get_double(right, &dright)) {
+
+		switch (type) {
+
+			case PHVOLT_T_ADD:
+				phvolt_replace_double(expr, dleft + dright);
+				return;
+
+			case PHVOLT_T_SUB:
+				phvolt_replace_double(expr, dleft - dright);
+				return;
+
+			case PHVOLT_T_MUL:
+				phvolt_replace_double(expr, dleft * dright);
+				return;
+
+			case PHVOLT_T_DIV:
+				if (dright != 0) {
+					phvolt_replace_double(expr, dleft / dright);
+				}
+				return;
+		}
+	}
+
+}
+
+/**
+ * Folds the concatenation of string and integer literals
+ */
+static void phvolt_fold_concat(zval *expr, zval *left, zval *right){
+
+	zval *left_text, *right_text;
+	char *value;
+	int value_length;
+
+	left_text = phvolt_get_text(left);
+	if (!left_text) {
+		return;
+	}
+
+	right_text = phvolt_get_text(right);
+	if (!right_text) {
+		return;
+	}
+
+	value_length = Z_STRLEN_P(left_text) + Z_STRLEN_P(right_text);
+	value = emalloc(value_length + 1);
+	memcpy(value, Z_STRVAL_P(left_text), Z_STRLEN_P(left_text));
+	memcpy(value + Z_STRLEN_P(left_text), Z_STRVAL_P(right_text), Z_STRLEN_P(right_text));
+	value[value_length] = '\0';
+
+	phvolt_replace_literal(expr, PHVOLT_T_STRING, value, value_length);
+}
+
+/**
+ * Folds the unary minus applied to a numeric literal
+ */
+static void phvolt_fold_minus(zval *expr, zval *right){
+
+	zval *value;
+	char *str;
+	int length;
+	long type;
+
+	type = phvolt_node_type(right);
+	if (type != PHVOLT_T_INTEGER && type != PHVOLT_T_DOUBLE) {
+		return;
+	}
+
+	value = phvolt_node_value(right);
+	if (!value || !Z_STRLEN_P(value)) {
+		return;
+	}
+
+	/**
+	 * Integers have no negative zero, PHP prints -0 as 0
+	 */
+	if (type == PHVOLT_T_INTEGER && Z_STRLEN_P(value) == 1 && Z_STRVAL_P(value)[0] == '0') {
+		phvolt_replace_literal(expr, type, estrndup("0", 1), 1);
+		return;
+	}
+
+	if (Z_STRVAL_P(value)[0] == '-') {
+		length = Z_STRLEN_P(value) - 1;
+		str = estrndup(Z_STRVAL_P(value) + 1, length);
+	} else {
+		length = Z_STRLEN_P(value) + 1;
+		str = emalloc(length + 1);
+		str[0] = '-';
+		memcpy(str + 1, Z_STRVAL_P(value), Z_STRLEN_P(value) + 1);
+	}
+
+	phvolt_replace_literal(expr, type, str, length);
+}
+
+/**
+ * Resolves cheap filters applied to string literals at compile time
+ */
+static void phvolt_fold_filter(zval *expr, zval *left, zval *filter){
+
+	zval *text, **name;
+	char *value, *start, *end;
+	int value_length, i;
+
+	if (phvolt_node_type(filter) != PHVOLT_T_QUALIFIED) {
+		return;
+	}
+
+	if (zend_hash_exists(Z_ARRVAL_P(filter), SS("qualified"))) {
+		return;
+	}
+
+	if (zend_hash_find(Z_ARRVAL_P(filter), SS("name"), (void **) &name) != SUCCESS) {
+		return;
+	}
+
+	if (Z_TYPE_PP(name) != IS_STRING) {
+		return;
+	}
+
+	text = phvolt_get_string(left);
+	if (!text) {
+		return;
+	}
+
+	/**
+	 * 'length' returns the number of bytes in a string
+	 */
+	if (!strcmp(Z_STRVAL_PP(name), "length")) {
+		phvolt_replace_long(expr, Z_STRLEN_P(text));
+		return;
+	}
+
+	/**
+	 * 'trim' strips the same characters than the PHP function
+	 */
+	if (!strcmp(Z_STRVAL_PP(name), "trim")) {
+		start = Z_STRVAL_P(text);
+		end = start + Z_STRLEN_P(text);
+		while (start < end && memchr(" \t\n\r\v\0", *start, 6)) {
+			start++;
+		}
+		while (end > start && memchr(" \t\n\r\v\0", *(end - 1), 6)) {
+			end--;
+		}
+		value_length = end - start;
+		phvolt_replace_literal(expr, PHVOLT_T_STRING, estrndup(start, value_length), value_length);
+		return;
+	}
+
+	/**
+	 * 'uppercase' and 'lowercase' depend on mbstring for multi-byte strings so only
+	 * ASCII strings are folded
+	 */
+	if (!strcmp(Z_STRVAL_PP(name), "uppercase") || !strcmp(Z_STRVAL_PP(name), "lowercase")) {
+
+		for (i = 0; i < Z_STRLEN_P(text); i++) {
+			if ((unsigned char) Z_STRVAL_P(text)[i] > 127 || !Z_STRVAL_P(text)[i]) {
+				return;
+			}
+		}
+
+		value_length = Z_STRLEN_P(text);
+		value = estrndup(Z_STRVAL_P(text), value_length);
+		if (Z_STRVAL_PP(name)[0] == 'u') {
+			for (i = 0; i < value_length; i++) {
+				value[i] = toupper(value[i]);
+			}
+		} else {
+			for (i = 0; i < value_length; i++) {
+				value[i] = tolower(value[i]);
+			}
+		}
+
+		phvolt_replace_literal(expr, PHVOLT_T_STRING, value, value_length);
+	}
+
+}
+
+/**
+ * Optimizes an expression node and its children
+ */
+static void phvolt_optimize_expr(zval *expr TSRMLS_DC){
+
+	zval *left = NULL, *right = NULL, *child, **item;
+	HashPosition pos;
+	long type;
+
+	if (Z_TYPE_P(expr) != IS_ARRAY) {
+		return;
+	}
+
+	type = phvolt_node_type(expr);
+
+	/**
+	 * Lists of expressions in arrays and function calls
+	 */
+	if (!type) {
+		if (zend_hash_index_exists(Z_ARRVAL_P(expr), 0)) {
+			zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(expr), &pos);
+			while (zend_hash_get_current_data_ex(Z_ARRVAL_P(expr), (void **) &item, &pos) == SUCCESS) {
+				SEPARATE_ZVAL(item);
+				phvolt_optimize_expr(*item TSRMLS_CC);
+				zend_hash_move_forward_ex(Z_ARRVAL_P(expr), &pos);
+			}
+		} else {
+			child = phvolt_separate_child(expr, SS("expr"));
+			if (child) {
+				phvolt_optimize_expr(child TSRMLS_CC);
+			}
+		}
+		return;
+	}
+
+	left = phvolt_separate_child(expr, SS("left"));
+	if (left) {
+		phvolt_optimize_expr(left TSRMLS_CC);
+	}
+
+	/**
+	 * The right side of a pipe is the filter itself
+	 */
+	if (type == PHVOLT_T_PIPE) {
+		right = phvolt_separate_child(expr, SS("right"));
+	} else {
+		right = phvolt_separate_child(expr, SS("right"));
+		if (right) {
+			phvolt_optimize_expr(right TSRMLS_CC);
+		}
+	}
+
+	child = phvolt_separate_child(expr, SS("arguments"));
+	if (child) {
+		phvolt_optimize_expr(child TSRMLS_CC);
+	}
+
+	switch (type) {
+
+		case PHVOLT_T_ADD:
+		case PHVOLT_T_SUB:
+		case PHVOLT_T_MUL:
+		case PHVOLT_T_DIV:
+		case PHVOLT_T_MOD:
+			if (left && right) {
+				phvolt_fold_arithmetic(expr, type, left, right);
+			}
+			break;
+
+		case PHVOLT_T_CONCAT:
+			if (left && right) {
+				phvolt_fold_concat(expr, left, right);
+			}
+			break;
+
+		case PHVOLT_T_MINUS:
+			if (right) {
+				phvolt_fold_minus(expr, right);
+			}
+			break;
+
+		case PHVOLT_T_PIPE:
+			if (left && right) {
+				phvolt_fold_filter(expr, left, right);
+			}
+			break;
+
+		case PHVOLT_T_ENCLOSED:
+			if (left) {
+				switch (phvolt_node_type(left)) {
+					case PHVOLT_T_INTEGER:
+					case PHVOLT_T_DOUBLE:
+					case PHVOLT_T_STRING:
+						phvolt_replace_node(expr, left);
+						break;
+				}
+			}
+			break;
+	}
+
+}
+
+/**
+ * Checks if an echo statement prints a literal that can be emitted as raw text
+ */
+static zval *phvolt_echo_text(zval *statement){
+
+	zval **expr, *text;
+
+	if (zend_hash_find(Z_ARRVAL_P(statement), SS("expr"), (void **) &expr) != SUCCESS) {
+		return NULL;
+	}
+
+	text = phvolt_get_text(*expr);
+	if (!text) {
+		return NULL;
+	}
+
+	/**
+	 * Literals that could open PHP code in the compiled template are echoed as usual
+	 */
+	if (php_memnstr(Z_STRVAL_P(text), "<?", 2, Z_STRVAL_P(text) + Z_STRLEN_P(text))) {
+		return NULL;
+	}
+	if (php_memnstr(Z_STRVAL_P(text), "<%", 2, Z_STRVAL_P(text) + Z_STRLEN_P(text))) {
+		return NULL;
+	}
+
+	return text;
+}
+
+/**
+ * Optimizes a single statement
+ */
+static void phvolt_optimize_statement(zval *statement TSRMLS_DC){
+
+	zval *child;
+
+	child = phvolt_separate_child(statement, SS("expr"));
+	if (child) {
+		phvolt_optimize_expr(child TSRMLS_CC);
+	}
+
+	switch (phvolt_node_type(statement)) {
+
+		case PHVOLT_T_IF:
+			child = phvolt_separate_child(statement, SS("true_statements"));
+			if (child) {
+				phvolt_optimize_statement_list(child TSRMLS_CC);
+			}
+			child = phvolt_separate_child(statement, SS("false_statements"));
+			if (child) {
+				phvolt_optimize_statement_list(child TSRMLS_CC);
+			}
+			break;
+
+		case PHVOLT_T_FOR:
+		case PHVOLT_T_BLOCK:
+			child = phvolt_separate_child(statement, SS("block_statements"));
+			if (child) {
+				phvolt_optimize_statement_list(child TSRMLS_CC);
+			}
+			break;
+	}
+
+}
+
+/**
+ * Adds the pending raw text as a raw fragment to a statement list
+ */
+static void phvolt_flush_raw_fragment(zval *statements, smart_str *raw, int *pending){
+
+	zval *fragment;
+
+	if (!*pending) {
+		return;
+	}
+
+	smart_str_0(raw);
+
+	MAKE_STD_ZVAL(fragment);
+	array_init(fragment);
+	add_assoc_long(fragment, "type", PHVOLT_T_RAW_FRAGMENT);
+	if (raw->len) {
+		add_assoc_stringl(fragment, "value", raw->c, raw->len, 0);
+	} else {
+		add_assoc_stringl(fragment, "value", "", 0, 1);
+		smart_str_free(raw);
+	}
+	add_next_index_zval(statements, fragment);
+
+	raw->c = NULL;
+	raw->len = 0;
+	raw->a = 0;
+	*pending = 0;
+}
+
+/**
+ * Optimizes a list of statements merging echoes of literals and raw fragments
+ */
+static void phvolt_optimize_statement_list(zval *statements TSRMLS_DC){
+
+	zval *merged, *text, **statement;
+	HashPosition pos;
+	smart_str raw = {0};
+	int pending = 0, after_echo = 0, skip;
+	char *str;
+	long type;
+
+	if (Z_TYPE_P(statements) != IS_ARRAY) {
+		return;
+	}
+
+	if (!zend_hash_index_exists(Z_ARRVAL_P(statements), 0)) {
+		phvolt_optimize_statement(statements TSRMLS_CC);
+		return;
+	}
+
+	ALLOC_INIT_ZVAL(merged);
+	array_init(merged);
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(statements), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(statements), (void **) &statement, &pos) == SUCCESS) {
+
+		SEPARATE_ZVAL(statement);
+		phvolt_optimize_statement(*statement TSRMLS_CC);
+
+		type = phvolt_node_type(*statement);
+
+		if (type == PHVOLT_T_ECHO) {
+			text = phvolt_echo_text(*statement);
+			if (text) {
+				smart_str_appendl(&raw, Z_STRVAL_P(text), Z_STRLEN_P(text));
+				pending = 1;
+				after_echo = 1;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(statements), &pos);
+				continue;
+			}
+		}
+
+		if (type == PHVOLT_T_RAW_FRAGMENT) {
+			text = phvolt_node_value(*statement);
+			if (text) {
+				str = Z_STRVAL_P(text);
+				skip = 0;
+
+				/**
+				 * PHP swallows the newline after a closing tag, the echo removed did it
+				 */
+				if (after_echo) {
+					if (str[0] == '\r' && str[1] == '\n') {
+						skip = 2;
+					} else {
+						if (str[0] == '\n' || str[0] == '\r') {
+							skip = 1;
+						}
+					}
+				}
+
+				smart_str_appendl(&raw, str + skip, Z_STRLEN_P(text) - skip);
+				pending = 1;
+				after_echo = 0;
+				zend_hash_move_forward_ex(Z_ARRVAL_P(statements), &pos);
+				continue;
+			}
+		}
+
+		phvolt_flush_raw_fragment(merged, &raw, &pending);
+		after_echo = 0;
+
+		Z_ADDREF_PP(statement);
+		add_next_index_zval(merged, *statement);
+
+		zend_hash_move_forward_ex(Z_ARRVAL_P(statements), &pos);
+	}
+
+	phvolt_flush_raw_fragment(merged, &raw, &pending);
+
+	zval_dtor(statements);
+	statements->value = merged->value;
+	Z_TYPE_P(statements) = IS_ARRAY;
+	efree(merged);
+}
+
+/**
+ * Optimizes the intermediate representation of a view in place
+ */
+int phvolt_optimize_view(zval *intermediate TSRMLS_DC){
+
+	if (Z_TYPE_P(intermediate) != IS_ARRAY) {
+		return FAILURE;
+	}
+
+	phvolt_optimize_statement_list(intermediate TSRMLS_CC);
+
+	return SUCCESS;
+}
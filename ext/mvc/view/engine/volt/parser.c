@@ -33,8 +33,6 @@ static zval *phvolt_ret_literal_zval(int type, phvolt_parser_token *T)
 	add_assoc_long(ret, "type", type);
 	if (T) {
 		add_assoc_stringl(ret, "value", T->token, T->token_len, 1);
-		efree(T->token);
-		efree(T);
 	}
 
 	return ret;
@@ -105,8 +103,6 @@ static zval *phvolt_ret_block_statement(phvolt_parser_token *name, zval *block_s
 	add_assoc_long(ret, "type", PHVOLT_T_BLOCK);
 
 	add_assoc_stringl(ret, "name", name->token, name->token_len, 1);
-	efree(name->token);
-	efree(name);
 
 	if (block_statements) {
 		add_assoc_zval(ret, "block_statements", block_statements);
@@ -125,8 +121,6 @@ static zval *phvolt_ret_extends_statement(phvolt_parser_token *P)
 	add_assoc_long(ret, "type", PHVOLT_T_EXTENDS);
 
 	add_assoc_stringl(ret, "path", P->token, P->token_len, 1);
-	efree(P->token);
-	efree(P);
 
 	return ret;
 }
@@ -141,8 +135,6 @@ static zval *phvolt_ret_include_statement(phvolt_parser_token *P)
 	add_assoc_long(ret, "type", PHVOLT_T_INCLUDE);
 
 	add_assoc_stringl(ret, "path", P->token, P->token_len, 1);
-	efree(P->token);
-	efree(P);
 
 	return ret;
 }
@@ -170,8 +162,6 @@ static zval *phvolt_ret_qualified_name(zval *A, phvolt_parser_token *B)
 	}
 
 	add_assoc_stringl(ret, "name", B->token, B->token_len, 1);
-	efree(B->token);
-	efree(B);
 
 	return ret;
 }
@@ -220,8 +210,6 @@ static zval *phvolt_ret_named_item(phvolt_parser_token *name, zval *expr)
 	add_assoc_zval(ret, "expr", expr);
 	if (name != NULL) {
 		add_assoc_stringl(ret, "name", name->token, name->token_len, 1);
-		efree(name->token);
-		efree(name);
 	}
 
 	return ret;
@@ -253,8 +241,6 @@ static zval *phvolt_ret_func_call(phvolt_parser_token *name, zval *arguments)
 	array_init(ret);
 	add_assoc_long(ret, "type", PHVOLT_T_FCALL);
 	add_assoc_stringl(ret, "name", name->token, name->token_len, 1);
-	efree(name->token);
-	efree(name);
 
 	if (arguments) {
 		add_assoc_zval(ret, "arguments", arguments);
@@ -264,7 +250,7 @@ static zval *phvolt_ret_func_call(phvolt_parser_token *name, zval *arguments)
 }
 
 
-// 268 "parser.c"
+// 254 "parser.c"
 /* Next is all token values, in a form suitable for use by makeheaders.
 ** This section will be null unless lemon is run with the -m switch.
 */
@@ -796,67 +782,6 @@ static void kk_destructor(KKCODETYPE kkmajor, KKMINORTYPE *kkpminor){
     ** which appear on the RHS of the rule, but which are not used
     ** inside the C code.
     */
-    case 1:
-    case 2:
-    case 3:
-    case 4:
-    case 5:
-    case 6:
-    case 7:
-    case 8:
-    case 9:
-    case 10:
-    case 11:
-    case 12:
-    case 13:
-    case 14:
-    case 15:
-    case 16:
-    case 17:
-    case 18:
-    case 19:
-    case 20:
-    case 21:
-    case 22:
-    case 23:
-    case 24:
-    case 25:
-    case 26:
-    case 27:
-    case 28:
-    case 29:
-    case 30:
-    case 31:
-    case 32:
-    case 33:
-    case 34:
-    case 35:
-    case 36:
-    case 37:
-    case 38:
-    case 39:
-    case 40:
-    case 41:
-    case 42:
-    case 43:
-    case 44:
-    case 45:
-    case 46:
-    case 47:
-    case 48:
-    case 49:
-    case 50:
-    case 51:
-    case 52:
-// 342 "parser.lemon"
-{
-	if ((kkpminor->kk0)) {
-		efree((kkpminor->kk0)->token);
-		efree((kkpminor->kk0));
-	}
-}
-// 859 "parser.c"
-      break;
     case 56:
     case 57:
     case 58:
@@ -874,9 +799,9 @@ static void kk_destructor(KKCODETYPE kkmajor, KKMINORTYPE *kkpminor){
     case 71:
     case 72:
     case 73:
-// 357 "parser.lemon"
+// 336 "parser.lemon"
 { zval_ptr_dtor(&(kkpminor->kk96)); }
-// 880 "parser.c"
+// 805 "parser.c"
       break;
     default:  break;   /* If no destructor action specified: do nothing */
   }
@@ -1159,11 +1084,11 @@ static void kk_reduce(
   **     break;
   */
       case 0:
-// 349 "parser.lemon"
+// 328 "parser.lemon"
 {
 	status->ret = kkmsp[0].minor.kk96;
 }
-// 1167 "parser.c"
+// 1092 "parser.c"
         break;
       case 1:
       case 3:
@@ -1180,461 +1105,365 @@ static void kk_reduce(
       case 53:
       case 57:
       case 60:
-// 353 "parser.lemon"
+// 332 "parser.lemon"
 {
 	kkgotominor.kk96 = kkmsp[0].minor.kk96;
 }
-// 1188 "parser.c"
+// 1113 "parser.c"
         break;
       case 2:
-// 359 "parser.lemon"
+// 338 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_zval_list(kkmsp[-1].minor.kk96, kkmsp[0].minor.kk96);
 }
-// 1195 "parser.c"
+// 1120 "parser.c"
         break;
       case 13:
-// 407 "parser.lemon"
+// 386 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_if_statement(kkmsp[-5].minor.kk96, kkmsp[-3].minor.kk96, NULL);
-  kk_destructor(24,&kkmsp[-7].minor);
-  kk_destructor(25,&kkmsp[-6].minor);
-  kk_destructor(26,&kkmsp[-4].minor);
-  kk_destructor(24,&kkmsp[-2].minor);
-  kk_destructor(27,&kkmsp[-1].minor);
-  kk_destructor(26,&kkmsp[0].minor);
-}
-// 1208 "parser.c"
+}
+// 1127 "parser.c"
         break;
       case 14:
-// 411 "parser.lemon"
+// 390 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_if_statement(kkmsp[-9].minor.kk96, kkmsp[-7].minor.kk96, kkmsp[-3].minor.kk96);
-  kk_destructor(24,&kkmsp[-11].minor);
-  kk_destructor(25,&kkmsp[-10].minor);
-  kk_destructor(26,&kkmsp[-8].minor);
-  kk_destructor(24,&kkmsp[-6].minor);
-  kk_destructor(28,&kkmsp[-5].minor);
-  kk_destructor(26,&kkmsp[-4].minor);
-  kk_destructor(24,&kkmsp[-2].minor);
-  kk_destructor(27,&kkmsp[-1].minor);
-  kk_destructor(26,&kkmsp[0].minor);
-}
-// 1224 "parser.c"
+}
+// 1134 "parser.c"
         break;
       case 15:
-// 417 "parser.lemon"
+// 396 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_for_statement(kkmsp[-7].minor.kk96, kkmsp[-5].minor.kk96, kkmsp[-3].minor.kk96);
-  kk_destructor(24,&kkmsp[-9].minor);
-  kk_destructor(29,&kkmsp[-8].minor);
-  kk_destructor(30,&kkmsp[-6].minor);
-  kk_destructor(26,&kkmsp[-4].minor);
-  kk_destructor(24,&kkmsp[-2].minor);
-  kk_destructor(31,&kkmsp[-1].minor);
-  kk_destructor(26,&kkmsp[0].minor);
-}
-// 1238 "parser.c"
+}
+// 1141 "parser.c"
         break;
       case 16:
-// 423 "parser.lemon"
+// 402 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_set_statement(kkmsp[-3].minor.kk96, kkmsp[-1].minor.kk96);
-  kk_destructor(24,&kkmsp[-5].minor);
-  kk_destructor(32,&kkmsp[-4].minor);
-  kk_destructor(33,&kkmsp[-2].minor);
-  kk_destructor(26,&kkmsp[0].minor);
 }
-// 1249 "parser.c"
+// 1148 "parser.c"
         break;
       case 17:
-// 429 "parser.lemon"
+// 408 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_empty_statement();
-  kk_destructor(24,&kkmsp[-1].minor);
-  kk_destructor(26,&kkmsp[0].minor);
 }
-// 1258 "parser.c"
+// 1155 "parser.c"
         break;
       case 18:
-// 435 "parser.lemon"
+// 414 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_echo_statement(kkmsp[-1].minor.kk96);
-  kk_destructor(34,&kkmsp[-2].minor);
-  kk_destructor(35,&kkmsp[0].minor);
 }
-// 1267 "parser.c"
+// 1162 "parser.c"
         break;
       case 19:
-// 441 "parser.lemon"
+// 420 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_block_statement(kkmsp[-5].minor.kk0, kkmsp[-3].minor.kk96);
-  kk_destructor(24,&kkmsp[-7].minor);
-  kk_destructor(36,&kkmsp[-6].minor);
-  kk_destructor(26,&kkmsp[-4].minor);
-  kk_destructor(24,&kkmsp[-2].minor);
-  kk_destructor(38,&kkmsp[-1].minor);
-  kk_destructor(26,&kkmsp[0].minor);
-}
-// 1280 "parser.c"
+}
+// 1169 "parser.c"
         break;
       case 20:
-// 445 "parser.lemon"
+// 424 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_block_statement(kkmsp[-4].minor.kk0, NULL);
-  kk_destructor(24,&kkmsp[-6].minor);
-  kk_destructor(36,&kkmsp[-5].minor);
-  kk_destructor(26,&kkmsp[-3].minor);
-  kk_destructor(24,&kkmsp[-2].minor);
-  kk_destructor(38,&kkmsp[-1].minor);
-  kk_destructor(26,&kkmsp[0].minor);
-}
-// 1293 "parser.c"
+}
+// 1176 "parser.c"
         break;
       case 21:
-// 451 "parser.lemon"
+// 430 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_extends_statement(kkmsp[-1].minor.kk0);
-  kk_destructor(24,&kkmsp[-3].minor);
-  kk_destructor(39,&kkmsp[-2].minor);
-  kk_destructor(26,&kkmsp[0].minor);
 }
-// 1303 "parser.c"
+// 1183 "parser.c"
         break;
       case 22:
-// 457 "parser.lemon"
+// 436 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_include_statement(kkmsp[-1].minor.kk0);
-  kk_destructor(24,&kkmsp[-3].minor);
-  kk_destructor(41,&kkmsp[-2].minor);
-  kk_destructor(26,&kkmsp[0].minor);
 }
-// 1313 "parser.c"
+// 1190 "parser.c"
         break;
       case 23:
-// 463 "parser.lemon"
+// 442 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_RAW_FRAGMENT, kkmsp[0].minor.kk0);
 }
-// 1320 "parser.c"
+// 1197 "parser.c"
         break;
       case 24:
-// 469 "parser.lemon"
+// 448 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_MINUS, NULL, kkmsp[0].minor.kk96);
-  kk_destructor(20,&kkmsp[-1].minor);
 }
-// 1328 "parser.c"
+// 1204 "parser.c"
         break;
       case 25:
-// 473 "parser.lemon"
+// 452 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_SUB, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(20,&kkmsp[-1].minor);
 }
-// 1336 "parser.c"
+// 1211 "parser.c"
         break;
       case 26:
-// 477 "parser.lemon"
+// 456 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_ADD, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(19,&kkmsp[-1].minor);
 }
-// 1344 "parser.c"
+// 1218 "parser.c"
         break;
       case 27:
-// 481 "parser.lemon"
+// 460 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_MUL, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(17,&kkmsp[-1].minor);
 }
-// 1352 "parser.c"
+// 1225 "parser.c"
         break;
       case 28:
-// 485 "parser.lemon"
+// 464 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_DIV, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(16,&kkmsp[-1].minor);
 }
-// 1360 "parser.c"
+// 1232 "parser.c"
         break;
       case 29:
-// 489 "parser.lemon"
+// 468 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_MOD, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(18,&kkmsp[-1].minor);
 }
-// 1368 "parser.c"
+// 1239 "parser.c"
         break;
       case 30:
-// 493 "parser.lemon"
+// 472 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_AND, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(13,&kkmsp[-1].minor);
 }
-// 1376 "parser.c"
+// 1246 "parser.c"
         break;
       case 31:
-// 497 "parser.lemon"
+// 476 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_OR, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(14,&kkmsp[-1].minor);
 }
-// 1384 "parser.c"
+// 1253 "parser.c"
         break;
       case 32:
-// 501 "parser.lemon"
+// 480 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_CONCAT, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(21,&kkmsp[-1].minor);
 }
-// 1392 "parser.c"
+// 1260 "parser.c"
         break;
       case 33:
-// 505 "parser.lemon"
+// 484 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_PIPE, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(15,&kkmsp[-1].minor);
 }
-// 1400 "parser.c"
+// 1267 "parser.c"
         break;
       case 34:
-// 509 "parser.lemon"
+// 488 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_RANGE, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(3,&kkmsp[-1].minor);
 }
-// 1408 "parser.c"
+// 1274 "parser.c"
         break;
       case 35:
-// 513 "parser.lemon"
+      case 38:
+// 492 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_EQUALS, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(5,&kkmsp[-1].minor);
 }
-// 1416 "parser.c"
+// 1282 "parser.c"
         break;
       case 36:
-// 517 "parser.lemon"
+// 496 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_NOT_ISSET, kkmsp[-3].minor.kk96, NULL);
-  kk_destructor(4,&kkmsp[-2].minor);
-  kk_destructor(22,&kkmsp[-1].minor);
-  kk_destructor(43,&kkmsp[0].minor);
 }
-// 1426 "parser.c"
+// 1289 "parser.c"
         break;
       case 37:
-// 521 "parser.lemon"
+// 500 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_ISSET, kkmsp[-2].minor.kk96, NULL);
-  kk_destructor(4,&kkmsp[-1].minor);
-  kk_destructor(43,&kkmsp[0].minor);
 }
-// 1435 "parser.c"
-        break;
-      case 38:
-// 525 "parser.lemon"
-{
-	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_EQUALS, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(4,&kkmsp[-1].minor);
-}
-// 1443 "parser.c"
+// 1296 "parser.c"
         break;
       case 39:
-// 529 "parser.lemon"
+// 508 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_NOTEQUALS, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(6,&kkmsp[-1].minor);
 }
-// 1451 "parser.c"
+// 1303 "parser.c"
         break;
       case 40:
-// 533 "parser.lemon"
+// 512 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_IDENTICAL, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(11,&kkmsp[-1].minor);
 }
-// 1459 "parser.c"
+// 1310 "parser.c"
         break;
       case 41:
-// 537 "parser.lemon"
+// 516 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_NOTIDENTICAL, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(12,&kkmsp[-1].minor);
 }
-// 1467 "parser.c"
+// 1317 "parser.c"
         break;
       case 42:
-// 541 "parser.lemon"
+// 520 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_LESS, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(7,&kkmsp[-1].minor);
 }
-// 1475 "parser.c"
+// 1324 "parser.c"
         break;
       case 43:
-// 545 "parser.lemon"
+// 524 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_GREATER, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(8,&kkmsp[-1].minor);
 }
-// 1483 "parser.c"
+// 1331 "parser.c"
         break;
       case 44:
-// 549 "parser.lemon"
+// 528 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_GREATEREQUAL, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(9,&kkmsp[-1].minor);
 }
-// 1491 "parser.c"
+// 1338 "parser.c"
         break;
       case 45:
-// 553 "parser.lemon"
+// 532 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_LESSEQUAL, kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(10,&kkmsp[-1].minor);
 }
-// 1499 "parser.c"
+// 1345 "parser.c"
         break;
       case 46:
-// 557 "parser.lemon"
+// 536 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_NOT, NULL, kkmsp[0].minor.kk96);
-  kk_destructor(22,&kkmsp[-1].minor);
 }
-// 1507 "parser.c"
+// 1352 "parser.c"
         break;
       case 47:
-// 561 "parser.lemon"
+// 540 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_ENCLOSED, kkmsp[-1].minor.kk96, NULL);
-  kk_destructor(44,&kkmsp[-2].minor);
-  kk_destructor(45,&kkmsp[0].minor);
 }
-// 1516 "parser.c"
+// 1359 "parser.c"
         break;
       case 48:
-// 565 "parser.lemon"
+// 544 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_ARRAY, kkmsp[-1].minor.kk96, NULL);
-  kk_destructor(2,&kkmsp[-2].minor);
-  kk_destructor(46,&kkmsp[0].minor);
 }
-// 1525 "parser.c"
+// 1366 "parser.c"
         break;
       case 49:
       case 56:
-// 571 "parser.lemon"
+// 550 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_zval_list(kkmsp[-2].minor.kk96, kkmsp[0].minor.kk96);
-  kk_destructor(1,&kkmsp[-1].minor);
 }
-// 1534 "parser.c"
+// 1374 "parser.c"
         break;
       case 51:
       case 59:
-// 579 "parser.lemon"
+// 558 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_named_item(kkmsp[-2].minor.kk0, kkmsp[0].minor.kk96);
-  kk_destructor(47,&kkmsp[-1].minor);
 }
-// 1543 "parser.c"
+// 1382 "parser.c"
         break;
       case 52:
       case 58:
-// 583 "parser.lemon"
+// 562 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_named_item(NULL, kkmsp[0].minor.kk96);
 }
-// 1551 "parser.c"
+// 1390 "parser.c"
         break;
       case 54:
-// 593 "parser.lemon"
+// 572 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_func_call(kkmsp[-3].minor.kk0, kkmsp[-1].minor.kk96);
-  kk_destructor(44,&kkmsp[-2].minor);
-  kk_destructor(45,&kkmsp[0].minor);
 }
-// 1560 "parser.c"
+// 1397 "parser.c"
         break;
       case 55:
-// 597 "parser.lemon"
+// 576 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_func_call(kkmsp[-2].minor.kk0, NULL);
-  kk_destructor(44,&kkmsp[-1].minor);
-  kk_destructor(45,&kkmsp[0].minor);
 }
-// 1569 "parser.c"
+// 1404 "parser.c"
         break;
       case 61:
-// 625 "parser.lemon"
+// 604 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_expr(PHVOLT_T_ARRAYACCESS, kkmsp[-3].minor.kk96, kkmsp[-1].minor.kk96);
-  kk_destructor(2,&kkmsp[-2].minor);
-  kk_destructor(46,&kkmsp[0].minor);
 }
-// 1578 "parser.c"
+// 1411 "parser.c"
         break;
       case 62:
-// 629 "parser.lemon"
+// 608 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_INTEGER, kkmsp[0].minor.kk0);
 }
-// 1585 "parser.c"
+// 1418 "parser.c"
         break;
       case 63:
-// 633 "parser.lemon"
+// 612 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_STRING, kkmsp[0].minor.kk0);
 }
-// 1592 "parser.c"
+// 1425 "parser.c"
         break;
       case 64:
-// 637 "parser.lemon"
+// 616 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_DOUBLE, kkmsp[0].minor.kk0);
 }
-// 1599 "parser.c"
+// 1432 "parser.c"
         break;
       case 65:
-// 641 "parser.lemon"
+// 620 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_NULL, NULL);
-  kk_destructor(50,&kkmsp[0].minor);
 }
-// 1607 "parser.c"
+// 1439 "parser.c"
         break;
       case 66:
-// 645 "parser.lemon"
+// 624 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_FALSE, NULL);
-  kk_destructor(51,&kkmsp[0].minor);
 }
-// 1615 "parser.c"
+// 1446 "parser.c"
         break;
       case 67:
-// 649 "parser.lemon"
+// 628 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_literal_zval(PHVOLT_T_TRUE, NULL);
-  kk_destructor(52,&kkmsp[0].minor);
 }
-// 1623 "parser.c"
+// 1453 "parser.c"
         break;
       case 68:
-// 655 "parser.lemon"
+// 634 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_qualified_name(kkmsp[-2].minor.kk96, kkmsp[0].minor.kk0);
-  kk_destructor(23,&kkmsp[-1].minor);
 }
-// 1631 "parser.c"
+// 1460 "parser.c"
         break;
       case 69:
-// 659 "parser.lemon"
+// 638 "parser.lemon"
 {
 	kkgotominor.kk96 = phvolt_ret_qualified_name(NULL, kkmsp[0].minor.kk0);
 }
-// 1638 "parser.c"
+// 1467 "parser.c"
         break;
   };
   kkgoto = kkRuleInfo[kkruleno].lhs;
@@ -1676,7 +1505,7 @@ static void kk_syntax_error(
 ){
   phvolt_ARG_FETCH;
 #define KTOKEN (kkminor.kk0)
-// 297 "parser.lemon"
+// 283 "parser.lemon"
 
 	if (status->scanner_state->start) {
 		{
@@ -1721,7 +1550,7 @@ static void kk_syntax_error(
 
 	status->status = PHVOLT_PARSING_FAILED;
 
-// 1725 "parser.c"
+// 1554 "parser.c"
   phvolt_ARG_STORE; /* Suppress warning about unused %extra_argument variable */
 }
 
@@ -1962,17 +1791,45 @@ const phvolt_token_names phvolt_tokens[] =
 };
 
 /**
- * Wrapper to alloc memory within the parser
+ * phvolt_Free gets the lemon parser declared in phvolt_internal_parse_view, there is nothing to free
  */
-static void *phvolt_wrapper_alloc(size_t bytes){
-	return emalloc(bytes);
+static void phvolt_wrapper_free(void *pointer){
 }
 
 /**
- * Wrapper to free memory within the parser
+ * Every token the scanner finds in the template is handed to the parser from here. Partials and
+ * short templates fit in the block on the stack of phvolt_internal_parse_view, longer templates
+ * chain heap blocks that are kept until the whole template is parsed
  */
-static void phvolt_wrapper_free(void *pointer){
-	efree(pointer);
+static phvolt_parser_token *phvolt_arena_token(phvolt_parser_status *parser_status){
+
+	phvolt_token_arena *arena = parser_status->arena;
+
+	if (arena->used == PHVOLT_ARENA_SIZE) {
+		arena = emalloc(sizeof(phvolt_token_arena));
+		arena->used = 0;
+		arena->prev = parser_status->arena;
+		parser_status->arena = arena;
+	}
+
+	return &arena->tokens[arena->used++];
+}
+
+/**
+ * Frees the heap blocks chained while parsing the template, the parser status is left pointing
+ * to the block on the stack
+ */
+static void phvolt_arena_free(phvolt_parser_status *parser_status){
+
+	phvolt_token_arena *arena = parser_status->arena, *prev;
+
+	while (arena->prev) {
+		prev = arena->prev;
+		efree(arena);
+		arena = prev;
+	}
+
+	parser_status->arena = arena;
 }
 
 /**
@@ -1980,10 +1837,11 @@ static void phvolt_wrapper_free(void *pointer){
  */
 static void phvolt_parse_with_token(void* phvolt_parser, int opcode, int parsercode, phvolt_scanner_token *token, phvolt_parser_status *parser_status){
 	phvolt_parser_token *pToken;
-	pToken = emalloc(sizeof(phvolt_parser_token));
+	pToken = phvolt_arena_token(parser_status);
 	pToken->opcode = opcode;
 	pToken->token = token->value;
 	pToken->token_len = token->len;
+	pToken->free_flag = 0;
 	phvolt_(phvolt_parser, parsercode, pToken, parser_status);
 }
 
@@ -2041,10 +1899,12 @@ int phvolt_is_blank_string(phvolt_scanner_token *token){
 int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view_length, zval **error_msg TSRMLS_DC) {
 
 	char *error;
-	phvolt_scanner_state *state;
-	phvolt_scanner_token *token;
+	phvolt_scanner_state state_memory, *state = &state_memory;
+	phvolt_scanner_token token_memory, *token = &token_memory;
 	int scanner_status, status = SUCCESS;
-	phvolt_parser_status *parser_status = NULL;
+	phvolt_parser_status status_memory, *parser_status = &status_memory;
+	phvolt_token_arena arena;
+	kkParser parser_memory;
 	void* phvolt_parser;
 
 	if (!view_code) {
@@ -2058,13 +1918,18 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 		return SUCCESS;
 	}
 
-	phvolt_parser = phvolt_Alloc(phvolt_wrapper_alloc);
+	/** 
+	 * The parser, the scanner and the first block of tokens are allocated on the stack, tokens
+	 * point to the view code instead of copying it
+	 */
+	parser_memory.kkidx = -1;
+	phvolt_parser = &parser_memory;
 
-	parser_status = emalloc(sizeof(phvolt_parser_status));
-	state = emalloc(sizeof(phvolt_scanner_state));
-	token = emalloc(sizeof(phvolt_scanner_token));
+	arena.used = 0;
+	arena.prev = NULL;
 
 	parser_status->status = PHVOLT_PARSING_OK;
+	parser_status->arena = &arena;
 	parser_status->scanner_state = state;
 	parser_status->ret = NULL;
 	parser_status->syntax_error = NULL;
@@ -2073,8 +1938,9 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 	state->active_token = 0;
 	state->start = view_code;
 	state->mode = PHVOLT_MODE_RAW;
-	state->raw_buffer = emalloc(sizeof(char) * PHVOLT_RAW_BUFFER_SIZE);
-	state->raw_buffer_size = PHVOLT_RAW_BUFFER_SIZE;
+	state->raw_fragment = NULL;
+	state->raw_buffer = NULL;
+	state->raw_buffer_size = 0;
 	state->raw_buffer_cursor = 0;
 	state->active_line = 1;
 	state->statement_position = 0;
@@ -2258,8 +2124,6 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 					if(!phvolt_is_blank_string(token)){
 						phvolt_create_error_msg(parser_status, "Child templates only may contain blocks");
 						parser_status->status = PHVOLT_PARSING_FAILED;
-					} else {
-						efree(token->value);
 					}
 					break;
 				}
@@ -2332,7 +2196,9 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 
 	state->active_token = 0;
 	state->start = NULL;
-	efree(state->raw_buffer);
+	if (state->raw_buffer) {
+		efree(state->raw_buffer);
+	}
 
 	if (status != FAILURE) {
 		switch (scanner_status) {
@@ -2381,9 +2247,7 @@ int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view
 		}
 	}
 
-	efree(parser_status);
-	efree(state);
-	efree(token);
+	phvolt_arena_free(parser_status);
 
 	return status;
 }
\ No newline at end of file
@@ -33,75 +33,113 @@
 #define KKLIMIT (s->end)
 #define KKMARKER q
 
+/**
+ * Appends a run of raw text to the fragment being scanned. Fragments point to the view code, they
+ * are only copied to the raw buffer when a comment splits them. The parser reduces every fragment
+ * before the next one is scanned so the buffer can be reused
+ */
+static void phvolt_append_raw(phvolt_scanner_state *s, char *run, unsigned int length) {
+
+	unsigned int needed;
+
+	if (!s->raw_buffer_cursor) {
+		s->raw_fragment = run;
+		s->raw_buffer_cursor = length;
+		return;
+	}
+
+	needed = s->raw_buffer_cursor + length;
+	if (needed > s->raw_buffer_size) {
+		while (needed > s->raw_buffer_size) {
+			s->raw_buffer_size += PHVOLT_RAW_BUFFER_SIZE;
+		}
+		if (s->raw_fragment == s->raw_buffer) {
+			s->raw_buffer = erealloc(s->raw_buffer, s->raw_buffer_size);
+			s->raw_fragment = s->raw_buffer;
+		} else {
+			if (s->raw_buffer) {
+				efree(s->raw_buffer);
+			}
+			s->raw_buffer = emalloc(s->raw_buffer_size);
+		}
+	}
+
+	if (s->raw_fragment != s->raw_buffer) {
+		memcpy(s->raw_buffer, s->raw_fragment, s->raw_buffer_cursor);
+		s->raw_fragment = s->raw_buffer;
+	}
+
+	memcpy(s->raw_buffer + s->raw_buffer_cursor, run, length);
+	s->raw_buffer_cursor = needed;
+}
+
 int phvolt_get_token(phvolt_scanner_state *s, phvolt_scanner_token *token) {
 
-	char next, *q = KKCURSOR, *start = KKCURSOR;
+	char ch, next, *cursor, *q = KKCURSOR, *start = KKCURSOR;
 	int status = PHVOLT_SCANNER_RETCODE_IMPOSSIBLE;
 
 	while (PHVOLT_SCANNER_RETCODE_IMPOSSIBLE == status) {
 
 		if (s->mode == PHVOLT_MODE_RAW || s->mode == PHVOLT_MODE_COMMENT) {
 
-			if (*KKCURSOR == '\n') {
-				s->active_line++;
+			/**
+			 * Raw text is scanned up to the next delimiter or comment in a single pass
+			 */
+			cursor = KKCURSOR;
+			while ((ch = *cursor)) {
+				if (ch == '{') {
+					next = *(cursor+1);
+					if (next == '%' || next == '{' || next == '#') {
+						break;
+					}
+				} else {
+					if (ch == '\n') {
+						s->active_line++;
+					}
+				}
+				cursor++;
 			}
 
-			next = *(KKCURSOR+1);
-			if (*KKCURSOR == '\0' || (*KKCURSOR == '{' && (next == '%' || next == '{' || next == '#'))) {
-
-				if (next != '#') {
+			if (cursor != KKCURSOR) {
+				phvolt_append_raw(s, KKCURSOR, cursor - KKCURSOR);
+				KKCURSOR = cursor;
+			}
 
-					s->mode = PHVOLT_MODE_CODE;
+			if (*KKCURSOR == '{' && *(KKCURSOR+1) == '#') {
 
-					if (s->raw_buffer_cursor > 0) {
-						token->opcode = PHVOLT_T_RAW_FRAGMENT;
-						token->value = emalloc(sizeof(char) * s->raw_buffer_cursor+1);
-						memcpy(token->value, s->raw_buffer, s->raw_buffer_cursor);
-						token->value[s->raw_buffer_cursor] = 0;
-						token->len = s->raw_buffer_cursor;
-						s->raw_buffer_cursor = 0;
-						q = KKCURSOR;
-					} else {
+				while ((next = *(++KKCURSOR))) {
+					if (next == '#' && *(KKCURSOR+1) == '}') {
+						KKCURSOR+=2;
 						token->opcode = PHVOLT_T_IGNORE;
-					}
-
-				} else {
-
-					while ((next = *(++KKCURSOR))) {
-						if (next == '#' && *(KKCURSOR+1) == '}') {
-							KKCURSOR+=2;
-							token->opcode = PHVOLT_T_IGNORE;
-							return 0;
-						} else {
-							if (next == '\n') {
-								s->active_line++;
-							}
+						return 0;
+					} else {
+						if (next == '\n') {
+							s->active_line++;
 						}
 					}
-
-					return PHVOLT_SCANNER_RETCODE_EOF;
-
 				}
 
-				return 0;
-
-			} else {
-
-				if (s->raw_buffer_cursor == s->raw_buffer_size) {
-					s->raw_buffer_size += PHVOLT_RAW_BUFFER_SIZE;
-					s->raw_buffer = erealloc(s->raw_buffer, s->raw_buffer_size);
-				}
+				return PHVOLT_SCANNER_RETCODE_EOF;
+			}
 
-				memcpy(s->raw_buffer+s->raw_buffer_cursor, KKCURSOR, 1);
-				s->raw_buffer_cursor++;
+			s->mode = PHVOLT_MODE_CODE;
 
-				++KKCURSOR;
+			if (s->raw_buffer_cursor > 0) {
+				token->opcode = PHVOLT_T_RAW_FRAGMENT;
+				token->value = s->raw_fragment;
+				token->len = s->raw_buffer_cursor;
+				s->raw_buffer_cursor = 0;
+				q = KKCURSOR;
+			} else {
+				token->opcode = PHVOLT_T_IGNORE;
 			}
 
+			return 0;
+
 		} else {
 
 		
-// 105 "scanner.c"
+// 143 "scanner.c"
 		{
 			KKCTYPE kkch;
 			unsigned int kkaccept = 0;
@@ -204,15 +242,15 @@ kk2:
 			kkch = *(KKMARKER = ++KKCURSOR);
 			goto kk180;
 kk3:
-// 106 "scanner.re"
+// 144 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_INTEGER;
-			token->value = estrndup(start, KKCURSOR - start);
+			token->value = start;
 			token->len = KKCURSOR - start;
 			q = KKCURSOR;
 			return 0;
 		}
-// 216 "scanner.c"
+// 254 "scanner.c"
 kk4:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -225,15 +263,15 @@ kk4:
 			default:	goto kk83;
 			}
 kk5:
-// 259 "scanner.re"
+// 297 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_IDENTIFIER;
-			token->value = estrndup(start, KKCURSOR - start);
+			token->value = start;
 			token->len = KKCURSOR - start;
 			q = KKCURSOR;
 			return 0;
 		}
-// 237 "scanner.c"
+// 275 "scanner.c"
 kk6:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -313,12 +351,12 @@ kk15:
 			default:	goto kk16;
 			}
 kk16:
-// 413 "scanner.re"
+// 451 "scanner.re"
 			{
 			status = PHVOLT_SCANNER_RETCODE_ERR;
 			break;
 		}
-// 322 "scanner.c"
+// 360 "scanner.c"
 kk17:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -326,12 +364,12 @@ kk17:
 			default:	goto kk18;
 			}
 kk18:
-// 287 "scanner.re"
+// 325 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_MOD;
 			return 0;
 		}
-// 335 "scanner.c"
+// 373 "scanner.c"
 kk19:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -353,44 +391,44 @@ kk22:
 			goto kk83;
 kk23:
 			++KKCURSOR;
-// 267 "scanner.re"
+// 305 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_ADD;
 			return 0;
 		}
-// 362 "scanner.c"
+// 400 "scanner.c"
 kk25:
 			++KKCURSOR;
-// 272 "scanner.re"
+// 310 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_SUB;
 			return 0;
 		}
-// 370 "scanner.c"
+// 408 "scanner.c"
 kk27:
 			++KKCURSOR;
-// 277 "scanner.re"
+// 315 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_MUL;
 			return 0;
 		}
-// 378 "scanner.c"
+// 416 "scanner.c"
 kk29:
 			++KKCURSOR;
-// 282 "scanner.re"
+// 320 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_DIV;
 			return 0;
 		}
-// 386 "scanner.c"
+// 424 "scanner.c"
 kk31:
 			++KKCURSOR;
-// 292 "scanner.re"
+// 330 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_CONCAT;
 			return 0;
 		}
-// 394 "scanner.c"
+// 432 "scanner.c"
 kk33:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -398,52 +436,52 @@ kk33:
 			default:	goto kk34;
 			}
 kk34:
-// 302 "scanner.re"
+// 340 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_DOT;
 			return 0;
 		}
-// 407 "scanner.c"
+// 445 "scanner.c"
 kk35:
 			++KKCURSOR;
-// 307 "scanner.re"
+// 345 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_COMMA;
 			return 0;
 		}
-// 415 "scanner.c"
+// 453 "scanner.c"
 kk37:
 			++KKCURSOR;
-// 312 "scanner.re"
+// 350 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_BRACKET_OPEN;
 			return 0;
 		}
-// 423 "scanner.c"
+// 461 "scanner.c"
 kk39:
 			++KKCURSOR;
-// 317 "scanner.re"
+// 355 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_BRACKET_CLOSE;
 			return 0;
 		}
-// 431 "scanner.c"
+// 469 "scanner.c"
 kk41:
 			++KKCURSOR;
-// 322 "scanner.re"
+// 360 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_SBRACKET_OPEN;
 			return 0;
 		}
-// 439 "scanner.c"
+// 477 "scanner.c"
 kk43:
 			++KKCURSOR;
-// 327 "scanner.re"
+// 365 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_SBRACKET_CLOSE;
 			return 0;
 		}
-// 447 "scanner.c"
+// 485 "scanner.c"
 kk45:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -452,12 +490,12 @@ kk45:
 			default:	goto kk46;
 			}
 kk46:
-// 377 "scanner.re"
+// 415 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_LESS;
 			return 0;
 		}
-// 461 "scanner.c"
+// 499 "scanner.c"
 kk47:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -465,12 +503,12 @@ kk47:
 			default:	goto kk48;
 			}
 kk48:
-// 337 "scanner.re"
+// 375 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_ASSIGN;
 			return 0;
 		}
-// 474 "scanner.c"
+// 512 "scanner.c"
 kk49:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -478,12 +516,12 @@ kk49:
 			default:	goto kk50;
 			}
 kk50:
-// 382 "scanner.re"
+// 420 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_GREATER;
 			return 0;
 		}
-// 487 "scanner.c"
+// 525 "scanner.c"
 kk51:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -491,56 +529,56 @@ kk51:
 			default:	goto kk52;
 			}
 kk52:
-// 372 "scanner.re"
+// 410 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_NOT;
 			return 0;
 		}
-// 500 "scanner.c"
+// 538 "scanner.c"
 kk53:
 			++KKCURSOR;
-// 387 "scanner.re"
+// 425 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_PIPE;
 			return 0;
 		}
-// 508 "scanner.c"
+// 546 "scanner.c"
 kk55:
 			++KKCURSOR;
-// 392 "scanner.re"
+// 430 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_DOUBLECOLON;
 			return 0;
 		}
-// 516 "scanner.c"
+// 554 "scanner.c"
 kk57:
 			++KKCURSOR;
 			kkch = *KKCURSOR;
 			goto kk65;
 kk58:
-// 397 "scanner.re"
+// 435 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_IGNORE;
 			return 0;
 		}
-// 527 "scanner.c"
+// 565 "scanner.c"
 kk59:
 			++KKCURSOR;
-// 402 "scanner.re"
+// 440 "scanner.re"
 			{
 			s->active_line++;
 			token->opcode = PHVOLT_T_IGNORE;
 			return 0;
 		}
-// 536 "scanner.c"
+// 574 "scanner.c"
 kk61:
 			++KKCURSOR;
-// 408 "scanner.re"
+// 446 "scanner.re"
 			{
 			status = PHVOLT_SCANNER_RETCODE_EOF;
 			break;
 		}
-// 544 "scanner.c"
+// 582 "scanner.c"
 kk63:
 			kkch = *++KKCURSOR;
 			goto kk16;
@@ -561,28 +599,28 @@ kk66:
 			default:	goto kk67;
 			}
 kk67:
-// 352 "scanner.re"
+// 390 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_NOTEQUALS;
 			return 0;
 		}
-// 570 "scanner.c"
+// 608 "scanner.c"
 kk68:
 			++KKCURSOR;
-// 367 "scanner.re"
+// 405 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_NOTIDENTICAL;
 			return 0;
 		}
-// 578 "scanner.c"
+// 616 "scanner.c"
 kk70:
 			++KKCURSOR;
-// 342 "scanner.re"
+// 380 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_GREATEREQUAL;
 			return 0;
 		}
-// 586 "scanner.c"
+// 624 "scanner.c"
 kk72:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -590,44 +628,44 @@ kk72:
 			default:	goto kk73;
 			}
 kk73:
-// 347 "scanner.re"
+// 385 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_EQUALS;
 			return 0;
 		}
-// 599 "scanner.c"
+// 637 "scanner.c"
 kk74:
 			++KKCURSOR;
-// 362 "scanner.re"
+// 400 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_IDENTICAL;
 			return 0;
 		}
-// 607 "scanner.c"
+// 645 "scanner.c"
 kk76:
 			++KKCURSOR;
-// 357 "scanner.re"
+// 395 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_NOTEQUALS;
 			return 0;
 		}
-// 615 "scanner.c"
+// 653 "scanner.c"
 kk78:
 			++KKCURSOR;
-// 332 "scanner.re"
+// 370 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_LESSEQUAL;
 			return 0;
 		}
-// 623 "scanner.c"
+// 661 "scanner.c"
 kk80:
 			++KKCURSOR;
-// 297 "scanner.re"
+// 335 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_RANGE;
 			return 0;
 		}
-// 631 "scanner.c"
+// 669 "scanner.c"
 kk82:
 			++KKCURSOR;
 			kkch = *KKCURSOR;
@@ -724,15 +762,15 @@ kk87:
 			}
 kk88:
 			++KKCURSOR;
-// 250 "scanner.re"
+// 288 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_STRING;
-			token->value = estrndup(q, KKCURSOR - q - 1);
+			token->value = q;
 			token->len = KKCURSOR - q - 1;
 			q = KKCURSOR;
 			return 0;
 		}
-// 736 "scanner.c"
+// 774 "scanner.c"
 kk90:
 			++KKCURSOR;
 			kkch = *KKCURSOR;
@@ -752,39 +790,39 @@ kk92:
 			}
 kk93:
 			++KKCURSOR;
-// 243 "scanner.re"
+// 281 "scanner.re"
 			{
 			s->mode = PHVOLT_MODE_RAW;
 			token->opcode = PHVOLT_T_CLOSE_EDELIMITER;
 			return 0;
 		}
-// 762 "scanner.c"
+// 800 "scanner.c"
 kk95:
 			++KKCURSOR;
-// 231 "scanner.re"
+// 269 "scanner.re"
 			{
 			s->mode = PHVOLT_MODE_RAW;
 			token->opcode = PHVOLT_T_CLOSE_DELIMITER;
 			return 0;
 		}
-// 771 "scanner.c"
+// 809 "scanner.c"
 kk97:
 			++KKCURSOR;
-// 237 "scanner.re"
+// 275 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_OPEN_EDELIMITER;
 			return 0;
 		}
-// 780 "scanner.c"
+// 818 "scanner.c"
 kk99:
 			++KKCURSOR;
-// 226 "scanner.re"
+// 264 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_OPEN_DELIMITER;
 			return 0;
 		}
-// 788 "scanner.c"
+// 826 "scanner.c"
 kk101:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -890,13 +928,13 @@ kk106:
 			default:	goto kk107;
 			}
 kk107:
-// 214 "scanner.re"
+// 252 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_DEFINED;
 			return 0;
 		}
-// 900 "scanner.c"
+// 938 "scanner.c"
 kk108:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -988,13 +1026,13 @@ kk111:
 			default:	goto kk112;
 			}
 kk112:
-// 185 "scanner.re"
+// 223 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_BLOCK;
 			return 0;
 		}
-// 998 "scanner.c"
+// 1036 "scanner.c"
 kk113:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -1065,12 +1103,12 @@ kk113:
 			default:	goto kk114;
 			}
 kk114:
-// 180 "scanner.re"
+// 218 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_OR;
 			return 0;
 		}
-// 1074 "scanner.c"
+// 1112 "scanner.c"
 kk115:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1148,12 +1186,12 @@ kk116:
 			default:	goto kk117;
 			}
 kk117:
-// 175 "scanner.re"
+// 213 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_AND;
 			return 0;
 		}
-// 1157 "scanner.c"
+// 1195 "scanner.c"
 kk118:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1238,12 +1276,12 @@ kk120:
 			default:	goto kk121;
 			}
 kk121:
-// 170 "scanner.re"
+// 208 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_TRUE;
 			return 0;
 		}
-// 1247 "scanner.c"
+// 1285 "scanner.c"
 kk122:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1335,12 +1373,12 @@ kk125:
 			default:	goto kk126;
 			}
 kk126:
-// 160 "scanner.re"
+// 198 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_NULL;
 			return 0;
 		}
-// 1344 "scanner.c"
+// 1382 "scanner.c"
 kk127:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -1411,13 +1449,13 @@ kk127:
 			default:	goto kk128;
 			}
 kk128:
-// 208 "scanner.re"
+// 246 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_NOT;
 			return 0;
 		}
-// 1421 "scanner.c"
+// 1459 "scanner.c"
 kk129:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1495,12 +1533,12 @@ kk130:
 			default:	goto kk131;
 			}
 kk131:
-// 155 "scanner.re"
+// 193 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_SET;
 			return 0;
 		}
-// 1504 "scanner.c"
+// 1542 "scanner.c"
 kk132:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1585,13 +1623,13 @@ kk134:
 			default:	goto kk135;
 			}
 kk135:
-// 139 "scanner.re"
+// 177 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_FOR;
 			return 0;
 		}
-// 1595 "scanner.c"
+// 1633 "scanner.c"
 kk136:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1676,12 +1714,12 @@ kk138:
 			default:	goto kk139;
 			}
 kk139:
-// 165 "scanner.re"
+// 203 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_FALSE;
 			return 0;
 		}
-// 1685 "scanner.c"
+// 1723 "scanner.c"
 kk140:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1801,13 +1839,13 @@ kk147:
 			default:	goto kk148;
 			}
 kk148:
-// 196 "scanner.re"
+// 234 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_EXTENDS;
 			return 0;
 		}
-// 1811 "scanner.c"
+// 1849 "scanner.c"
 kk149:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1910,12 +1948,12 @@ kk153:
 			default:	goto kk154;
 			}
 kk154:
-// 134 "scanner.re"
+// 172 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_ENDIF;
 			return 0;
 		}
-// 1919 "scanner.c"
+// 1957 "scanner.c"
 kk155:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -1993,12 +2031,12 @@ kk156:
 			default:	goto kk157;
 			}
 kk157:
-// 145 "scanner.re"
+// 183 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_ENDFOR;
 			return 0;
 		}
-// 2002 "scanner.c"
+// 2040 "scanner.c"
 kk158:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -2090,12 +2128,12 @@ kk161:
 			default:	goto kk162;
 			}
 kk162:
-// 191 "scanner.re"
+// 229 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_ENDBLOCK;
 			return 0;
 		}
-// 2099 "scanner.c"
+// 2137 "scanner.c"
 kk163:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -2173,12 +2211,12 @@ kk164:
 			default:	goto kk165;
 			}
 kk165:
-// 129 "scanner.re"
+// 167 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_ELSE;
 			return 0;
 		}
-// 2182 "scanner.c"
+// 2220 "scanner.c"
 kk166:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -2249,13 +2287,13 @@ kk166:
 			default:	goto kk167;
 			}
 kk167:
-// 123 "scanner.re"
+// 161 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_IF;
 			return 0;
 		}
-// 2259 "scanner.c"
+// 2297 "scanner.c"
 kk168:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -2326,12 +2364,12 @@ kk168:
 			default:	goto kk169;
 			}
 kk169:
-// 150 "scanner.re"
+// 188 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_IN;
 			return 0;
 		}
-// 2335 "scanner.c"
+// 2373 "scanner.c"
 kk170:
 			++KKCURSOR;
 			switch ((kkch = *KKCURSOR)) {
@@ -2402,13 +2440,13 @@ kk170:
 			default:	goto kk171;
 			}
 kk171:
-// 202 "scanner.re"
+// 240 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_IS;
 			return 0;
 		}
-// 2412 "scanner.c"
+// 2450 "scanner.c"
 kk172:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -2507,13 +2545,13 @@ kk176:
 			default:	goto kk177;
 			}
 kk177:
-// 220 "scanner.re"
+// 258 "scanner.re"
 			{
 			s->statement_position++;
 			token->opcode = PHVOLT_T_INCLUDE;
 			return 0;
 		}
-// 2517 "scanner.c"
+// 2555 "scanner.c"
 kk178:
 			kkch = *++KKCURSOR;
 			switch (kkch) {
@@ -2565,17 +2603,17 @@ kk181:
 			default:	goto kk183;
 			}
 kk183:
-// 115 "scanner.re"
+// 153 "scanner.re"
 			{
 			token->opcode = PHVOLT_T_DOUBLE;
-			token->value = estrndup(start, KKCURSOR - start);
+			token->value = start;
 			token->len = KKCURSOR - start;
 			q = KKCURSOR;
 			return 0;
 		}
-// 2577 "scanner.c"
+// 2615 "scanner.c"
 		}
-// 418 "scanner.re"
+// 456 "scanner.re"
 
 
 		}
@@ -124,12 +124,13 @@ typedef struct _phvolt_scanner_state {
 	unsigned int statement_position;
 	unsigned int extends_mode;
 	unsigned int block_level;
+	char *raw_fragment;
 	char *raw_buffer;
 	unsigned int raw_buffer_cursor;
 	unsigned int raw_buffer_size;
 } phvolt_scanner_state;
 
-/* extra information tokens */
+/* extra information tokens, values point to the view code and they're not NUL terminated */
 typedef struct _phvolt_scanner_token {
 	int opcode;
 	char *value;
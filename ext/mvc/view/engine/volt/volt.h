@@ -17,6 +17,7 @@
   +------------------------------------------------------------------------+
 */
 
+/** Tokens point to the view code or to the raw buffer of the scanner, they're not NUL terminated */
 typedef struct _phvolt_parser_token {
 	int opcode;
 	char *token;
@@ -24,12 +25,22 @@ typedef struct _phvolt_parser_token {
 	int free_flag;
 } phvolt_parser_token;
 
+/** Tokens per block of the Volt parser arena, the first block lives on the stack */
+#define PHVOLT_ARENA_SIZE 64
+
+typedef struct _phvolt_token_arena {
+	phvolt_parser_token tokens[PHVOLT_ARENA_SIZE];
+	int used;
+	struct _phvolt_token_arena *prev;
+} phvolt_token_arena;
+
 typedef struct _phvolt_parser_status {
 	int status;
 	zval *ret;
 	phvolt_scanner_state *scanner_state;
 	char *syntax_error;
 	zend_uint syntax_error_len;
+	phvolt_token_arena *arena;
 } phvolt_parser_status;
 
 #define PHVOLT_PARSING_OK 1
@@ -37,3 +48,4 @@ typedef struct _phvolt_parser_status {
 
 extern int phvolt_parse_view(zval *result, zval *view_code TSRMLS_DC);
 extern int phvolt_internal_parse_view(zval **result, char *view_code, unsigned int view_length, zval **error_msg TSRMLS_DC);
+extern int phvolt_optimize_view(zval *intermediate TSRMLS_DC);
@@ -21,8 +21,11 @@ extern zend_class_entry *phalcon_config_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Config);
 
+void phalcon_config_import(zval *object, zval *array_config TSRMLS_DC);
+
 PHP_METHOD(Phalcon_Config, __construct);
 PHP_METHOD(Phalcon_Config, __set_state);
+PHP_METHOD(Phalcon_Config, toArray);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_config___construct, 0, 0, 0)
 	ZEND_ARG_INFO(0, arrayConfig)
@@ -35,6 +38,7 @@ ZEND_END_ARG_INFO()
 PHALCON_INIT_FUNCS(phalcon_config_method_entry){
 	PHP_ME(Phalcon_Config, __construct, arginfo_phalcon_config___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
 	PHP_ME(Phalcon_Config, __set_state, arginfo_phalcon_config___set_state, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC) 
+	PHP_ME(Phalcon_Config, toArray, NULL, ZEND_ACC_PUBLIC) 
 	PHP_FE_END
 };
 
@@ -22,6 +22,7 @@
 #endif
 
 #include "php.h"
+#include "php_ini.h"
 #include "php_phalcon.h"
 #include "phalcon.h"
 
@@ -31,6 +32,8 @@
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
+#include "kernel/persistent.h"
+#include "kernel/trace.h"
 
 
 zend_class_entry *phalcon_tag_ce;
@@ -95,6 +98,7 @@ zend_class_entry *phalcon_session_exception_ce;
 zend_class_entry *phalcon_session_baginterface_ce;
 zend_class_entry *phalcon_session_adapterinterface_ce;
 zend_class_entry *phalcon_session_adapter_files_ce;
+zend_class_entry *phalcon_session_adapter_memcache_ce;
 zend_class_entry *phalcon_filter_ce;
 zend_class_entry *phalcon_di_service_ce;
 zend_class_entry *phalcon_di_exception_ce;
@@ -109,6 +113,7 @@ zend_class_entry *phalcon_filter_exception_ce;
 zend_class_entry *phalcon_dispatcher_ce;
 zend_class_entry *phalcon_dispatcherinterface_ce;
 zend_class_entry *phalcon_cli_task_ce;
+zend_class_entry *phalcon_cli_task_volt_ce;
 zend_class_entry *phalcon_flash_ce;
 zend_class_entry *phalcon_flash_direct_ce;
 zend_class_entry *phalcon_flashinterface_ce;
@@ -136,6 +141,7 @@ zend_class_entry *phalcon_translate_adapter_ce;
 zend_class_entry *phalcon_translate_exception_ce;
 zend_class_entry *phalcon_translate_adapterinterface_ce;
 zend_class_entry *phalcon_translate_adapter_nativearray_ce;
+zend_class_entry *phalcon_translate_adapter_gettext_ce;
 zend_class_entry *phalcon_escaper_ce;
 zend_class_entry *phalcon_escaperinterface_ce;
 zend_class_entry *phalcon_escaper_exception_ce;
@@ -237,6 +243,19 @@ zend_class_entry *phalcon_exception_ce;
 
 ZEND_DECLARE_MODULE_GLOBALS(phalcon)
 
+/**
+ * phalcon.trace.enabled wraps the traced methods when the module starts, it can't be changed later.
+ * One of every phalcon.trace.sampling requests is traced, its timeline is written to the
+ * phalcon.trace.output directory as a Chrome trace. Spans keep the start of the SQL/URIs they
+ * trace, so the directory can only be set in php.ini and nothing is traced until it is
+ */
+PHP_INI_BEGIN()
+	STD_PHP_INI_BOOLEAN("phalcon.trace.enabled", "0", PHP_INI_SYSTEM, OnUpdateBool, trace_enabled, zend_phalcon_globals, phalcon_globals)
+	STD_PHP_INI_ENTRY("phalcon.trace.sampling", "100", PHP_INI_ALL, OnUpdateLong, trace_sampling, zend_phalcon_globals, phalcon_globals)
+	STD_PHP_INI_ENTRY("phalcon.trace.max_spans", PHALCON_TRACE_MAX_SPANS, PHP_INI_ALL, OnUpdateLong, trace_max_spans, zend_phalcon_globals, phalcon_globals)
+	STD_PHP_INI_ENTRY("phalcon.trace.output", NULL, PHP_INI_SYSTEM, OnUpdateString, trace_output, zend_phalcon_globals, phalcon_globals)
+PHP_INI_END()
+
 PHP_MINIT_FUNCTION(phalcon){
 
 	if(!zend_ce_serializable){
@@ -261,7 +280,12 @@ PHP_MINIT_FUNCTION(phalcon){
 	}
 
 	/** Init globals */
-	ZEND_INIT_MODULE_GLOBALS(phalcon, php_phalcon_init_globals, NULL);
+	ZEND_INIT_MODULE_GLOBALS(phalcon, php_phalcon_init_globals, php_phalcon_destroy_globals);
+
+	REGISTER_INI_ENTRIES();
+
+	/** Connection pools are kept in the persistent list */
+	phalcon_persistent_startup(module_number);
 
 	PHALCON_INIT(Phalcon_DI_InjectionAwareInterface);
 	PHALCON_INIT(Phalcon_Events_EventsAwareInterface);
@@ -371,6 +395,7 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Session_Bag);
 	PHALCON_INIT(Phalcon_Session_Exception);
 	PHALCON_INIT(Phalcon_Session_Adapter_Files);
+	PHALCON_INIT(Phalcon_Session_Adapter_Memcache);
 	PHALCON_INIT(Phalcon_Filter);
 	PHALCON_INIT(Phalcon_DI_Exception);
 	PHALCON_INIT(Phalcon_DI_FactoryDefault_CLI);
@@ -380,6 +405,7 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Flash_Session);
 	PHALCON_INIT(Phalcon_Flash_Exception);
 	PHALCON_INIT(Phalcon_CLI_Task);
+	PHALCON_INIT(Phalcon_CLI_Task_Volt);
 	PHALCON_INIT(Phalcon_CLI_Console);
 	PHALCON_INIT(Phalcon_CLI_Router);
 	PHALCON_INIT(Phalcon_CLI_Console_Exception);
@@ -397,6 +423,7 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Translate);
 	PHALCON_INIT(Phalcon_Translate_Exception);
 	PHALCON_INIT(Phalcon_Translate_Adapter_NativeArray);
+	PHALCON_INIT(Phalcon_Translate_Adapter_Gettext);
 	PHALCON_INIT(Phalcon_Escaper);
 	PHALCON_INIT(Phalcon_Escaper_Exception);
 	PHALCON_INIT(Phalcon_Http_Request);
@@ -465,18 +492,28 @@ PHP_MINIT_FUNCTION(phalcon){
 	PHALCON_INIT(Phalcon_Events_Manager);
 	PHALCON_INIT(Phalcon_Events_Exception);
 
+	/** The traced methods are wrapped once every class is registered */
+	if (PHALCON_GLOBAL(trace_enabled)) {
+		phalcon_trace_startup(TSRMLS_C);
+	}
+
 	return SUCCESS;
 }
 
 
 PHP_MSHUTDOWN_FUNCTION(phalcon){
+	UNREGISTER_INI_ENTRIES();
 	if (PHALCON_GLOBAL(active_memory) != NULL) {
 		phalcon_clean_shutdown_stack(TSRMLS_C);
 	}
+#ifndef ZTS
+	php_phalcon_destroy_globals(&phalcon_globals TSRMLS_CC);
+#endif
 	return SUCCESS;
 }
 
 PHP_RINIT_FUNCTION(phalcon){
+	phalcon_trace_request_startup(TSRMLS_C);
 	return SUCCESS;
 }
 
@@ -484,6 +521,8 @@ PHP_RSHUTDOWN_FUNCTION(phalcon){
 	if (PHALCON_GLOBAL(active_memory) != NULL) {
 		phalcon_clean_shutdown_stack(TSRMLS_C);
 	}
+	phalcon_persistent_release_all(TSRMLS_C);
+	phalcon_trace_request_shutdown(TSRMLS_C);
 	return SUCCESS;
 }
 
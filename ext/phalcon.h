@@ -125,6 +125,7 @@
 #include "session/bag.h"
 #include "session/exception.h"
 #include "session/adapter/files.h"
+#include "session/adapter/memcache.h"
 #include "filter.h"
 #include "di/exception.h"
 #include "di/factorydefault/cli.h"
@@ -134,6 +135,7 @@
 #include "flash/session.h"
 #include "flash/exception.h"
 #include "cli/task.h"
+#include "cli/task/volt.h"
 #include "cli/console.h"
 #include "cli/router.h"
 #include "cli/console/exception.h"
@@ -151,6 +153,7 @@
 #include "translate.h"
 #include "translate/exception.h"
 #include "translate/adapter/nativearray.h"
+#include "translate/adapter/gettext.h"
 #include "escaper.h"
 #include "escaper/exception.h"
 #include "http/request.h"
@@ -25,6 +25,15 @@
 
 #define PHALCON_MAX_MEMORY_STACK 48
 
+/** Number of parsed Accept-* headers kept per process */
+#define PHALCON_ACCEPT_CACHE_SIZE 16
+
+/** Number of parsed ini files kept per process by Phalcon\Config\Adapter\Ini */
+#define PHALCON_CONFIG_CACHE_SIZE 64
+
+/** Number of gettext catalogs kept per process by Phalcon\Translate\Adapter\Gettext */
+#define PHALCON_TRANSLATE_CACHE_SIZE 16
+
 typedef struct _phalcon_memory_entry {
 	int pointer;
 	zval **addresses[PHALCON_MAX_MEMORY_STACK];
@@ -35,6 +44,20 @@ typedef struct _phalcon_memory_entry {
 ZEND_BEGIN_MODULE_GLOBALS(phalcon)
 	phalcon_memory_entry *start_memory;
 	phalcon_memory_entry *active_memory;
+	struct _phalcon_accept_header *accept_cache[PHALCON_ACCEPT_CACHE_SIZE];
+	HashTable *config_cache;
+	HashTable *translate_cache;
+	zend_bool trace_enabled;
+	long trace_sampling;
+	long trace_max_spans;
+	char *trace_output;
+	zend_bool trace_active;
+	struct _phalcon_trace_span *trace_spans;
+	unsigned int trace_count;
+	unsigned int trace_size;
+	unsigned int trace_depth;
+	unsigned long trace_dropped;
+	double trace_start;
 #ifndef PHALCON_RELEASE
 	unsigned int phalcon_stack_stats;
 	unsigned int phalcon_number_grows;
@@ -43,8 +43,90 @@
  * Phalcon\Session\Adapter
  *
  * Base class for Phalcon\Session adapters
+ *
+ * With the "lazy" option the storage is only opened when the session is accessed for the first
+ * time. Reads without a session id don't open it at all and a session nothing was written to is
+ * not saved again at the end of the request. Only set() and remove() mark a lazy session as
+ * changed, values written to $_SESSION directly are discarded by session_abort when nothing else
+ * changed. With the "readOnly" option the session is closed
+ * right after it's read, releasing the lock the storage holds (the files handler locks the session
+ * for the whole request)
+ *
+ *<code>
+ * $session = new Phalcon\Session\Adapter\Files(array('lazy' => true));
+ * $session->start();
+ *</code>
  */
 
+/**
+ * Opens the storage of a lazy session before it's accessed, writes to a started read-only
+ * session throw a Phalcon\Session\Exception
+ */
+void phalcon_session_adapter_open(zval *this_ptr, int write TSRMLS_DC){
+
+	zval *lazy, *started, *opened, *read_only, *session_id;
+	zval *session_name, *g0 = NULL;
+	int has_id;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(started);
+	phalcon_read_property(&started, this_ptr, SL("_started"), PH_NOISY_CC);
+	
+	/** 
+	 * Read-only sessions are already closed, lazy or not, writes would be lost
+	 */
+	PHALCON_INIT_VAR(read_only);
+	phalcon_read_property(&read_only, this_ptr, SL("_readOnly"), PH_NOISY_CC);
+	if (write && zend_is_true(started) && zend_is_true(read_only)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_session_exception_ce, "The session was started in read-only mode");
+		return;
+	}
+	
+	PHALCON_INIT_VAR(lazy);
+	phalcon_read_property(&lazy, this_ptr, SL("_lazy"), PH_NOISY_CC);
+	if (!zend_is_true(lazy) || !zend_is_true(started)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(opened);
+	phalcon_read_property(&opened, this_ptr, SL("_opened"), PH_NOISY_CC);
+	if (zend_is_true(opened)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	/** 
+	 * Without a session id there is nothing to read, the storage is not opened until something
+	 * is written
+	 */
+	if (!write) {
+		PHALCON_INIT_VAR(session_id);
+		PHALCON_CALL_FUNC(session_id, "session_id");
+		has_id = zend_is_true(session_id);
+		if (!has_id) {
+			PHALCON_INIT_VAR(session_name);
+			PHALCON_CALL_FUNC(session_name, "session_name");
+			phalcon_get_global(&g0, SL("_COOKIE")+1 TSRMLS_CC);
+			has_id = phalcon_array_isset(g0, session_name);
+		}
+		if (!has_id) {
+			PHALCON_MM_RESTORE();
+			return;
+		}
+	}
+	
+	PHALCON_CALL_FUNC_NORETURN("session_start");
+	phalcon_update_property_bool(this_ptr, SL("_opened"), 1 TSRMLS_CC);
+	
+	if (zend_is_true(read_only)) {
+		PHALCON_CALL_FUNC_NORETURN("session_write_close");
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
 
 /**
  * Phalcon\Session\Adapter initializer
@@ -56,6 +138,10 @@ PHALCON_INIT_CLASS(Phalcon_Session_Adapter){
 	zend_declare_property_null(phalcon_session_adapter_ce, SL("_uniqueId"), ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_bool(phalcon_session_adapter_ce, SL("_started"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 	zend_declare_property_null(phalcon_session_adapter_ce, SL("_options"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_session_adapter_ce, SL("_lazy"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_session_adapter_ce, SL("_readOnly"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_session_adapter_ce, SL("_opened"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_session_adapter_ce, SL("_dirty"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
 
 	return SUCCESS;
 }
@@ -88,21 +174,37 @@ PHP_METHOD(Phalcon_Session_Adapter, __construct){
 }
 
 /**
- * Starts session, optionally using an adapter
+ * Starts session, optionally using an adapter. Lazy sessions are opened when they're accessed
  *
  * @param array $options
  */
 PHP_METHOD(Phalcon_Session_Adapter, start){
 
-	zval *headers_sent;
+	zval *headers_sent, *lazy, *read_only;
 
 	PHALCON_MM_GROW();
 
 	PHALCON_INIT_VAR(headers_sent);
 	PHALCON_CALL_FUNC(headers_sent, "headers_sent");
 	if (PHALCON_IS_FALSE(headers_sent)) {
-		PHALCON_CALL_FUNC_NORETURN("session_start");
 		phalcon_update_property_bool(this_ptr, SL("_started"), 1 TSRMLS_CC);
+	
+		PHALCON_INIT_VAR(lazy);
+		phalcon_read_property(&lazy, this_ptr, SL("_lazy"), PH_NOISY_CC);
+		if (!zend_is_true(lazy)) {
+			PHALCON_CALL_FUNC_NORETURN("session_start");
+			phalcon_update_property_bool(this_ptr, SL("_opened"), 1 TSRMLS_CC);
+	
+			/** 
+			 * Read-only sessions release the lock right after the data is read
+			 */
+			PHALCON_INIT_VAR(read_only);
+			phalcon_read_property(&read_only, this_ptr, SL("_readOnly"), PH_NOISY_CC);
+			if (zend_is_true(read_only)) {
+				PHALCON_CALL_FUNC_NORETURN("session_write_close");
+			}
+		}
+	
 		PHALCON_MM_RESTORE();
 		RETURN_TRUE;
 	}
@@ -118,7 +220,7 @@ PHP_METHOD(Phalcon_Session_Adapter, start){
  */
 PHP_METHOD(Phalcon_Session_Adapter, setOptions){
 
-	zval *options, *unique_id;
+	zval *options, *unique_id, *lazy, *read_only;
 	int eval_int;
 
 	PHALCON_MM_GROW();
@@ -135,6 +237,20 @@ PHP_METHOD(Phalcon_Session_Adapter, setOptions){
 			phalcon_array_fetch_string(&unique_id, options, SL("uniqueId"), PH_NOISY_CC);
 			phalcon_update_property_zval(this_ptr, SL("_uniqueId"), unique_id TSRMLS_CC);
 		}
+	
+		eval_int = phalcon_array_isset_string(options, SS("lazy"));
+		if (eval_int) {
+			PHALCON_INIT_VAR(lazy);
+			phalcon_array_fetch_string(&lazy, options, SL("lazy"), PH_NOISY_CC);
+			phalcon_update_property_bool(this_ptr, SL("_lazy"), zend_is_true(lazy) TSRMLS_CC);
+		}
+	
+		eval_int = phalcon_array_isset_string(options, SS("readOnly"));
+		if (eval_int) {
+			PHALCON_INIT_VAR(read_only);
+			phalcon_array_fetch_string(&read_only, options, SL("readOnly"), PH_NOISY_CC);
+			phalcon_update_property_bool(this_ptr, SL("_readOnly"), zend_is_true(read_only) TSRMLS_CC);
+		}
 		phalcon_update_property_zval(this_ptr, SL("_options"), options TSRMLS_CC);
 	} else {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_session_exception_ce, "Options must be an Array");
@@ -179,6 +295,12 @@ PHP_METHOD(Phalcon_Session_Adapter, get){
 		RETURN_NULL();
 	}
 
+	phalcon_session_adapter_open(this_ptr, 0 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	PHALCON_INIT_VAR(unique_id);
 	phalcon_read_property(&unique_id, this_ptr, SL("_uniqueId"), PH_NOISY_CC);
 	
@@ -215,6 +337,12 @@ PHP_METHOD(Phalcon_Session_Adapter, set){
 		RETURN_NULL();
 	}
 
+	phalcon_session_adapter_open(this_ptr, 1 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	PHALCON_INIT_VAR(unique_id);
 	phalcon_read_property(&unique_id, this_ptr, SL("_uniqueId"), PH_NOISY_CC);
 	
@@ -222,6 +350,7 @@ PHP_METHOD(Phalcon_Session_Adapter, set){
 	PHALCON_CONCAT_VV(key, unique_id, index);
 	phalcon_get_global(&g0, SL("_SESSION")+1 TSRMLS_CC);
 	phalcon_array_update_zval(&g0, key, &value, PH_COPY TSRMLS_CC);
+	phalcon_update_property_bool(this_ptr, SL("_dirty"), 1 TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -244,6 +373,12 @@ PHP_METHOD(Phalcon_Session_Adapter, has){
 		RETURN_NULL();
 	}
 
+	phalcon_session_adapter_open(this_ptr, 0 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	PHALCON_INIT_VAR(unique_id);
 	phalcon_read_property(&unique_id, this_ptr, SL("_uniqueId"), PH_NOISY_CC);
 	
@@ -277,6 +412,12 @@ PHP_METHOD(Phalcon_Session_Adapter, remove){
 		RETURN_NULL();
 	}
 
+	phalcon_session_adapter_open(this_ptr, 1 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	PHALCON_INIT_VAR(unique_id);
 	phalcon_read_property(&unique_id, this_ptr, SL("_uniqueId"), PH_NOISY_CC);
 	
@@ -284,6 +425,7 @@ PHP_METHOD(Phalcon_Session_Adapter, remove){
 	PHALCON_CONCAT_VV(key, unique_id, index);
 	phalcon_get_global(&g0, SL("_SESSION")+1 TSRMLS_CC);
 	phalcon_array_unset(g0, key);
+	phalcon_update_property_bool(this_ptr, SL("_dirty"), 1 TSRMLS_CC);
 	
 	PHALCON_MM_RESTORE();
 }
@@ -333,10 +475,107 @@ PHP_METHOD(Phalcon_Session_Adapter, destroy){
 
 	PHALCON_MM_GROW();
 
+	phalcon_session_adapter_open(this_ptr, 1 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
 	PHALCON_INIT_VAR(destroyed);
 	PHALCON_CALL_FUNC(destroyed, "session_destroy");
 	phalcon_update_property_bool(this_ptr, SL("_started"), 0 TSRMLS_CC);
+	phalcon_update_property_bool(this_ptr, SL("_opened"), 0 TSRMLS_CC);
+	phalcon_update_property_bool(this_ptr, SL("_dirty"), 0 TSRMLS_CC);
 	
 	RETURN_CCTOR(destroyed);
 }
 
+/**
+ * Check whether the session is in read-only mode
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter, isReadOnly){
+
+
+	RETURN_MEMBER(this_ptr, "_readOnly");
+}
+
+/**
+ * Check whether something was written to the session through the adapter
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter, isDirty){
+
+
+	RETURN_MEMBER(this_ptr, "_dirty");
+}
+
+/**
+ * Ends the session. A lazy session nothing was written to is discarded instead of being saved
+ * again (this requires session_abort, available since PHP 5.6), including direct writes to $_SESSION
+ */
+PHP_METHOD(Phalcon_Session_Adapter, close){
+
+	zval *opened, *read_only, *lazy, *dirty;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(opened);
+	phalcon_read_property(&opened, this_ptr, SL("_opened"), PH_NOISY_CC);
+	if (!zend_is_true(opened)) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	phalcon_update_property_bool(this_ptr, SL("_opened"), 0 TSRMLS_CC);
+	phalcon_update_property_bool(this_ptr, SL("_started"), 0 TSRMLS_CC);
+	
+	/** 
+	 * Read-only sessions were already closed after they were read
+	 */
+	PHALCON_INIT_VAR(read_only);
+	phalcon_read_property(&read_only, this_ptr, SL("_readOnly"), PH_NOISY_CC);
+	if (zend_is_true(read_only)) {
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	PHALCON_INIT_VAR(lazy);
+	phalcon_read_property(&lazy, this_ptr, SL("_lazy"), PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(dirty);
+	phalcon_read_property(&dirty, this_ptr, SL("_dirty"), PH_NOISY_CC);
+	if (zend_is_true(lazy) && !zend_is_true(dirty)) {
+		if (phalcon_function_exists_ex(SS("session_abort") TSRMLS_CC) == SUCCESS) {
+			PHALCON_CALL_FUNC_NORETURN("session_abort");
+			PHALCON_MM_RESTORE();
+			RETURN_TRUE;
+		}
+	}
+	
+	PHALCON_CALL_FUNC_NORETURN("session_write_close");
+	
+	PHALCON_MM_RESTORE();
+	RETURN_TRUE;
+}
+
+/**
+ * Lazy sessions are closed when the adapter is released, so unchanged sessions are not saved
+ */
+PHP_METHOD(Phalcon_Session_Adapter, __destruct){
+
+	zval *lazy;
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(lazy);
+	phalcon_read_property(&lazy, this_ptr, SL("_lazy"), PH_NOISY_CC);
+	if (zend_is_true(lazy)) {
+		PHALCON_CALL_METHOD_NORETURN(this_ptr, "close", PH_NO_CHECK);
+	}
+	
+	PHALCON_MM_RESTORE();
+}
+
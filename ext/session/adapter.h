@@ -21,6 +21,8 @@ extern zend_class_entry *phalcon_session_adapter_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Session_Adapter);
 
+void phalcon_session_adapter_open(zval *this_ptr, int write TSRMLS_DC);
+
 PHP_METHOD(Phalcon_Session_Adapter, __construct);
 PHP_METHOD(Phalcon_Session_Adapter, start);
 PHP_METHOD(Phalcon_Session_Adapter, setOptions);
@@ -32,6 +34,10 @@ PHP_METHOD(Phalcon_Session_Adapter, remove);
 PHP_METHOD(Phalcon_Session_Adapter, getId);
 PHP_METHOD(Phalcon_Session_Adapter, isStarted);
 PHP_METHOD(Phalcon_Session_Adapter, destroy);
+PHP_METHOD(Phalcon_Session_Adapter, isReadOnly);
+PHP_METHOD(Phalcon_Session_Adapter, isDirty);
+PHP_METHOD(Phalcon_Session_Adapter, close);
+PHP_METHOD(Phalcon_Session_Adapter, __destruct);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter___construct, 0, 0, 0)
 	ZEND_ARG_INFO(0, options)
@@ -70,6 +76,10 @@ PHALCON_INIT_FUNCS(phalcon_session_adapter_method_entry){
 	PHP_ME(Phalcon_Session_Adapter, getId, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Session_Adapter, isStarted, NULL, ZEND_ACC_PUBLIC) 
 	PHP_ME(Phalcon_Session_Adapter, destroy, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter, isReadOnly, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter, isDirty, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter, close, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter, __destruct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_DTOR) 
 	PHP_FE_END
 };
 
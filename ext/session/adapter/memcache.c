@@ -0,0 +1,1454 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/fcall.h"
+#include "kernel/object.h"
+#include "kernel/array.h"
+#include "kernel/exception.h"
+#include "kernel/concat.h"
+#include "kernel/operators.h"
+
+#include "main/php_streams.h"
+#include "ext/standard/php_smart_str.h"
+#include "ext/standard/php_var.h"
+#include "ext/standard/md5.h"
+
+/**
+ * Phalcon\Session\Adapter\Memcache
+ *
+ * This adapter stores sessions in memcached or in any local daemon that speaks the memcached
+ * text protocol, over TCP or a UNIX socket. The connection is persistent, it's reused by the
+ * following requests served by the same process
+ *
+ * Values stored with set() are kept in their own items, each one is written with a single
+ * command and can have its own lifetime, so requests changing different values of the same
+ * session don't have to wait on a session lock. $_SESSION is stored as one more item and is only
+ * written again when it changed
+ *
+ * Values stored without their own lifetime live as long as the session is used, their keys are
+ * listed in another item and their lifetime is renewed every time the session is written. Values
+ * stored with a lifetime expire that many seconds after they were written
+ *
+ *<code>
+ * $session = new Phalcon\Session\Adapter\Memcache(array(
+ *    'host' => '/var/run/memcached.sock',
+ *    'lifetime' => 3600,
+ *    'compact' => true
+ * ));
+ * $session->start();
+ *
+ * $session->set('cart', $items, 600);
+ *</code>
+ */
+
+/**
+ * Item flags, the encoding of each item is stored with it
+ */
+#define PHALCON_SESSION_MEMCACHE_RAW 0
+#define PHALCON_SESSION_MEMCACHE_SERIALIZED 1
+#define PHALCON_SESSION_MEMCACHE_COMPACT 2
+
+#define PHALCON_SESSION_MEMCACHE_MAX_KEY 250
+#define PHALCON_SESSION_MEMCACHE_MAX_LINE 512
+#define PHALCON_SESSION_MEMCACHE_MAX_DEPTH 64
+
+/**
+ * Phalcon\Session\Adapter\Memcache initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Session_Adapter_Memcache){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\Session\\Adapter, Memcache, session_adapter_memcache, "phalcon\\session\\adapter", phalcon_session_adapter_memcache_method_entry, 0);
+
+	zend_declare_property_null(phalcon_session_adapter_memcache_ce, SL("_address"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_session_adapter_memcache_ce, SL("_stream"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_double(phalcon_session_adapter_memcache_ce, SL("_timeout"), 1, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_string(phalcon_session_adapter_memcache_ce, SL("_prefix"), "phs_", ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_long(phalcon_session_adapter_memcache_ce, SL("_lifetime"), 1440, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_bool(phalcon_session_adapter_memcache_ce, SL("_compact"), 0, ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_session_adapter_memcache_ce, SL("_namespace"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_session_adapter_memcache_ce, SL("_namespaceId"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_session_adapter_memcache_ce, SL("_data"), ZEND_ACC_PROTECTED TSRMLS_CC);
+	zend_declare_property_null(phalcon_session_adapter_memcache_ce, SL("_keys"), ZEND_ACC_PROTECTED TSRMLS_CC);
+
+	zend_class_implements(phalcon_session_adapter_memcache_ce TSRMLS_CC, 1, phalcon_session_adapterinterface_ce);
+
+	return SUCCESS;
+}
+
+/**
+ * Drops a broken connection and throws an exception, a persistent connection left in the middle
+ * of a response would be reused by the next request otherwise
+ */
+static void phalcon_session_memcache_fail(zval *object, php_stream *stream, const char *message TSRMLS_DC){
+
+	zval *null_value;
+
+	if (stream) {
+		php_stream_free(stream, PHP_STREAM_FREE_CLOSE_PERSISTENT);
+	}
+
+	MAKE_STD_ZVAL(null_value);
+	ZVAL_NULL(null_value);
+	zend_update_property(phalcon_session_adapter_memcache_ce, object, SL("_stream"), null_value TSRMLS_CC);
+	zval_ptr_dtor(&null_value);
+
+	zend_throw_exception_ex(phalcon_session_exception_ce, 0 TSRMLS_CC, "%s", message);
+}
+
+/**
+ * Returns the connection to the storage, connecting the first time it's used
+ */
+static php_stream *phalcon_session_memcache_stream(zval *object TSRMLS_DC){
+
+	zval *stream_zval, *address, *timeout, *resource;
+	php_stream *stream = NULL;
+	struct timeval tv;
+	double seconds;
+	char *persistent_id, *error_string = NULL;
+	int error_code = 0;
+
+	stream_zval = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_stream"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(stream_zval) == IS_RESOURCE) {
+		php_stream_from_zval_no_verify(stream, &stream_zval);
+		if (stream) {
+			return stream;
+		}
+	}
+
+	address = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_address"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(address) != IS_STRING) {
+		zend_throw_exception_ex(phalcon_session_exception_ce, 0 TSRMLS_CC, "The session storage address is not valid");
+		return NULL;
+	}
+
+	timeout = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_timeout"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(timeout) == IS_DOUBLE) {
+		seconds = Z_DVAL_P(timeout);
+	} else {
+		seconds = (double) phalcon_get_intval(timeout);
+	}
+	tv.tv_sec = (long) seconds;
+	tv.tv_usec = (long) ((seconds - tv.tv_sec) * 1000000);
+
+	spprintf(&persistent_id, 0, "phalcon_session_memcache:%s", Z_STRVAL_P(address));
+	stream = php_stream_xport_create(Z_STRVAL_P(address), Z_STRLEN_P(address), REPORT_ERRORS, STREAM_XPORT_CLIENT | STREAM_XPORT_CONNECT, persistent_id, &tv, NULL, &error_string, &error_code);
+	efree(persistent_id);
+
+	if (!stream) {
+		zend_throw_exception_ex(phalcon_session_exception_ce, 0 TSRMLS_CC, "Cannot connect to the session storage at %s: %s", Z_STRVAL_P(address), error_string ? error_string : "unknown error");
+		if (error_string) {
+			efree(error_string);
+		}
+		return NULL;
+	}
+
+	if (error_string) {
+		efree(error_string);
+	}
+
+	php_stream_set_option(stream, PHP_STREAM_OPTION_READ_TIMEOUT, 0, &tv);
+
+	MAKE_STD_ZVAL(resource);
+	php_stream_to_zval(stream, resource);
+	zend_update_property(phalcon_session_adapter_memcache_ce, object, SL("_stream"), resource TSRMLS_CC);
+	zval_ptr_dtor(&resource);
+
+	return stream;
+}
+
+/**
+ * Reads a response line without the line terminator
+ */
+static int phalcon_session_memcache_line(php_stream *stream, char *line, size_t *length TSRMLS_DC){
+
+	if (!php_stream_get_line(stream, line, PHALCON_SESSION_MEMCACHE_MAX_LINE, length)) {
+		return FAILURE;
+	}
+
+	while (*length && (line[*length - 1] == '\n' || line[*length - 1] == '\r')) {
+		line[--(*length)] = '\0';
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Sends a command and reads the response line, returns 1 if the response is the expected one,
+ * 0 for any other valid response and -1 when the connection failed (an exception is thrown)
+ */
+static int phalcon_session_memcache_command(zval *object, smart_str *command, const char *expected TSRMLS_DC){
+
+	php_stream *stream;
+	char line[PHALCON_SESSION_MEMCACHE_MAX_LINE];
+	size_t length;
+
+	stream = phalcon_session_memcache_stream(object TSRMLS_CC);
+	if (!stream) {
+		return -1;
+	}
+
+	if (php_stream_write(stream, command->c, command->len) != command->len || phalcon_session_memcache_line(stream, line, &length TSRMLS_CC) == FAILURE) {
+		phalcon_session_memcache_fail(object, stream, "The session storage is not responding" TSRMLS_CC);
+		return -1;
+	}
+
+	if (!strcmp(line, expected)) {
+		return 1;
+	}
+
+	if (!strncmp(line, "ERROR", 5) || !strncmp(line, "CLIENT_ERROR", 12) || !strncmp(line, "SERVER_ERROR", 12)) {
+		phalcon_session_memcache_fail(object, stream, "The session storage rejected the command" TSRMLS_CC);
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * Fetches an item, returns 1 when it was found, 0 when it doesn't exist and -1 on errors
+ */
+static int phalcon_session_memcache_fetch(zval *object, const char *key, unsigned int key_length, char **data, unsigned int *data_length, long *flags TSRMLS_DC){
+
+	php_stream *stream;
+	smart_str command = { NULL, 0, 0 };
+	char line[PHALCON_SESSION_MEMCACHE_MAX_LINE], *value;
+	size_t length, received, chunk;
+	unsigned long bytes;
+
+	stream = phalcon_session_memcache_stream(object TSRMLS_CC);
+	if (!stream) {
+		return -1;
+	}
+
+	smart_str_appendl(&command, "get ", 4);
+	smart_str_appendl(&command, key, key_length);
+	smart_str_appendl(&command, "\r\n", 2);
+
+	if (php_stream_write(stream, command.c, command.len) != command.len) {
+		smart_str_free(&command);
+		phalcon_session_memcache_fail(object, stream, "The session storage is not responding" TSRMLS_CC);
+		return -1;
+	}
+	smart_str_free(&command);
+
+	if (phalcon_session_memcache_line(stream, line, &length TSRMLS_CC) == FAILURE) {
+		phalcon_session_memcache_fail(object, stream, "The session storage is not responding" TSRMLS_CC);
+		return -1;
+	}
+
+	if (!strcmp(line, "END")) {
+		return 0;
+	}
+
+	/** 
+	 * VALUE <key> <flags> <bytes>
+	 */
+	if (strncmp(line, "VALUE ", 6) || length < 6 + key_length + 4 || sscanf(line + 6 + key_length, " %ld %lu", flags, &bytes) != 2) {
+		phalcon_session_memcache_fail(object, stream, "Invalid response from the session storage" TSRMLS_CC);
+		return -1;
+	}
+
+	value = emalloc(bytes + 1);
+	received = 0;
+	while (received < bytes) {
+		chunk = php_stream_read(stream, value + received, bytes - received);
+		if (!chunk) {
+			efree(value);
+			phalcon_session_memcache_fail(object, stream, "The session storage is not responding" TSRMLS_CC);
+			return -1;
+		}
+		received += chunk;
+	}
+	value[bytes] = '\0';
+
+	/** 
+	 * The data is followed by an empty line and END
+	 */
+	if (phalcon_session_memcache_line(stream, line, &length TSRMLS_CC) == FAILURE || length || phalcon_session_memcache_line(stream, line, &length TSRMLS_CC) == FAILURE || strcmp(line, "END")) {
+		efree(value);
+		phalcon_session_memcache_fail(object, stream, "Invalid response from the session storage" TSRMLS_CC);
+		return -1;
+	}
+
+	*data = value;
+	*data_length = bytes;
+	return 1;
+}
+
+/**
+ * Stores an item with "set" or "add", returns 1 when it was stored
+ */
+static int phalcon_session_memcache_store(zval *object, const char *verb, const char *key, unsigned int key_length, long flags, long lifetime, const char *data, unsigned int data_length TSRMLS_DC){
+
+	smart_str command = { NULL, 0, 0 };
+	int status;
+
+	smart_str_appends(&command, verb);
+	smart_str_appendc(&command, ' ');
+	smart_str_appendl(&command, key, key_length);
+	smart_str_appendc(&command, ' ');
+	smart_str_append_long(&command, flags);
+	smart_str_appendc(&command, ' ');
+	smart_str_append_long(&command, lifetime);
+	smart_str_appendc(&command, ' ');
+	smart_str_append_unsigned(&command, data_length);
+	smart_str_appendl(&command, "\r\n", 2);
+	smart_str_appendl(&command, data, data_length);
+	smart_str_appendl(&command, "\r\n", 2);
+
+	status = phalcon_session_memcache_command(object, &command, "STORED" TSRMLS_CC);
+	smart_str_free(&command);
+
+	return status;
+}
+
+/**
+ * Sends "delete" or "touch" for a key
+ */
+static int phalcon_session_memcache_key_command(zval *object, const char *verb, const char *key, unsigned int key_length, long lifetime, const char *expected TSRMLS_DC){
+
+	smart_str command = { NULL, 0, 0 };
+	int status;
+
+	smart_str_appends(&command, verb);
+	smart_str_appendc(&command, ' ');
+	smart_str_appendl(&command, key, key_length);
+	if (lifetime >= 0) {
+		smart_str_appendc(&command, ' ');
+		smart_str_append_long(&command, lifetime);
+	}
+	smart_str_appendl(&command, "\r\n", 2);
+
+	status = phalcon_session_memcache_command(object, &command, expected TSRMLS_CC);
+	smart_str_free(&command);
+
+	return status;
+}
+
+/**
+ * Builds a key with the prefix, keys memcached doesn't accept (too long, spaces or control
+ * characters) are replaced by their md5
+ */
+static void phalcon_session_memcache_key(smart_str *key, zval *object, const char *id, unsigned int id_length, zval *name_space, zval *index TSRMLS_DC){
+
+	zval *prefix, *unique_id, index_copy;
+	PHP_MD5_CTX context;
+	unsigned char digest[16];
+	char hash[33];
+	unsigned int i, start;
+	int use_copy = 0;
+
+	prefix = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_prefix"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(prefix) == IS_STRING) {
+		smart_str_appendl(key, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix));
+	}
+
+	start = key->len;
+	smart_str_appendl(key, id, id_length);
+
+	if (name_space) {
+		smart_str_appendc(key, '.');
+		smart_str_appendl(key, Z_STRVAL_P(name_space), Z_STRLEN_P(name_space));
+	}
+
+	if (index) {
+		smart_str_appendc(key, '.');
+		unique_id = zend_read_property(phalcon_session_adapter_ce, object, SL("_uniqueId"), 1 TSRMLS_CC);
+		if (Z_TYPE_P(unique_id) == IS_STRING) {
+			smart_str_appendl(key, Z_STRVAL_P(unique_id), Z_STRLEN_P(unique_id));
+		}
+		if (Z_TYPE_P(index) != IS_STRING) {
+			zend_make_printable_zval(index, &index_copy, &use_copy);
+			if (use_copy) {
+				index = &index_copy;
+			}
+		}
+		smart_str_appendl(key, Z_STRVAL_P(index), Z_STRLEN_P(index));
+		if (use_copy) {
+			zval_dtor(&index_copy);
+		}
+	}
+
+	for (i = 0; i < key->len; i++) {
+		if ((unsigned char) key->c[i] <= ' ' || key->c[i] == 127) {
+			break;
+		}
+	}
+
+	if (i < key->len || key->len > PHALCON_SESSION_MEMCACHE_MAX_KEY) {
+		PHP_MD5Init(&context);
+		PHP_MD5Update(&context, key->c + start, key->len - start);
+		PHP_MD5Final(digest, &context);
+		make_digest(hash, digest);
+		key->len = start;
+		smart_str_appendl(key, hash, 32);
+	}
+
+	smart_str_0(key);
+}
+
+/**
+ * Returns the namespace of the items of a session, destroying a session only removes its
+ * namespace item, the values in the old namespace are not reachable anymore and expire
+ */
+static zval *phalcon_session_memcache_namespace(zval *object, const char *id, unsigned int id_length, int create TSRMLS_DC){
+
+	zval *name_space, *namespace_id, *lifetime, *value;
+	smart_str key = { NULL, 0, 0 };
+	char *data, *generated;
+	unsigned int data_length;
+	int status, generated_length;
+	long flags;
+	struct timeval tv;
+
+	name_space = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_namespace"), 1 TSRMLS_CC);
+	namespace_id = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_namespaceId"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(name_space) == IS_STRING && Z_TYPE_P(namespace_id) == IS_STRING) {
+		if (Z_STRLEN_P(namespace_id) == id_length && !memcmp(Z_STRVAL_P(namespace_id), id, id_length)) {
+			return name_space;
+		}
+	}
+
+	phalcon_session_memcache_key(&key, object, id, id_length, NULL, NULL TSRMLS_CC);
+
+	status = phalcon_session_memcache_fetch(object, key.c, key.len, &data, &data_length, &flags TSRMLS_CC);
+	if (status < 0) {
+		smart_str_free(&key);
+		return NULL;
+	}
+
+	if (!status) {
+		if (!create) {
+			smart_str_free(&key);
+			return NULL;
+		}
+
+		gettimeofday(&tv, NULL);
+		generated_length = spprintf(&generated, 0, "%lx%05lx", (long) tv.tv_sec, (long) tv.tv_usec);
+
+		lifetime = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_lifetime"), 1 TSRMLS_CC);
+		status = phalcon_session_memcache_store(object, "add", key.c, key.len, PHALCON_SESSION_MEMCACHE_RAW, phalcon_get_intval(lifetime), generated, generated_length TSRMLS_CC);
+		if (status < 0) {
+			efree(generated);
+			smart_str_free(&key);
+			return NULL;
+		}
+
+		/** 
+		 * Another request created the namespace first
+		 */
+		if (!status) {
+			efree(generated);
+			status = phalcon_session_memcache_fetch(object, key.c, key.len, &generated, &data_length, &flags TSRMLS_CC);
+			if (status <= 0) {
+				smart_str_free(&key);
+				if (!status) {
+					zend_throw_exception_ex(phalcon_session_exception_ce, 0 TSRMLS_CC, "The session namespace could not be created");
+				}
+				return NULL;
+			}
+			generated_length = data_length;
+		}
+
+		data = generated;
+		data_length = generated_length;
+	}
+
+	smart_str_free(&key);
+
+	MAKE_STD_ZVAL(value);
+	ZVAL_STRINGL(value, data, data_length, 0);
+	zend_update_property(phalcon_session_adapter_memcache_ce, object, SL("_namespace"), value TSRMLS_CC);
+	zval_ptr_dtor(&value);
+
+	MAKE_STD_ZVAL(value);
+	ZVAL_STRINGL(value, id, id_length, 1);
+	zend_update_property(phalcon_session_adapter_memcache_ce, object, SL("_namespaceId"), value TSRMLS_CC);
+	zval_ptr_dtor(&value);
+
+	return zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_namespace"), 1 TSRMLS_CC);
+}
+
+/**
+ * Appends an unsigned number in 7-bit groups
+ */
+static void phalcon_session_memcache_varint(smart_str *buffer, unsigned long value){
+
+	while (value >= 0x80) {
+		smart_str_appendc(buffer, (char) ((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	smart_str_appendc(buffer, (char) value);
+}
+
+static int phalcon_session_memcache_read_varint(const unsigned char **cursor, const unsigned char *end, unsigned long *value){
+
+	unsigned int shift = 0;
+
+	*value = 0;
+	while (*cursor < end && shift < sizeof(unsigned long) * 8) {
+		*value |= ((unsigned long) (**cursor & 0x7f)) << shift;
+		if (!(*(*cursor)++ & 0x80)) {
+			return SUCCESS;
+		}
+		shift += 7;
+	}
+
+	return FAILURE;
+}
+
+/**
+ * Compact binary encoding, scalars and arrays are written with a type byte and variable length
+ * numbers, objects are stored serialized
+ *
+ * N null, T true, F false, I integer (zigzag), D double, S string, A array, O serialized object
+ */
+static void phalcon_session_memcache_encode(smart_str *buffer, zval *value, int depth TSRMLS_DC){
+
+	HashTable *ht;
+	HashPosition pos;
+	zval **item;
+	char *key;
+	uint key_length;
+	ulong index;
+	long number;
+	double dval;
+	smart_str serialized = { NULL, 0, 0 };
+	php_serialize_data_t var_hash;
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_BOOL:
+			smart_str_appendc(buffer, Z_BVAL_P(value) ? 'T' : 'F');
+			return;
+
+		case IS_LONG:
+			number = Z_LVAL_P(value);
+			smart_str_appendc(buffer, 'I');
+			phalcon_session_memcache_varint(buffer, ((unsigned long) number << 1) ^ (unsigned long) (number >> (sizeof(long) * 8 - 1)));
+			return;
+
+		case IS_DOUBLE:
+			dval = Z_DVAL_P(value);
+			smart_str_appendc(buffer, 'D');
+			smart_str_appendl(buffer, (const char *) &dval, sizeof(double));
+			return;
+
+		case IS_STRING:
+			smart_str_appendc(buffer, 'S');
+			phalcon_session_memcache_varint(buffer, Z_STRLEN_P(value));
+			smart_str_appendl(buffer, Z_STRVAL_P(value), Z_STRLEN_P(value));
+			return;
+
+		case IS_ARRAY:
+			if (depth < PHALCON_SESSION_MEMCACHE_MAX_DEPTH) {
+				break;
+			}
+			/* no break */
+
+		case IS_OBJECT:
+			PHP_VAR_SERIALIZE_INIT(var_hash);
+			php_var_serialize(&serialized, &value, &var_hash TSRMLS_CC);
+			PHP_VAR_SERIALIZE_DESTROY(var_hash);
+			smart_str_appendc(buffer, 'O');
+			phalcon_session_memcache_varint(buffer, serialized.len);
+			smart_str_appendl(buffer, serialized.c, serialized.len);
+			smart_str_free(&serialized);
+			return;
+
+		default:
+			smart_str_appendc(buffer, 'N');
+			return;
+	}
+
+	ht = Z_ARRVAL_P(value);
+
+	smart_str_appendc(buffer, 'A');
+	phalcon_session_memcache_varint(buffer, zend_hash_num_elements(ht));
+
+	zend_hash_internal_pointer_reset_ex(ht, &pos);
+	while (zend_hash_get_current_data_ex(ht, (void **) &item, &pos) == SUCCESS) {
+
+		if (zend_hash_get_current_key_ex(ht, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+			smart_str_appendc(buffer, 'S');
+			phalcon_session_memcache_varint(buffer, key_length - 1);
+			smart_str_appendl(buffer, key, key_length - 1);
+		} else {
+			number = (long) index;
+			smart_str_appendc(buffer, 'I');
+			phalcon_session_memcache_varint(buffer, ((unsigned long) number << 1) ^ (unsigned long) (number >> (sizeof(long) * 8 - 1)));
+		}
+
+		phalcon_session_memcache_encode(buffer, *item, depth + 1 TSRMLS_CC);
+
+		zend_hash_move_forward_ex(ht, &pos);
+	}
+}
+
+static int phalcon_session_memcache_decode(const unsigned char **cursor, const unsigned char *end, zval *result, int depth TSRMLS_DC){
+
+	unsigned long length, count, number;
+	double dval;
+	zval *item, *key;
+	php_unserialize_data_t var_hash;
+	const unsigned char *start;
+	int status;
+
+	if (*cursor >= end || depth > PHALCON_SESSION_MEMCACHE_MAX_DEPTH) {
+		return FAILURE;
+	}
+
+	switch (*(*cursor)++) {
+
+		case 'N':
+			ZVAL_NULL(result);
+			return SUCCESS;
+
+		case 'T':
+			ZVAL_BOOL(result, 1);
+			return SUCCESS;
+
+		case 'F':
+			ZVAL_BOOL(result, 0);
+			return SUCCESS;
+
+		case 'I':
+			if (phalcon_session_memcache_read_varint(cursor, end, &number) == FAILURE) {
+				return FAILURE;
+			}
+			ZVAL_LONG(result, (long) ((number >> 1) ^ (~(number & 1) + 1)));
+			return SUCCESS;
+
+		case 'D':
+			if ((size_t) (end - *cursor) < sizeof(double)) {
+				return FAILURE;
+			}
+			memcpy(&dval, *cursor, sizeof(double));
+			*cursor += sizeof(double);
+			ZVAL_DOUBLE(result, dval);
+			return SUCCESS;
+
+		case 'S':
+			if (phalcon_session_memcache_read_varint(cursor, end, &length) == FAILURE || (unsigned long) (end - *cursor) < length) {
+				return FAILURE;
+			}
+			ZVAL_STRINGL(result, (char *) *cursor, length, 1);
+			*cursor += length;
+			return SUCCESS;
+
+		case 'O':
+			if (phalcon_session_memcache_read_varint(cursor, end, &length) == FAILURE || (unsigned long) (end - *cursor) < length) {
+				return FAILURE;
+			}
+			start = *cursor;
+			PHP_VAR_UNSERIALIZE_INIT(var_hash);
+			status = php_var_unserialize(&result, &start, *cursor + length, &var_hash TSRMLS_CC);
+			PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+			*cursor += length;
+			return status ? SUCCESS : FAILURE;
+
+		case 'A':
+			if (phalcon_session_memcache_read_varint(cursor, end, &count) == FAILURE || (unsigned long) (end - *cursor) < count) {
+				return FAILURE;
+			}
+			array_init(result);
+			while (count--) {
+
+				MAKE_STD_ZVAL(key);
+				ZVAL_NULL(key);
+				if (phalcon_session_memcache_decode(cursor, end, key, depth + 1 TSRMLS_CC) == FAILURE || (Z_TYPE_P(key) != IS_LONG && Z_TYPE_P(key) != IS_STRING)) {
+					zval_ptr_dtor(&key);
+					return FAILURE;
+				}
+
+				MAKE_STD_ZVAL(item);
+				ZVAL_NULL(item);
+				if (phalcon_session_memcache_decode(cursor, end, item, depth + 1 TSRMLS_CC) == FAILURE) {
+					zval_ptr_dtor(&key);
+					zval_ptr_dtor(&item);
+					return FAILURE;
+				}
+
+				if (Z_TYPE_P(key) == IS_LONG) {
+					zend_hash_index_update(Z_ARRVAL_P(result), Z_LVAL_P(key), &item, sizeof(zval *), NULL);
+				} else {
+					zend_symtable_update(Z_ARRVAL_P(result), Z_STRVAL_P(key), Z_STRLEN_P(key) + 1, &item, sizeof(zval *), NULL);
+				}
+				zval_ptr_dtor(&key);
+			}
+			return SUCCESS;
+	}
+
+	return FAILURE;
+}
+
+/**
+ * Records a key written or removed by this request, keys with "renew" get their lifetime renewed
+ * together with the session
+ */
+static void phalcon_session_memcache_track(zval *object, const char *key, unsigned int key_length, int renew TSRMLS_DC){
+
+	zval *keys, *tracked;
+
+	keys = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_keys"), 1 TSRMLS_CC);
+
+	MAKE_STD_ZVAL(tracked);
+	if (Z_TYPE_P(keys) == IS_ARRAY) {
+		ZVAL_ZVAL(tracked, keys, 1, 0);
+	} else {
+		array_init(tracked);
+	}
+	add_assoc_bool_ex(tracked, key, key_length + 1, renew);
+
+	zend_update_property(phalcon_session_adapter_memcache_ce, object, SL("_keys"), tracked TSRMLS_CC);
+	zval_ptr_dtor(&tracked);
+}
+
+/**
+ * Renews the lifetime of the values stored without their own lifetime. Their keys are listed,
+ * one per line, in an item next to $_SESSION, the keys tracked by this request are merged into
+ * it and keys of values that already expired are dropped
+ */
+static int phalcon_session_memcache_renew(zval *object, const char *id, unsigned int id_length, zval *name_space, long lifetime TSRMLS_DC){
+
+	zval *keys, *list_namespace, **renew;
+	smart_str list_key = { NULL, 0, 0 }, list = { NULL, 0, 0 };
+	HashTable known;
+	HashPosition pos;
+	char *data = NULL, *cursor, *end, *line_end, *key;
+	unsigned int data_length, key_length;
+	ulong index;
+	long flags;
+	int status, changed = 0, dummy = 1;
+
+	MAKE_STD_ZVAL(list_namespace);
+	Z_STRLEN_P(list_namespace) = spprintf(&Z_STRVAL_P(list_namespace), 0, "%s#", Z_STRVAL_P(name_space));
+	Z_TYPE_P(list_namespace) = IS_STRING;
+	phalcon_session_memcache_key(&list_key, object, id, id_length, list_namespace, NULL TSRMLS_CC);
+	zval_ptr_dtor(&list_namespace);
+
+	status = phalcon_session_memcache_fetch(object, list_key.c, list_key.len, &data, &data_length, &flags TSRMLS_CC);
+	if (status < 0) {
+		smart_str_free(&list_key);
+		return -1;
+	}
+
+	zend_hash_init(&known, 8, NULL, NULL, 0);
+
+	if (status == 1) {
+		cursor = data;
+		end = data + data_length;
+		while (cursor < end) {
+			line_end = memchr(cursor, '\n', end - cursor);
+			if (!line_end) {
+				line_end = end;
+			}
+			*line_end = '\0';
+			if (line_end > cursor) {
+				zend_hash_add(&known, cursor, line_end - cursor + 1, &dummy, sizeof(int), NULL);
+			}
+			cursor = line_end + 1;
+		}
+	}
+
+	/** 
+	 * Keys written or removed by this request
+	 */
+	keys = zend_read_property(phalcon_session_adapter_memcache_ce, object, SL("_keys"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(keys) == IS_ARRAY) {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(keys), &pos);
+		while (zend_hash_get_current_data_ex(Z_ARRVAL_P(keys), (void **) &renew, &pos) == SUCCESS) {
+			if (zend_hash_get_current_key_ex(Z_ARRVAL_P(keys), &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+				if (zend_is_true(*renew)) {
+					if (zend_hash_add(&known, key, key_length, &dummy, sizeof(int), NULL) == SUCCESS) {
+						changed = 1;
+					}
+				} else {
+					if (zend_hash_del(&known, key, key_length) == SUCCESS) {
+						changed = 1;
+					}
+				}
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(keys), &pos);
+		}
+		zend_update_property_null(phalcon_session_adapter_memcache_ce, object, SL("_keys") TSRMLS_CC);
+	}
+
+	status = 1;
+	zend_hash_internal_pointer_reset_ex(&known, &pos);
+	while (zend_hash_get_current_key_ex(&known, &key, &key_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+		status = phalcon_session_memcache_key_command(object, "touch", key, key_length - 1, lifetime, "TOUCHED" TSRMLS_CC);
+		if (status < 0) {
+			break;
+		}
+		if (status) {
+			smart_str_appendl(&list, key, key_length - 1);
+			smart_str_appendc(&list, '\n');
+		} else {
+			changed = 1;
+		}
+		zend_hash_move_forward_ex(&known, &pos);
+	}
+
+	if (status >= 0) {
+		if (changed) {
+			if (list.len) {
+				status = phalcon_session_memcache_store(object, "set", list_key.c, list_key.len, PHALCON_SESSION_MEMCACHE_RAW, lifetime, list.c, list.len TSRMLS_CC);
+			} else {
+				status = phalcon_session_memcache_key_command(object, "delete", list_key.c, list_key.len, -1, "DELETED" TSRMLS_CC) < 0 ? -1 : 1;
+			}
+		} else {
+			if (list.len) {
+				status = phalcon_session_memcache_key_command(object, "touch", list_key.c, list_key.len, lifetime, "TOUCHED" TSRMLS_CC);
+			} else {
+				status = 1;
+			}
+		}
+	}
+
+	zend_hash_destroy(&known);
+	smart_str_free(&list);
+	smart_str_free(&list_key);
+	if (data) {
+		efree(data);
+	}
+
+	return status;
+}
+
+/**
+ * Fetches and decodes the value stored for an index, returns 1 when it exists
+ */
+static int phalcon_session_memcache_get_value(zval *object, zval *session_id, zval *index, zval *return_value TSRMLS_DC){
+
+	zval *name_space;
+	smart_str key = { NULL, 0, 0 };
+	char *data;
+	const unsigned char *cursor;
+	unsigned int data_length;
+	long flags;
+	int status;
+	php_unserialize_data_t var_hash;
+
+	if (Z_TYPE_P(session_id) != IS_STRING || !Z_STRLEN_P(session_id)) {
+		return 0;
+	}
+
+	name_space = phalcon_session_memcache_namespace(object, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), 0 TSRMLS_CC);
+	if (!name_space) {
+		return EG(exception) ? -1 : 0;
+	}
+
+	phalcon_session_memcache_key(&key, object, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), name_space, index TSRMLS_CC);
+
+	status = phalcon_session_memcache_fetch(object, key.c, key.len, &data, &data_length, &flags TSRMLS_CC);
+	smart_str_free(&key);
+	if (status <= 0) {
+		return status;
+	}
+
+	if (return_value) {
+		cursor = (const unsigned char *) data;
+		switch (flags) {
+
+			case PHALCON_SESSION_MEMCACHE_COMPACT:
+				if (phalcon_session_memcache_decode(&cursor, cursor + data_length, return_value, 0 TSRMLS_CC) == FAILURE) {
+					zval_dtor(return_value);
+					ZVAL_NULL(return_value);
+				}
+				break;
+
+			case PHALCON_SESSION_MEMCACHE_SERIALIZED:
+				PHP_VAR_UNSERIALIZE_INIT(var_hash);
+				if (!php_var_unserialize(&return_value, &cursor, cursor + data_length, &var_hash TSRMLS_CC)) {
+					zval_dtor(return_value);
+					ZVAL_NULL(return_value);
+				}
+				PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+				break;
+
+			default:
+				ZVAL_STRINGL(return_value, data, data_length, 1);
+				break;
+		}
+	}
+
+	efree(data);
+	return 1;
+}
+
+/**
+ * Phalcon\Session\Adapter\Memcache constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, __construct){
+
+	zval *options = NULL, *host = NULL, *port = NULL, *address = NULL;
+	zval *option = NULL;
+	long lifetime;
+	int eval_int;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|z", &options) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	if (!options) {
+		PHALCON_INIT_NVAR(options);
+		array_init(options);
+	}
+	
+	if (Z_TYPE_P(options) != IS_ARRAY) { 
+		PHALCON_THROW_EXCEPTION_STR(phalcon_session_exception_ce, "Options must be an Array");
+		return;
+	}
+	
+	eval_int = phalcon_array_isset_string(options, SS("host"));
+	if (eval_int) {
+		PHALCON_INIT_VAR(host);
+		phalcon_array_fetch_string(&host, options, SL("host"), PH_NOISY_CC);
+	} else {
+		PHALCON_INIT_VAR(host);
+		ZVAL_STRING(host, "127.0.0.1", 1);
+	}
+	
+	if (Z_TYPE_P(host) != IS_STRING || !Z_STRLEN_P(host)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_session_exception_ce, "The session storage host must be a string");
+		return;
+	}
+	
+	/** 
+	 * Paths are UNIX sockets, addresses with a transport are used as they are
+	 */
+	PHALCON_INIT_VAR(address);
+	if (Z_STRVAL_P(host)[0] == '/') {
+		PHALCON_CONCAT_SV(address, "unix://", host);
+	} else {
+		if (strstr(Z_STRVAL_P(host), "://")) {
+			ZVAL_ZVAL(address, host, 1, 0);
+		} else {
+			eval_int = phalcon_array_isset_string(options, SS("port"));
+			if (eval_int) {
+				PHALCON_INIT_VAR(port);
+				phalcon_array_fetch_string(&port, options, SL("port"), PH_NOISY_CC);
+			} else {
+				PHALCON_INIT_VAR(port);
+				ZVAL_LONG(port, 11211);
+			}
+			PHALCON_CONCAT_SVSV(address, "tcp://", host, ":", port);
+		}
+	}
+	phalcon_update_property_zval(this_ptr, SL("_address"), address TSRMLS_CC);
+	
+	eval_int = phalcon_array_isset_string(options, SS("prefix"));
+	if (eval_int) {
+		PHALCON_INIT_NVAR(option);
+		phalcon_array_fetch_string(&option, options, SL("prefix"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_prefix"), option TSRMLS_CC);
+	}
+	
+	/** 
+	 * The lifetime defaults to session.gc_maxlifetime
+	 */
+	eval_int = phalcon_array_isset_string(options, SS("lifetime"));
+	if (eval_int) {
+		PHALCON_INIT_NVAR(option);
+		phalcon_array_fetch_string(&option, options, SL("lifetime"), PH_NOISY_CC);
+		lifetime = phalcon_get_intval(option);
+	} else {
+		lifetime = INI_INT("session.gc_maxlifetime");
+	}
+	if (lifetime > 0) {
+		phalcon_update_property_long(this_ptr, SL("_lifetime"), lifetime TSRMLS_CC);
+	}
+	
+	eval_int = phalcon_array_isset_string(options, SS("timeout"));
+	if (eval_int) {
+		PHALCON_INIT_NVAR(option);
+		phalcon_array_fetch_string(&option, options, SL("timeout"), PH_NOISY_CC);
+		phalcon_update_property_zval(this_ptr, SL("_timeout"), option TSRMLS_CC);
+	}
+	
+	eval_int = phalcon_array_isset_string(options, SS("compact"));
+	if (eval_int) {
+		PHALCON_INIT_NVAR(option);
+		phalcon_array_fetch_string(&option, options, SL("compact"), PH_NOISY_CC);
+		phalcon_update_property_bool(this_ptr, SL("_compact"), zend_is_true(option) TSRMLS_CC);
+	}
+	
+	PHALCON_CALL_PARENT_PARAMS_1_NORETURN(this_ptr, "Phalcon\\Session\\Adapter\\Memcache", "__construct", options);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Registers the adapter as the session save handler and starts the session
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, start){
+
+	zval *handlers[6], *name = NULL, *shutdown, *started;
+	static const char *methods[6] = { "handlerOpen", "handlerClose", "handlerRead", "handlerWrite", "handlerDestroy", "handlerGc" };
+	int i;
+
+	PHALCON_MM_GROW();
+
+	for (i = 0; i < 6; i++) {
+		PHALCON_INIT_NVAR(name);
+		ZVAL_STRING(name, methods[i], 1);
+	
+		PHALCON_INIT_VAR(handlers[i]);
+		array_init(handlers[i]);
+		phalcon_array_append(&handlers[i], this_ptr, 0 TSRMLS_CC);
+		phalcon_array_append(&handlers[i], name, 0 TSRMLS_CC);
+	}
+	
+	PHALCON_CALL_FUNC_PARAMS_NORETURN("session_set_save_handler", 6, handlers);
+	
+	/** 
+	 * The session has to be written before the adapter is destroyed
+	 */
+	PHALCON_INIT_VAR(shutdown);
+	ZVAL_STRING(shutdown, "session_write_close", 1);
+	PHALCON_CALL_FUNC_PARAMS_1_NORETURN("register_shutdown_function", shutdown);
+	
+	PHALCON_INIT_VAR(started);
+	PHALCON_CALL_PARENT(started, this_ptr, "Phalcon\\Session\\Adapter\\Memcache", "start");
+	
+	RETURN_CCTOR(started);
+}
+
+/**
+ * Gets a session variable from an application context
+ *
+ * @param string $index
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, get){
+
+	zval *index, *session_id;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &index) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	phalcon_session_adapter_open(this_ptr, 0 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(session_id);
+	PHALCON_CALL_FUNC(session_id, "session_id");
+	
+	phalcon_session_memcache_get_value(this_ptr, session_id, index, return_value TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+}
+
+/**
+ * Sets a session variable in an application context, optionally with its own lifetime
+ *
+ * @param string $index
+ * @param mixed $value
+ * @param int $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, set){
+
+	zval *index, *value, *lifetime = NULL, *session_id, *name_space;
+	zval *compact, *serialized, *default_lifetime;
+	smart_str key = { NULL, 0, 0 }, data = { NULL, 0, 0 };
+	long flags, ttl;
+	int status;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz|z", &index, &value, &lifetime) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	phalcon_session_adapter_open(this_ptr, 1 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(session_id);
+	PHALCON_CALL_FUNC(session_id, "session_id");
+	if (Z_TYPE_P(session_id) != IS_STRING || !Z_STRLEN_P(session_id)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_session_exception_ce, "The session must be started before storing values");
+		return;
+	}
+	
+	name_space = phalcon_session_memcache_namespace(this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), 1 TSRMLS_CC);
+	if (!name_space) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(compact);
+	phalcon_read_property(&compact, this_ptr, SL("_compact"), PH_NOISY_CC);
+	if (zend_is_true(compact)) {
+		phalcon_session_memcache_encode(&data, value, 0 TSRMLS_CC);
+		flags = PHALCON_SESSION_MEMCACHE_COMPACT;
+	} else {
+		PHALCON_INIT_VAR(serialized);
+		PHALCON_CALL_FUNC_PARAMS_1(serialized, "serialize", value);
+		smart_str_appendl(&data, Z_STRVAL_P(serialized), Z_STRLEN_P(serialized));
+		flags = PHALCON_SESSION_MEMCACHE_SERIALIZED;
+	}
+	
+	PHALCON_INIT_VAR(default_lifetime);
+	phalcon_read_property(&default_lifetime, this_ptr, SL("_lifetime"), PH_NOISY_CC);
+	if (lifetime && Z_TYPE_P(lifetime) != IS_NULL) {
+		ttl = phalcon_get_intval(lifetime);
+	} else {
+		ttl = phalcon_get_intval(default_lifetime);
+	}
+	
+	phalcon_session_memcache_key(&key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), name_space, index TSRMLS_CC);
+	status = phalcon_session_memcache_store(this_ptr, "set", key.c, key.len, flags, ttl, data.c, data.len TSRMLS_CC);
+	if (status == 1) {
+		phalcon_session_memcache_track(this_ptr, key.c, key.len, !lifetime || Z_TYPE_P(lifetime) == IS_NULL TSRMLS_CC);
+	}
+	smart_str_free(&key);
+	smart_str_free(&data);
+	
+	if (status < 0) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	phalcon_update_property_bool(this_ptr, SL("_dirty"), 1 TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_BOOL(status == 1);
+}
+
+/**
+ * Check whether a session variable is set in an application context
+ *
+ * @param string $index
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, has){
+
+	zval *index, *session_id;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &index) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	phalcon_session_adapter_open(this_ptr, 0 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(session_id);
+	PHALCON_CALL_FUNC(session_id, "session_id");
+	if (phalcon_session_memcache_get_value(this_ptr, session_id, index, NULL TSRMLS_CC) == 1) {
+		PHALCON_MM_RESTORE();
+		RETURN_TRUE;
+	}
+	
+	PHALCON_MM_RESTORE();
+	RETURN_FALSE;
+}
+
+/**
+ * Removes a session variable from an application context
+ *
+ * @param string $index
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, remove){
+
+	zval *index, *session_id, *name_space;
+	smart_str key = { NULL, 0, 0 };
+	int status;
+
+	PHALCON_MM_GROW();
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &index) == FAILURE) {
+		PHALCON_MM_RESTORE();
+		RETURN_NULL();
+	}
+
+	phalcon_session_adapter_open(this_ptr, 1 TSRMLS_CC);
+	if (EG(exception)) {
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(session_id);
+	PHALCON_CALL_FUNC(session_id, "session_id");
+	if (Z_TYPE_P(session_id) != IS_STRING || !Z_STRLEN_P(session_id)) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	name_space = phalcon_session_memcache_namespace(this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), 0 TSRMLS_CC);
+	if (!name_space) {
+		PHALCON_MM_RESTORE();
+		RETURN_FALSE;
+	}
+	
+	phalcon_session_memcache_key(&key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), name_space, index TSRMLS_CC);
+	status = phalcon_session_memcache_key_command(this_ptr, "delete", key.c, key.len, -1, "DELETED" TSRMLS_CC);
+	if (status >= 0) {
+		phalcon_session_memcache_track(this_ptr, key.c, key.len, 0 TSRMLS_CC);
+	}
+	smart_str_free(&key);
+	
+	phalcon_update_property_bool(this_ptr, SL("_dirty"), 1 TSRMLS_CC);
+	
+	PHALCON_MM_RESTORE();
+	RETURN_BOOL(status == 1);
+}
+
+/**
+ * Destroys the active session and all the values stored in it
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, destroy){
+
+	zval *session_id, *destroyed;
+	smart_str key = { NULL, 0, 0 };
+
+	PHALCON_MM_GROW();
+
+	PHALCON_INIT_VAR(session_id);
+	PHALCON_CALL_FUNC(session_id, "session_id");
+	if (Z_TYPE_P(session_id) == IS_STRING && Z_STRLEN_P(session_id)) {
+		phalcon_session_memcache_key(&key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), NULL, NULL TSRMLS_CC);
+		phalcon_session_memcache_key_command(this_ptr, "delete", key.c, key.len, -1, "DELETED" TSRMLS_CC);
+		smart_str_free(&key);
+		if (EG(exception)) {
+			PHALCON_MM_RESTORE();
+			return;
+		}
+	}
+	
+	phalcon_update_property_null(this_ptr, SL("_namespace") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_namespaceId") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_keys") TSRMLS_CC);
+	
+	PHALCON_INIT_VAR(destroyed);
+	PHALCON_CALL_PARENT(destroyed, this_ptr, "Phalcon\\Session\\Adapter\\Memcache", "destroy");
+	
+	RETURN_CCTOR(destroyed);
+}
+
+/**
+ * Save handler: opens the storage
+ *
+ * @param string $savePath
+ * @param string $sessionName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerOpen){
+
+
+	RETURN_TRUE;
+}
+
+/**
+ * Save handler: closes the storage, the connection stays open for the next request
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerClose){
+
+
+	RETURN_TRUE;
+}
+
+/**
+ * Save handler: reads the serialized $_SESSION
+ *
+ * @param string $sessionId
+ * @return string
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerRead){
+
+	zval *session_id, *name_space, *data;
+	smart_str key = { NULL, 0, 0 };
+	char *value;
+	unsigned int value_length;
+	long flags;
+	int status;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &session_id) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	RETVAL_EMPTY_STRING();
+
+	if (Z_TYPE_P(session_id) == IS_STRING) {
+		name_space = phalcon_session_memcache_namespace(this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), 0 TSRMLS_CC);
+		if (name_space) {
+			phalcon_session_memcache_key(&key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), name_space, NULL TSRMLS_CC);
+			status = phalcon_session_memcache_fetch(this_ptr, key.c, key.len, &value, &value_length, &flags TSRMLS_CC);
+			smart_str_free(&key);
+			if (status == 1) {
+				zval_dtor(return_value);
+				ZVAL_STRINGL(return_value, value, value_length, 0);
+			}
+		}
+	}
+
+	/** 
+	 * The data read is kept to know if it changed when it's written
+	 */
+	MAKE_STD_ZVAL(data);
+	ZVAL_ZVAL(data, return_value, 1, 0);
+	zend_update_property(phalcon_session_adapter_memcache_ce, this_ptr, SL("_data"), data TSRMLS_CC);
+	zval_ptr_dtor(&data);
+}
+
+/**
+ * Save handler: writes the serialized $_SESSION, unchanged data only refreshes its lifetime
+ *
+ * @param string $sessionId
+ * @param string $data
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerWrite){
+
+	zval *session_id, *data, *previous, *name_space, *lifetime;
+	smart_str key = { NULL, 0, 0 }, namespace_key = { NULL, 0, 0 };
+	int status;
+	long ttl;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "zz", &session_id, &data) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(session_id) != IS_STRING || Z_TYPE_P(data) != IS_STRING) {
+		RETURN_FALSE;
+	}
+
+	name_space = phalcon_session_memcache_namespace(this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), 1 TSRMLS_CC);
+	if (!name_space) {
+		RETURN_FALSE;
+	}
+
+	lifetime = zend_read_property(phalcon_session_adapter_memcache_ce, this_ptr, SL("_lifetime"), 1 TSRMLS_CC);
+	ttl = phalcon_get_intval(lifetime);
+
+	phalcon_session_memcache_key(&key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), name_space, NULL TSRMLS_CC);
+
+	previous = zend_read_property(phalcon_session_adapter_memcache_ce, this_ptr, SL("_data"), 1 TSRMLS_CC);
+	if (Z_TYPE_P(previous) == IS_STRING && Z_STRLEN_P(previous) == Z_STRLEN_P(data) && !memcmp(Z_STRVAL_P(previous), Z_STRVAL_P(data), Z_STRLEN_P(data))) {
+		status = phalcon_session_memcache_key_command(this_ptr, "touch", key.c, key.len, ttl, "TOUCHED" TSRMLS_CC);
+		if (!status) {
+			status = phalcon_session_memcache_store(this_ptr, "set", key.c, key.len, PHALCON_SESSION_MEMCACHE_RAW, ttl, Z_STRVAL_P(data), Z_STRLEN_P(data) TSRMLS_CC);
+		}
+	} else {
+		status = phalcon_session_memcache_store(this_ptr, "set", key.c, key.len, PHALCON_SESSION_MEMCACHE_RAW, ttl, Z_STRVAL_P(data), Z_STRLEN_P(data) TSRMLS_CC);
+	}
+	smart_str_free(&key);
+
+	/** 
+	 * The namespace and the values stored without their own lifetime live as long as the
+	 * session is used
+	 */
+	if (status == 1) {
+		phalcon_session_memcache_key(&namespace_key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), NULL, NULL TSRMLS_CC);
+		status = phalcon_session_memcache_key_command(this_ptr, "touch", namespace_key.c, namespace_key.len, ttl, "TOUCHED" TSRMLS_CC);
+		smart_str_free(&namespace_key);
+	}
+	
+	if (status == 1) {
+		status = phalcon_session_memcache_renew(this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), name_space, ttl TSRMLS_CC);
+	}
+
+	RETURN_BOOL(status == 1);
+}
+
+/**
+ * Save handler: destroys a session
+ *
+ * @param string $sessionId
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerDestroy){
+
+	zval *session_id;
+	smart_str key = { NULL, 0, 0 };
+	int status = 0;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &session_id) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(session_id) == IS_STRING && Z_STRLEN_P(session_id)) {
+		phalcon_session_memcache_key(&key, this_ptr, Z_STRVAL_P(session_id), Z_STRLEN_P(session_id), NULL, NULL TSRMLS_CC);
+		status = phalcon_session_memcache_key_command(this_ptr, "delete", key.c, key.len, -1, "DELETED" TSRMLS_CC);
+		smart_str_free(&key);
+	}
+
+	phalcon_update_property_null(this_ptr, SL("_namespace") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_namespaceId") TSRMLS_CC);
+	phalcon_update_property_null(this_ptr, SL("_keys") TSRMLS_CC);
+
+	RETURN_BOOL(status >= 0);
+}
+
+/**
+ * Save handler: the items expire by themselves, there is nothing to collect
+ *
+ * @param int $maxLifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerGc){
+
+
+	RETURN_TRUE;
+}
+
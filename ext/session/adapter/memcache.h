@@ -0,0 +1,98 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+extern zend_class_entry *phalcon_session_adapter_memcache_ce;
+
+PHALCON_INIT_CLASS(Phalcon_Session_Adapter_Memcache);
+
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, __construct);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, start);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, get);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, set);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, has);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, remove);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, destroy);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerOpen);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerClose);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerRead);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerWrite);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerDestroy);
+PHP_METHOD(Phalcon_Session_Adapter_Memcache, handlerGc);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache___construct, 0, 0, 0)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_get, 0, 0, 1)
+	ZEND_ARG_INFO(0, index)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_set, 0, 0, 2)
+	ZEND_ARG_INFO(0, index)
+	ZEND_ARG_INFO(0, value)
+	ZEND_ARG_INFO(0, lifetime)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_has, 0, 0, 1)
+	ZEND_ARG_INFO(0, index)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_remove, 0, 0, 1)
+	ZEND_ARG_INFO(0, index)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_handleropen, 0, 0, 2)
+	ZEND_ARG_INFO(0, savePath)
+	ZEND_ARG_INFO(0, sessionName)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_handlerread, 0, 0, 1)
+	ZEND_ARG_INFO(0, sessionId)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_handlerwrite, 0, 0, 2)
+	ZEND_ARG_INFO(0, sessionId)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_handlerdestroy, 0, 0, 1)
+	ZEND_ARG_INFO(0, sessionId)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_session_adapter_memcache_handlergc, 0, 0, 1)
+	ZEND_ARG_INFO(0, maxLifetime)
+ZEND_END_ARG_INFO()
+
+PHALCON_INIT_FUNCS(phalcon_session_adapter_memcache_method_entry){
+	PHP_ME(Phalcon_Session_Adapter_Memcache, __construct, arginfo_phalcon_session_adapter_memcache___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, start, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, get, arginfo_phalcon_session_adapter_memcache_get, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, set, arginfo_phalcon_session_adapter_memcache_set, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, has, arginfo_phalcon_session_adapter_memcache_has, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, remove, arginfo_phalcon_session_adapter_memcache_remove, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, destroy, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, handlerOpen, arginfo_phalcon_session_adapter_memcache_handleropen, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, handlerClose, NULL, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, handlerRead, arginfo_phalcon_session_adapter_memcache_handlerread, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, handlerWrite, arginfo_phalcon_session_adapter_memcache_handlerwrite, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, handlerDestroy, arginfo_phalcon_session_adapter_memcache_handlerdestroy, ZEND_ACC_PUBLIC) 
+	PHP_ME(Phalcon_Session_Adapter_Memcache, handlerGc, arginfo_phalcon_session_adapter_memcache_handlergc, ZEND_ACC_PUBLIC) 
+	PHP_FE_END
+};
+
@@ -198,7 +198,7 @@ PHP_METHOD(Phalcon_Session_Bag, destroy){
 }
 
 /**
- * Setter of values
+ * Setter of values. Assigning the value a property already has doesn't write the session
  *
  * @param string $property
  * @param string $value
@@ -206,7 +206,7 @@ PHP_METHOD(Phalcon_Session_Bag, destroy){
 PHP_METHOD(Phalcon_Session_Bag, __set){
 
 	zval *property, *value, *initalized, *name, *data;
-	zval *session;
+	zval *session, *current, *unchanged;
 	zval *t0 = NULL;
 
 	PHALCON_MM_GROW();
@@ -224,6 +224,18 @@ PHP_METHOD(Phalcon_Session_Bag, __set){
 	
 	PHALCON_INIT_VAR(t0);
 	phalcon_read_property(&t0, this_ptr, SL("_data"), PH_NOISY_CC);
+	if (phalcon_array_isset(t0, property)) {
+		PHALCON_INIT_VAR(current);
+		phalcon_array_fetch(&current, t0, property, PH_NOISY_CC);
+	
+		PHALCON_INIT_VAR(unchanged);
+		is_identical_function(unchanged, current, value TSRMLS_CC);
+		if (zend_is_true(unchanged)) {
+			PHALCON_MM_RESTORE();
+			RETURN_NULL();
+		}
+	}
+	
 	phalcon_array_update_zval(&t0, property, &value, PH_COPY TSRMLS_CC);
 	phalcon_update_property_zval(this_ptr, SL("_data"), t0 TSRMLS_CC);
 	
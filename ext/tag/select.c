@@ -37,6 +37,8 @@
 #include "kernel/operators.h"
 #include "kernel/concat.h"
 #include "kernel/exception.h"
+#include "kernel/object.h"
+#include "kernel/string.h"
 
 /**
  * Phalcon\Tag\Select
@@ -249,9 +251,112 @@ PHP_METHOD(Phalcon_Tag_Select, selectField){
 	RETURN_CTOR(code);
 }
 
+/**
+ * Appends a value escaped for HTML. Strings that aren't valid UTF-8 are escaped byte by byte like
+ * htmlspecialchars does with single-byte charsets, so the value is never dropped
+ */
+static void phalcon_tag_select_append_escaped(smart_str *code, zval *value){
+
+	zval copy;
+	const char *str;
+	unsigned int i, length;
+
+	if (Z_TYPE_P(value) == IS_STRING) {
+		str = Z_STRVAL_P(value);
+		length = Z_STRLEN_P(value);
+	} else {
+		copy = *value;
+		zval_copy_ctor(&copy);
+		convert_to_string(&copy);
+		str = Z_STRVAL(copy);
+		length = Z_STRLEN(copy);
+	}
+
+	if (phalcon_escape_html_append(code, str, length, 3) == FAILURE) {
+		for (i = 0; i < length; i++) {
+			switch (str[i]) {
+				case '&':
+					smart_str_appendl(code, "&amp;", 5);
+					break;
+				case '<':
+					smart_str_appendl(code, "&lt;", 4);
+					break;
+				case '>':
+					smart_str_appendl(code, "&gt;", 4);
+					break;
+				case '"':
+					smart_str_appendl(code, "&quot;", 6);
+					break;
+				case '\'':
+					smart_str_appendl(code, "&#039;", 6);
+					break;
+				default:
+					smart_str_appendc(code, str[i]);
+			}
+		}
+	}
+
+	if (Z_TYPE_P(value) != IS_STRING) {
+		zval_dtor(&copy);
+	}
+}
+
+/**
+ * Appends an OPTION tag, values and texts are escaped
+ */
+static void phalcon_tag_select_append_option(smart_str *code, zval *value, zval *option_value, zval *option_text, zval *close_option TSRMLS_DC){
+
+	zval is_equals;
+
+	is_equal_function(&is_equals, value, option_value TSRMLS_CC);
+	if (Z_BVAL(is_equals)) {
+		smart_str_appendl(code, "\t<option selected=\"selected\" value=\"", sizeof("\t<option selected=\"selected\" value=\"") - 1);
+	} else {
+		smart_str_appendl(code, "\t<option value=\"", sizeof("\t<option value=\"") - 1);
+	}
+
+	phalcon_tag_select_append_escaped(code, option_value);
+	smart_str_appendl(code, "\">", 2);
+	phalcon_tag_select_append_escaped(code, option_text);
+
+	smart_str_appendl(code, Z_STRVAL_P(close_option), Z_STRLEN_P(close_option));
+}
+
+/**
+ * Finds the name of the column mapped to an attribute, the attribute itself if there is no column map
+ */
+static int phalcon_tag_select_column(zval *column_map, zval *attribute, char **column, uint *column_length){
+
+	HashPosition pos;
+	zval **mapped;
+	ulong index;
+
+	if (Z_TYPE_P(column_map) != IS_ARRAY) {
+		*column = Z_STRVAL_P(attribute);
+		*column_length = Z_STRLEN_P(attribute) + 1;
+		return SUCCESS;
+	}
+
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(column_map), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(column_map), (void **) &mapped, &pos) == SUCCESS) {
+		if (Z_TYPE_PP(mapped) == IS_STRING && Z_STRLEN_PP(mapped) == Z_STRLEN_P(attribute) && !memcmp(Z_STRVAL_PP(mapped), Z_STRVAL_P(attribute), Z_STRLEN_P(attribute))) {
+			if (zend_hash_get_current_key_ex(Z_ARRVAL_P(column_map), column, column_length, &index, 0, &pos) == HASH_KEY_IS_STRING) {
+				return SUCCESS;
+			}
+			return FAILURE;
+		}
+		zend_hash_move_forward_ex(Z_ARRVAL_P(column_map), &pos);
+	}
+
+	return FAILURE;
+}
+
 /**
  * Generate the OPTION tags based on the rows
  *
+ * Simple resultsets are read straight from their rows, only the two columns in 'using' are
+ * used and no model is built. Other resultsets are traversed as usual
+ *
  * @param Phalcon\Mvc\Model $resultset
  * @param array $using
  * @param mixed value
@@ -260,9 +365,17 @@ PHP_METHOD(Phalcon_Tag_Select, selectField){
 PHP_METHOD(Phalcon_Tag_Select, _optionsFromResultset){
 
 	zval *resultset, *using, *value, *close_option;
-	zval *code, *using_zero = NULL, *using_one = NULL, *option = NULL, *option_value = NULL;
-	zval *option_text = NULL, *is_equals = NULL;
+	zval *using_zero = NULL, *using_one = NULL, *option = NULL, *option_value = NULL;
+	zval *option_text = NULL, *rows = NULL, *result = NULL, *type, *active_row;
+	zval *column_map, *zero, *null_value, *options, *packed;
 	zval *r0 = NULL;
+	zval **row, **column_value, **column_text;
+	HashTable *value_ht;
+	HashPosition pos;
+	char *value_column = NULL, *text_column = NULL;
+	uint value_column_length = 0, text_column_length = 0;
+	smart_str code = {0};
+	size_t newlen;
 
 	PHALCON_MM_GROW();
 
@@ -271,8 +384,108 @@ PHP_METHOD(Phalcon_Tag_Select, _optionsFromResultset){
 		RETURN_NULL();
 	}
 
-	PHALCON_INIT_VAR(code);
-	ZVAL_STRING(code, "", 1);
+	PHALCON_INIT_VAR(using_zero);
+	phalcon_array_fetch_long(&using_zero, using, 0, PH_NOISY_CC);
+	
+	PHALCON_INIT_VAR(using_one);
+	phalcon_array_fetch_long(&using_one, using, 1, PH_NOISY_CC);
+	
+	/** 
+	 * Simple resultsets keep the rows as the database returned them, the columns mapped to the
+	 * attributes in 'using' are read directly
+	 */
+	if (Z_TYPE_P(resultset) == IS_OBJECT && Z_OBJCE_P(resultset) == phalcon_mvc_model_resultset_simple_ce) {
+	
+		/** 
+		 * Unserialized resultsets decode their rows while they are traversed
+		 */
+		PHALCON_INIT_VAR(packed);
+		phalcon_read_property(&packed, resultset, SL("_packed"), PH_NOISY_CC);
+		if (!phalcon_mvc_model_resultset_is_packed(packed) && Z_TYPE_P(using_zero) == IS_STRING && Z_TYPE_P(using_one) == IS_STRING) {
+	
+			PHALCON_INIT_VAR(column_map);
+			phalcon_read_property(&column_map, resultset, SL("_columnMap"), PH_NOISY_CC);
+	
+			if (phalcon_tag_select_column(column_map, using_zero, &value_column, &value_column_length) == FAILURE) {
+				value_column = NULL;
+			} else if (phalcon_tag_select_column(column_map, using_one, &text_column, &text_column_length) == FAILURE) {
+				value_column = NULL;
+			}
+		}
+	}
+	
+	if (value_column) {
+	
+		PHALCON_INIT_VAR(rows);
+		phalcon_read_property(&rows, resultset, SL("_rows"), PH_NOISY_CC);
+		if (Z_TYPE_P(rows) != IS_ARRAY) {
+	
+			PHALCON_INIT_VAR(result);
+			phalcon_read_property(&result, resultset, SL("_result"), PH_NOISY_CC);
+			if (Z_TYPE_P(result) == IS_OBJECT) {
+	
+				PHALCON_INIT_VAR(type);
+				phalcon_read_property(&type, resultset, SL("_type"), PH_NOISY_CC);
+				if (zend_is_true(type)) {
+					/** 
+					 * Unbuffered resultsets are rewound if they were traversed before
+					 */
+					PHALCON_INIT_VAR(active_row);
+					phalcon_read_property(&active_row, resultset, SL("_activeRow"), PH_NOISY_CC);
+					if (Z_TYPE_P(active_row) != IS_NULL) {
+						PHALCON_INIT_VAR(zero);
+						ZVAL_LONG(zero, 0);
+						PHALCON_CALL_METHOD_PARAMS_1_NORETURN(result, "dataseek", zero, PH_NO_CHECK);
+					}
+	
+					PHALCON_INIT_NVAR(rows);
+					PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
+					phalcon_update_property_bool(resultset, SL("_activeRow"), 0 TSRMLS_CC);
+				} else {
+					PHALCON_INIT_NVAR(rows);
+					PHALCON_CALL_METHOD(rows, result, "fetchall", PH_NO_CHECK);
+					phalcon_update_property_zval(resultset, SL("_rows"), rows TSRMLS_CC);
+				}
+			}
+		}
+	
+		if (Z_TYPE_P(rows) == IS_ARRAY) {
+	
+			PHALCON_INIT_VAR(null_value);
+	
+			value_ht = Z_ARRVAL_P(rows);
+			smart_str_alloc(&code, zend_hash_num_elements(value_ht) * (48 + Z_STRLEN_P(close_option)), 0);
+	
+			zend_hash_internal_pointer_reset_ex(value_ht, &pos);
+			while (zend_hash_get_current_data_ex(value_ht, (void **) &row, &pos) == SUCCESS) {
+	
+				if (Z_TYPE_PP(row) == IS_ARRAY) {
+					if (zend_symtable_find(Z_ARRVAL_PP(row), value_column, value_column_length, (void **) &column_value) == FAILURE) {
+						column_value = &null_value;
+					}
+					if (zend_symtable_find(Z_ARRVAL_PP(row), text_column, text_column_length, (void **) &column_text) == FAILURE) {
+						column_text = &null_value;
+					}
+					phalcon_tag_select_append_option(&code, value, *column_value, *column_text, close_option TSRMLS_CC);
+				}
+	
+				zend_hash_move_forward_ex(value_ht, &pos);
+			}
+		}
+	
+		smart_str_0(&code);
+		if (code.c) {
+			RETVAL_STRINGL(code.c, code.len, 0);
+		} else {
+			RETVAL_EMPTY_STRING();
+		}
+		PHALCON_MM_RESTORE();
+		return;
+	}
+	
+	PHALCON_INIT_VAR(options);
+	ZVAL_EMPTY_STRING(options);
+	
 	PHALCON_CALL_METHOD_NORETURN(resultset, "rewind", PH_NO_CHECK);
 	ph_cycle_start_0:
 	
@@ -281,11 +494,6 @@ PHP_METHOD(Phalcon_Tag_Select, _optionsFromResultset){
 		if (PHALCON_IS_NOT_TRUE(r0)) {
 			goto ph_cycle_end_0;
 		}
-		PHALCON_INIT_NVAR(using_zero);
-		phalcon_array_fetch_long(&using_zero, using, 0, PH_NOISY_CC);
-	
-		PHALCON_INIT_NVAR(using_one);
-		phalcon_array_fetch_long(&using_one, using, 1, PH_NOISY_CC);
 	
 		PHALCON_INIT_NVAR(option);
 		PHALCON_CALL_METHOD(option, resultset, "current", PH_NO_CHECK);
@@ -296,19 +504,15 @@ PHP_METHOD(Phalcon_Tag_Select, _optionsFromResultset){
 		PHALCON_INIT_NVAR(option_text);
 		PHALCON_CALL_METHOD_PARAMS_1(option_text, option, "readattribute", using_one, PH_NO_CHECK);
 	
-		PHALCON_INIT_NVAR(is_equals);
-		is_equal_function(is_equals, value, option_value TSRMLS_CC);
-		if (PHALCON_IS_TRUE(is_equals)) {
-			PHALCON_SCONCAT_SVSVV(code, "\t<option selected=\"selected\" value=\"", option_value, "\">", option_text, close_option);
-		} else {
-			PHALCON_SCONCAT_SVSVV(code, "\t<option value=\"", option_value, "\">", option_text, close_option);
-		}
+		phalcon_tag_select_append_option(&code, value, option_value, option_text, close_option TSRMLS_CC);
+		phalcon_concat_self_str(options, code.c, code.len TSRMLS_CC);
+		smart_str_free(&code);
 	
 		PHALCON_CALL_METHOD_NORETURN(resultset, "next", PH_NO_CHECK);
 		goto ph_cycle_start_0;
 	ph_cycle_end_0:
 	
-	RETURN_CTOR(code);
+	RETURN_CTOR(options);
 }
 
 PHP_METHOD(Phalcon_Tag_Select, _optionsFromArray){
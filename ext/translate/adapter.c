@@ -35,12 +35,94 @@
 #include "kernel/fcall.h"
 #include "kernel/exception.h"
 
+#include "ext/standard/php_smart_str.h"
+
 /**
  * Phalcon\Translate\Adapter
  *
  * Base class for Phalcon\Translate adapters
  */
 
+/**
+ * Replaces the %placeholders% of a translation in a single pass. marks are the offsets of the
+ * '%' characters in the translation, adapters that keep them compiled pass them, otherwise the
+ * translation is scanned
+ */
+void phalcon_translate_interpolate(zval *return_value, const char *translation, zend_uint length, const zend_uint *marks, zend_uint marks_count, zval *placeholders TSRMLS_DC){
+
+	smart_str replaced = {0};
+	char buffer[64], *name;
+	const char *percent;
+	zend_uint *scanned = NULL, i = 0, start, end, name_length, position = 0;
+	zval **value, copy;
+	int found;
+
+	if (!marks) {
+		percent = memchr(translation, '%', length);
+		while (percent) {
+			if (marks_count % 16 == 0) {
+				scanned = erealloc(scanned, (marks_count + 16) * sizeof(zend_uint));
+			}
+			scanned[marks_count++] = percent - translation;
+			percent = memchr(percent + 1, '%', length - (percent - translation) - 1);
+		}
+		marks = scanned;
+	}
+
+	if (marks_count < 2 || Z_TYPE_P(placeholders) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(placeholders))) {
+		if (scanned) {
+			efree(scanned);
+		}
+		RETURN_STRINGL(translation, length, 1);
+	}
+
+	while (i + 1 < marks_count) {
+
+		start = marks[i];
+		end = marks[i + 1];
+		name_length = end - start - 1;
+
+		found = 0;
+		if (name_length > 0) {
+			name = name_length < sizeof(buffer) ? buffer : emalloc(name_length + 1);
+			memcpy(name, translation + start + 1, name_length);
+			name[name_length] = '\0';
+			found = zend_symtable_find(Z_ARRVAL_P(placeholders), name, name_length + 1, (void **) &value) == SUCCESS;
+			if (name != buffer) {
+				efree(name);
+			}
+		}
+
+		if (!found) {
+			i++;
+			continue;
+		}
+
+		smart_str_appendl(&replaced, translation + position, start - position);
+		if (Z_TYPE_PP(value) == IS_STRING) {
+			smart_str_appendl(&replaced, Z_STRVAL_PP(value), Z_STRLEN_PP(value));
+		} else {
+			copy = **value;
+			zval_copy_ctor(&copy);
+			convert_to_string(&copy);
+			smart_str_appendl(&replaced, Z_STRVAL(copy), Z_STRLEN(copy));
+			zval_dtor(&copy);
+		}
+
+		position = end + 1;
+		i += 2;
+	}
+
+	smart_str_appendl(&replaced, translation + position, length - position);
+	smart_str_0(&replaced);
+
+	if (scanned) {
+		efree(scanned);
+	}
+
+	RETURN_STRINGL(replaced.c, replaced.len, 0);
+}
+
 
 /**
  * Phalcon\Translate\Adapter initializer
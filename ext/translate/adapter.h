@@ -21,6 +21,8 @@ extern zend_class_entry *phalcon_translate_adapter_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Translate_Adapter);
 
+void phalcon_translate_interpolate(zval *return_value, const char *translation, zend_uint length, const zend_uint *marks, zend_uint marks_count, zval *placeholders TSRMLS_DC);
+
 PHP_METHOD(Phalcon_Translate_Adapter, _);
 PHP_METHOD(Phalcon_Translate_Adapter, offsetSet);
 PHP_METHOD(Phalcon_Translate_Adapter, offsetExists);
@@ -0,0 +1,586 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+#include "phalcon.h"
+
+#include "Zend/zend_operators.h"
+#include "Zend/zend_exceptions.h"
+#include "Zend/zend_interfaces.h"
+
+#include "main/php_streams.h"
+
+#include <fcntl.h>
+#ifdef PHP_WIN32
+#include <io.h>
+#endif
+#if HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+
+#include "kernel/exception.h"
+#include "kernel/array.h"
+
+/**
+ * Phalcon\Translate\Adapter\Gettext
+ *
+ * Reads translations from gettext .mo catalogs
+ *
+ *<code>
+ *	$translate = new Phalcon\Translate\Adapter\Gettext(array(
+ *		'file' => 'app/messages/es_ES/LC_MESSAGES/messages.mo'
+ *	));
+ *	echo $translate->_('Hello %name%', array('name' => 'Phalcon'));
+ *</code>
+ *
+ * Catalogs are mapped in memory and shared by the requests served by the same process, messages
+ * are found through the hash table stored in the catalog and the placeholders of every translation
+ * are located when the catalog is loaded. A catalog is loaded again when its modification time or
+ * size change, replace the files instead of rewriting them in place
+ */
+
+typedef struct _phalcon_translate_catalog {
+	char *data;
+	size_t length;
+	int mapped;
+	int refcount;
+	time_t mtime;
+	off_t size;
+	int swap;
+	zend_uint count;
+	zend_uint originals;
+	zend_uint translations;
+	zend_uint hash_size;
+	zend_uint hash_offset;
+	zend_uint *marks;
+	zend_uint *marks_index;
+} phalcon_translate_catalog;
+
+typedef struct _phalcon_translate_gettext_object {
+	zend_object std;
+	phalcon_translate_catalog *catalog;
+} phalcon_translate_gettext_object;
+
+static zend_uint phalcon_translate_catalog_word(const phalcon_translate_catalog *catalog, size_t offset){
+
+	unsigned char *bytes = (unsigned char *) catalog->data + offset;
+
+	if (catalog->swap) {
+		return ((zend_uint) bytes[0] << 24) | ((zend_uint) bytes[1] << 16) | ((zend_uint) bytes[2] << 8) | bytes[3];
+	}
+
+	return ((zend_uint) bytes[3] << 24) | ((zend_uint) bytes[2] << 16) | ((zend_uint) bytes[1] << 8) | bytes[0];
+}
+
+/**
+ * Hash function used by gettext to build the catalog hash tables
+ */
+static zend_uint phalcon_translate_hashpjw(const char *str, zend_uint length){
+
+	zend_uint hval = 0, g, i;
+
+	for (i = 0; i < length && str[i]; i++) {
+		hval <<= 4;
+		hval += (unsigned char) str[i];
+		g = hval & ((zend_uint) 0xf << 28);
+		if (g) {
+			hval ^= g >> 24;
+			hval ^= g;
+		}
+	}
+
+	return hval;
+}
+
+static void phalcon_translate_catalog_release(phalcon_translate_catalog *catalog){
+
+	if (--catalog->refcount > 0) {
+		return;
+	}
+
+#if HAVE_MMAP
+	if (catalog->mapped) {
+		munmap(catalog->data, catalog->length);
+	} else {
+		pefree(catalog->data, 1);
+	}
+#else
+	pefree(catalog->data, 1);
+#endif
+
+	if (catalog->marks) {
+		pefree(catalog->marks, 1);
+	}
+	pefree(catalog->marks_index, 1);
+	pefree(catalog, 1);
+}
+
+static void phalcon_translate_catalog_dtor(void *data){
+	phalcon_translate_catalog_release(*((phalcon_translate_catalog **) data));
+}
+
+/**
+ * Checks the tables of a catalog and locates the placeholders of its translations
+ */
+static int phalcon_translate_catalog_compile(phalcon_translate_catalog *catalog){
+
+	zend_uint magic, i, offset, length, marks_count = 0;
+	const char *translation, *percent;
+
+	if (catalog->length < 28) {
+		return FAILURE;
+	}
+
+	magic = phalcon_translate_catalog_word(catalog, 0);
+	if (magic != 0x950412de) {
+		catalog->swap = 1;
+		if (phalcon_translate_catalog_word(catalog, 0) != 0x950412de) {
+			return FAILURE;
+		}
+	}
+
+	catalog->count = phalcon_translate_catalog_word(catalog, 8);
+	catalog->originals = phalcon_translate_catalog_word(catalog, 12);
+	catalog->translations = phalcon_translate_catalog_word(catalog, 16);
+	catalog->hash_size = phalcon_translate_catalog_word(catalog, 20);
+	catalog->hash_offset = phalcon_translate_catalog_word(catalog, 24);
+
+	if (catalog->originals > catalog->length || catalog->translations > catalog->length) {
+		return FAILURE;
+	}
+	if (catalog->count > (catalog->length - catalog->originals) / 8 || catalog->count > (catalog->length - catalog->translations) / 8) {
+		return FAILURE;
+	}
+	if (catalog->hash_size && (catalog->hash_size < 3 || catalog->hash_offset > catalog->length || catalog->hash_size > (catalog->length - catalog->hash_offset) / 4)) {
+		return FAILURE;
+	}
+
+	catalog->marks_index = pemalloc((catalog->count + 1) * sizeof(zend_uint), 1);
+
+	for (i = 0; i < catalog->count; i++) {
+
+		/** 
+		 * Strings must fit in the file followed by their NUL, truncated catalogs are rejected
+		 */
+		length = phalcon_translate_catalog_word(catalog, catalog->originals + i * 8);
+		offset = phalcon_translate_catalog_word(catalog, catalog->originals + i * 8 + 4);
+		if (offset >= catalog->length || length >= catalog->length - offset || catalog->data[offset + length] != '\0') {
+			return FAILURE;
+		}
+
+		length = phalcon_translate_catalog_word(catalog, catalog->translations + i * 8);
+		offset = phalcon_translate_catalog_word(catalog, catalog->translations + i * 8 + 4);
+		if (offset >= catalog->length || length >= catalog->length - offset || catalog->data[offset + length] != '\0') {
+			return FAILURE;
+		}
+
+		/** 
+		 * Only the first form of plural translations is used
+		 */
+		translation = catalog->data + offset;
+		percent = memchr(translation, '\0', length);
+		if (percent) {
+			length = percent - translation;
+		}
+
+		catalog->marks_index[i] = marks_count;
+
+		percent = memchr(translation, '%', length);
+		while (percent) {
+			if (marks_count % 64 == 0) {
+				catalog->marks = perealloc(catalog->marks, (marks_count + 64) * sizeof(zend_uint), 1);
+			}
+			catalog->marks[marks_count++] = percent - translation;
+			percent = memchr(percent + 1, '%', length - (percent - translation) - 1);
+		}
+	}
+
+	catalog->marks_index[catalog->count] = marks_count;
+
+	return SUCCESS;
+}
+
+/**
+ * Maps a catalog in memory, catalogs that can't be mapped are read
+ */
+static phalcon_translate_catalog *phalcon_translate_catalog_load(const char *path, php_stream_statbuf *ssb){
+
+	phalcon_translate_catalog *catalog;
+	size_t length, done = 0;
+	ssize_t bytes;
+	int fd;
+
+	length = ssb->sb.st_size;
+	if (length < 28) {
+		return NULL;
+	}
+
+	fd = open(path, O_RDONLY | O_BINARY);
+	if (fd < 0) {
+		return NULL;
+	}
+
+	catalog = pecalloc(1, sizeof(phalcon_translate_catalog), 1);
+	catalog->refcount = 1;
+	catalog->length = length;
+	catalog->mtime = ssb->sb.st_mtime;
+	catalog->size = ssb->sb.st_size;
+
+#if HAVE_MMAP
+	catalog->data = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+	if (catalog->data != MAP_FAILED) {
+		catalog->mapped = 1;
+	} else {
+		catalog->data = NULL;
+	}
+#endif
+
+	if (!catalog->data) {
+		catalog->data = pemalloc(length, 1);
+		while (done < length) {
+			bytes = read(fd, catalog->data + done, length - done);
+			if (bytes <= 0) {
+				break;
+			}
+			done += bytes;
+		}
+		if (done < length) {
+			close(fd);
+			phalcon_translate_catalog_release(catalog);
+			return NULL;
+		}
+	}
+
+	close(fd);
+
+	if (phalcon_translate_catalog_compile(catalog) == FAILURE) {
+		if (!catalog->marks_index) {
+			catalog->marks_index = pemalloc(sizeof(zend_uint), 1);
+		}
+		phalcon_translate_catalog_release(catalog);
+		return NULL;
+	}
+
+	return catalog;
+}
+
+/**
+ * Finds the position of a message in the catalog, -1 if it isn't translated
+ */
+static long phalcon_translate_catalog_find(const phalcon_translate_catalog *catalog, const char *message, zend_uint message_length){
+
+	zend_uint hash, index, increment, entry, length, offset, probes;
+	long low, high, middle;
+	const char *original;
+	int result;
+
+	if (catalog->hash_size) {
+
+		hash = phalcon_translate_hashpjw(message, message_length);
+		index = hash % catalog->hash_size;
+		increment = 1 + (hash % (catalog->hash_size - 2));
+
+		for (probes = 0; probes < catalog->hash_size; probes++) {
+
+			entry = phalcon_translate_catalog_word(catalog, catalog->hash_offset + index * 4);
+			if (!entry || entry > catalog->count) {
+				return -1;
+			}
+			entry--;
+
+			length = phalcon_translate_catalog_word(catalog, catalog->originals + entry * 8);
+			offset = phalcon_translate_catalog_word(catalog, catalog->originals + entry * 8 + 4);
+			if (length >= message_length && !memcmp(catalog->data + offset, message, message_length)) {
+				if (length == message_length || catalog->data[offset + message_length] == '\0') {
+					return entry;
+				}
+			}
+
+			if (index >= catalog->hash_size - increment) {
+				index -= catalog->hash_size - increment;
+			} else {
+				index += increment;
+			}
+		}
+
+		return -1;
+	}
+
+	/** 
+	 * Catalogs without a hash table have their messages sorted
+	 */
+	low = 0;
+	high = (long) catalog->count - 1;
+	while (low <= high) {
+
+		middle = (low + high) / 2;
+
+		length = phalcon_translate_catalog_word(catalog, catalog->originals + middle * 8);
+		offset = phalcon_translate_catalog_word(catalog, catalog->originals + middle * 8 + 4);
+
+		/** 
+		 * The original of a plural form is followed by its plural, only the singular is compared
+		 */
+		original = memchr(catalog->data + offset, '\0', length);
+		if (original) {
+			length = original - (catalog->data + offset);
+		}
+
+		result = memcmp(catalog->data + offset, message, length < message_length ? length : message_length);
+		if (!result && length != message_length) {
+			result = length < message_length ? -1 : 1;
+		}
+		if (!result) {
+			return middle;
+		}
+		if (result < 0) {
+			low = middle + 1;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Returns the catalog of a file, loading it if it isn't in the cache or it changed
+ */
+static phalcon_translate_catalog *phalcon_translate_catalog_get(const char *file_path TSRMLS_DC){
+
+	phalcon_translate_catalog *catalog, **cached;
+	php_stream_statbuf ssb;
+	char real_path[MAXPATHLEN];
+	uint real_path_length;
+	HashTable *cache;
+
+	if (!expand_filepath(file_path, real_path TSRMLS_CC)) {
+		return NULL;
+	}
+
+	if (php_check_open_basedir(real_path TSRMLS_CC)) {
+		return NULL;
+	}
+
+	if (php_stream_stat_path(real_path, &ssb) != 0) {
+		return NULL;
+	}
+
+	real_path_length = strlen(real_path) + 1;
+
+	cache = PHALCON_GLOBAL(translate_cache);
+	if (cache && zend_hash_find(cache, real_path, real_path_length, (void **) &cached) == SUCCESS) {
+		if ((*cached)->mtime == ssb.sb.st_mtime && (*cached)->size == ssb.sb.st_size) {
+			(*cached)->refcount++;
+			return *cached;
+		}
+	}
+
+	catalog = phalcon_translate_catalog_load(real_path, &ssb);
+	if (!catalog) {
+		return NULL;
+	}
+
+	if (!cache) {
+		cache = pemalloc(sizeof(HashTable), 1);
+		zend_hash_init(cache, 4, NULL, phalcon_translate_catalog_dtor, 1);
+		PHALCON_GLOBAL(translate_cache) = cache;
+	} else if (zend_hash_num_elements(cache) >= PHALCON_TRANSLATE_CACHE_SIZE) {
+		zend_hash_clean(cache);
+	}
+
+	/** 
+	 * One reference for the cache and one for the adapter
+	 */
+	catalog->refcount++;
+	zend_hash_update(cache, real_path, real_path_length, &catalog, sizeof(phalcon_translate_catalog *), NULL);
+
+	return catalog;
+}
+
+static void phalcon_translate_gettext_object_free(void *object TSRMLS_DC){
+
+	phalcon_translate_gettext_object *intern = (phalcon_translate_gettext_object *) object;
+
+	if (intern->catalog) {
+		phalcon_translate_catalog_release(intern->catalog);
+	}
+
+	zend_object_std_dtor(&intern->std TSRMLS_CC);
+	efree(intern);
+}
+
+static zend_object_value phalcon_translate_gettext_object_new(zend_class_entry *class_type TSRMLS_DC){
+
+	phalcon_translate_gettext_object *intern;
+	zend_object_value retval;
+#if PHP_VERSION_ID < 50400
+	zval *tmp;
+#endif
+
+	intern = ecalloc(1, sizeof(phalcon_translate_gettext_object));
+	zend_object_std_init(&intern->std, class_type TSRMLS_CC);
+#if PHP_VERSION_ID >= 50400
+	object_properties_init(&intern->std, class_type);
+#else
+	zend_hash_copy(intern->std.properties, &class_type->default_properties, (copy_ctor_func_t) zval_add_ref, (void *) &tmp, sizeof(zval *));
+#endif
+
+	retval.handle = zend_objects_store_put(intern, (zend_objects_store_dtor_t) zend_objects_destroy_object, phalcon_translate_gettext_object_free, NULL TSRMLS_CC);
+	retval.handlers = zend_get_std_object_handlers();
+
+	return retval;
+}
+
+/**
+ * Phalcon\Translate\Adapter\Gettext initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Translate_Adapter_Gettext){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\Translate\\Adapter, Gettext, translate_adapter_gettext, "phalcon\\translate\\adapter", phalcon_translate_adapter_gettext_method_entry, 0);
+
+	phalcon_translate_adapter_gettext_ce->create_object = phalcon_translate_gettext_object_new;
+
+	zend_class_implements(phalcon_translate_adapter_gettext_ce TSRMLS_CC, 1, phalcon_translate_adapterinterface_ce);
+
+	return SUCCESS;
+}
+
+/**
+ * Phalcon\Translate\Adapter\Gettext constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Translate_Adapter_Gettext, __construct){
+
+	zval *options, **file_path;
+	phalcon_translate_gettext_object *intern;
+	phalcon_translate_catalog *catalog;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &options) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE_P(options) != IS_ARRAY) { 
+		zend_throw_exception_ex(phalcon_translate_exception_ce, 0 TSRMLS_CC, "Invalid options");
+		return;
+	}
+
+	if (zend_hash_find(Z_ARRVAL_P(options), SS("file"), (void **) &file_path) == FAILURE || Z_TYPE_PP(file_path) != IS_STRING) {
+		zend_throw_exception_ex(phalcon_translate_exception_ce, 0 TSRMLS_CC, "Translation file was not provided");
+		return;
+	}
+
+	catalog = phalcon_translate_catalog_get(Z_STRVAL_PP(file_path) TSRMLS_CC);
+	if (!catalog) {
+		zend_throw_exception_ex(phalcon_translate_exception_ce, 0 TSRMLS_CC, "Translation file %s can't be loaded", Z_STRVAL_PP(file_path));
+		return;
+	}
+
+	intern = (phalcon_translate_gettext_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (intern->catalog) {
+		phalcon_translate_catalog_release(intern->catalog);
+	}
+	intern->catalog = catalog;
+}
+
+/**
+ * Returns the translation related to the given key
+ *
+ * @param string $index
+ * @param array $placeholders
+ * @return string
+ */
+PHP_METHOD(Phalcon_Translate_Adapter_Gettext, query){
+
+	zval *index, *placeholders = NULL;
+	phalcon_translate_gettext_object *intern;
+	phalcon_translate_catalog *catalog;
+	const char *translation, *end;
+	zend_uint length, offset, first_mark;
+	long entry;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z|z", &index, &placeholders) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	intern = (phalcon_translate_gettext_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	catalog = intern->catalog;
+
+	if (!catalog || Z_TYPE_P(index) != IS_STRING) {
+		RETURN_ZVAL(index, 1, 0);
+	}
+
+	entry = phalcon_translate_catalog_find(catalog, Z_STRVAL_P(index), Z_STRLEN_P(index));
+	if (entry < 0) {
+		RETURN_ZVAL(index, 1, 0);
+	}
+
+	length = phalcon_translate_catalog_word(catalog, catalog->translations + entry * 8);
+	offset = phalcon_translate_catalog_word(catalog, catalog->translations + entry * 8 + 4);
+
+	translation = catalog->data + offset;
+	end = memchr(translation, '\0', length);
+	if (end) {
+		length = end - translation;
+	}
+
+	first_mark = catalog->marks_index[entry];
+	if (!placeholders || Z_TYPE_P(placeholders) != IS_ARRAY || first_mark == catalog->marks_index[entry + 1]) {
+		RETURN_STRINGL(translation, length, 1);
+	}
+
+	phalcon_translate_interpolate(return_value, translation, length, catalog->marks + first_mark, catalog->marks_index[entry + 1] - first_mark, placeholders TSRMLS_CC);
+}
+
+/**
+ * Check whether is defined a translation key in the catalog
+ *
+ * @param string $index
+ * @return bool
+ */
+PHP_METHOD(Phalcon_Translate_Adapter_Gettext, exists){
+
+	zval *index;
+	phalcon_translate_gettext_object *intern;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &index) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	intern = (phalcon_translate_gettext_object *) zend_object_store_get_object(this_ptr TSRMLS_CC);
+	if (!intern->catalog || Z_TYPE_P(index) != IS_STRING) {
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(phalcon_translate_catalog_find(intern->catalog, Z_STRVAL_P(index), Z_STRLEN_P(index)) >= 0);
+}
+
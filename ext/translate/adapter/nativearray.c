@@ -111,14 +111,6 @@ PHP_METHOD(Phalcon_Translate_Adapter_NativeArray, __construct){
 PHP_METHOD(Phalcon_Translate_Adapter_NativeArray, query){
 
 	zval *index, *placeholders = NULL, *translate, *translation = NULL;
-	zval *value = NULL, *key = NULL, *key_placeholder = NULL, *replaced = NULL;
-	HashTable *ah0;
-	HashPosition hp0;
-	zval **hd;
-	char *hash_index;
-	uint hash_index_len;
-	ulong hash_num;
-	int hash_type;
 	int eval_int;
 
 	PHALCON_MM_GROW();
@@ -138,42 +130,14 @@ PHP_METHOD(Phalcon_Translate_Adapter_NativeArray, query){
 	if (eval_int) {
 		PHALCON_INIT_VAR(translation);
 		phalcon_array_fetch(&translation, translate, index, PH_NOISY_CC);
-		if (Z_TYPE_P(placeholders) == IS_ARRAY) { 
+		if (Z_TYPE_P(placeholders) == IS_ARRAY && Z_TYPE_P(translation) == IS_STRING) { 
 			if (phalcon_fast_count_ev(placeholders TSRMLS_CC)) {
-	
-				if (!phalcon_valid_foreach(placeholders TSRMLS_CC)) {
-					return;
-				}
-	
-				ah0 = Z_ARRVAL_P(placeholders);
-				zend_hash_internal_pointer_reset_ex(ah0, &hp0);
-	
-				ph_cycle_start_0:
-	
-					if (zend_hash_get_current_data_ex(ah0, (void**) &hd, &hp0) != SUCCESS) {
-						goto ph_cycle_end_0;
-					}
-	
-					PHALCON_GET_FOREACH_KEY(key, ah0, hp0);
-					PHALCON_GET_FOREACH_VALUE(value);
-	
-					PHALCON_INIT_NVAR(key_placeholder);
-					PHALCON_CONCAT_SVS(key_placeholder, "%", key, "%");
-	
-					PHALCON_INIT_NVAR(replaced);
-					phalcon_fast_str_replace(replaced, key_placeholder, value, translation TSRMLS_CC);
-					PHALCON_CPY_WRT(translation, replaced);
-	
-					zend_hash_move_forward_ex(ah0, &hp0);
-					goto ph_cycle_start_0;
-	
-				ph_cycle_end_0:
-				if(0){}
-	
+				phalcon_translate_interpolate(return_value, Z_STRVAL_P(translation), Z_STRLEN_P(translation), NULL, 0, placeholders TSRMLS_CC);
+				PHALCON_MM_RESTORE();
+				return;
 			}
 		}
 	
-	
 		RETURN_CCTOR(translation);
 	}
 	
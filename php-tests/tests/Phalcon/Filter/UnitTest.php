@@ -805,5 +805,104 @@ class Filter_UnitTest extends Phalcon_Test_UnitTestCase
             'Striptags single HTML filter is not correct'
         );
     }
+
+    /**
+     * Tests chained filters
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-10
+     */
+    public function testSanitizeChain()
+    {
+        $filter = new Flt();
+
+        $expected = 'hello world';
+        $actual   = $filter->sanitize("  Hello World\n", 'trim|lower');
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'Chained filters are not correct'
+        );
+
+        $expected = '100019';
+        $actual   = $filter->sanitize(' !100a019 ', 'trim | int');
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'Chained filters with spaces are not correct'
+        );
+
+        $expected = 'HELLO';
+        $actual   = $filter->sanitize('<b>hello</b>', array('striptags|upper'));
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'Chained filters in an array are not correct'
+        );
+    }
+
+    /**
+     * Tests chained filters with custom filters
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-10
+     */
+    public function testSanitizeChainCustomFilter()
+    {
+        $filter = new Flt();
+
+        $this->assertEquals('HELLO', $filter->sanitize(' hello ', 'trim|upper'));
+
+        $filter->add('upper', function($value) {
+            return '[' . $value . ']';
+        });
+
+        $expected = '[hello]';
+        $actual   = $filter->sanitize(' hello ', 'trim|upper');
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'Custom filters do not override built-in filters in chains'
+        );
+    }
+
+    /**
+     * Tests sanitizing arrays
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-10
+     */
+    public function testSanitizeArray()
+    {
+        $filter = new Flt();
+
+        $expected = array('a' => '1', 'b' => '-2', 5 => '30');
+        $actual   = $filter->sanitizeArray(
+            array('a' => ' 1 ', 'b' => '-2x', 5 => 30),
+            'trim|int'
+        );
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'sanitizeArray does not return correct data'
+        );
+
+        $expected = array('café', 'hello');
+        $actual   = $filter->sanitizeArray(
+            array(' CAFÉ ', 'HELLO'),
+            array('trim', 'lower')
+        );
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'sanitizeArray with multibyte data does not return correct data'
+        );
+    }
 }
 
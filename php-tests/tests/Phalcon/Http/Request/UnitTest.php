@@ -210,6 +210,73 @@ class Http_Request_UnitTest extends Phalcon_Test_UnitTestCase
         );
     }
 
+    /**
+     * Tests getHeader with header names as they are sent
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-12
+     */
+    public function testHeaderGetNormalized()
+    {
+        $this->_setServerVar('HTTP_X_REQUESTED_WITH', 'XMLHttpRequest');
+        $this->_setServerVar('CONTENT_TYPE', 'application/json');
+
+        $requestedWith = $this->_request->getHeader('X-Requested-With');
+        $contentType   = $this->_request->getHeader('content-type');
+        $headers       = $this->_request->getHeaders();
+
+        $this->_unsetServerVar('HTTP_X_REQUESTED_WITH');
+        $this->_unsetServerVar('CONTENT_TYPE');
+
+        $this->assertEquals(
+            'XMLHttpRequest',
+            $requestedWith,
+            'Header does not contain correct data'
+        );
+        $this->assertEquals(
+            'application/json',
+            $contentType,
+            'Header does not contain correct data'
+        );
+        $this->assertEquals(
+            'XMLHttpRequest',
+            $headers['X_REQUESTED_WITH'],
+            'Headers do not contain correct data'
+        );
+        $this->assertEquals(
+            'application/json',
+            $headers['CONTENT_TYPE'],
+            'Headers do not contain correct data'
+        );
+        $this->assertEquals(
+            '',
+            $this->_request->getHeader('X-Requested-With'),
+            'Header is still set after unsetting it'
+        );
+    }
+
+    /**
+     * Tests getServerAddress on IIS
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-12
+     */
+    public function testGetServerAddressLocalAddr()
+    {
+        $this->_setServerVar('LOCAL_ADDR', '192.168.4.2');
+
+        $expected = '192.168.4.2';
+        $actual   = $this->_request->getServerAddress();
+
+        $this->_unsetServerVar('LOCAL_ADDR');
+
+        $this->assertEquals(
+            $expected,
+            $actual,
+            'Server address is not correct'
+        );
+    }
+
     /**
      * Tests getServerAddress default
      *
@@ -393,6 +460,32 @@ class Http_Request_UnitTest extends Phalcon_Test_UnitTestCase
 
     }
 
+    /**
+     * Tests the Accept header negotiation with parameters and repeated calls
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-12
+     */
+    public function testAcceptableContentParameters()
+    {
+        $this->_setServerVar('HTTP_ACCEPT', 'text/html;level=1;q=0.5, application/json, text/plain;q=0.9');
+
+        for ($i = 0; $i < 2; $i++) {
+            $accept = $this->_request->getAcceptableContent();
+            $this->assertEquals(count($accept), 3);
+            $this->assertEquals($accept[0]['accept'], 'text/html');
+            $this->assertEquals($accept[0]['quality'], 0.5);
+            $this->assertEquals($accept[1]['accept'], 'application/json');
+            $this->assertEquals($accept[1]['quality'], 1);
+            $this->assertEquals($this->_request->getBestAccept(), 'application/json');
+        }
+
+        $this->_unsetServerVar('HTTP_ACCEPT');
+
+        $this->assertEquals($this->_request->getAcceptableContent(), array());
+        $this->assertEquals($this->_request->getBestAccept(), '');
+    }
+
     public function testAcceptableCharsets()
     {
 
@@ -1125,4 +1125,105 @@ class Logger_Adapter_File_UnitTest extends Phalcon_Test_UnitTestCase
             'Log does not contain correct number of messages after rollback'
         );
     }
-}
\ No newline at end of file
+
+    /**
+     * Tests the buffered mode
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-12
+     */
+    public function testBuffered()
+    {
+        $fileName = $this->getFileName('log', 'log');
+        $params   = array('buffer' => 4096);
+
+        $logger = new PhFLg($this->_logPath . $fileName, $params);
+        $logger->log('Message 1');
+        $logger->log('Message 2');
+
+        clearstatcache();
+        $before = filesize($this->_logPath . $fileName);
+
+        // Errors are written right away along with the buffered lines
+        $logger->error('Message 3');
+
+        $contents = file($this->_logPath . $fileName);
+        $afterError = count($contents);
+
+        $logger->log('Message 4');
+        $logger->close();
+
+        $contents = file($this->_logPath . $fileName);
+
+        $this->cleanFile($this->_logPath, $fileName);
+
+        $this->assertEquals(
+            0,
+            $before,
+            'Buffered messages were written before the buffer was flushed'
+        );
+        $this->assertEquals(
+            3,
+            $afterError,
+            'Error message did not flush the buffer'
+        );
+        $this->assertEquals(
+            4,
+            count($contents),
+            'Log does not contain correct number of messages after close'
+        );
+    }
+
+    /**
+     * Tests the JSON and logfmt encodings and the context interpolation
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-12
+     */
+    public function testEncodings()
+    {
+        $fileName = $this->getFileName('log', 'log');
+        $context  = array('id' => 1022, 'gateway' => 'pay pal');
+
+        $logger = new PhFLg($this->_logPath . $fileName);
+        $logger->setDateFormat('Y');
+        $logger->error('Payment {id} via {gateway} failed {missing}', $context);
+
+        $logger->setEncoding(PhLg::ENCODING_JSON);
+        $logger->error("Payment {id}\n\"failed\"", $context);
+
+        $logger->setEncoding(PhLg::ENCODING_LOGFMT);
+        $logger->error('Payment {id} failed', $context);
+        $logger->close();
+
+        $contents = file($this->_logPath . $fileName, FILE_IGNORE_NEW_LINES);
+
+        $this->cleanFile($this->_logPath, $fileName);
+
+        $year = date('Y');
+
+        $this->assertEquals(
+            "[{$year}][ERROR] Payment 1022 via pay pal failed {missing}",
+            $contents[0],
+            'Context was not interpolated in the line encoding'
+        );
+
+        $json = json_decode($contents[1], true);
+        $this->assertEquals(
+            array(
+                'time'    => $year,
+                'type'    => 'ERROR',
+                'message' => "Payment 1022\n\"failed\"",
+                'context' => $context,
+            ),
+            $json,
+            'JSON encoding is not correct'
+        );
+
+        $this->assertEquals(
+            "time={$year} type=ERROR message=\"Payment 1022 failed\" id=1022 gateway=\"pay pal\"",
+            $contents[2],
+            'logfmt encoding is not correct'
+        );
+    }
+}
@@ -230,4 +230,49 @@ class Url_UnitTest extends Phalcon_Test_UnitTestCase
         $this->assertEquals($expected, $actual, 'External Site Url not correct');
 
     }
+
+    /**
+     * Tests routes added and renamed after urls were generated
+     *
+     * @author Andres Gutierrez <andres@phalconphp.com>
+     * @since  2012-12-11
+     */
+    public function testUrlForRoutesDefinedLater()
+    {
+        $url = new PhUrl();
+
+        $url->setDI($this->_di);
+
+        $router = $this->_di->getShared('router');
+
+        $params   = array(
+                        'for'   => 'classApi',
+                        'class' => 'Some',
+                    );
+        $expected = '/api/classes/Some';
+        $actual   = $url->get($params);
+
+        $this->assertEquals($expected, $actual, 'Class Url not correct');
+
+        $router->add('/shop/{category}/{product}')->setName('shopProduct');
+
+        $params   = array(
+                        'for'      => 'shopProduct',
+                        'category' => 'books',
+                        'product'  => 'phalcon',
+                    );
+        $expected = '/shop/books/phalcon';
+        $actual   = $url->get($params);
+
+        $this->assertEquals($expected, $actual, 'Url for a route added later not correct');
+
+        $router->getRouteByName('shopProduct')->setName('storeProduct');
+
+        $this->assertFalse($router->getRouteByName('shopProduct'), 'Renamed route is still indexed');
+
+        $params['for'] = 'storeProduct';
+        $actual        = $url->get($params);
+
+        $this->assertEquals($expected, $actual, 'Url for a renamed route not correct');
+    }
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+<?php
+
+/**
+ * Escaper benchmark
+ *
+ * Compares the native escapers in Phalcon\Escaper with the userland implementations they replaced
+ *
+ * Usage: php scripts/bench-escaper.php [iterations]
+ */
+
+$iterations = isset($argv[1]) ? (int) $argv[1] : 100000;
+
+$samples = array(
+	'clean'  => 'A perfectly clean sentence without anything to escape at all, just text',
+	'markup' => '<a href="/products?id=1&amp;page=2" title=\'Products\'>Products & Services</a>',
+	'utf8'   => "Crème brûlée, 東京 and € prices <b>today</b>",
+);
+
+$escaper = new Phalcon\Escaper();
+
+function bench($name, $callback, $iterations)
+{
+	$start = microtime(true);
+	for ($i = 0; $i < $iterations; $i++) {
+		$callback();
+	}
+	$elapsed = microtime(true) - $start;
+	printf("%-40s %8.2f ms %10.0f ops/s\n", $name, $elapsed * 1000, $iterations / $elapsed);
+}
+
+function css_sanitize($matches)
+{
+	$chr = $matches[0];
+	if (strlen($chr) == 1) {
+		$ord = ord($chr);
+	} else {
+		$ord = hexdec($chr);
+	}
+	return sprintf('\\%X ', $ord);
+}
+
+foreach ($samples as $type => $text) {
+
+	echo $type, ":\n";
+
+	bench('  htmlspecialchars', function() use ($text) {
+		htmlspecialchars($text, ENT_QUOTES, 'utf-8');
+	}, $iterations);
+
+	bench('  Phalcon\Escaper::escapeHtml', function() use ($escaper, $text) {
+		$escaper->escapeHtml($text);
+	}, $iterations);
+
+	bench('  preg_replace_callback (css)', function() use ($text) {
+		preg_replace_callback('/[^a-z0-9]/iSu', 'css_sanitize', $text);
+	}, $iterations);
+
+	bench('  Phalcon\Escaper::escapeCss', function() use ($escaper, $text) {
+		$escaper->escapeCss($text);
+	}, $iterations);
+
+	bench('  Phalcon\Escaper::escapeHtmlAttr', function() use ($escaper, $text) {
+		$escaper->escapeHtmlAttr($text);
+	}, $iterations);
+
+	bench('  Phalcon\Escaper::escapeJs', function() use ($escaper, $text) {
+		$escaper->escapeJs($text);
+	}, $iterations);
+
+	echo "\n";
+}
@@ -0,0 +1,56 @@
+<?php
+
+/**
+ * Logger benchmark
+ *
+ * Compares the line format built with str_replace (as Phalcon\Logger\Adapter did before) with the
+ * native line, JSON and logfmt encodings of Phalcon\Logger\Adapter\File
+ *
+ * Usage: php scripts/bench-logger.php [lines]
+ */
+
+$lines = isset($argv[1]) ? (int) $argv[1] : 1000000;
+
+$path = tempnam(sys_get_temp_dir(), 'phalcon-log');
+$message = 'Payment {id} via {gateway} failed';
+$context = array('id' => 1022, 'gateway' => 'paypal', 'amount' => 10.5);
+
+function bench($name, $callback, $lines)
+{
+	$start = microtime(true);
+	for ($i = 0; $i < $lines; $i++) {
+		$callback();
+	}
+	$elapsed = microtime(true) - $start;
+	printf("%-40s %8.2f ms %10.0f lines/s\n", $name, $elapsed * 1000, $lines / $elapsed);
+}
+
+$handler = fopen($path, 'w');
+bench('str_replace + fwrite', function() use ($handler, $message, $context) {
+	$replace = array();
+	foreach ($context as $key => $value) {
+		$replace['{' . $key . '}'] = $value;
+	}
+	$line = str_replace('%date%', date('D, d M y H:i:s O'), '[%date%][%type%] %message%');
+	$line = str_replace('%type%', 'ERROR', $line);
+	$line = str_replace('%message%', strtr($message, $replace), $line);
+	fwrite($handler, $line . PHP_EOL);
+}, $lines);
+fclose($handler);
+
+$encodings = array(
+	'line'   => Phalcon\Logger::ENCODING_LINE,
+	'json'   => Phalcon\Logger::ENCODING_JSON,
+	'logfmt' => Phalcon\Logger::ENCODING_LOGFMT,
+);
+
+foreach ($encodings as $name => $encoding) {
+	$logger = new Phalcon\Logger\Adapter\File($path, array('mode' => 'w', 'buffer' => 65536));
+	$logger->setEncoding($encoding);
+	bench('Phalcon\Logger (' . $name . ')', function() use ($logger, $message, $context) {
+		$logger->error($message, $context);
+	}, $lines);
+	$logger->close();
+}
+
+unlink($path);
@@ -0,0 +1,40 @@
+<?php
+
+/**
+ * PHQL parser benchmark
+ *
+ * Parses the statements used by unit-tests/ModelsQueryParsingTest.php with
+ * Phalcon\Mvc\Model\Query\Lang::parsePHQL and reports the time and memory used per statement
+ *
+ * Usage: php scripts/bench-phql.php [iterations]
+ */
+
+$iterations = isset($argv[1]) ? (int) $argv[1] : 1000;
+
+$source = file_get_contents(__DIR__ . '/../unit-tests/ModelsQueryParsingTest.php');
+preg_match_all("/'((?:SELECT|UPDATE|DELETE|INSERT) [^']*)'/", $source, $matches);
+
+$statements = array();
+foreach ($matches[1] as $phql) {
+	$statements[str_replace('\\\\', '\\', $phql)] = true;
+}
+$statements = array_keys($statements);
+
+$total = count($statements) * $iterations;
+
+$memory = memory_get_usage();
+$peak = 0;
+$start = microtime(true);
+for ($i = 0; $i < $iterations; $i++) {
+	foreach ($statements as $phql) {
+		$ast = Phalcon\Mvc\Model\Query\Lang::parsePHQL($phql);
+		$peak = max($peak, memory_get_usage() - $memory);
+		unset($ast);
+	}
+}
+$elapsed = microtime(true) - $start;
+
+printf("%d statements, %d iterations\n", count($statements), $iterations);
+printf("%-30s %8.2f ms\n", 'total', $elapsed * 1000);
+printf("%-30s %8.2f us\n", 'per statement', $elapsed * 1000000 / $total);
+printf("%-30s %8d bytes\n", 'peak memory per statement', $peak);
@@ -118,4 +118,51 @@ class ConfigTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($config, $expectedConfig);
 	}
 
+	public function testConfigLazyObjects()
+	{
+		$config = new Phalcon\Config($this->_config);
+
+		$this->assertInstanceOf('Phalcon\Config', $config->database);
+		$this->assertSame($config->database, $config->database);
+		$this->assertEquals($config->database->host, 'localhost');
+
+		$config->test->parent->property2 = 'changed';
+		$this->assertEquals($config->test->parent->property2, 'changed');
+
+		foreach ($config as $section) {
+			$this->assertInstanceOf('Phalcon\Config', $section);
+		}
+	}
+
+	public function testConfigToArray()
+	{
+		$config = new Phalcon\Config($this->_config);
+		$this->assertEquals($config->toArray(), $this->_config);
+
+		$config->database->host = '127.0.0.1';
+		$array = $config->toArray();
+		$this->assertEquals($array['database']['host'], '127.0.0.1');
+		$this->assertEquals($array['models'], array('metadata' => 'memory'));
+	}
+
+	public function testIniConfigCache()
+	{
+		$path = 'unit-tests/cache/config-cache.ini';
+
+		file_put_contents($path, "[database]\nhost = localhost\n");
+		$config = new Phalcon\Config\Adapter\Ini($path);
+		$this->assertEquals($config->database->host, 'localhost');
+
+		$config->database->host = 'changed';
+		$config = new Phalcon\Config\Adapter\Ini($path);
+		$this->assertEquals($config->database->host, 'localhost');
+
+		file_put_contents($path, "[database]\nhost = 192.168.0.1\n");
+		clearstatcache();
+		$config = new Phalcon\Config\Adapter\Ini($path);
+		$this->assertEquals($config->database->host, '192.168.0.1');
+
+		unlink($path);
+	}
+
 }
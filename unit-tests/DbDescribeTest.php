@@ -602,6 +602,15 @@ class DbDescribeTest extends PHPUnit_Framework_TestCase
 		$describeReferences = $connection->describeReferences('robots_parts', 'phalcon_test');
 		$this->assertEquals($describeReferences, $expectedReferences);
 
+		//Whole schema
+		$schemaColumns = $connection->describeSchemaColumns('phalcon_test');
+		$this->assertEquals($schemaColumns['personas'], $expectedDescribe);
+
+		$schemaDescription = $connection->describeSchema('phalcon_test');
+		$this->assertEquals($schemaDescription['personas']['columns'], $expectedDescribe);
+		$this->assertEquals($schemaDescription['robots_parts']['indexes'], $expectedIndexes);
+		$this->assertEquals($schemaDescription['robots_parts']['references'], $expectedReferences);
+
 	}
 
 	public function testDbPostgresql()
@@ -691,6 +700,15 @@ class DbDescribeTest extends PHPUnit_Framework_TestCase
 		$describeReferences = $connection->describeReferences('robots_parts', 'public');
 		$this->assertEquals($describeReferences, $expectedReferences);
 
+		//Whole schema
+		$schemaColumns = $connection->describeSchemaColumns('public');
+		$this->assertEquals($schemaColumns['personas'], $expectedDescribe);
+
+		$schemaDescription = $connection->describeSchema('public');
+		$this->assertEquals($schemaDescription['personas']['columns'], $expectedDescribe);
+		$this->assertEquals($schemaDescription['robots_parts']['indexes'], $expectedIndexes);
+		$this->assertEquals($schemaDescription['robots_parts']['references'], $expectedReferences);
+
 	}
 
 	public function testDbSqlite()
@@ -772,6 +790,16 @@ class DbDescribeTest extends PHPUnit_Framework_TestCase
 
 		$describeReferences = $connection->describeReferences('robots_parts');
 		$this->assertEquals($describeReferences, $expectedReferences);
+
+		//Whole schema
+		$schemaColumns = $connection->describeSchemaColumns();
+		$this->assertEquals($schemaColumns['personas'], $expectedDescribe);
+
+		$schemaDescription = $connection->describeSchema();
+		$this->assertEquals($schemaDescription['personas']['columns'], $expectedDescribe);
+		$this->assertEquals($schemaDescription['robots_parts']['indexes'], $expectedIndexes);
+		$this->assertEquals($schemaDescription['robots_parts']['references'], $expectedReferences);
+
 	}
 
 }
@@ -76,6 +76,7 @@ class DbProfilerTest extends PHPUnit_Framework_TestCase
 		$connection = new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
 
 		$this->_executeTests($connection);
+		$this->_executeAggregatedTests($connection);
 	}
 
 	public function testDbPostgresql()
@@ -86,6 +87,7 @@ class DbProfilerTest extends PHPUnit_Framework_TestCase
 		$connection = new Phalcon\Db\Adapter\Pdo\Postgresql($configPostgresql);
 
 		$this->_executeTests($connection);
+		$this->_executeAggregatedTests($connection);
 	}
 
 	public function _executeTests($connection)
@@ -139,4 +141,72 @@ class DbProfilerTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($profiler->getNumberTotalStatements(), 0);
 	}
 
+	public function _executeAggregatedTests($connection)
+	{
+
+		$eventsManager = new Phalcon\Events\Manager();
+
+		$listener = new DbProfilerListener();
+
+		$eventsManager->attach('db', $listener);
+
+		$connection->setEventsManager($eventsManager);
+
+		$profiler = $listener->getProfiler();
+		$this->assertFalse($profiler->isAggregated());
+		$profiler->setAggregated(true);
+		$this->assertTrue($profiler->isAggregated());
+
+		$connection->query("SELECT * FROM personas LIMIT 3");
+		$connection->query("SELECT * FROM personas LIMIT 100");
+		$connection->query("SELECT *   FROM personas WHERE estado = 'A' LIMIT 5");
+		$connection->query("SELECT * FROM personas WHERE estado IN ('A', 'I') LIMIT 10");
+
+		//Aggregated profiles aren't kept
+		$this->assertEquals(count($profiler->getProfiles()), 0);
+		$this->assertEquals($profiler->getPoints(), 0);
+		$this->assertEquals($profiler->getNumberTotalStatements(), 4);
+		$this->assertEquals(gettype($profiler->getTotalElapsedSeconds()), "double");
+
+		$histograms = $profiler->getHistograms();
+		$this->assertEquals(array_keys($histograms), array(
+			"SELECT * FROM personas LIMIT ?",
+			"SELECT * FROM personas WHERE estado = ? LIMIT ?",
+			"SELECT * FROM personas WHERE estado IN (?) LIMIT ?",
+		));
+
+		$histogram = $histograms["SELECT * FROM personas LIMIT ?"];
+		$this->assertEquals($histogram['count'], 2);
+		$this->assertTrue($histogram['min'] <= $histogram['p50']);
+		$this->assertTrue($histogram['p50'] <= $histogram['p95']);
+		$this->assertTrue($histogram['p95'] <= $histogram['p99']);
+		$this->assertTrue($histogram['p99'] <= $histogram['max']);
+
+		$dump = json_decode($profiler->dump(), true);
+		$this->assertEquals($dump['statements'], 4);
+		$this->assertEquals(count($dump['shapes']), 3);
+		$this->assertEquals($dump['shapes'][0]['sql'], "SELECT * FROM personas LIMIT ?");
+		$this->assertEquals($dump['shapes'][0]['count'], 2);
+
+		$dumpFile = 'unit-tests/cache/profiler.log';
+		@unlink($dumpFile);
+		$profiler->setDumpFile($dumpFile);
+
+		$profiler->reset();
+		$this->assertEquals($profiler->getNumberTotalStatements(), 0);
+		$this->assertEquals($profiler->getHistograms(), array());
+
+		$connection->query("SELECT * FROM personas LIMIT 3");
+
+		$connection->setEventsManager(null);
+		unset($profiler, $listener, $eventsManager);
+
+		//The histograms are appended to the dump file when the profiler is destroyed
+		$lines = file($dumpFile);
+		$this->assertEquals(count($lines), 1);
+		$dump = json_decode($lines[0], true);
+		$this->assertEquals($dump['statements'], 1);
+		@unlink($dumpFile);
+	}
+
 }
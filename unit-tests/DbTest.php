@@ -87,6 +87,69 @@ class DbTest extends PHPUnit_Framework_TestCase
 		$this->_executeTests($connection);
 	}
 
+	public function testDbPoolMysql()
+	{
+
+		require 'unit-tests/config.db.php';
+
+		$configMysql['pool'] = array('size' => 2);
+
+		$this->_executePoolTests('Phalcon\Db\Adapter\Pdo\Mysql', $configMysql, 'mysql:host=localhost;dbname=phalcon_test:root');
+	}
+
+	public function testDbPoolSqlite()
+	{
+
+		require 'unit-tests/config.db.php';
+
+		$configSqlite['pool'] = array('size' => 2);
+
+		$this->_executePoolTests('Phalcon\Db\Adapter\Pdo\Sqlite', $configSqlite, 'sqlite:'.$configSqlite['dbname'].':');
+	}
+
+	protected function _executePoolTests($className, $descriptor, $poolKey)
+	{
+
+		$first = new $className($descriptor);
+		$second = new $className($descriptor);
+
+		//The request can't lease more connections than the size of the pool
+		try {
+			$third = new $className($descriptor);
+			$this->assertTrue(false);
+		} catch (Phalcon\Db\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		$stats = Phalcon\Db\Adapter\Pdo::getPoolStats();
+		$this->assertTrue(isset($stats[$poolKey]));
+		$this->assertEquals($stats[$poolKey]['size'], 2);
+		$this->assertEquals($stats[$poolKey]['leased'], 2);
+		$this->assertTrue($stats[$poolKey]['exhausted'] > 0);
+
+		//Closed connections are reused without the transaction they left open
+		$hits = $stats[$poolKey]['hits'];
+
+		$this->assertTrue($first->begin());
+		$this->assertTrue($first->close());
+
+		$third = new $className($descriptor);
+		$this->assertFalse($third->isUnderTransaction());
+
+		$result = $third->query("SELECT * FROM personas LIMIT 3");
+		$this->assertEquals(count($result->fetchAll()), 3);
+
+		$stats = Phalcon\Db\Adapter\Pdo::getPoolStats();
+		$this->assertEquals($stats[$poolKey]['hits'], $hits + 1);
+		$this->assertEquals($stats[$poolKey]['leased'], 2);
+
+		$second->close();
+		$third->close();
+
+		$stats = Phalcon\Db\Adapter\Pdo::getPoolStats();
+		$this->assertEquals($stats[$poolKey]['leased'], 0);
+	}
+
 	protected function _executeTests($connection)
 	{
 
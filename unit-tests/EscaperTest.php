@@ -0,0 +1,76 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class EscaperTest extends PHPUnit_Framework_TestCase
+{
+
+	public function testEscapeHtml()
+	{
+		$escaper = new Phalcon\Escaper();
+
+		$text = "Unescaped text, nothing to do here";
+		$this->assertEquals($escaper->escapeHtml($text), $text);
+
+		$texts = array(
+			'<a href="/about">it\'s "quoted" & done</a>',
+			"caf\xc3\xa9 <b>\xe2\x82\xac</b>",
+			str_repeat('<p class="x">', 20),
+			"invalid \xc3\x28 sequence <b>",
+			""
+		);
+		foreach ($texts as $text) {
+			$this->assertEquals($escaper->escapeHtml($text), htmlspecialchars($text, ENT_QUOTES, 'utf-8'));
+		}
+
+		$escaper->setHtmlQuoteType(ENT_NOQUOTES);
+		$this->assertEquals($escaper->escapeHtml('"it\'s" <b>'), '"it\'s" &lt;b&gt;');
+
+		$escaper->setHtmlQuoteType(ENT_COMPAT);
+		$this->assertEquals($escaper->escapeHtml('"it\'s" <b>'), '&quot;it\'s&quot; &lt;b&gt;');
+	}
+
+	public function testEscapeHtmlAttr()
+	{
+		$escaper = new Phalcon\Escaper();
+
+		$this->assertEquals($escaper->escapeHtmlAttr('plain_attr-value.1,2'), 'plain_attr-value.1,2');
+		$this->assertEquals($escaper->escapeHtmlAttr('a"b&c<d>e f'), 'a&quot;b&amp;c&lt;d&gt;e&#x20;f');
+		$this->assertEquals($escaper->escapeHtmlAttr("caf\xc3\xa9 \xe2\x82\xac\x01"), 'caf&#xE9;&#x20;&#x20AC;&#xFFFD;');
+	}
+
+	public function testEscapeCss()
+	{
+		$escaper = new Phalcon\Escaper();
+
+		$this->assertEquals($escaper->escapeCss("Verdana"), "Verdana");
+		$this->assertEquals($escaper->escapeCss("font-family: <Verdana>"), 'font\2D family\3A \20 \3C Verdana\3E ');
+		$this->assertEquals($escaper->escapeCss("caf\xc3\xa9"), 'caf\E9 ');
+	}
+
+	public function testEscapeJs()
+	{
+		$escaper = new Phalcon\Escaper();
+
+		$this->assertEquals($escaper->escapeJs("some_text,1.2"), "some_text,1.2");
+		$this->assertEquals($escaper->escapeJs("alert('hello');"), 'alert\x28\x27hello\x27\x29\x3B');
+		$this->assertEquals($escaper->escapeJs("\xe2\x82\xac\xf0\x9f\x98\x80"), '\u20AC\uD83D\uDE00');
+	}
+
+}
@@ -101,6 +101,9 @@ class ModelsMetadataTest extends PHPUnit_Framework_TestCase
 
 		$personas = new Personas($di);
 
+		//Initialize both models from a single schema description
+		$metaData->warm(array($personas, new Robots($di)));
+
 		$pAttributes = array(
 			0 => 'cedula',
 			1 => 'tipo_documento_id',
@@ -363,6 +363,28 @@ class ModelsQueryExecuteTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($result[1]->r->id, 1);
 		$this->assertEquals($result[1]->p->id, 2);
 
+		// Scalars and objects in the same row, the rows are built again on every iteration
+		$result = $manager->executeQuery('SELECT r.id, r.name robotName, p.* FROM Robots r JOIN RobotsParts p ON r.id = p.robots_id ORDER BY r.id, p.id');
+		$this->assertInstanceOf('Phalcon\Mvc\Model\Resultset\Complex', $result);
+		$robotName = $result[0]->robotName;
+		$this->assertTrue(is_string($robotName));
+		for ($i = 0; $i < 2; $i++) {
+			$parts = array();
+			foreach ($result as $row) {
+				$this->assertEquals($row->id, 1);
+				$this->assertEquals($row->robotName, $robotName);
+				$this->assertEquals(get_class($row->p), 'RobotsParts');
+				$parts[] = $row->p->id;
+			}
+			$this->assertEquals(count($parts), 3);
+			$this->assertEquals($parts[0], 1);
+			$this->assertEquals($parts[1], 2);
+		}
+
+		$copy = clone $result;
+		$this->assertEquals($copy[1]->p->id, 2);
+		$this->assertEquals($copy[1]->robotName, $robotName);
+
 	}
 
 	public function _testSelectRenamedExecute($di)
@@ -0,0 +1,127 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class ModelsReadConnectionsTest extends PHPUnit_Framework_TestCase
+{
+
+	public function __construct()
+	{
+		spl_autoload_register(array($this, 'modelsAutoloader'));
+	}
+
+	public function __destruct()
+	{
+		spl_autoload_unregister(array($this, 'modelsAutoloader'));
+	}
+
+	public function modelsAutoloader($className)
+	{
+		if (file_exists('unit-tests/models/'.$className.'.php')) {
+			require 'unit-tests/models/'.$className.'.php';
+		}
+	}
+
+	protected function _getDI()
+	{
+
+		Phalcon\DI::reset();
+
+		$di = new Phalcon\DI();
+
+		$di->set('modelsManager', function(){
+			return new Phalcon\Mvc\Model\Manager();
+		});
+
+		$di->set('modelsMetadata', function(){
+			return new Phalcon\Mvc\Model\Metadata\Memory();
+		});
+
+		return $di;
+	}
+
+	public function testReadConnectionsMysql()
+	{
+
+		$di = $this->_getDI();
+
+		$connection = function(){
+			require 'unit-tests/config.db.php';
+			return new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
+		};
+
+		$di->set('db', $connection);
+		$di->set('dbReplica1', $connection);
+		$di->set('dbReplica2', $connection);
+
+		$this->_executeTests($di);
+	}
+
+	public function testReadConnectionsPostgresql()
+	{
+
+		$di = $this->_getDI();
+
+		$connection = function(){
+			require 'unit-tests/config.db.php';
+			return new Phalcon\Db\Adapter\Pdo\Postgresql($configPostgresql);
+		};
+
+		$di->set('db', $connection);
+		$di->set('dbReplica1', $connection);
+		$di->set('dbReplica2', $connection);
+
+		$this->_executeTests($di);
+	}
+
+	protected function _executeTests($di)
+	{
+
+		$primary = $di->getShared('db');
+		$replica1 = $di->getShared('dbReplica1');
+		$replica2 = $di->getShared('dbReplica2');
+
+		//Models without read connections read from the primary
+		$robot = new Robots();
+		$this->assertSame($robot->getReadConnection(), $primary);
+
+		//The replicas are used round-robin
+		$robot = new RobotsReplicated();
+		$first = $robot->getReadConnection();
+		$second = $robot->getReadConnection();
+		$this->assertNotSame($first, $primary);
+		$this->assertNotSame($second, $primary);
+		$this->assertNotSame($first, $second);
+		$this->assertTrue($first === $replica1 || $first === $replica2);
+		$this->assertSame($robot->getReadConnection(), $first);
+
+		$this->assertEquals(count(RobotsReplicated::find()), 3);
+		$this->assertEquals(RobotsReplicated::count(), 3);
+
+		//Reads stick to the primary after a write
+		$robot = RobotsReplicated::findFirst();
+		$this->assertTrue($robot->save());
+		$this->assertSame($robot->getReadConnection(), $primary);
+
+		$robot = new RobotsReplicated();
+		$this->assertSame($robot->getReadConnection(), $primary);
+		$this->assertEquals(count(RobotsReplicated::find()), 3);
+	}
+
+}
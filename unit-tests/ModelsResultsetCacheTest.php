@@ -187,6 +187,107 @@ class ModelsResultsetCacheTest extends PHPUnit_Framework_TestCase
 		));
 	}
 
+	protected function _testCacheAutoKeys($di)
+	{
+
+		$di->set('modelsCache', function(){
+			$frontCache = new Phalcon\Cache\Frontend\Data();
+			return new Phalcon\Cache\Backend\File($frontCache, array(
+				'cacheDir' => 'unit-tests/cache/'
+			));
+		});
+
+		$di->getShared('modelsManager')->setCacheService('modelsCache');
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertEquals(count($robots), 3);
+		$this->assertTrue($robots->isFresh());
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertEquals(count($robots), 3);
+		$this->assertFalse($robots->isFresh());
+
+		//Other bound values are other keys
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 1),
+			'order' => 'id'
+		));
+		$this->assertEquals(count($robots), 2);
+		$this->assertTrue($robots->isFresh());
+
+		//Writing the table discards the cached results
+		$robot = Robots::findFirst();
+		$this->assertTrue($robot->save());
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertEquals(count($robots), 3);
+		$this->assertTrue($robots->isFresh());
+
+		//Writing other tables keeps them
+		$part = Parts::findFirst();
+		$this->assertTrue($part->save());
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertEquals(count($robots), 3);
+		$this->assertFalse($robots->isFresh());
+
+		//Results cached while a transaction is open are discarded when it commits
+		$transaction = new Phalcon\Mvc\Model\Transaction($di, true);
+
+		$robot = Robots::findFirst();
+		$robot->setTransaction($transaction);
+		$this->assertTrue($robot->save());
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertTrue($robots->isFresh());
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertFalse($robots->isFresh());
+
+		$transaction->commit();
+
+		$robots = Robots::find(array(
+			'cache' => array('auto' => true),
+			'conditions' => 'id > :id1:',
+			'bind' => array('id1' => 0),
+			'order' => 'id'
+		));
+		$this->assertEquals(count($robots), 3);
+		$this->assertTrue($robots->isFresh());
+	}
+
 	public function testCacheDefaultDIMysql()
 	{
 		$di = $this->_prepareTestMysql();
@@ -211,6 +312,18 @@ class ModelsResultsetCacheTest extends PHPUnit_Framework_TestCase
 		$this->_testCacheDefaultDIBindings($di);
 	}
 
+	public function testCacheAutoKeysMysql()
+	{
+		$di = $this->_prepareTestMysql();
+		$this->_testCacheAutoKeys($di);
+	}
+
+	public function testCacheAutoKeysPostgresql()
+	{
+		$di = $this->_prepareTestPostgresql();
+		$this->_testCacheAutoKeys($di);
+	}
+
 	public function testCacheOtherServiceMysql()
 	{
 
@@ -224,6 +224,7 @@ class ModelsResultsetTest extends PHPUnit_Framework_TestCase
 		$this->_prepareTestMysql();
 
 		$data = serialize(Robots::find(array('order' => 'id')));
+		$this->assertTrue(strpos($data, ':{PHR') !== false);
 
 		$robots = unserialize($data);
 
@@ -231,6 +232,8 @@ class ModelsResultsetTest extends PHPUnit_Framework_TestCase
 
 		$this->_applyTests($robots);
 
+		$this->assertEquals(serialize($robots), $data);
+
 	}
 
 	public function testSerializeBindingsMysql()
@@ -329,4 +332,37 @@ class ModelsResultsetTest extends PHPUnit_Framework_TestCase
 
 	}
 
-}
\ No newline at end of file
+	public function testSerializeComplexMysql()
+	{
+
+		$this->_prepareTestMysql();
+
+		$manager = Phalcon\DI::getDefault()->getShared('modelsManager');
+
+		$data = serialize($manager->executeQuery('SELECT r.id, r.name, p.* FROM Robots r JOIN RobotsParts p ON r.id = p.robots_id ORDER BY r.id, p.id'));
+
+		//Rows are packed after a header with the column names
+		$this->assertTrue(strpos($data, ':{PHR') !== false);
+
+		$result = unserialize($data);
+
+		$this->assertEquals(get_class($result), 'Phalcon\Mvc\Model\Resultset\Complex');
+		$this->assertEquals(count($result), 3);
+
+		$number = 0;
+		foreach ($result as $row) {
+			$this->assertEquals($row->id, 1);
+			$this->assertTrue(is_string($row->name));
+			$this->assertEquals(get_class($row->p), 'RobotsParts');
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+
+		$this->assertEquals($result[1]->p->id, 2);
+		$this->assertEquals($result->getLast()->p->robots_id, 1);
+
+		//Restored resultsets are serialized again without decoding the rows
+		$this->assertEquals(serialize($result), $data);
+	}
+
+}
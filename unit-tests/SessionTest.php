@@ -34,4 +34,144 @@ class SessionTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($session->get('some'), 'value');
 	}
 
+	public function testSessionLazy()
+	{
+
+		$session = new Phalcon\Session\Adapter\Files(array('lazy' => true, 'readOnly' => false));
+
+		$this->assertFalse($session->isReadOnly());
+		$this->assertFalse($session->isDirty());
+
+		//Headers were already sent, the session can't be started here
+		$this->assertFalse($session->start());
+		$this->assertFalse($session->isStarted());
+
+		$path = sys_get_temp_dir() . '/phalcon-lazy-' . getmypid();
+		if (!is_dir($path)) {
+			mkdir($path);
+		}
+
+		$id = 'phalconlazy' . getmypid();
+
+		$result = $this->_runLazySession($path, $id, 'write');
+		$this->assertTrue($result['started']);
+		$this->assertTrue($result['dirty']);
+		$this->assertTrue($result['closed']);
+		$this->assertTrue(file_exists($path . '/sess_' . $id));
+
+		$result = $this->_runLazySession($path, $id, 'read');
+		$this->assertEquals($result['lazy'], 'value');
+		$this->assertFalse($result['dirty']);
+		$this->assertTrue($result['closed']);
+
+		//Direct writes to $_SESSION are discarded, session_abort drops sessions that weren't changed
+		$result = $this->_runLazySession($path, $id, 'direct');
+		$this->assertFalse($result['dirty']);
+
+		$result = $this->_runLazySession($path, $id, 'read');
+		$this->assertEquals($result['lazy'], 'value');
+		if (function_exists('session_abort')) {
+			$this->assertNull($result['direct']);
+		} else {
+			$this->assertEquals($result['direct'], 'value');
+		}
+
+		//Writes to a read-only session throw and leave the stored data unchanged
+		$result = $this->_runLazySession($path, $id, 'readOnly');
+		$this->assertTrue($result['started']);
+		$this->assertEquals($result['lazy'], 'value');
+		$this->assertEquals($result['exceptions'], 2);
+
+		$result = $this->_runLazySession($path, $id, 'read');
+		$this->assertEquals($result['lazy'], 'value');
+
+		@unlink($path . '/sess_' . $id);
+		@rmdir($path);
+	}
+
+	protected function _runLazySession($path, $id, $action)
+	{
+		$binary = defined('PHP_BINARY') ? PHP_BINARY : 'php';
+		$output = shell_exec(escapeshellarg($binary) . ' ' . escapeshellarg(__DIR__ . '/session/lazy.php') . ' ' . escapeshellarg($path) . ' ' . escapeshellarg($id) . ' ' . $action);
+		return unserialize($output);
+	}
+
+	public function testSessionMemcache()
+	{
+
+		if (!function_exists('proc_open')) {
+			$this->markTestSkipped('proc_open is required to run the memcached stand-in');
+			return;
+		}
+
+		$socket = sys_get_temp_dir() . '/phalcon-session-' . getmypid() . '.sock';
+		$binary = defined('PHP_BINARY') ? PHP_BINARY : 'php';
+
+		$process = proc_open(escapeshellarg($binary) . ' ' . escapeshellarg(__DIR__ . '/session/memcached.php') . ' ' . escapeshellarg($socket), array(), $pipes);
+		for ($i = 0; $i < 100 && !file_exists($socket); $i++) {
+			usleep(20000);
+		}
+
+		session_id('phalcontest' . getmypid());
+
+		$cart = array(1, 2, 'three' => 3.5, 'nested' => array(true, null, -7, 'text'));
+
+		foreach (array(true, false) as $compact) {
+
+			$session = new Phalcon\Session\Adapter\Memcache(array(
+				'host' => $socket,
+				'prefix' => $compact ? 'c_' : 's_',
+				'compact' => $compact
+			));
+
+			$this->assertFalse($session->has('cart'));
+			$this->assertNull($session->get('cart'));
+
+			$this->assertTrue($session->set('cart', $cart));
+			$this->assertTrue($session->set('user', 'phalcon', 60));
+
+			$this->assertTrue($session->has('cart'));
+			$this->assertEquals($session->get('cart'), $cart);
+			$this->assertEquals($session->get('user'), 'phalcon');
+
+			$this->assertTrue($session->remove('user'));
+			$this->assertFalse($session->has('user'));
+
+			$this->assertEquals($session->handlerRead('other'), '');
+			$this->assertTrue($session->handlerWrite('other', 'a|s:1:"b";'));
+
+			$session = new Phalcon\Session\Adapter\Memcache(array(
+				'host' => $socket,
+				'prefix' => $compact ? 'c_' : 's_'
+			));
+
+			$this->assertEquals($session->get('cart'), $cart);
+			$this->assertEquals($session->handlerRead('other'), 'a|s:1:"b";');
+			$this->assertTrue($session->handlerWrite('other', 'a|s:1:"b";'));
+			$this->assertTrue($session->handlerDestroy('other'));
+			$this->assertEquals($session->handlerRead('other'), '');
+		}
+
+		//Values without their own lifetime are renewed when the session is written
+		$session = new Phalcon\Session\Adapter\Memcache(array(
+			'host' => $socket,
+			'prefix' => 'l_',
+			'lifetime' => 3
+		));
+
+		$this->assertTrue($session->set('kept', 'value'));
+		$this->assertTrue($session->set('short', 'value', 3));
+
+		sleep(2);
+		$this->assertTrue($session->handlerWrite(session_id(), ''));
+
+		sleep(2);
+		$this->assertTrue($session->has('kept'));
+		$this->assertFalse($session->has('short'));
+
+		proc_terminate($process);
+		proc_close($process);
+		@unlink($socket);
+	}
+
 }
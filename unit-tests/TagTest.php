@@ -183,6 +183,16 @@ class TagTest extends PHPUnit_Framework_TestCase
 	<option selected="selected" value="C">Crystal</option>
 </select>');
 
+		//Options from arrays are written as given, texts may already be escaped
+		$values = array(
+			'T&amp;C' => 'Terms &amp; Conditions',
+			'<b>' => '<b>Bold</b>'
+		);
+		$this->assertEquals(Tag::selectStatic('legal', $values), '<select name="legal" id="legal">
+	<option value="T&amp;C">Terms &amp; Conditions</option>
+	<option value="<b>"><b>Bold</b></option>
+</select>');
+
 	}
 
 	public function testSelect()
@@ -206,6 +216,20 @@ class TagTest extends PHPUnit_Framework_TestCase
 	<option value="3">Terminator</option>
 </select>');
 
+		$number = 0;
+		foreach ($robots as $robot) {
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+
+		$robotters = Robotters::find();
+
+		$params = array('nice', $robotters, 'using' => array('code', 'theName'), 'value' => 3);
+		$this->assertEquals(Tag::select($params), '<select name="nice" id="nice">
+	<option value="1">Robotina</option>
+	<option value="2">Astro Boy</option>
+	<option selected="selected" value="3">Terminator</option>
+</select>');
 
 	}
 
@@ -60,4 +60,37 @@ class TasksCliTest extends PHPUnit_Framework_TestCase
 		$this->assertEquals($task2->mainAction(), 'echoMainAction');
 	}
 
+	public function testVoltTask()
+	{
+
+		$di = new \Phalcon\DI\FactoryDefault\CLI();
+
+		$di->set('view', function(){
+			$view = new \Phalcon\Mvc\View();
+			$view->setViewsDir('unit-tests/views/');
+			return $view;
+		});
+
+		@unlink('unit-tests/cache/unit-tests.views.test10.index.volt.php');
+		@unlink('unit-tests/cache/volt-manifest.php');
+
+		$task = new VoltTask();
+		$task->setDI($di);
+
+		$manifest = $task->compileAction('unit-tests/views/test10/');
+
+		$this->assertEquals($manifest['unit-tests/views/test10/index.volt'], 'unit-tests/cache/unit-tests.views.test10.index.volt.php');
+		$this->assertEquals(file_get_contents('unit-tests/cache/unit-tests.views.test10.index.volt.php'), 'Hello <?php echo $song; ?>!');
+
+		$this->assertTrue(file_exists('unit-tests/cache/volt-manifest.php'));
+		$this->assertEquals(require 'unit-tests/cache/volt-manifest.php', $manifest);
+
+		//Compiling in several processes produces the same manifest
+		if (function_exists('pcntl_fork')) {
+			@unlink('unit-tests/cache/unit-tests.views.test10.index.volt.php');
+			$this->assertEquals($task->compileAction('unit-tests/views/test10/', 2), $manifest);
+			$this->assertTrue(file_exists('unit-tests/cache/unit-tests.views.test10.index.volt.php'));
+		}
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+<?php
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2012 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+class TraceTest extends PHPUnit_Framework_TestCase
+{
+
+	public function testTraceOutput()
+	{
+
+		//The output directory can only be set in php.ini
+		$this->assertFalse(ini_set('phalcon.trace.output', sys_get_temp_dir()));
+
+		$path = sys_get_temp_dir() . '/phalcon-trace-' . getmypid();
+		if (!is_dir($path)) {
+			mkdir($path);
+		}
+
+		$events = $this->_runTraced($path, 16, $dropped);
+		$this->assertEquals($dropped, 0);
+		$this->assertEquals(count($events), 2);
+
+		$this->assertEquals($events[0]['name'], 'Phalcon\Loader::autoload');
+		$this->assertEquals($events[0]['ph'], 'X');
+		$this->assertEquals($events[0]['args']['depth'], 0);
+		$this->assertEquals($events[0]['args']['detail'], 'TraceChild');
+
+		//The parent class is loaded while the child is
+		$this->assertEquals($events[1]['name'], 'Phalcon\Loader::autoload');
+		$this->assertEquals($events[1]['args']['depth'], 1);
+		$this->assertEquals($events[1]['args']['detail'], 'TraceParent');
+		$this->assertGreaterThanOrEqual($events[0]['ts'], $events[1]['ts']);
+		$this->assertLessThanOrEqual($events[0]['ts'] + $events[0]['dur'], $events[1]['ts'] + $events[1]['dur']);
+
+		//Spans over phalcon.trace.max_spans are counted as dropped
+		$events = $this->_runTraced($path, 1, $dropped);
+		$this->assertEquals($dropped, 1);
+		$this->assertEquals(count($events), 1);
+		$this->assertEquals($events[0]['args']['detail'], 'TraceChild');
+
+		@rmdir($path);
+	}
+
+	protected function _runTraced($path, $maxSpans, &$dropped)
+	{
+		$binary = defined('PHP_BINARY') ? PHP_BINARY : 'php';
+
+		$command = escapeshellarg($binary) .
+			' -d phalcon.trace.enabled=1 -d phalcon.trace.sampling=1' .
+			' -d phalcon.trace.max_spans=' . $maxSpans .
+			' -d phalcon.trace.output=' . escapeshellarg($path) .
+			' ' . escapeshellarg(__DIR__ . '/trace/autoload.php');
+
+		$this->assertEquals(shell_exec($command), 'TraceParent');
+
+		$files = glob($path . '/phalcon-trace-*.json');
+		$this->assertEquals(count($files), 1);
+
+		$trace = json_decode(file_get_contents($files[0]), true);
+		unlink($files[0]);
+
+		$this->assertTrue(is_array($trace));
+		$this->assertEquals($trace['displayTimeUnit'], 'ms');
+
+		$dropped = $trace['otherData']['dropped'];
+		return $trace['traceEvents'];
+	}
+
+}
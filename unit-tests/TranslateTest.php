@@ -81,4 +81,77 @@ class TranslateTest extends PHPUnit_Framework_TestCase
 		}
 	}
 
-}
\ No newline at end of file
+	public function testPlaceholders()
+	{
+		$translate = new Phalcon\Translate\Adapter\NativeArray(array(
+			'content' => array(
+				'song-key' => 'This song is %name%, %song%',
+				'percent-key' => '100% of %name%'
+			)
+		));
+
+		$this->assertEquals($translate->_('song-key', array('name' => 'Sonny', 'song' => 'scary movies')), 'This song is Sonny, scary movies');
+		$this->assertEquals($translate->_('percent-key', array('name' => 'Sonny')), '100% of Sonny');
+		$this->assertEquals($translate->_('song-key', array('name' => 1)), 'This song is 1, %song%');
+	}
+
+	public function testGettext()
+	{
+		foreach (array('es' => 'Hola', 'fr' => 'Bonjour') as $lang => $hello) {
+
+			$translate = new Phalcon\Translate\Adapter\Gettext(array(
+				'file' => 'unit-tests/messages/'.$lang.'.mo'
+			));
+
+			$this->assertTrue(isset($translate['hi']));
+			$this->assertFalse(isset($translate['missing']));
+			$this->assertEquals($translate['hi'], $hello);
+			$this->assertEquals($translate['missing'], 'missing');
+			$this->assertEquals($translate->_('hello-key', array('name' => 'Sonny')), $hello.' Sonny');
+		}
+
+		$translate = new Phalcon\Translate\Adapter\Gettext(array(
+			'file' => 'unit-tests/messages/es.mo'
+		));
+		$this->assertEquals($translate->_('song-key', array('name' => 'Sonny', 'song' => 'scary movies')), 'La canción es Sonny, scary movies');
+		$this->assertEquals($translate->_('percent-key', array('name' => 'Sonny')), '100% de Sonny');
+		$this->assertEquals($translate->_('apple'), 'manzana');
+
+		try {
+			new Phalcon\Translate\Adapter\Gettext(array('file' => 'unit-tests/messages/es.php'));
+			$this->assertTrue(false);
+		} catch (Phalcon\Translate\Exception $e) {
+			$this->assertTrue(true);
+		}
+	}
+
+	public function testGettextCorrupt()
+	{
+		$catalog = file_get_contents('unit-tests/messages/es.mo');
+		$path = sys_get_temp_dir() . '/phalcon-gettext-' . getmypid() . '.mo';
+
+		//Without a hash table the sorted messages are searched
+		file_put_contents($path, substr_replace($catalog, pack('V', 0), 20, 4));
+
+		$translate = new Phalcon\Translate\Adapter\Gettext(array('file' => $path));
+		$this->assertEquals($translate['hi'], 'Hola');
+		$this->assertEquals($translate->_('apple'), 'manzana');
+		$this->assertFalse(isset($translate['missing']));
+		$this->assertFalse(isset($translate['h']));
+		$this->assertFalse(isset($translate['hip']));
+		unset($translate);
+
+		//Truncated catalogs are rejected instead of being read past their end
+		clearstatcache();
+		file_put_contents($path, substr($catalog, 0, -1));
+		try {
+			new Phalcon\Translate\Adapter\Gettext(array('file' => $path));
+			$this->assertTrue(false);
+		} catch (Phalcon\Translate\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		unlink($path);
+	}
+
+}
@@ -18,6 +18,18 @@
   +------------------------------------------------------------------------+
 */
 
+class VoltCountingCompiler extends Phalcon\Mvc\View\Engine\Volt\Compiler
+{
+
+	public $lists = 0;
+
+	protected function _statementList($statements, $extendsMode)
+	{
+		$this->lists++;
+		return parent::_statementList($statements, $extendsMode);
+	}
+
+}
 
 class ViewEnginesVoltTest extends PHPUnit_Framework_TestCase
 {
@@ -482,6 +494,7 @@ class ViewEnginesVoltTest extends PHPUnit_Framework_TestCase
 	{
 
 		$volt = new \Phalcon\Mvc\View\Engine\Volt\Compiler();
+		$volt->setOptions(array('optimize' => false));
 
 		$compilation = $volt->compileString('');
 		$this->assertEquals($compilation, '');
@@ -727,6 +740,108 @@ class ViewEnginesVoltTest extends PHPUnit_Framework_TestCase
 		$compilation = $volt->compileString('{# some comment #}{{ "hello" }}{# other comment }}');
 		$this->assertEquals($compilation, "<?php echo 'hello'; ?>");
 
+		//Raw text split by comments
+		$compilation = $volt->compileString('hello {# some comment #}world{% if a %}{# x #}yes{# y #}, no{% endif %}');
+		$this->assertEquals($compilation, 'hello world<?php if ($a) { ?>yes, no<?php } ?>');
+
+		$text = str_repeat('a', 300);
+		$compilation = $volt->compileString($text . '{# some comment #}' . $text . '{# other comment #}' . $text);
+		$this->assertEquals($compilation, str_repeat('a', 900));
+
+	}
+
+	public function testVoltCompilerStatementListOverride()
+	{
+		$volt = new VoltCountingCompiler();
+		$volt->setOptions(array('optimize' => false));
+
+		$compilation = $volt->compileString('{% for a in b %}{% if a %} hello {% endif %}{% endfor %}');
+		$this->assertEquals($compilation, '<?php foreach ($b as $a) { ?><?php if ($a) { ?> hello <?php } ?><?php } ?>');
+		$this->assertEquals($volt->lists, 3);
+	}
+
+	public function testVoltCompilerOptimizer()
+	{
+
+		$volt = new \Phalcon\Mvc\View\Engine\Volt\Compiler();
+
+		$this->assertEquals($volt->getOptions(), null);
+
+		//Constant folding
+		$compilation = $volt->compileString('Some = {{ 100+50 }}');
+		$this->assertEquals($compilation, 'Some = 150');
+
+		$compilation = $volt->compileString('Some = {{ 100-50*2 }}');
+		$this->assertEquals($compilation, 'Some = 0');
+
+		$compilation = $volt->compileString('{{ -10 }}');
+		$this->assertEquals($compilation, '-10');
+
+		$compilation = $volt->compileString('{{ 10/4 }}');
+		$this->assertEquals($compilation, '<?php echo 2.5; ?>');
+
+		$compilation = $volt->compileString('{{ 1.5*2 }}');
+		$this->assertEquals($compilation, '<?php echo 3.0; ?>');
+
+		$compilation = $volt->compileString('{{ 10/0 }}');
+		$this->assertEquals($compilation, '<?php echo 10 / 0; ?>');
+
+		$compilation = $volt->compileString('{% set a = 2*(3+4) %}');
+		$this->assertEquals($compilation, '<?php $a = 14; ?>');
+
+		$compilation = $volt->compileString('{% set a = 1.2+1*(20/b) %}');
+		$this->assertEquals($compilation, '<?php $a = 1.2 + 1 * (20 / $b); ?>');
+
+		$compilation = $volt->compileString('{{ "hello" ~ " " ~ "world" }}');
+		$this->assertEquals($compilation, 'hello world');
+
+		$compilation = $volt->compileString('{{ "hello" ~ a }}');
+		$this->assertEquals($compilation, '<?php echo \'hello\' . $a; ?>');
+
+		//Echo of literals and raw fragments
+		$compilation = $volt->compileString('-{{ "hello" }}-{{ "hello" }}-');
+		$this->assertEquals($compilation, '-hello-hello-');
+
+		$compilation = $volt->compileString("{{ 'a' }}\nb");
+		$this->assertEquals($compilation, 'ab');
+
+		$compilation = $volt->compileString('{{ "<?php" }}');
+		$this->assertEquals($compilation, "<?php echo '<?php'; ?>");
+
+		//Filters
+		$compilation = $volt->compileString('{{ "  hello "|trim|uppercase }}');
+		$this->assertEquals($compilation, 'HELLO');
+
+		$compilation = $volt->compileString('{{ "hello"|length }}');
+		$this->assertEquals($compilation, '5');
+
+		$compilation = $volt->compileString('{{ -0 }}');
+		$this->assertEquals($compilation, '0');
+
+		$compilation = $volt->compileString('{{ a|length }}');
+		$this->assertEquals($compilation, '<?php echo (is_string($a) ? strlen($a) : count($a)); ?>');
+
+		$compilation = $volt->compileString('{{ a.b|length }}');
+		$this->assertEquals($compilation, '<?php echo $this->length($a->b); ?>');
+
+		$compilation = $volt->compileString('{{ ("hello" ~ "lol")|e|length }}');
+		$this->assertEquals($compilation, '<?php echo $this->length($this->escaper->escapeHtml(\'hellolol\')); ?>');
+
+		//Services hoisted out of loops
+		$compilation = $volt->compileString('{% for a in b %}{{ a|e }}{% endfor %}');
+		$this->assertEquals($compilation, '<?php $__escaper = $this->escaper; foreach ($b as $a) { ?><?php echo $__escaper->escapeHtml($a); ?><?php } ?>');
+
+		$compilation = $volt->compileString('{% for a in b %}{% for c in a %}{{ c|e }}{% endfor %}{% endfor %}');
+		$this->assertEquals($compilation, '<?php $__escaper = $this->escaper; foreach ($b as $a) { ?><?php foreach ($a as $c) { ?><?php echo $__escaper->escapeHtml($c); ?><?php } ?><?php } ?>');
+
+		$compilation = $volt->compileString('{% for a in b %}{{ a }}{% endfor %}{{ c|e }}');
+		$this->assertEquals($compilation, '<?php foreach ($b as $a) { ?><?php echo $a; ?><?php } ?><?php echo $this->escaper->escapeHtml($c); ?>');
+
+		$volt->setOptions(array('optimize' => false));
+
+		$compilation = $volt->compileString('{% for a in b %}{{ a|e }}{% endfor %}');
+		$this->assertEquals($compilation, '<?php foreach ($b as $a) { ?><?php echo $this->escaper->escapeHtml($a); ?><?php } ?>');
+
 	}
 
 	public function testVoltCompilerFile()
@@ -778,6 +893,45 @@ Clearly, the song is: <?php echo $this->getContent(); ?>.
 
 	}
 
+	public function testVoltCompilerDirectory()
+	{
+
+		$di = new Phalcon\DI();
+
+		$di->set('view', function(){
+			$view = new Phalcon\Mvc\View();
+			$view->setViewsDir('unit-tests/views/');
+			return $view;
+		});
+
+		$volt = new \Phalcon\Mvc\View\Engine\Volt\Compiler();
+		$volt->setDI($di);
+		$volt->setOptions(array(
+			"compiledPath" => "unit-tests/cache/",
+			"compiledSeparator" => ".",
+			"compiledExtension" => ".compiled"
+		));
+
+		$this->assertEquals($volt->getCompiledPath('unit-tests/views/test10/index.volt'), 'unit-tests/cache/unit-tests.views.test10.index.volt.compiled');
+
+		$templates = $volt->findTemplates('unit-tests/views/test10');
+		$this->assertTrue(in_array('unit-tests/views/test10/index.volt', $templates));
+		$this->assertTrue(in_array('unit-tests/views/test10/children.extends.volt', $templates));
+		$this->assertFalse(in_array('unit-tests/views/test10/index.volt.php', $templates));
+
+		$sorted = $templates;
+		sort($sorted);
+		$this->assertEquals($templates, $sorted);
+
+		@unlink('unit-tests/cache/unit-tests.views.test10.index.volt.compiled');
+
+		$manifest = $volt->compileDirectory('unit-tests/views/test10/');
+		$this->assertEquals(count($manifest), count($templates));
+		$this->assertEquals($manifest['unit-tests/views/test10/index.volt'], 'unit-tests/cache/unit-tests.views.test10.index.volt.compiled');
+		$this->assertEquals(file_get_contents('unit-tests/cache/unit-tests.views.test10.index.volt.compiled'), 'Hello <?php echo $song; ?>!');
+
+	}
+
 	public function testVoltCompilerFileOptions()
 	{
 
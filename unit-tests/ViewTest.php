@@ -103,6 +103,57 @@ class ViewTest extends PHPUnit_Framework_TestCase
 
 	}
 
+	public function testStreamingRender()
+	{
+
+		$view = new View();
+		$view->setBasePath(__DIR__.'/../');
+
+		$view->setViewsDir('unit-tests/views/');
+
+		$this->assertFalse($view->isStreaming());
+		$view->setStreaming(true);
+		$this->assertTrue($view->isStreaming());
+
+		//Every level is sent to the output instead of the buffer
+		ob_start();
+		$view->start();
+		$view->render('test3', 'other');
+		$view->finish();
+		$this->assertEquals(ob_get_clean(), '<html>lolhere</html>'.PHP_EOL);
+		$this->assertEquals($view->getContent(), '');
+
+		//Templates
+		$view->setTemplateAfter('test');
+
+		ob_start();
+		$view->start();
+		$view->render('test3', 'other');
+		$view->finish();
+		$this->assertEquals(ob_get_clean(), '<html>zuplolhere</html>'.PHP_EOL);
+
+		$view->cleanTemplateAfter();
+
+		//Render Levels
+		$view->setRenderLevel(View::LEVEL_LAYOUT);
+
+		ob_start();
+		$view->start();
+		$view->render('test3', 'other');
+		$view->finish();
+		$this->assertEquals(ob_get_clean(), 'lolhere');
+
+		//Missing levels are skipped
+		$view->setRenderLevel(View::LEVEL_MAIN_LAYOUT);
+
+		ob_start();
+		$view->start();
+		$view->render('test2', 'index');
+		$view->finish();
+		$this->assertEquals(ob_get_clean(), '<html>here</html>'.PHP_EOL);
+
+	}
+
 	public function testPartials()
 	{
 
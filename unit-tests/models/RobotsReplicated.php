@@ -0,0 +1,19 @@
+<?php
+
+/**
+ * Robots read from a pool of replicas
+ */
+class RobotsReplicated extends Phalcon\Mvc\Model
+{
+
+	public function getSource()
+	{
+		return 'robots';
+	}
+
+	public function getReadConnectionService()
+	{
+		return array('dbReplica1', 'dbReplica2');
+	}
+
+}
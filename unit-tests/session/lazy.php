@@ -0,0 +1,60 @@
+<?php
+
+/**
+ * Runs a lazy (or read-only) Phalcon\Session\Adapter\Files session in its own process, nothing is
+ * printed before the session is closed so it can be started under the CLI
+ *
+ * Usage: php unit-tests/session/lazy.php /tmp/sessions session-id (write|read|direct|readOnly)
+ */
+
+ini_set('session.save_path', $argv[1]);
+ini_set('session.use_cookies', 0);
+ini_set('session.cache_limiter', '');
+
+session_id($argv[2]);
+
+if ($argv[3] == 'readOnly') {
+	$session = new Phalcon\Session\Adapter\Files(array('readOnly' => true));
+} else {
+	$session = new Phalcon\Session\Adapter\Files(array('lazy' => true));
+}
+
+$result = array('started' => $session->start());
+
+switch ($argv[3]) {
+
+	case 'write':
+		$session->set('lazy', 'value');
+		break;
+
+	case 'read':
+		$result['lazy'] = $session->get('lazy');
+		$result['direct'] = isset($_SESSION['direct']) ? $_SESSION['direct'] : null;
+		break;
+
+	case 'direct':
+		//Only set() and remove() mark the session as changed
+		$session->get('lazy');
+		$_SESSION['direct'] = 'value';
+		break;
+
+	case 'readOnly':
+		$result['lazy'] = $session->get('lazy');
+		$result['exceptions'] = 0;
+		try {
+			$session->set('lazy', 'changed');
+		} catch (Phalcon\Session\Exception $e) {
+			$result['exceptions']++;
+		}
+		try {
+			$session->remove('lazy');
+		} catch (Phalcon\Session\Exception $e) {
+			$result['exceptions']++;
+		}
+		break;
+}
+
+$result['dirty'] = $session->isDirty();
+$result['closed'] = $session->close();
+
+echo serialize($result);
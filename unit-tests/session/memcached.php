@@ -0,0 +1,121 @@
+<?php
+
+/**
+ * Stand-in for memcached used by the session tests, it speaks the subset of the text protocol
+ * Phalcon\Session\Adapter\Memcache uses (get, set, add, delete, touch) on a UNIX socket
+ *
+ * Usage: php unit-tests/session/memcached.php /tmp/memcached.sock
+ */
+
+$path = $argv[1];
+if (file_exists($path)) {
+	unlink($path);
+}
+
+$server = stream_socket_server('unix://' . $path, $errno, $errstr);
+if (!$server) {
+	fwrite(STDERR, $errstr . PHP_EOL);
+	exit(1);
+}
+
+$items = array();
+$clients = array();
+
+function expiration($lifetime)
+{
+	$lifetime = (int) $lifetime;
+	if ($lifetime <= 0) {
+		return 0;
+	}
+	return time() + $lifetime;
+}
+
+function fetch(&$items, $key)
+{
+	if (!isset($items[$key])) {
+		return null;
+	}
+	if ($items[$key]['expires'] && $items[$key]['expires'] < time()) {
+		unset($items[$key]);
+		return null;
+	}
+	return $items[$key];
+}
+
+while (true) {
+
+	$read = $clients;
+	$read[] = $server;
+	$write = null;
+	$except = null;
+	if (!stream_select($read, $write, $except, null)) {
+		continue;
+	}
+
+	foreach ($read as $client) {
+
+		if ($client === $server) {
+			$clients[] = stream_socket_accept($server);
+			continue;
+		}
+
+		$line = fgets($client);
+		if ($line === false) {
+			fclose($client);
+			unset($clients[array_search($client, $clients, true)]);
+			continue;
+		}
+
+		$parts = explode(' ', rtrim($line, "\r\n"));
+		switch ($parts[0]) {
+
+			case 'get':
+				$item = fetch($items, $parts[1]);
+				if ($item) {
+					fwrite($client, 'VALUE ' . $parts[1] . ' ' . $item['flags'] . ' ' . strlen($item['data']) . "\r\n" . $item['data'] . "\r\n");
+				}
+				fwrite($client, "END\r\n");
+				break;
+
+			case 'set':
+			case 'add':
+				$data = '';
+				while (strlen($data) < $parts[4] + 2) {
+					$data .= fread($client, $parts[4] + 2 - strlen($data));
+				}
+				if ($parts[0] == 'add' && fetch($items, $parts[1])) {
+					fwrite($client, "NOT_STORED\r\n");
+					break;
+				}
+				$items[$parts[1]] = array(
+					'flags' => $parts[2],
+					'expires' => expiration($parts[3]),
+					'data' => substr($data, 0, -2)
+				);
+				fwrite($client, "STORED\r\n");
+				break;
+
+			case 'delete':
+				if (fetch($items, $parts[1])) {
+					unset($items[$parts[1]]);
+					fwrite($client, "DELETED\r\n");
+				} else {
+					fwrite($client, "NOT_FOUND\r\n");
+				}
+				break;
+
+			case 'touch':
+				if (fetch($items, $parts[1])) {
+					$items[$parts[1]]['expires'] = expiration($parts[2]);
+					fwrite($client, "TOUCHED\r\n");
+				} else {
+					fwrite($client, "NOT_FOUND\r\n");
+				}
+				break;
+
+			default:
+				fwrite($client, "ERROR\r\n");
+				break;
+		}
+	}
+}
@@ -0,0 +1,11 @@
+<?php
+
+class VoltTask extends \Phalcon\CLI\Task\Volt
+{
+
+	protected $_options = array(
+		"compiledPath" => "unit-tests/cache/",
+		"compiledSeparator" => "."
+	);
+
+}
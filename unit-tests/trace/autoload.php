@@ -0,0 +1,20 @@
+<?php
+
+/**
+ * Autoloads a class whose parent is autoloaded too, so the traced request has nested spans
+ *
+ * Usage: php -d phalcon.trace.enabled=1 -d phalcon.trace.output=/tmp/traces unit-tests/trace/autoload.php
+ */
+
+$loader = new Phalcon\Loader();
+
+$loader->registerClasses(array(
+	'TraceChild' => __DIR__ . '/TraceChild.php',
+	'TraceParent' => __DIR__ . '/TraceParent.php'
+));
+
+$loader->register();
+
+$child = new TraceChild();
+
+echo get_parent_class($child);